@@ -421,6 +421,18 @@ static int avb_control_valid(struct genavb_control_handle const *handle, genavb_
 
 			break;
 
+		case GENAVB_MSG_MAAP_CREATE_RANGES:
+			if (msg_len == sizeof(struct genavb_msg_maap_create_ranges)) {
+				avb_u32 range_id = ((struct genavb_msg_maap_create_ranges *)msg)->range_id;
+				avb_u16 n_ranges = ((struct genavb_msg_maap_create_ranges *)msg)->n_ranges;
+
+				if (n_ranges && (n_ranges <= MAAP_CREATE_RANGES_MAX) && (range_id < MAAP_MAX_CTRL_ID)
+				&& (n_ranges <= (MAAP_MAX_CTRL_ID - range_id)))
+					rc = 1;
+			}
+
+			break;
+
 		case GENAVB_MSG_MAAP_DELETE_RANGE:
 			if (msg_len == sizeof(struct genavb_msg_maap_delete)) {
 				avb_u32 range_id = ((struct genavb_msg_maap_delete *)msg)->range_id;
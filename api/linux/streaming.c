@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2018, 2020, 2023 NXP
+* Copyright 2018, 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -10,7 +10,7 @@
  \brief GenAVB public API for linux
  \details API definition for the GenAVB library
  \copyright Copyright 2014 Freescale Semiconductor, Inc.
-            Copyright 2018, 2020, 2023 NXP
+            Copyright 2018, 2020, 2023, 2026 NXP
 */
 
 #define _POSIX_C_SOURCE 200809L
@@ -38,6 +38,19 @@
 #define MEDIA_QUEUE_API_FILE "/dev/media_queue_api"
 #define API_SYNC_POLL_TIMEOUT 1000
 
+#if GENAVB_STREAM_GROUP_MAX > MEDIA_GROUP_MAX
+#error GENAVB_STREAM_GROUP_MAX larger than media driver MEDIA_GROUP_MAX
+#endif
+
+struct genavb_stream_group {
+	unsigned int n;
+	int fd[GENAVB_STREAM_GROUP_MAX];
+	int notify_fd;					/* readiness notifier, -1 if none */
+	unsigned int tx_map[GENAVB_STREAM_GROUP_MAX];	/* tx entry to stream index */
+	struct media_queue_rx_entry rx[GENAVB_STREAM_GROUP_MAX];
+	struct media_queue_tx_entry tx[GENAVB_STREAM_GROUP_MAX];
+};
+
 extern pthread_mutex_t avb_mutex;
 extern struct genavb_handle *genavb_handle;
 
@@ -683,6 +696,205 @@ exit:
 }
 
 
+int genavb_stream_group_create(struct genavb_stream_group **group, struct genavb_stream_handle * const *streams, unsigned int n)
+{
+	struct genavb_stream_group *g;
+	unsigned int i;
+	int rc;
+
+	if (!group || !streams || !n || (n > GENAVB_STREAM_GROUP_MAX)) {
+		rc = -GENAVB_ERR_INVALID_PARAMS;
+		goto err_params;
+	}
+
+	g = calloc(1, sizeof(struct genavb_stream_group));
+	if (!g) {
+		rc = -GENAVB_ERR_NO_MEMORY;
+		goto err_alloc;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (!streams[i] || (streams[i]->fd < 0)) {
+			rc = -GENAVB_ERR_STREAM_INVALID;
+			goto err_stream;
+		}
+
+		g->fd[i] = streams[i]->fd;
+		g->rx[i].fd = streams[i]->fd;
+	}
+
+	g->n = n;
+	g->notify_fd = -1;
+
+	*group = g;
+
+	return GENAVB_SUCCESS;
+
+err_stream:
+	free(g);
+
+err_alloc:
+err_params:
+	if (group)
+		*group = NULL;
+
+	return rc;
+}
+
+
+int genavb_stream_group_destroy(struct genavb_stream_group *group)
+{
+	if (!group)
+		return -GENAVB_ERR_INVALID_PARAMS;
+
+	if (group->notify_fd >= 0)
+		close(group->notify_fd);
+
+	free(group);
+
+	return GENAVB_SUCCESS;
+}
+
+
+int genavb_stream_group_notify_create(struct genavb_stream_group *group, unsigned int threshold)
+{
+	struct media_queue_notify msg;
+	int fd;
+
+	if (!group || (threshold > group->n))
+		return -GENAVB_ERR_INVALID_PARAMS;
+
+	if (group->notify_fd >= 0)
+		return -GENAVB_ERR_STREAM_PARAMS;
+
+	msg.fd = group->fd;
+	msg.len = group->n;
+	msg.threshold = threshold;
+
+	fd = ioctl(group->fd[0], MEDIA_IOC_NOTIFY_CREATE, &msg);
+	if (fd < 0)
+		return -GENAVB_ERR_STREAM_BIND;
+
+	group->notify_fd = fd;
+
+	return fd;
+}
+
+
+int genavb_stream_group_ready(struct genavb_stream_group *group, unsigned int *ready)
+{
+	u32 bitmap;
+
+	if (!group || !ready)
+		return -GENAVB_ERR_INVALID_PARAMS;
+
+	if (group->notify_fd < 0)
+		return -GENAVB_ERR_STREAM_INVALID;
+
+	if (read(group->notify_fd, &bitmap, sizeof(bitmap)) != sizeof(bitmap))
+		return -GENAVB_ERR_STREAM_RX;
+
+	*ready = bitmap;
+
+	return GENAVB_SUCCESS;
+}
+
+
+int genavb_stream_group_receive(struct genavb_stream_group *group, struct genavb_stream_group_rx *rx)
+{
+	struct media_queue_group msg;
+	unsigned int i;
+	int rc;
+
+	if (!group || !rx)
+		return -GENAVB_ERR_INVALID_PARAMS;
+
+	for (i = 0; i < group->n; i++) {
+		if (rx[i].event_iov && rx[i].event_iov_len) {
+			group->rx[i].rx.event_iov = rx[i].event_iov;
+			group->rx[i].rx.event_iov_len = rx[i].event_iov_len;
+		} else {
+			group->rx[i].rx.event_iov = NULL;
+			group->rx[i].rx.event_iov_len = 0;
+		}
+
+		group->rx[i].rx.data_iov = rx[i].data_iov;
+		group->rx[i].rx.data_iov_len = rx[i].data_iov_len;
+	}
+
+	msg.entries = group->rx;
+	msg.len = group->n;
+
+	rc = ioctl(group->fd[0], MEDIA_IOC_RX_GROUP, &msg);
+	if (rc < 0)
+		return -GENAVB_ERR_STREAM_RX;
+
+	for (i = 0; i < group->n; i++) {
+		if (group->rx[i].rc < 0)
+			rx[i].rc = -GENAVB_ERR_STREAM_RX;
+		else
+			rx[i].rc = group->rx[i].rx.data_read;
+
+		rx[i].event_len = group->rx[i].rx.event_read;
+	}
+
+	return rc;
+}
+
+
+int genavb_stream_group_send(struct genavb_stream_group *group, struct genavb_stream_group_tx *tx)
+{
+	struct media_queue_group msg;
+	struct media_queue_tx_entry *entry;
+	unsigned int i, n = 0;
+	int rc;
+
+	if (!group || !tx)
+		return -GENAVB_ERR_INVALID_PARAMS;
+
+	/* Only the streams with data to send are passed to the driver */
+	for (i = 0; i < group->n; i++) {
+		tx[i].rc = 0;
+
+		if (!tx[i].data_iov || !tx[i].data_iov_len)
+			continue;
+
+		entry = &group->tx[n];
+		entry->fd = group->fd[i];
+		entry->tx.data_iov = tx[i].data_iov;
+		entry->tx.data_iov_len = tx[i].data_iov_len;
+		entry->tx.event = tx[i].event;
+		entry->tx.event_len = tx[i].event_len;
+
+		group->tx_map[n] = i;
+		n++;
+	}
+
+	if (!n)
+		return 0;
+
+	msg.entries = group->tx;
+	msg.len = n;
+
+	rc = ioctl(group->fd[0], MEDIA_IOC_TX_GROUP, &msg);
+	if (rc < 0)
+		return -GENAVB_ERR_STREAM_TX;
+
+	for (i = 0; i < n; i++) {
+		entry = &group->tx[i];
+
+		if (entry->rc >= 0)
+			tx[group->tx_map[i]].rc = entry->rc;
+		else if ((entry->rc == -EAGAIN) || (entry->rc == -EINTR))
+			tx[group->tx_map[i]].rc = 0;
+		else
+			tx[group->tx_map[i]].rc = -GENAVB_ERR_STREAM_TX;
+	}
+
+	return rc;
+}
+
+
 int genavb_stream_destroy(struct genavb_stream_handle *handle)
 {
 	struct list_head *entry, *next;
@@ -1,5 +1,5 @@
 /*
-* Copyright 2018, 2020-2021, 2023 NXP
+* Copyright 2018, 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -8,7 +8,7 @@
  \file socket.c
  \brief control public API
  \details
- \copyright Copyright 2018, 2020-2021, 2023 NXP
+ \copyright Copyright 2018, 2020-2021, 2023, 2026 NXP
 */
 
 #include "api/socket.h"
@@ -27,11 +27,6 @@ int genavb_socket_rx_open(struct genavb_socket_rx **sock, genavb_sock_f_t flags,
 		goto out;
 	}
 
-	if (flags & GENAVB_SOCKF_ZEROCOPY) {
-		rc = -GENAVB_ERR_SOCKET_PARAMS;
-		goto out;
-	}
-
 	*sock = os_malloc(sizeof(struct genavb_socket_rx));
 	if (!*sock) {
 		rc = -GENAVB_ERR_NO_MEMORY;
@@ -215,6 +210,72 @@ out:
 	return rc;
 }
 
+void genavb_socket_rx_release(struct genavb_socket_rx *sock)
+{
+	if (sock && sock->zc_desc) {
+		net_rx_free(sock->zc_desc);
+		sock->zc_desc = NULL;
+	}
+}
+
+int genavb_socket_batch_receive(struct genavb_socket_batch_rx *rx, unsigned int n)
+{
+	struct genavb_socket_rx *sock;
+	struct net_rx_desc *desc;
+	unsigned int i;
+	int received = 0;
+
+	if (!rx)
+		return -GENAVB_ERR_INVALID;
+
+	for (i = 0; i < n; i++) {
+		sock = rx[i].sock;
+		rx[i].buf = NULL;
+
+		if (!sock) {
+			rx[i].rc = -GENAVB_ERR_INVALID;
+			continue;
+		}
+
+		if (!(sock->flags & GENAVB_SOCKF_ZEROCOPY)) {
+			rx[i].rc = -GENAVB_ERR_SOCKET_PARAMS;
+			continue;
+		}
+
+		genavb_socket_rx_release(sock);
+
+		if (socket_rx_event_check(sock) < 0) {
+			rx[i].rc = -GENAVB_ERR_SOCKET_INTR;
+			continue;
+		}
+
+		desc = __net_rx(&sock->net);
+		if (!desc) {
+			rx[i].rc = -GENAVB_ERR_SOCKET_AGAIN;
+			goto rearm;
+		}
+
+		if (sock->flags & GENAVB_SOCKF_RAW) {
+			rx[i].buf = (uint8_t *)desc + desc->l2_offset;
+			rx[i].rc = desc->len;
+		} else {
+			rx[i].buf = (uint8_t *)desc + desc->l3_offset;
+			rx[i].rc = desc->len - (desc->l3_offset - desc->l2_offset);
+		}
+
+		rx[i].ts = desc->ts64;
+
+		/* Released on the next receive */
+		sock->zc_desc = desc;
+		received++;
+
+	rearm:
+		socket_rx_event_rearm(sock);
+	}
+
+	return received;
+}
+
 int genavb_socket_tx(struct genavb_socket_tx *sock, void *buf, unsigned int len)
 {
 	struct net_tx_desc *desc;
@@ -277,6 +338,8 @@ void genavb_socket_rx_close(struct genavb_socket_rx *sock)
 
 	addr = &sock->params.addr;
 
+	genavb_socket_rx_release(sock);
+
 	if (MAC_IS_MCAST(addr->u.l2.dst_mac)) {
 		net_del_multi(&sock->net, addr->port,
 			      addr->u.l2.dst_mac);
@@ -320,6 +383,16 @@ int genavb_socket_rx(struct genavb_socket_rx *sock, void *buf, unsigned int len,
 	return -1;
 }
 
+int genavb_socket_batch_receive(struct genavb_socket_batch_rx *rx, unsigned int n)
+{
+	return -1;
+}
+
+void genavb_socket_rx_release(struct genavb_socket_rx *sock)
+{
+	return;
+}
+
 int genavb_socket_tx(struct genavb_socket_tx *sock, void *buf, unsigned int len)
 {
 	return -1;
@@ -1,5 +1,5 @@
 /*
-* Copyright 2018, 2020, 2023 NXP
+* Copyright 2018, 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -9,7 +9,7 @@
  \brief GenAVB API private includes
  \details private definitions for the GenAVB library
 
- \copyright Copyright 2018, 2020, 2023 NXP
+ \copyright Copyright 2018, 2020, 2023, 2026 NXP
 */
 
 #ifndef _PRIVATE_SOCKET_H
@@ -25,6 +25,7 @@ struct genavb_socket_rx {
 	struct net_rx net;
 	struct genavb_socket_rx_params params;
 	unsigned long priv;
+	struct net_rx_desc *zc_desc;	/* frame held by the last zero-copy receive */
 };
 
 struct genavb_socket_tx {
@@ -1,5 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
+ * Copyright 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -8,6 +9,8 @@
 #include <string.h>
 #include <sys/select.h>
 #include <unistd.h>
+#include <sched.h>
+#include <time.h>
 
 #include "file_buffer.h"
 #include "common.h"
@@ -27,22 +30,32 @@ void file_buffer_init(struct file_buffer *buf, unsigned int readers)
 	buf->readers = readers;
 	buf->eof = 0;
 	buf->size = FILE_BUFFER_SIZE;
+	buf->stalls = 0;
+	buf->filled = 0;
+	buf->async = 0;
 }
 
 
+/* Offsets are shared with the read ahead thread (asynchronous mode) */
 unsigned int file_buffer_available(struct file_buffer *buf, int reader)
 {
-	if (buf->w_offset >= buf->r_offset[reader])
-		return buf->w_offset - buf->r_offset[reader];
+	unsigned int w_offset = __atomic_load_n(&buf->w_offset, __ATOMIC_ACQUIRE);
+	unsigned int r_offset = __atomic_load_n(&buf->r_offset[reader], __ATOMIC_ACQUIRE);
+
+	if (w_offset >= r_offset)
+		return w_offset - r_offset;
 	else
-		return (buf->w_offset + buf->size) - buf->r_offset[reader];
+		return (w_offset + buf->size) - r_offset;
 }
 
 void file_buffer_read(struct file_buffer *buf, int reader, unsigned int len)
 {
-	buf->r_offset[reader] += len;
-	if (buf->r_offset[reader] >= buf->size)
-		buf->r_offset[reader] -= buf->size;
+	unsigned int r_offset = buf->r_offset[reader] + len;
+
+	if (r_offset >= buf->size)
+		r_offset -= buf->size;
+
+	__atomic_store_n(&buf->r_offset[reader], r_offset, __ATOMIC_RELEASE);
 }
 
 void *file_buffer_buf(struct file_buffer *buf, int reader)
@@ -52,8 +65,10 @@ void *file_buffer_buf(struct file_buffer *buf, int reader)
 
 unsigned int file_buffer_available_wrap(struct file_buffer *buf, int reader)
 {
-	if (buf->w_offset >= buf->r_offset[reader])
-		return buf->w_offset - buf->r_offset[reader];
+	unsigned int w_offset = __atomic_load_n(&buf->w_offset, __ATOMIC_ACQUIRE);
+
+	if (w_offset >= buf->r_offset[reader])
+		return w_offset - buf->r_offset[reader];
 	else
 		return buf->size - buf->r_offset[reader];
 }
@@ -69,15 +84,70 @@ unsigned int file_buffer_free(struct file_buffer *buf, int reader)
 	return buf->size - file_buffer_available(buf, reader) - 1;
 }
 
+/* Asynchronous mode, the data is written by the read ahead thread. Only waits (up to timeout) if the buffer is empty. */
+static int file_buffer_async_write(struct file_buffer *buf, unsigned int timeout)
+{
+	struct timespec period = {
+		.tv_sec = 0,
+		.tv_nsec = FILE_BUFFER_STALL_PERIOD * 1000,
+	};
+	unsigned int available, waited = 0;
+
+	available = file_buffer_available(buf, 0);
+	if (available)
+		goto filled;
+
+	if (buf->filled && !__atomic_load_n(&buf->eof, __ATOMIC_ACQUIRE))
+		buf->stalls++;
+
+	while (1) {
+		if (__atomic_load_n(&buf->async_error, __ATOMIC_ACQUIRE))
+			return -1;
+
+		/* data written before end of file */
+		if (__atomic_load_n(&buf->eof, __ATOMIC_ACQUIRE))
+			return file_buffer_available(buf, 0);
+
+		if (waited >= timeout)
+			return 0;
+
+		nanosleep(&period, NULL);
+		waited += FILE_BUFFER_STALL_PERIOD;
+
+		available = file_buffer_available(buf, 0);
+		if (available)
+			goto filled;
+	}
+
+filled:
+	buf->filled = 1;
+
+	return available;
+}
+
+/** Fills the buffer from a file.
+ * In asynchronous mode (file_buffer_async_start()), the file is read by the read ahead thread and the call only waits
+ * (up to timeout) for data if the buffer is empty.
+ * \return	number of bytes written (asynchronous mode: available), 0 on end of file/timeout, negative on error
+ * \param buf	pointer to file buffer
+ * \param fd	file descriptor (ignored in asynchronous mode)
+ * \param timeout	read timeout, in us
+ */
 int file_buffer_write(struct file_buffer *buf, unsigned int fd, unsigned int timeout)
 {
 	unsigned int len, len_now;
 	unsigned int written = 0;
 	int rc;
 
+	if (buf->async)
+		return file_buffer_async_write(buf, timeout);
+
 	if (buf->eof)
 		return 0;
 
+	if (buf->filled && file_buffer_empty(buf, 0))
+		buf->stalls++;
+
 //	printf("%s: %u %u %u %u\n", __func__, buf->w_offset, buf->r_offset[0], buf->r_offset[1], buf->eof);
 
 	len = file_buffer_free(buf, 0);
@@ -101,6 +171,7 @@ int file_buffer_write(struct file_buffer *buf, unsigned int fd, unsigned int tim
 		if (buf->w_offset >= buf->size)
 			buf->w_offset = 0;
 
+		buf->filled = 1;
 		written += rc;
 
 		if (rc < (int)len_now)
@@ -126,5 +197,107 @@ int file_buffer_write(struct file_buffer *buf, unsigned int fd, unsigned int tim
 	if (buf->w_offset >= buf->size)
 		buf->w_offset = 0;
 
+	buf->filled = 1;
+
 	return written;
 }
+
+static void *file_buffer_async_thread(void *arg)
+{
+	struct file_buffer *buf = arg;
+	struct timespec period = {
+		.tv_sec = 0,
+		.tv_nsec = FILE_BUFFER_ASYNC_PERIOD * 1000,
+	};
+	unsigned int len, w_offset;
+	int rc;
+
+	while (!__atomic_load_n(&buf->async_stop, __ATOMIC_RELAXED)) {
+		len = file_buffer_free(buf, 0);
+
+		if (buf->readers > 1) {
+			if (len > file_buffer_free(buf, 1))
+				len = file_buffer_free(buf, 1);
+		}
+
+		if (len < buf->size / 16) {
+			nanosleep(&period, NULL);
+			continue;
+		}
+
+		w_offset = buf->w_offset;
+		if ((w_offset + len) > buf->size)
+			len = buf->size - w_offset;
+
+		rc = file_read(buf->fd, buf->buf + w_offset, len, FILE_BUFFER_ASYNC_TIMEOUT);
+		if (rc < 0) {
+			__atomic_store_n(&buf->async_error, 1, __ATOMIC_RELEASE);
+			break;
+		}
+
+		if (!rc) {
+			__atomic_store_n(&buf->eof, 1, __ATOMIC_RELEASE);
+			break;
+		}
+
+		w_offset += rc;
+		if (w_offset >= buf->size)
+			w_offset = 0;
+
+		__atomic_store_n(&buf->w_offset, w_offset, __ATOMIC_RELEASE);
+	}
+
+	return NULL;
+}
+
+/** Starts reading a file ahead, asynchronously, in a separate thread (at normal priority). The caller (realtime)
+ * thread then never blocks on file I/O, file_buffer_write() only waits if the buffer is empty.
+ * The buffer must be initialized, and must only be re-initialized after file_buffer_async_stop().
+ * \return	0 on success, -1 on error
+ * \param buf	pointer to file buffer
+ * \param fd	file descriptor
+ */
+int file_buffer_async_start(struct file_buffer *buf, int fd)
+{
+	struct sched_param param = {
+		.sched_priority = 0,
+	};
+	pthread_attr_t attr;
+	int rc;
+
+	buf->fd = fd;
+	buf->async_stop = 0;
+	buf->async_error = 0;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+	pthread_attr_setschedparam(&attr, &param);
+
+	rc = pthread_create(&buf->thread, &attr, file_buffer_async_thread, buf);
+
+	pthread_attr_destroy(&attr);
+
+	if (rc) {
+		printf("%s: pthread_create() failed: %s\n", __func__, strerror(rc));
+		return -1;
+	}
+
+	buf->async = 1;
+
+	return 0;
+}
+
+/** Stops the asynchronous read ahead, waiting for the current file read to complete
+ * \param buf	pointer to file buffer
+ */
+void file_buffer_async_stop(struct file_buffer *buf)
+{
+	if (!buf->async)
+		return;
+
+	__atomic_store_n(&buf->async_stop, 1, __ATOMIC_RELAXED);
+	pthread_join(buf->thread, NULL);
+
+	buf->async = 0;
+}
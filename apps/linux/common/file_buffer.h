@@ -1,5 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
+ * Copyright 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -7,11 +8,17 @@
 #ifndef _FILE_BUFFER_H_
 #define _FILE_BUFFER_H_
 
+#include <pthread.h>
+
 #define PES_SIZE	188
 
 #define FILE_BUFFER_SIZE (1024 * 10 * PES_SIZE)
 #define FILE_BUFFER_READERS	2
 
+#define FILE_BUFFER_ASYNC_PERIOD	1000	/* Read ahead thread polling period, buffer full, in us */
+#define FILE_BUFFER_STALL_PERIOD	100	/* Reader polling period, buffer empty, in us */
+#define FILE_BUFFER_ASYNC_TIMEOUT	1000000	/* Read ahead thread file read timeout, in us */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -26,6 +33,16 @@ struct file_buffer {
 
 	unsigned int eof;
 	unsigned int readers;
+
+	unsigned long long stalls;	/* Buffer found empty by file_buffer_write(), reader waiting for file I/O */
+	unsigned int filled;		/* Data written at least once, the initially empty buffer is not a stall */
+
+	/* Asynchronous read ahead, see file_buffer_async_start() */
+	unsigned int async;
+	unsigned int async_stop;
+	int async_error;
+	int fd;
+	pthread_t thread;
 };
 
 /* initialize a buffer that can handle "readers" number of readers */
@@ -45,6 +62,9 @@ void file_buffer_read(struct file_buffer *buf, int reader, unsigned int len);
 
 int file_buffer_write(struct file_buffer *buf, unsigned int fd, unsigned int timeout);
 
+int file_buffer_async_start(struct file_buffer *buf, int fd);
+void file_buffer_async_stop(struct file_buffer *buf);
+
 #ifdef __cplusplus
 }
 #endif
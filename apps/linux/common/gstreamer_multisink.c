@@ -1,6 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
- * Copyright 2017 NXP
+ * Copyright 2017, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -66,24 +66,129 @@ static void stream_stats_show(struct stats *s)
 static GstFlowReturn talker_gst_multi_new_sample_handler(GstAppSink *sink, gpointer data)
 {
 	struct talker_gst_multi_app *stream = data;
-	pthread_mutex_lock(&stream->samples_lock);
-	stream->samples++;
-	pthread_mutex_unlock(&stream->samples_lock);
+
+	g_atomic_int_inc(&stream->samples);
+
 	return GST_FLOW_OK;
 }
 
+/* Maps the current buffer. Buffers made of several memories are mapped one memory at a time (scatter-gather), and sent
+ * with an iovec, instead of being merged (copied) into a single memory by gst_buffer_map(). H264 NALUs must be
+ * contiguous for the packetization and are always mapped as a whole. */
+static int talker_gst_multi_buffer_map(struct talker_gst_multi_app *stream)
+{
+	GstBuffer *buffer = stream->current_buffer;
+	unsigned int n = gst_buffer_n_memory(buffer);
+	unsigned int i;
+
+	stream->current_map_index = 0;
+	stream->current_map_offset = 0;
+	stream->current_total = 0;
+
+	if ((n > 1) && (n <= TALKER_GST_MAX_MEMORIES) && (stream->params.format.u.s.subtype_u.cvf.subtype != CVF_FORMAT_SUBTYPE_H264)) {
+		for (i = 0; i < n; i++) {
+			if (!gst_memory_map(gst_buffer_peek_memory(buffer, i), &stream->current_map[i], GST_MAP_READ))
+				goto err_unmap;
+
+			stream->current_total += stream->current_map[i].size;
+		}
+
+		stream->current_n_map = n;
+		stream->current_buffer_mapped = 0;
+	} else {
+		if (!gst_buffer_map(buffer, &stream->current_map[0], GST_MAP_READ))
+			return -1;
+
+		stream->current_total = stream->current_map[0].size;
+		stream->current_n_map = 1;
+		stream->current_buffer_mapped = 1;
+	}
+
+	stream->current_size = stream->current_total;
+
+	return 0;
+
+err_unmap:
+	while (i--)
+		gst_memory_unmap(gst_buffer_peek_memory(buffer, i), &stream->current_map[i]);
+
+	return -1;
+}
+
+static void talker_gst_multi_buffer_unmap(struct talker_gst_multi_app *stream)
+{
+	unsigned int i;
+
+	if (stream->current_buffer_mapped) {
+		gst_buffer_unmap(stream->current_buffer, &stream->current_map[0]);
+	} else {
+		for (i = 0; i < stream->current_n_map; i++)
+			gst_memory_unmap(gst_buffer_peek_memory(stream->current_buffer, i), &stream->current_map[i]);
+	}
+
+	stream->current_n_map = 0;
+}
+
+/* Fills an iovec with the next len bytes of the current buffer, without copy */
+static unsigned int talker_gst_multi_buffer_iov(struct talker_gst_multi_app *stream, struct avb_iovec *iov, unsigned int len)
+{
+	unsigned int i = stream->current_map_index;
+	unsigned int offset = stream->current_map_offset;
+	unsigned int chunk, n = 0;
+
+	while (len && (i < stream->current_n_map)) {
+		chunk = minimum(stream->current_map[i].size - offset, len);
+
+		iov[n].iov_base = stream->current_map[i].data + offset;
+		iov[n].iov_len = chunk;
+		n++;
+
+		len -= chunk;
+		offset = 0;
+		i++;
+	}
+
+	return n;
+}
+
+/* Next byte to send, for the APIs requiring contiguous data (buffer mapped as a whole) */
+static void *talker_gst_multi_buffer_data(struct talker_gst_multi_app *stream)
+{
+	return stream->current_map[stream->current_map_index].data + stream->current_map_offset;
+}
+
+static void talker_gst_multi_buffer_advance(struct talker_gst_multi_app *stream, unsigned int len)
+{
+	unsigned int chunk;
+
+	stream->current_size -= len;
+
+	while (len && (stream->current_map_index < stream->current_n_map)) {
+		chunk = minimum(stream->current_map[stream->current_map_index].size - stream->current_map_offset, len);
+
+		stream->current_map_offset += chunk;
+		len -= chunk;
+
+		if (stream->current_map_offset == stream->current_map[stream->current_map_index].size) {
+			stream->current_map_index++;
+			stream->current_map_offset = 0;
+		}
+	}
+}
+
 
 int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 {
 	struct talker_gst_media *gst = stream->gst;
 	struct avb_event event;
+	struct avb_iovec iov[TALKER_GST_MAX_MEMORIES];
+	unsigned int iov_n;
 	int nbytes = 0;
 	int rc = 0;
 	uint64_t now = 0;
 	unsigned int remaining, written = 0;
 	unsigned int event_n;
 	unsigned long long offset;
-	unsigned long long read_samples = 0;
 
 	if (stream->state == STREAM_STATE_CONNECTED)
 		remaining = stream->batch_size;
@@ -100,11 +205,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 
 			stream->count++;
 
-			pthread_mutex_lock(&stream->samples_lock);
-			read_samples = stream->samples;
-			pthread_mutex_unlock(&stream->samples_lock);
-
-			if (read_samples)
+			if (g_atomic_int_get(&stream->samples) > 0)
 				stream->current_sample = gst_app_sink_pull_sample(GST_APP_SINK(stream->sink));
 			else
 				stream->current_sample = NULL;
@@ -114,9 +215,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 				break;
 			}
 
-			pthread_mutex_lock(&stream->samples_lock);
-			stream->samples--;
-			pthread_mutex_unlock(&stream->samples_lock);
+			g_atomic_int_add(&stream->samples, -1);
 
 			stream->current_buffer = gst_sample_get_buffer(stream->current_sample);
 			if (!stream->current_buffer) {
@@ -124,19 +223,15 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 				goto exit_unref;
 			}
 
-			if (gst_buffer_map(stream->current_buffer, &stream->current_info, GST_MAP_READ))
-				stream->current_data = stream->current_info.data;
-			else {
-				printf("%s stream(%d) gst_buffer_map() failed\n", __func__, stream->index);
+			if (talker_gst_multi_buffer_map(stream) < 0) {
+				printf("%s stream(%d) buffer map failed\n", __func__, stream->index);
 				goto exit_unref;
 			}
 
-			if (!stream->current_data) {
+			if (!stream->current_map[0].data) {
 				printf("%s stream(%d) couldn't get data buffer\n", __func__, stream->index);
 				goto exit_unmap;
 			}
-
-			stream->current_size = stream->current_info.size;
 		}
 
 		nbytes = minimum(stream->current_size, remaining);
@@ -145,7 +240,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 		event.event_mask = 0;
 		event_n = 0;
 
-		if ((stream->current_size == stream->current_info.size) && GST_CLOCK_TIME_IS_VALID(GST_BUFFER_PTS(stream->current_buffer))) {
+		if ((stream->current_size == stream->current_total) && GST_CLOCK_TIME_IS_VALID(GST_BUFFER_PTS(stream->current_buffer))) {
 
 			gst->gst_pipeline->basetime = gst_element_get_base_time(GST_ELEMENT(gst->gst_pipeline->pipeline));
 			if(!GST_CLOCK_TIME_IS_VALID(gst->gst_pipeline->basetime) || !gst->gst_pipeline->basetime) {
@@ -184,7 +279,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 			if (stream->params.format.u.s.subtype_u.cvf.subtype == CVF_FORMAT_SUBTYPE_H264) {
 				/* In some cases, Gstreamer will output invalid timestamp for buffers
                        		 * So use the last valid one */
-				if ((stream->current_size == stream->current_info.size) && !(GST_CLOCK_TIME_IS_VALID(GST_BUFFER_PTS(stream->current_buffer)))) {
+				if ((stream->current_size == stream->current_total) && !(GST_CLOCK_TIME_IS_VALID(GST_BUFFER_PTS(stream->current_buffer)))) {
 						event.event_mask |= AVTP_SYNC;
 						event.ts = stream->last_ts;
 						event_n = 1;
@@ -197,10 +292,11 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 
 // 				printf(" %s : h264 stream sending nbytes %d event_n %d event.event_mask %x event-ts %"GST_TIME_FORMAT" GST Buffer PTS %"GST_TIME_FORMAT" GST Basetime %"GST_TIME_FORMAT"<<<<< \n", __func__, nbytes, event_n, event.event_mask, GST_TIME_ARGS((event.ts)), GST_TIME_ARGS(GST_BUFFER_PTS(stream->current_buffer)), GST_TIME_ARGS((gst->gst_pipeline->basetime)));
 
-				rc = avb_stream_h264_send(stream->stream_h, stream->current_data, nbytes, &event, event_n);
+				rc = avb_stream_h264_send(stream->stream_h, talker_gst_multi_buffer_data(stream), nbytes, &event, event_n);
 			} else {
-				// TODO use iov version of API
-				rc = avb_stream_send(stream->stream_h, stream->current_data, nbytes, &event, event_n);
+				iov_n = talker_gst_multi_buffer_iov(stream, iov, nbytes);
+
+				rc = avb_stream_send_iov(stream->stream_h, iov, iov_n, &event, event_n);
 			}
 
 			if (rc != nbytes) {
@@ -211,7 +307,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 						rc = 0;
 					} else {
 						printf("%s failed: %s \n",
-								(stream->params.format.u.s.subtype_u.cvf.subtype == CVF_FORMAT_SUBTYPE_H264) ? "avb_stream_h264_send" : "avb_stream_send",
+								(stream->params.format.u.s.subtype_u.cvf.subtype == CVF_FORMAT_SUBTYPE_H264) ? "avb_stream_h264_send" : "avb_stream_send_iov",
 								avb_strerror(rc));
 
 						stream->current_size = 0;
@@ -220,7 +316,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 				}
 
 				printf("%s incomplete (sent %d instead of %d) \n",
-						(stream->params.format.u.s.subtype_u.cvf.subtype == CVF_FORMAT_SUBTYPE_H264) ? "avb_stream_h264_send" : "avb_stream_send",
+						(stream->params.format.u.s.subtype_u.cvf.subtype == CVF_FORMAT_SUBTYPE_H264) ? "avb_stream_h264_send" : "avb_stream_send_iov",
 						rc, nbytes);
 
 				nbytes = rc;
@@ -229,8 +325,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 				stream->byte_count += nbytes;
 				written += nbytes;
 				remaining -= nbytes;
-				stream->current_size -= nbytes;
-				stream->current_data += nbytes;
+				talker_gst_multi_buffer_advance(stream, nbytes);
 				break;
 			}
 
@@ -239,13 +334,11 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 
 		written += nbytes;
 		remaining -= nbytes;
-		stream->current_size -= nbytes;
-		stream->current_data += nbytes;
+		talker_gst_multi_buffer_advance(stream, nbytes);
 
 		if (stream->current_size == 0) {
-			gst_buffer_unmap(stream->current_buffer, &stream->current_info);
+			talker_gst_multi_buffer_unmap(stream);
 			gst_sample_unref(stream->current_sample);
-			stream->current_data = NULL;
 		}
 	}
 
@@ -254,7 +347,7 @@ int talker_gst_multi_data_handler(struct talker_gst_multi_app *stream)
 	goto exit;
 
 exit_unmap:
-	gst_buffer_unmap(stream->current_buffer, &stream->current_info);
+	talker_gst_multi_buffer_unmap(stream);
 
 exit_unref:
 	gst_sample_unref(stream->current_sample);
@@ -289,9 +382,7 @@ start:
 
 			stream->sink = stream->gst->gst_pipeline->sink[stream->sink_index].sink;
 			gst_app_sink_set_max_buffers(stream->sink, 1000);
-			pthread_mutex_lock(&stream->samples_lock);
-			stream->samples = 0;
-			pthread_mutex_unlock(&stream->samples_lock);
+			g_atomic_int_set(&stream->samples, 0);
 			callbacks.new_sample = talker_gst_multi_new_sample_handler;
 			gst_app_sink_set_callbacks(stream->sink, &callbacks, stream, NULL);
 		}
@@ -559,9 +650,7 @@ start:
 		case STREAM_EVENT_TIMER:
 			print = 0;
 
-			pthread_mutex_lock(&stream->samples_lock);
-			rc = stream->samples;
-			pthread_mutex_unlock(&stream->samples_lock);
+			rc = g_atomic_int_get(&stream->samples);
 
 			if (rc > 0) {
 				stream->timer_count = 0;
@@ -1,6 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
- * Copyright 2017 NXP
+ * Copyright 2017, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -37,6 +37,7 @@ extern "C" {
 #define PREVNEXT_STOP_DURATION	(1)  // Stop stream and wait 1s when changing tracks before starting stream again
 
 #define MAX_GST_MULTI_HANDLERS	1
+#define TALKER_GST_MAX_MEMORIES	16	/* Buffer memories mapped separately (scatter-gather), must be <= IOV_MAX */
 #define MAX_GST_MULTI_HANDLERS_STREAMS	(MAX_GST_MULTI_HANDLERS * GST_MAX_SINKS)
 
 enum gst_state {
@@ -85,10 +86,14 @@ struct talker_gst_multi_app {  //TODO: merge with struct media_stream
 	GstAppSink *sink;
 	GstSample *current_sample;
 	GstBuffer *current_buffer;
-	GstMapInfo current_info;
-	void *current_data;
-	unsigned int current_size;
-	unsigned long long samples;
+	GstMapInfo current_map[TALKER_GST_MAX_MEMORIES];	/* Mapped buffer memories */
+	unsigned int current_n_map;
+	unsigned int current_map_index;		/* Memory of the next byte to send */
+	unsigned int current_map_offset;	/* Offset of the next byte to send, in the memory */
+	unsigned int current_buffer_mapped;	/* Buffer mapped as a whole, with gst_buffer_map() */
+	unsigned int current_total;		/* Buffer size */
+	unsigned int current_size;		/* Buffer bytes remaining to send */
+	gint samples;				/* Samples available in the appsink, updated atomically */
 	unsigned int last_ts; /*Used for H264 Stream :
 				Gstreamer sometimes output buffers with an invalid PTS , so use the last valid one */
 
@@ -109,7 +114,6 @@ struct talker_gst_multi_app {  //TODO: merge with struct media_stream
 	struct avb_stream_handle *stream_h;
 	struct avb_stream_params params;
 	unsigned int batch_size;
-	pthread_mutex_t samples_lock;
 };
 
 struct talker_gst_media {    //TODO: merge with struct media_stream and talker_gst_multi_app
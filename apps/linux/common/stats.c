@@ -1,11 +1,12 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
- * Copyright 2020 NXP
+ * Copyright 2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <errno.h>
 
 #include "stats.h"
@@ -173,3 +174,105 @@ void hist_print(struct hist *hist)
 
 	_PRINT("\n");
 }
+
+void hdr_hist_reset(struct hdr_hist *h)
+{
+	memset(h, 0, sizeof(*h));
+	h->min = 0xffffffff;
+}
+
+static inline unsigned int hdr_hist_index(unsigned int val)
+{
+	unsigned int shift;
+
+	if (val < HDR_HIST_SUB)
+		return val;
+
+	/* Top HDR_HIST_SUB_BITS bits of the value, in [HDR_HIST_SUB / 2, HDR_HIST_SUB) */
+	shift = (31 - __builtin_clz(val)) - HDR_HIST_SUB_BITS + 1;
+
+	return shift * (HDR_HIST_SUB / 2) + (val >> shift);
+}
+
+/* Highest value counted in a bucket */
+static inline unsigned int hdr_hist_value(unsigned int index)
+{
+	unsigned int shift;
+
+	if (index < HDR_HIST_SUB)
+		return index;
+
+	shift = (index - HDR_HIST_SUB / 2) / (HDR_HIST_SUB / 2);
+
+	return (((index - shift * (HDR_HIST_SUB / 2)) + 1) << shift) - 1;
+}
+
+/* Lock-free for a single writer: counters are only written by the caller, with single word stores, and may be read
+ * concurrently (e.g. by hdr_hist_merge()) by other threads. */
+void hdr_hist_update(struct hdr_hist *h, unsigned int val)
+{
+	unsigned int *bucket = &h->bucket[hdr_hist_index(val)];
+
+	__atomic_store_n(bucket, *bucket + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&h->count, h->count + 1, __ATOMIC_RELAXED);
+
+	if (val < h->min)
+		__atomic_store_n(&h->min, val, __ATOMIC_RELAXED);
+
+	if (val > h->max)
+		__atomic_store_n(&h->max, val, __ATOMIC_RELAXED);
+}
+
+void hdr_hist_merge(struct hdr_hist *dst, struct hdr_hist const *src)
+{
+	unsigned int val;
+	unsigned int i;
+
+	for (i = 0; i < HDR_HIST_BUCKETS; i++)
+		dst->bucket[i] += __atomic_load_n(&src->bucket[i], __ATOMIC_RELAXED);
+
+	dst->count += __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+
+	val = __atomic_load_n(&src->min, __ATOMIC_RELAXED);
+	if (val < dst->min)
+		dst->min = val;
+
+	val = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+	if (val > dst->max)
+		dst->max = val;
+}
+
+/* Highest value of the bucket containing the percentile (bounded by the maximum value), 0 if the histogram is empty */
+unsigned int hdr_hist_percentile(struct hdr_hist const *h, unsigned int ppm)
+{
+	unsigned long long target, sum = 0;
+	unsigned int i;
+
+	if (!h->count)
+		return 0;
+
+	target = ((unsigned long long)h->count * ppm + 999999) / 1000000;
+	if (!target)
+		target = 1;
+
+	for (i = 0; i < HDR_HIST_BUCKETS; i++) {
+		sum += h->bucket[i];
+
+		if (sum >= target)
+			break;
+	}
+
+	if ((i == HDR_HIST_BUCKETS) || (hdr_hist_value(i) > h->max))
+		return h->max;
+
+	return hdr_hist_value(i);
+}
+
+void hdr_hist_print(struct hdr_hist const *h, const char *name)
+{
+	PRINT("hdr hist %s count %u min %u p50 %u p90 %u p99 %u p99.9 %u p99.99 %u max %u\n",
+	      name, h->count, h->count ? h->min : 0,
+	      hdr_hist_percentile(h, HDR_HIST_PPM(50)), hdr_hist_percentile(h, HDR_HIST_PPM(90)),
+	      hdr_hist_percentile(h, HDR_HIST_PPM(99)), hdr_hist_percentile(h, HDR_HIST_PPM(99.9)),
+	      hdr_hist_percentile(h, HDR_HIST_PPM(99.99)), h->max);
+}
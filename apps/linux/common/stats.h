@@ -1,6 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
- * Copyright 2020 NXP
+ * Copyright 2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -40,6 +40,21 @@ struct hist {
 	unsigned int slot_size;
 };
 
+/* Log-linear (HDR) histogram, for tail latencies: values are counted in HDR_HIST_SUB / 2 buckets per power of 2
+ * (exact below HDR_HIST_SUB), with a bounded relative error (< 2 / HDR_HIST_SUB) over the whole 32bit range. */
+#define HDR_HIST_SUB_BITS	5
+#define HDR_HIST_SUB		(1U << HDR_HIST_SUB_BITS)
+#define HDR_HIST_BUCKETS	((32 - HDR_HIST_SUB_BITS) * (HDR_HIST_SUB / 2) + HDR_HIST_SUB)
+
+#define HDR_HIST_PPM(pct)	((unsigned int)((pct) * 10000))	/* percentile, in parts per million */
+
+struct hdr_hist {
+	unsigned int count;
+	unsigned int min;
+	unsigned int max;
+	unsigned int bucket[HDR_HIST_BUCKETS];
+};
+
 void stats_reset(struct stats *s);
 void stats_print(struct stats *s);
 void stats_init(struct stats *s, unsigned int log2_size, void *priv, void (*func)(struct stats *s));
@@ -51,4 +66,11 @@ void hist_update(struct hist *hist, unsigned int value);
 void hist_reset(struct hist *hist);
 
 void hist_print(struct hist *hist);
+
+void hdr_hist_reset(struct hdr_hist *h);
+void hdr_hist_update(struct hdr_hist *h, unsigned int val);
+void hdr_hist_merge(struct hdr_hist *dst, struct hdr_hist const *src);
+unsigned int hdr_hist_percentile(struct hdr_hist const *h, unsigned int ppm);
+void hdr_hist_print(struct hdr_hist const *h, const char *name);
+
 #endif /* _COMMON_STATS_H_ */
@@ -1,5 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
+ * Copyright 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -22,6 +23,8 @@
 
 #define SYSTEM_CLOCK_FREQUENCY	27000000
 
+#define TS_SCAN_LANES		16	/* Packets checked per scanner iteration */
+
 #define NSECS_PER_USEC	1000
 #define NSEC_PER_MSEC	1000000
 #define USEC_PER_SEC	1000000
@@ -152,6 +155,51 @@ static int transport_packet(struct ts_parser *p, void *buf)
 	return 0;
 }
 
+/* 1 if the packet has a PCR, or an invalid sync byte, evaluated without branches */
+static inline unsigned int ts_scan_packet(const u8 *packet)
+{
+	return (packet[0] != SYNC_BYTE) | ((packet[3] >> 5) & (packet[4] != 0) & (packet[5] >> 4) & 1);
+}
+
+/* Checks TS_SCAN_LANES packets at once, one branch for all of them.
+ * Returns a bitmask with bit i set if packet i has a PCR or an invalid sync byte. */
+static inline unsigned int ts_scan_lanes(const u8 *buf)
+{
+	unsigned int mask = 0;
+	unsigned int i;
+
+	for (i = 0; i < TS_SCAN_LANES; i++, buf += PES_SIZE)
+		mask |= ts_scan_packet(buf) << i;
+
+	return mask;
+}
+
+/** Scans transport packets for the next one carrying a PCR
+ * \return	index of the first packet with a PCR, or with an invalid sync byte, n if none
+ * \param buf	pointer to the first transport packet
+ * \param n	number of transport packets
+ */
+unsigned int ts_parser_scan_pcr(const void *buf, unsigned int n)
+{
+	const u8 *packet = buf;
+	unsigned int i = 0;
+	unsigned int mask;
+
+	for (; (i + TS_SCAN_LANES) <= n; i += TS_SCAN_LANES, packet += TS_SCAN_LANES * PES_SIZE) {
+		mask = ts_scan_lanes(packet);
+		if (mask)
+			return i + __builtin_ctz(mask);
+	}
+
+	/* Remaining packets */
+	for (; i < n; i++, packet += PES_SIZE) {
+		if (ts_scan_packet(packet))
+			break;
+	}
+
+	return i;
+}
+
 void ts_parser_init(struct ts_parser *p)
 {
 	memset(p, 0, sizeof(*p));
@@ -198,10 +246,18 @@ int ts_parser_is_pcr(void *buf, u64 *pcr)
 static int ts_parser_update_pcr(struct ts_parser *p, void *buf, unsigned int *len, unsigned long long byte)
 {
 	unsigned int offset = 0;
+	unsigned int skip;
 	int rc = 0;
 
 	/* Parse buffer for PCR */
 	while ((p->pcr_count < 2) || (byte > p->count[1])) {
+		/* Skip packets without PCR, they don't change the parser state (other than the byte count) */
+		skip = ts_parser_scan_pcr(buf + offset, *len / PES_SIZE);
+
+		offset += skip * PES_SIZE;
+		*len -= skip * PES_SIZE;
+		p->byte_count += skip * PES_SIZE;
+
 		if (*len < PES_SIZE) {
 			rc = -1;
 			break;
@@ -1,5 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
+ * Copyright 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -36,6 +37,7 @@ struct ts_parser {
 void ts_parser_init(struct ts_parser *p);
 int ts_parser_timestamp_range(struct file_buffer *b, struct ts_parser *p, struct avb_event *event, unsigned int *event_len, unsigned int data_start, unsigned int data_len, unsigned int presentation_offset);
 int ts_parser_is_pcr(void *buf, unsigned long long *pcr);
+unsigned int ts_parser_scan_pcr(const void *buf, unsigned int n);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Media file buffer benchmark, comparing the synchronous file_buffer_write() (file read in the caller thread) with the
+ * asynchronous read ahead (file_buffer_async_start(), file read in a separate thread).
+ *
+ * A talker is simulated: every period, the buffer is filled with file_buffer_write() (as done by simple-audio-app), and
+ * a batch of data consumed, at a constant rate. The file is looped over at the end. For each mode the cost of the
+ * file_buffer_write() calls (mean/max), the number of calls exceeding the period (missed talker deadlines) and the
+ * number of stalls (buffer found empty) are reported.
+ *
+ * Run on a tmpfs file, and on a file of a throttled block device (e.g. a loop device, with a cgroup io.max limit or a
+ * dm-delay target), with the page cache dropped at each file loop (-c).
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+
+#include <genavb/genavb.h>
+#include <genavb/helpers.h>
+
+#include "../common/common.h"
+#include "../common/file_buffer.h"
+
+#define MODE_SYNC	(1 << 0)
+#define MODE_ASYNC	(1 << 1)
+
+#define DEFAULT_RATE		20	/* Mbit/s */
+#define DEFAULT_PERIOD		1000	/* us */
+#define DEFAULT_DURATION	10	/* s */
+
+#define WRITE_TIMEOUT		1000000	/* us, buffer empty, as simple-audio-app */
+
+struct bench_result {
+	unsigned long long calls;
+	unsigned long long missed;	/* file_buffer_write() calls longer than the period */
+	unsigned long long stalls;
+	unsigned long long loops;
+	unsigned long long bytes;
+	uint64_t cost_sum;		/* ns */
+	uint64_t cost_max;
+};
+
+struct bench_app {
+	const char *file_name;
+	unsigned int mode;
+	unsigned int rate;		/* Mbit/s */
+	unsigned int period;		/* us */
+	unsigned int duration;		/* s */
+	unsigned int drop_cache;
+
+	int fd;
+	struct file_buffer *b;
+};
+
+static struct bench_app app;
+
+static void usage(void)
+{
+	printf("\nUsage:\ngenavb-file-bench [options] -f <file>\n");
+	printf("\nOptions:\n"
+		"\t-f <file>                 media file to stream\n"
+		"\t-m <mode>                 file buffer mode: both (default), sync, async\n"
+		"\t-r <rate>                 talker rate in Mbit/s: %u (default)\n"
+		"\t-p <period>               talker period in us: %u (default)\n"
+		"\t-d <duration>             duration per mode in s: %u (default)\n"
+		"\t-c                        drop the file from the page cache at each file loop\n"
+		"\t-h                        print this help text\n",
+		DEFAULT_RATE, DEFAULT_PERIOD, DEFAULT_DURATION);
+}
+
+static void timespec_add_us(struct timespec *ts, unsigned int us)
+{
+	ts->tv_nsec += us * 1000;
+	while (ts->tv_nsec >= NSECS_PER_SEC) {
+		ts->tv_nsec -= NSECS_PER_SEC;
+		ts->tv_sec++;
+	}
+}
+
+static int file_loop(struct bench_result *r, unsigned int async)
+{
+	file_buffer_async_stop(app.b);
+
+	r->stalls += app.b->stalls;
+	r->loops++;
+
+	if (app.drop_cache)
+		posix_fadvise(app.fd, 0, 0, POSIX_FADV_DONTNEED);
+
+	lseek(app.fd, 0, SEEK_SET);
+
+	file_buffer_init(app.b, 1);
+
+	if (async)
+		return file_buffer_async_start(app.b, app.fd);
+
+	return 0;
+}
+
+static int bench_mode(const char *name, unsigned int async)
+{
+	struct bench_result r = { 0 };
+	unsigned int batch = ((unsigned long long)app.rate * 1000000 / 8) * app.period / USECS_PER_SEC;
+	unsigned int nbytes;
+	uint64_t start, now, t0, t1, cost;
+	struct timespec next;
+	int rc = -1;
+
+	if (!batch)
+		batch = 1;
+
+	if (file_loop(&r, async) < 0)
+		goto exit;
+
+	r.loops = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &next);
+	gettime_ns_monotonic(&start);
+
+	do {
+		timespec_add_us(&next, app.period);
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+		gettime_ns_monotonic(&t0);
+
+		rc = file_buffer_write(app.b, app.fd, file_buffer_empty(app.b, 0) ? WRITE_TIMEOUT : 0);
+
+		gettime_ns_monotonic(&t1);
+
+		cost = t1 - t0;
+		r.calls++;
+		r.cost_sum += cost;
+		if (cost > r.cost_max)
+			r.cost_max = cost;
+		if (cost > (uint64_t)app.period * 1000)
+			r.missed++;
+
+		if (rc < 0) {
+			printf("file_buffer_write() failed\n");
+			goto exit;
+		}
+
+		if (!rc && file_buffer_empty(app.b, 0)) {
+			if (file_loop(&r, async) < 0)
+				goto exit;
+		} else {
+			nbytes = file_buffer_available_wrap(app.b, 0);
+			if (nbytes > batch)
+				nbytes = batch;
+
+			file_buffer_read(app.b, 0, nbytes);
+			r.bytes += nbytes;
+		}
+
+		gettime_ns_monotonic(&now);
+	} while ((now - start) < (uint64_t)app.duration * NSECS_PER_SEC);
+
+	rc = 0;
+
+exit:
+	file_buffer_async_stop(app.b);
+	r.stalls += app.b->stalls;
+
+	printf("%-6s %10llu %10" PRIu64 " %10" PRIu64 " %10llu %10llu %8llu %10.3f\n", name,
+		r.calls, r.calls ? (uint64_t)(r.cost_sum / r.calls) : 0, r.cost_max, r.missed, r.stalls, r.loops,
+		(double)r.bytes * 8 / ((double)app.duration * 1000000));
+
+	return rc;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long val;
+	int option;
+	int rc = -1;
+
+	app.mode = MODE_SYNC | MODE_ASYNC;
+	app.rate = DEFAULT_RATE;
+	app.period = DEFAULT_PERIOD;
+	app.duration = DEFAULT_DURATION;
+
+	while ((option = getopt(argc, argv, "f:m:r:p:d:ch")) != -1) {
+		switch (option) {
+		case 'f':
+			app.file_name = optarg;
+			break;
+
+		case 'm':
+			if (!strcmp(optarg, "both"))
+				app.mode = MODE_SYNC | MODE_ASYNC;
+			else if (!strcmp(optarg, "sync"))
+				app.mode = MODE_SYNC;
+			else if (!strcmp(optarg, "async"))
+				app.mode = MODE_ASYNC;
+			else
+				goto err_option;
+			break;
+
+		case 'r':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val || (val > 10000))
+				goto err_option;
+			app.rate = val;
+			break;
+
+		case 'p':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val || (val >= USECS_PER_SEC))
+				goto err_option;
+			app.period = val;
+			break;
+
+		case 'd':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.duration = val;
+			break;
+
+		case 'c':
+			app.drop_cache = 1;
+			break;
+
+		case 'h':
+		default:
+			usage();
+			return 0;
+		}
+	}
+
+	if (!app.file_name)
+		goto err_option;
+
+	app.fd = open(app.file_name, O_RDONLY);
+	if (app.fd < 0) {
+		printf("open(%s) failed: %s\n", app.file_name, strerror(errno));
+		goto exit;
+	}
+
+	app.b = calloc(1, sizeof(struct file_buffer));
+	if (!app.b)
+		goto exit_close;
+
+	printf("genavb-file-bench: %s, %u Mbit/s, period %u us, %u s per mode%s\n\n", app.file_name,
+		app.rate, app.period, app.duration, app.drop_cache ? ", page cache dropped at each loop" : "");
+
+	printf("mode        calls  mean (ns)   max (ns)     missed     stalls    loops     Mbit/s\n");
+
+	if ((app.mode & MODE_SYNC) && (bench_mode("sync", 0) < 0))
+		goto exit_free;
+
+	if ((app.mode & MODE_ASYNC) && (bench_mode("async", 1) < 0))
+		goto exit_free;
+
+	rc = 0;
+
+exit_free:
+	free(app.b);
+
+exit_close:
+	close(app.fd);
+
+exit:
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	usage();
+	return -1;
+}
@@ -0,0 +1,343 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * GStreamer talker buffer send throughput benchmark, comparing the two ways the GStreamer talker
+ * (talker_gst_multi_data_handler()) reads an appsink buffer: mapped as a whole with gst_buffer_map(), which merges
+ * (copies) the memories of a multi-memory buffer into a newly allocated one, or mapped one memory at a time with
+ * gst_memory_map() and sent with an iovec (avb_stream_send_iov()).
+ *
+ * Each frame is a new buffer referencing preallocated memories (a single one, or several for the multi-memory case),
+ * as handed over by an upstream element. The stack copy of the data into its network buffers is simulated by copying
+ * the frame, in batch size chunks, into a destination buffer. Frames/s and Mbit/s are reported for single and
+ * multi-memory buffers, with and without the iov path.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <string.h>
+#include <getopt.h>
+
+#include <gst/gst.h>
+
+#include <genavb/genavb.h>
+#include <genavb/helpers.h>
+
+#include "../common/time.h"
+
+#define DEFAULT_FRAME_SIZE	131072	/* bytes, of the order of a 1080p H264 frame */
+#define DEFAULT_MEMORIES	4
+#define DEFAULT_BATCH		1024	/* bytes per send */
+#define DEFAULT_FRAMES		20000
+#define MAX_MEMORIES		16	/* Same as TALKER_GST_MAX_MEMORIES */
+
+#define minimum(a,b)  ((a)<(b)?(a):(b))
+
+struct bench_app {
+	unsigned int frame_size;
+	unsigned int n_memories;
+	unsigned int batch;
+	unsigned int frames;
+
+	unsigned char *ref;		/* frame content */
+	unsigned char *dst;		/* simulated stack network buffers */
+	GstMemory *single;
+	GstMemory *multi[MAX_MEMORIES];
+};
+
+static struct bench_app app;
+
+static void usage(void)
+{
+	printf("\nUsage:\ngenavb-gst-bench [options]\n");
+	printf("\nOptions:\n"
+		"\t-s <size>                 frame size in bytes: %u (default)\n"
+		"\t-m <memories>             memories per multi-memory buffer, 2 to %u: %u (default)\n"
+		"\t-b <batch>                bytes per send: %u (default)\n"
+		"\t-n <frames>               frames per method: %u (default)\n"
+		"\t-h                        print this help text\n",
+		DEFAULT_FRAME_SIZE, MAX_MEMORIES, DEFAULT_MEMORIES, DEFAULT_BATCH, DEFAULT_FRAMES);
+}
+
+static GstMemory *memory_alloc(const unsigned char *data, unsigned int size)
+{
+	GstMemory *mem;
+	GstMapInfo map;
+
+	mem = gst_allocator_alloc(NULL, size, NULL);
+	if (!mem)
+		return NULL;
+
+	if (!gst_memory_map(mem, &map, GST_MAP_WRITE)) {
+		gst_memory_unref(mem);
+		return NULL;
+	}
+
+	memcpy(map.data, data, size);
+
+	gst_memory_unmap(mem, &map);
+
+	return mem;
+}
+
+static int memories_alloc(void)
+{
+	unsigned int offset = 0, size, i;
+
+	app.single = memory_alloc(app.ref, app.frame_size);
+	if (!app.single)
+		return -1;
+
+	for (i = 0; i < app.n_memories; i++) {
+		size = app.frame_size / app.n_memories;
+		if (i == (app.n_memories - 1))
+			size = app.frame_size - offset;
+
+		app.multi[i] = memory_alloc(app.ref + offset, size);
+		if (!app.multi[i])
+			return -1;
+
+		offset += size;
+	}
+
+	return 0;
+}
+
+static void memories_free(void)
+{
+	unsigned int i;
+
+	if (app.single)
+		gst_memory_unref(app.single);
+
+	for (i = 0; i < app.n_memories; i++)
+		if (app.multi[i])
+			gst_memory_unref(app.multi[i]);
+}
+
+/* New buffer for each frame, as pulled from the appsink */
+static GstBuffer *frame_new(GstMemory **mem, unsigned int n)
+{
+	GstBuffer *buffer;
+	unsigned int i;
+
+	buffer = gst_buffer_new();
+	if (!buffer)
+		return NULL;
+
+	for (i = 0; i < n; i++)
+		gst_buffer_append_memory(buffer, gst_memory_ref(mem[i]));
+
+	return buffer;
+}
+
+/* Buffer mapped as a whole, sent from contiguous data */
+static int frame_send_map(GstBuffer *buffer)
+{
+	unsigned int offset, chunk;
+	GstMapInfo map;
+
+	if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+		return -1;
+
+	for (offset = 0; offset < map.size; offset += chunk) {
+		chunk = minimum(app.batch, map.size - offset);
+
+		memcpy(app.dst + offset, map.data + offset, chunk);
+	}
+
+	gst_buffer_unmap(buffer, &map);
+
+	return 0;
+}
+
+/* Buffer mapped one memory at a time, each batch gathered from the memories it spans */
+static int frame_send_iov(GstBuffer *buffer)
+{
+	GstMapInfo map[MAX_MEMORIES];
+	unsigned int n = gst_buffer_n_memory(buffer);
+	unsigned int i, offset, chunk, len, dst = 0;
+
+	if (n > MAX_MEMORIES)
+		return -1;
+
+	for (i = 0; i < n; i++)
+		if (!gst_memory_map(gst_buffer_peek_memory(buffer, i), &map[i], GST_MAP_READ))
+			goto err_unmap;
+
+	i = 0;
+	offset = 0;
+
+	while (i < n) {
+		len = app.batch;
+
+		while (len && (i < n)) {
+			chunk = minimum(map[i].size - offset, len);
+
+			memcpy(app.dst + dst, map[i].data + offset, chunk);
+
+			dst += chunk;
+			offset += chunk;
+			len -= chunk;
+
+			if (offset == map[i].size) {
+				i++;
+				offset = 0;
+			}
+		}
+	}
+
+	i = n;
+
+err_unmap:
+	while (i--)
+		gst_memory_unmap(gst_buffer_peek_memory(buffer, i), &map[i]);
+
+	return (dst == app.frame_size) ? 0 : -1;
+}
+
+static int bench_method(const char *name, GstMemory **mem, unsigned int n, int (*send)(GstBuffer *buffer))
+{
+	uint64_t start, end, elapsed;
+	GstBuffer *buffer;
+	unsigned int i;
+
+	memset(app.dst, 0, app.frame_size);
+
+	gettime_ns_monotonic(&start);
+
+	for (i = 0; i < app.frames; i++) {
+		buffer = frame_new(mem, n);
+		if (!buffer)
+			goto err;
+
+		if (send(buffer) < 0) {
+			gst_buffer_unref(buffer);
+			goto err;
+		}
+
+		gst_buffer_unref(buffer);
+	}
+
+	gettime_ns_monotonic(&end);
+
+	elapsed = end - start;
+	if (!elapsed)
+		elapsed = 1;
+
+	if (memcmp(app.dst, app.ref, app.frame_size)) {
+		printf("%-24s error: frame data mismatch\n", name);
+		return -1;
+	}
+
+	printf("%-24s %12.1f %10.1f %10.2f\n", name,
+		(double)app.frames * NSECS_PER_SEC / elapsed,
+		(double)app.frame_size * 8 * app.frames * 1000 / elapsed,
+		(double)elapsed / app.frames / 1000);
+
+	return 0;
+
+err:
+	printf("%-24s error: buffer allocation or mapping failed\n", name);
+	return -1;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long val;
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	app.frame_size = DEFAULT_FRAME_SIZE;
+	app.n_memories = DEFAULT_MEMORIES;
+	app.batch = DEFAULT_BATCH;
+	app.frames = DEFAULT_FRAMES;
+
+	while ((option = getopt(argc, argv, "s:m:b:n:h")) != -1) {
+		switch (option) {
+		case 's':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val || (val > (64 * 1024 * 1024)))
+				goto err_option;
+			app.frame_size = val;
+			break;
+
+		case 'm':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || (val < 2) || (val > MAX_MEMORIES))
+				goto err_option;
+			app.n_memories = val;
+			break;
+
+		case 'b':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.batch = val;
+			break;
+
+		case 'n':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.frames = val;
+			break;
+
+		case 'h':
+		default:
+			usage();
+			return 0;
+		}
+	}
+
+	if (app.frame_size < app.n_memories)
+		goto err_option;
+
+	gst_init(NULL, NULL);
+
+	app.ref = malloc(app.frame_size);
+	app.dst = malloc(app.frame_size);
+	if (!app.ref || !app.dst)
+		goto exit;
+
+	for (i = 0; i < app.frame_size; i++)
+		app.ref[i] = random();
+
+	if (memories_alloc() < 0) {
+		printf("memory allocation failed\n");
+		goto exit;
+	}
+
+	printf("genavb-gst-bench: %u bytes frames, %u memories per multi-memory buffer, %u bytes per send, %u frames\n\n",
+		app.frame_size, app.n_memories, app.batch, app.frames);
+
+	printf("method                       frames/s     Mbit/s   us/frame\n");
+
+	if (bench_method("single memory, map", &app.single, 1, frame_send_map) < 0)
+		goto exit;
+
+	if (bench_method("single memory, iov", &app.single, 1, frame_send_iov) < 0)
+		goto exit;
+
+	if (bench_method("multi memory, map", app.multi, app.n_memories, frame_send_map) < 0)
+		goto exit;
+
+	if (bench_method("multi memory, iov", app.multi, app.n_memories, frame_send_iov) < 0)
+		goto exit;
+
+	rc = 0;
+
+exit:
+	memories_free();
+	free(app.ref);
+	free(app.dst);
+
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	usage();
+	return -1;
+}
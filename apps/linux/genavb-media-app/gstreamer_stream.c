@@ -1,5 +1,5 @@
 /*
- * Copyright 2017-2020 NXP
+ * Copyright 2017-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -35,7 +35,7 @@ static int connected_gst_listeners = 0;
 
 /* Single Stream handler structs*/
 static struct talker_gst_media  gstreamer_talker_media[MAX_GSTREAMER_TALKERS] = { [0 ... MAX_GSTREAMER_TALKERS - 1 ].stream_lock = PTHREAD_MUTEX_INITIALIZER };
-static struct talker_gst_multi_app gstreamer_talker_multi_app[MAX_GSTREAMER_TALKERS] = { [0 ... MAX_GSTREAMER_TALKERS - 1].samples_lock = PTHREAD_MUTEX_INITIALIZER};
+static struct talker_gst_multi_app gstreamer_talker_multi_app[MAX_GSTREAMER_TALKERS];
 
 void gstreamer_pipeline_init(struct gstreamer_pipeline *pipeline)
 {
@@ -0,0 +1,542 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Multi-stream throughput benchmark, comparing the per stream genavb_stream_send()/genavb_stream_receive() calls
+ * (one system call per stream) with the stream group calls genavb_stream_group_send()/genavb_stream_group_receive()
+ * (one system call for all streams).
+ *
+ * N talker (or listener) NTSCF streams are created, without stream reservation, and serviced first with the per stream
+ * API, then with the group API, for the same duration:
+ * - talker, each period one packet is sent on every stream.
+ * - listener, the available data is read from the ready streams, after each wakeup. With the per stream API, the
+ *   application waits on all the stream file descriptors. With the group API, it waits on the group readiness notifier
+ *   (genavb_stream_group_notify_create()), woken up once when all the streams are ready.
+ * For each API the number of wakeups, the cost of servicing the streams (min/mean/max per wakeup), the number of
+ * system calls and the throughput are reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <arpa/inet.h>
+
+#include <genavb/genavb.h>
+#include <genavb/helpers.h>
+
+#include "../common/time.h"
+
+#define MODE_LISTENER	0
+#define MODE_TALKER	1
+
+#define API_STREAM	(1 << 0)	/* genavb_stream_send()/genavb_stream_receive() */
+#define API_GROUP	(1 << 1)	/* genavb_stream_group_send()/genavb_stream_group_receive() */
+
+#define DEFAULT_STREAMS		4
+#define DEFAULT_PAYLOAD_SIZE	256	/* bytes */
+#define DEFAULT_PERIOD		1000	/* us */
+#define DEFAULT_DURATION	10	/* s */
+
+#define MAX_DATA_BUF_SZ		(4 * 1024)
+#define MAX_EVENT_BUF_SZ	64
+
+#define POLL_TIMEOUT		1000	/* ms */
+
+static avb_u8 default_stream_id[8] = { 0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc, 0xde, 0x00 };
+static avb_u8 default_dst_mac[6] = { 0x91, 0xE0, 0xF0, 0x00, 0xeb, 0x00 };
+
+struct bench_result {
+	unsigned long long wakeups;
+	unsigned long long syscalls;
+	unsigned long long bytes;
+	unsigned long long errors;
+	uint64_t cost_sum;	/* ns */
+	uint64_t cost_min;
+	uint64_t cost_max;
+};
+
+struct bench_app {
+	unsigned int mode;
+	unsigned int api;
+	unsigned int n_streams;
+	unsigned int payload_size;
+	unsigned int period;		/* us */
+	unsigned int duration;		/* s */
+
+	struct genavb_handle *avb_h;
+	struct genavb_stream_handle *stream_h[GENAVB_STREAM_GROUP_MAX];
+	struct genavb_stream_group *group;
+	int timer_fd;
+	int notify_fd;
+	struct pollfd poll_fd[GENAVB_STREAM_GROUP_MAX];
+
+	unsigned char data[GENAVB_STREAM_GROUP_MAX][MAX_DATA_BUF_SZ];
+	struct genavb_event event[GENAVB_STREAM_GROUP_MAX][MAX_EVENT_BUF_SZ];
+	struct genavb_iovec data_iov[GENAVB_STREAM_GROUP_MAX];
+	struct genavb_iovec event_iov[GENAVB_STREAM_GROUP_MAX];
+	struct genavb_stream_group_rx rx[GENAVB_STREAM_GROUP_MAX];
+	struct genavb_stream_group_tx tx[GENAVB_STREAM_GROUP_MAX];
+};
+
+static struct bench_app app;
+
+static volatile int signal_terminate = 0;
+
+static void usage(void)
+{
+	printf("\nUsage:\ngenavb-stream-bench [options]\n");
+	printf("\nOptions:\n"
+		"\t-m <mode>                 application mode: talker (default), listener\n"
+		"\t-n <streams>              number of streams: %u (default), at most %u\n"
+		"\t-p <payload_size>         talker payload size in bytes: %u (default)\n"
+		"\t-i <period>               talker period in us: %u (default)\n"
+		"\t-d <duration>             duration per API in s: %u (default)\n"
+		"\t-a <api>                  API: both (default), stream, group\n"
+		"\t-h                        print this help text\n",
+		DEFAULT_STREAMS, GENAVB_STREAM_GROUP_MAX, DEFAULT_PAYLOAD_SIZE, DEFAULT_PERIOD, DEFAULT_DURATION);
+}
+
+static void signal_terminate_handler(int signal_num)
+{
+	signal_terminate = 1;
+}
+
+static void set_signal_handlers(void)
+{
+	struct sigaction action;
+
+	action.sa_handler = signal_terminate_handler;
+	action.sa_flags = 0;
+	sigemptyset(&action.sa_mask);
+
+	sigaction(SIGTERM, &action, NULL);
+	sigaction(SIGINT, &action, NULL);
+}
+
+static void set_stream_params(struct genavb_stream_params *params, unsigned int i)
+{
+	memset(params, 0, sizeof(*params));
+
+	if (app.mode == MODE_TALKER) {
+		params->direction = AVTP_DIRECTION_TALKER;
+		params->clock_domain = GENAVB_MEDIA_CLOCK_DOMAIN_PTP;
+		params->talker.vlan_id = htons(0);
+		params->talker.priority = 0;
+		params->talker.max_frame_size = (avb_u16)(sizeof(struct avtp_data_hdr) + app.payload_size);
+		params->talker.max_interval_frames = 1;
+	} else {
+		params->direction = AVTP_DIRECTION_LISTENER;
+		params->clock_domain = GENAVB_MEDIA_CLOCK_DOMAIN_STREAM;
+	}
+
+	params->stream_class = SR_CLASS_NONE;
+	params->subtype = AVTP_SUBTYPE_NTSCF;
+	params->flags = GENAVB_STREAM_FLAGS_CUSTOM_TSPEC;
+	params->port = 0;
+
+	memcpy(params->stream_id, default_stream_id, 8);
+	params->stream_id[7] += i;
+
+	memcpy(params->dst_mac, default_dst_mac, 6);
+	params->dst_mac[5] += i;
+}
+
+static int streams_create(void)
+{
+	struct genavb_stream_params params;
+	unsigned int batch_size;
+	unsigned int i;
+	int rc;
+
+	for (i = 0; i < app.n_streams; i++) {
+		set_stream_params(&params, i);
+
+		batch_size = 1;
+
+		rc = genavb_stream_create(app.avb_h, &app.stream_h[i], &params, &batch_size, AVTP_NONBLOCK | AVTP_DGRAM);
+		if (rc != GENAVB_SUCCESS) {
+			printf("genavb_stream_create(%u) failed: %s\n", i, genavb_strerror(rc));
+			goto err;
+		}
+
+		app.data_iov[i].iov_base = app.data[i];
+		app.event_iov[i].iov_base = app.event[i];
+		app.event_iov[i].iov_len = MAX_EVENT_BUF_SZ;
+
+		if (app.mode == MODE_TALKER) {
+			memset(app.data[i], i, app.payload_size);
+			app.data_iov[i].iov_len = app.payload_size;
+
+			app.tx[i].data_iov = &app.data_iov[i];
+			app.tx[i].data_iov_len = 1;
+		} else {
+			app.poll_fd[i].fd = genavb_stream_fd(app.stream_h[i]);
+			app.poll_fd[i].events = POLLIN;
+
+			app.data_iov[i].iov_len = MAX_DATA_BUF_SZ;
+
+			app.rx[i].data_iov = &app.data_iov[i];
+			app.rx[i].data_iov_len = 1;
+			app.rx[i].event_iov = &app.event_iov[i];
+			app.rx[i].event_iov_len = 1;
+		}
+	}
+
+	rc = genavb_stream_group_create(&app.group, app.stream_h, app.n_streams);
+	if (rc != GENAVB_SUCCESS) {
+		printf("genavb_stream_group_create() failed: %s\n", genavb_strerror(rc));
+		goto err;
+	}
+
+	if (app.mode == MODE_LISTENER) {
+		app.notify_fd = genavb_stream_group_notify_create(app.group, 0);
+		if (app.notify_fd < 0) {
+			printf("genavb_stream_group_notify_create() failed: %s\n", genavb_strerror(app.notify_fd));
+			goto err_notify;
+		}
+	}
+
+	return 0;
+
+err_notify:
+	genavb_stream_group_destroy(app.group);
+
+err:
+	while (i--)
+		genavb_stream_destroy(app.stream_h[i]);
+
+	return -1;
+}
+
+static void streams_destroy(void)
+{
+	unsigned int i;
+
+	genavb_stream_group_destroy(app.group);
+
+	for (i = 0; i < app.n_streams; i++)
+		genavb_stream_destroy(app.stream_h[i]);
+}
+
+/* Waits for the next period */
+static int wait_timer(void)
+{
+	uint64_t expirations;
+
+	if (read(app.timer_fd, &expirations, sizeof(expirations)) < 0) {
+		if (errno == EINTR)
+			return 0;
+
+		printf("read(timer_fd) failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	return 1;
+}
+
+/* Waits for any of the streams to be ready */
+static int wait_streams(void)
+{
+	int rc;
+
+	rc = poll(app.poll_fd, app.n_streams, POLL_TIMEOUT);
+	if (rc < 0) {
+		if (errno == EINTR)
+			return 0;
+
+		printf("poll() failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	return rc ? 1 : 0;
+}
+
+/* Waits for the group readiness notifier */
+static int wait_group(void)
+{
+	struct pollfd poll_fd = { .fd = app.notify_fd, .events = POLLIN };
+	unsigned int ready;
+	int rc;
+
+	rc = poll(&poll_fd, 1, POLL_TIMEOUT);
+	if (rc < 0) {
+		if (errno == EINTR)
+			return 0;
+
+		printf("poll() failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	if (!rc)
+		return 0;
+
+	if (poll_fd.revents & POLLHUP) {
+		printf("group readiness notifier closed\n");
+		return -1;
+	}
+
+	rc = genavb_stream_group_ready(app.group, &ready);
+	if (rc < 0) {
+		printf("genavb_stream_group_ready() failed: %s\n", genavb_strerror(rc));
+		return -1;
+	}
+
+	return 1;
+}
+
+/* Services the streams once, with the per stream API */
+static void period_stream(struct bench_result *r)
+{
+	unsigned int event_len;
+	unsigned int i;
+	int rc;
+
+	for (i = 0; i < app.n_streams; i++) {
+		if (app.mode == MODE_TALKER) {
+			rc = genavb_stream_send(app.stream_h[i], app.data[i], app.payload_size, NULL, 0);
+		} else {
+			if (!(app.poll_fd[i].revents & POLLIN))
+				continue;
+
+			rc = genavb_stream_receive_iov(app.stream_h[i], &app.data_iov[i], 1, &app.event_iov[i], 1, &event_len);
+		}
+
+		r->syscalls++;
+
+		if (rc < 0)
+			r->errors++;
+		else
+			r->bytes += rc;
+	}
+}
+
+/* Services all the streams once, with the group API */
+static void period_group(struct bench_result *r)
+{
+	unsigned int i;
+	int rc;
+
+	if (app.mode == MODE_TALKER)
+		rc = genavb_stream_group_send(app.group, app.tx);
+	else
+		rc = genavb_stream_group_receive(app.group, app.rx);
+
+	r->syscalls++;
+
+	if (rc < 0) {
+		r->errors += app.n_streams;
+		return;
+	}
+
+	for (i = 0; i < app.n_streams; i++) {
+		rc = (app.mode == MODE_TALKER) ? app.tx[i].rc : app.rx[i].rc;
+
+		if (rc < 0)
+			r->errors++;
+		else
+			r->bytes += rc;
+	}
+}
+
+static int run(const char *name, int (*wait)(void), void (*period)(struct bench_result *r))
+{
+	struct bench_result r = { .cost_min = UINT64_MAX };
+	uint64_t start, end, t0, t1;
+	double seconds;
+	int rc;
+
+	if (gettime_ns_monotonic(&start) < 0)
+		return -1;
+
+	end = start + (uint64_t)app.duration * NSECS_PER_SEC;
+	t1 = start;
+
+	do {
+		rc = wait();
+		if (rc < 0)
+			return -1;
+
+		if (!rc) {
+			gettime_ns_monotonic(&t1);
+			continue;
+		}
+
+		gettime_ns_monotonic(&t0);
+		period(&r);
+		gettime_ns_monotonic(&t1);
+
+		r.wakeups++;
+		r.cost_sum += t1 - t0;
+		if ((t1 - t0) < r.cost_min)
+			r.cost_min = t1 - t0;
+		if ((t1 - t0) > r.cost_max)
+			r.cost_max = t1 - t0;
+
+	} while (!signal_terminate && (t1 < end));
+
+	if (!r.wakeups) {
+		printf("%-8s no wakeup\n", name);
+		return 0;
+	}
+
+	seconds = (double)(t1 - start) / NSECS_PER_SEC;
+
+	printf("%-8s %10llu %10llu %10llu %10" PRIu64 " %10" PRIu64 " %10" PRIu64 " %12.3f\n",
+	       name, r.wakeups, r.syscalls, r.errors,
+	       r.cost_min, r.cost_sum / (uint64_t)r.wakeups, r.cost_max,
+	       (r.bytes * 8) / seconds / 1000000.0);
+
+	return 0;
+}
+
+static int timer_create_fd(void)
+{
+	struct itimerspec its;
+
+	app.timer_fd = timerfd_create(CLOCK_MONOTONIC, 0);
+	if (app.timer_fd < 0) {
+		printf("timerfd_create() failed: %s\n", strerror(errno));
+		return -1;
+	}
+
+	its.it_value.tv_sec = app.period / USECS_PER_SEC;
+	its.it_value.tv_nsec = (app.period % USECS_PER_SEC) * (NSECS_PER_SEC / USECS_PER_SEC);
+	its.it_interval = its.it_value;
+
+	if (timerfd_settime(app.timer_fd, 0, &its, NULL) < 0) {
+		printf("timerfd_settime() failed: %s\n", strerror(errno));
+		close(app.timer_fd);
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long val;
+	int option;
+	int rc = -1;
+
+	app.mode = MODE_TALKER;
+	app.api = API_STREAM | API_GROUP;
+	app.n_streams = DEFAULT_STREAMS;
+	app.payload_size = DEFAULT_PAYLOAD_SIZE;
+	app.period = DEFAULT_PERIOD;
+	app.duration = DEFAULT_DURATION;
+
+	while ((option = getopt(argc, argv, "m:n:p:i:d:a:h")) != -1) {
+		switch (option) {
+		case 'm':
+			if (!strcmp(optarg, "talker"))
+				app.mode = MODE_TALKER;
+			else if (!strcmp(optarg, "listener"))
+				app.mode = MODE_LISTENER;
+			else
+				goto err_option;
+			break;
+
+		case 'n':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val || (val > GENAVB_STREAM_GROUP_MAX))
+				goto err_option;
+			app.n_streams = val;
+			break;
+
+		case 'p':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val || (val > MAX_DATA_BUF_SZ))
+				goto err_option;
+			app.payload_size = val;
+			break;
+
+		case 'i':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.period = val;
+			break;
+
+		case 'd':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.duration = val;
+			break;
+
+		case 'a':
+			if (!strcmp(optarg, "both"))
+				app.api = API_STREAM | API_GROUP;
+			else if (!strcmp(optarg, "stream"))
+				app.api = API_STREAM;
+			else if (!strcmp(optarg, "group"))
+				app.api = API_GROUP;
+			else
+				goto err_option;
+			break;
+
+		case 'h':
+		default:
+			usage();
+			return 0;
+		}
+	}
+
+	set_signal_handlers();
+
+	rc = genavb_init(&app.avb_h, 0);
+	if (rc != GENAVB_SUCCESS) {
+		printf("genavb_init() failed: %s\n", genavb_strerror(rc));
+		rc = -1;
+		goto err_init;
+	}
+
+	rc = streams_create();
+	if (rc < 0)
+		goto err_streams;
+
+	rc = timer_create_fd();
+	if (rc < 0)
+		goto err_timer;
+
+	printf("genavb-stream-bench: %s, %u streams, period %u us, %u s per API\n\n",
+	       (app.mode == MODE_TALKER) ? "talker" : "listener", app.n_streams, app.period, app.duration);
+
+	printf("API         wakeups   syscalls     errors            cost per wakeup (ns)  throughput\n");
+	printf("                                                   min       mean        max     (Mbit/s)\n");
+
+	if ((app.api & API_STREAM) && !signal_terminate) {
+		rc = run("stream", (app.mode == MODE_TALKER) ? wait_timer : wait_streams, period_stream);
+		if (rc < 0)
+			goto err_run;
+	}
+
+	if ((app.api & API_GROUP) && !signal_terminate) {
+		rc = run("group", (app.mode == MODE_TALKER) ? wait_timer : wait_group, period_group);
+		if (rc < 0)
+			goto err_run;
+	}
+
+err_run:
+	close(app.timer_fd);
+
+err_timer:
+	streams_destroy();
+
+err_streams:
+	genavb_exit(app.avb_h);
+
+err_init:
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	usage();
+	return -1;
+}
@@ -0,0 +1,340 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * MPEG-TS PCR scan throughput benchmark, comparing the per packet header parsing (ts_parser_is_pcr() called on every
+ * transport packet) with the multi-packet scanner (ts_parser_scan_pcr(), jumping to the PCR-bearing packets).
+ *
+ * The transport stream is either a synthetic one, generated in memory (constant bitrate, one PCR every N packets, and
+ * a random adaptation field without PCR on other packets), and optionally written to a file, or read from a file. Each method scans the whole stream a number of times, and the
+ * throughput (MB/s, packets/s) and number of PCRs found are reported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <string.h>
+#include <getopt.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <genavb/genavb.h>
+#include <genavb/helpers.h>
+
+#include "../common/time.h"
+#include "../common/ts_parser.h"
+
+#define DEFAULT_SIZE		2		/* MB, of the order of the applications file buffer (FILE_BUFFER_SIZE) */
+#define DEFAULT_PCR_INTERVAL	40		/* packets */
+#define DEFAULT_RUNS		500
+#define DEFAULT_BITRATE		20000000	/* bit/s, synthetic stream */
+
+#define SYNC_BYTE		0x47
+#define TS_PID			0x100
+#define TS_CLOCK_FREQUENCY	27000000ULL
+
+struct bench_app {
+	const char *input_file;
+	const char *output_file;
+	unsigned int size;		/* MB */
+	unsigned int pcr_interval;	/* packets */
+	unsigned int runs;
+
+	unsigned char *buf;
+	unsigned int n_packets;
+};
+
+static struct bench_app app;
+
+static void usage(void)
+{
+	printf("\nUsage:\ngenavb-ts-bench [options]\n");
+	printf("\nOptions:\n"
+		"\t-f <file>                 transport stream file to scan (default: synthetic stream)\n"
+		"\t-o <file>                 write the synthetic stream to a file\n"
+		"\t-s <size>                 synthetic stream size in MB: %u (default)\n"
+		"\t-p <packets>              synthetic stream PCR interval in packets: %u (default)\n"
+		"\t-r <runs>                 scans per method: %u (default)\n"
+		"\t-h                        print this help text\n",
+		DEFAULT_SIZE, DEFAULT_PCR_INTERVAL, DEFAULT_RUNS);
+}
+
+/* Constant bitrate stream, a single PID, with a PCR every pcr_interval packets */
+static void synthetic_generate(void)
+{
+	unsigned char *packet;
+	unsigned long long pcr, pcr_base;
+	unsigned int pcr_ext;
+	unsigned int i;
+
+	for (i = 0; i < app.n_packets; i++) {
+		packet = app.buf + (unsigned long)i * PES_SIZE;
+
+		packet[0] = SYNC_BYTE;
+		packet[1] = (TS_PID >> 8) & 0x1f;
+		packet[2] = TS_PID & 0xff;
+
+		if (!(i % app.pcr_interval)) {
+			pcr = ((unsigned long long)i * PES_SIZE * 8 * TS_CLOCK_FREQUENCY) / DEFAULT_BITRATE;
+			pcr_base = (pcr / 300) & 0x1ffffffffULL;
+			pcr_ext = pcr % 300;
+
+			packet[3] = 0x30 | (i & 0xf);		/* adaptation field and payload */
+			packet[4] = 7;				/* adaptation field length */
+			packet[5] = 0x10;			/* PCR flag */
+			packet[6] = pcr_base >> 25;
+			packet[7] = pcr_base >> 17;
+			packet[8] = pcr_base >> 9;
+			packet[9] = pcr_base >> 1;
+			packet[10] = ((pcr_base & 0x1) << 7) | 0x7e | (pcr_ext >> 8);
+			packet[11] = pcr_ext & 0xff;
+			memset(packet + 12, 0xa5, PES_SIZE - 12);
+		} else if (!(random() % 4)) {
+			packet[3] = 0x30 | (i & 0xf);		/* adaptation field (stuffing, random access) and payload */
+			packet[4] = 1 + random() % 16;
+			packet[5] = (random() % 2) ? 0x40 : 0x00;
+			memset(packet + 6, 0xa5, PES_SIZE - 6);
+		} else {
+			packet[3] = 0x10 | (i & 0xf);		/* payload only */
+			memset(packet + 4, 0xa5, PES_SIZE - 4);
+		}
+	}
+}
+
+static int synthetic_write(void)
+{
+	unsigned long len = (unsigned long)app.n_packets * PES_SIZE;
+	unsigned long offset = 0;
+	ssize_t rc;
+	int fd;
+
+	fd = open(app.output_file, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		printf("open(%s) failed: %s\n", app.output_file, strerror(errno));
+		return -1;
+	}
+
+	while (offset < len) {
+		rc = write(fd, app.buf + offset, len - offset);
+		if (rc < 0) {
+			printf("write(%s) failed: %s\n", app.output_file, strerror(errno));
+			close(fd);
+			return -1;
+		}
+
+		offset += rc;
+	}
+
+	close(fd);
+
+	return 0;
+}
+
+static int input_read(void)
+{
+	unsigned long len, offset = 0;
+	struct stat st;
+	ssize_t rc;
+	int fd;
+
+	fd = open(app.input_file, O_RDONLY);
+	if (fd < 0) {
+		printf("open(%s) failed: %s\n", app.input_file, strerror(errno));
+		return -1;
+	}
+
+	if (fstat(fd, &st) < 0)
+		goto err;
+
+	app.n_packets = st.st_size / PES_SIZE;
+	len = (unsigned long)app.n_packets * PES_SIZE;
+
+	if (!app.n_packets) {
+		printf("%s: no transport packet\n", app.input_file);
+		goto err;
+	}
+
+	app.buf = malloc(len);
+	if (!app.buf)
+		goto err;
+
+	while (offset < len) {
+		rc = read(fd, app.buf + offset, len - offset);
+		if (rc <= 0) {
+			printf("read(%s) failed: %s\n", app.input_file, rc ? strerror(errno) : "end of file");
+			goto err;
+		}
+
+		offset += rc;
+	}
+
+	close(fd);
+
+	return 0;
+
+err:
+	close(fd);
+
+	return -1;
+}
+
+/* Header of every packet parsed */
+static unsigned int scan_per_packet(unsigned long long *pcr_sum)
+{
+	unsigned long long pcr;
+	unsigned int i, n = 0;
+
+	for (i = 0; i < app.n_packets; i++) {
+		if (ts_parser_is_pcr(app.buf + (unsigned long)i * PES_SIZE, &pcr)) {
+			*pcr_sum += pcr;
+			n++;
+		}
+	}
+
+	return n;
+}
+
+/* Multi-packet scanner, only PCR-bearing packets parsed */
+static unsigned int scan_multi_packet(unsigned long long *pcr_sum)
+{
+	unsigned long long pcr;
+	unsigned int i = 0, n = 0;
+
+	while (i < app.n_packets) {
+		i += ts_parser_scan_pcr(app.buf + (unsigned long)i * PES_SIZE, app.n_packets - i);
+		if (i == app.n_packets)
+			break;
+
+		if (ts_parser_is_pcr(app.buf + (unsigned long)i * PES_SIZE, &pcr)) {
+			*pcr_sum += pcr;
+			n++;
+		}
+
+		i++;
+	}
+
+	return n;
+}
+
+static void bench_method(const char *name, unsigned int (*scan)(unsigned long long *pcr_sum), unsigned int *pcrs, unsigned long long *pcr_sum)
+{
+	uint64_t start, end, elapsed;
+	double bytes;
+	unsigned int i;
+
+	*pcr_sum = 0;
+
+	gettime_ns_monotonic(&start);
+
+	for (i = 0; i < app.runs; i++)
+		*pcrs = scan(pcr_sum);
+
+	gettime_ns_monotonic(&end);
+
+	elapsed = end - start;
+	if (!elapsed)
+		elapsed = 1;
+
+	bytes = (double)app.n_packets * PES_SIZE * app.runs;
+
+	printf("%-14s %10.1f %12.1f %10.2f %10u\n", name,
+		bytes * NSECS_PER_SEC / elapsed / (1024 * 1024),
+		(double)app.n_packets * app.runs * NSECS_PER_SEC / elapsed / 1000000,
+		(double)elapsed / app.runs / 1000000, *pcrs);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long long pcr_sum[2];
+	unsigned int pcrs[2] = { 0 };
+	unsigned long val;
+	int option;
+	int rc = -1;
+
+	app.size = DEFAULT_SIZE;
+	app.pcr_interval = DEFAULT_PCR_INTERVAL;
+	app.runs = DEFAULT_RUNS;
+
+	while ((option = getopt(argc, argv, "f:o:s:p:r:h")) != -1) {
+		switch (option) {
+		case 'f':
+			app.input_file = optarg;
+			break;
+
+		case 'o':
+			app.output_file = optarg;
+			break;
+
+		case 's':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val || (val > 4096))
+				goto err_option;
+			app.size = val;
+			break;
+
+		case 'p':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.pcr_interval = val;
+			break;
+
+		case 'r':
+			if ((h_strtoul(&val, optarg, NULL, 0) < 0) || !val)
+				goto err_option;
+			app.runs = val;
+			break;
+
+		case 'h':
+		default:
+			usage();
+			return 0;
+		}
+	}
+
+	if (app.input_file) {
+		if (input_read() < 0)
+			goto exit;
+
+		printf("genavb-ts-bench: %s, %u packets, %u runs\n\n", app.input_file, app.n_packets, app.runs);
+	} else {
+		app.n_packets = ((unsigned long)app.size * 1024 * 1024) / PES_SIZE;
+
+		app.buf = malloc((unsigned long)app.n_packets * PES_SIZE);
+		if (!app.buf)
+			goto exit;
+
+		synthetic_generate();
+
+		if (app.output_file && (synthetic_write() < 0))
+			goto exit;
+
+		printf("genavb-ts-bench: synthetic stream, %u packets, PCR every %u packets, %u runs\n\n",
+			app.n_packets, app.pcr_interval, app.runs);
+	}
+
+	printf("method               MB/s   Mpackets/s   ms/scan       PCRs\n");
+
+	bench_method("per packet", scan_per_packet, &pcrs[0], &pcr_sum[0]);
+	bench_method("multi packet", scan_multi_packet, &pcrs[1], &pcr_sum[1]);
+
+	if ((pcrs[0] != pcrs[1]) || (pcr_sum[0] != pcr_sum[1])) {
+		printf("\nerror: methods found different PCRs\n");
+		goto exit;
+	}
+
+	rc = 0;
+
+exit:
+	free(app.buf);
+
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	usage();
+	return -1;
+}
@@ -19,7 +19,7 @@ static char *device_name;
 static int dump_stats(struct genavb_control_handle *ctrl_h, unsigned int port)
 {
 	struct genavb_msg_managed_set_response get_response;
-	uint16_t cmd[38];
+	uint16_t cmd[42];
 	uint16_t rep[7];
 	uint8_t *data;
 	int i;
@@ -40,7 +40,9 @@ static int dump_stats(struct genavb_control_handle *ctrl_h, unsigned int port)
 		"txPdelayRequestCount",
 		"txPdelayResponseCount",
 		"txPdelayResponseFollowUpCount",
-		"txAnnounceCount"
+		"txAnnounceCount",
+		"pdelayDelayOutlierCount",
+		"pdelayRateRatioOutlierCount"
 	};
 
 	cmd[0] = 5; /* port_parameter_statistics */
@@ -51,7 +53,7 @@ static int dump_stats(struct genavb_control_handle *ctrl_h, unsigned int port)
 	cmd[4] = port; /* key value */
 	cmd[1] += 3 * 2;
 
-	for (i = 0; i < 16; i++) {
+	for (i = 0; i < 18; i++) {
 		cmd[5 + 2 * i] = i + 1; /* stat index */
 		cmd[5 + 2 * i + 1] = 0;
 		cmd[1] += 2 * 2;
@@ -81,7 +83,7 @@ static int dump_stats(struct genavb_control_handle *ctrl_h, unsigned int port)
 
 	data = get_node_next(data, length);
 
-	for (i = 0; i < 16; i++) {
+	for (i = 0; i < 18; i++) {
 		data = get_node_header(data, &id, &length, &status);
 
 		if (!status)
@@ -1,6 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
- * Copyright 2022 NXP
+ * Copyright 2022, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -35,6 +35,7 @@
 /* GenAVB stack cofiguration */
 #define FLAG_BLOCKING	(1 << 2) /* use blocking call to the genavb library */
 #define FLAG_IOV	(1 << 3) /* use iov array for data and event */
+#define FLAG_ASYNC	(1 << 4) /* read the media file ahead asynchronously */
 
 #define PROCESS_PRIORITY	60 /* RT_FIFO priority to be used for the process */
 
@@ -112,6 +113,7 @@ static void usage (void)
 		"\t-i                    use iov\n"
 		"\t-f <file name>        media file name (default media.raw)\n"
 		"\t-t                    parse the media file as mpegts and apply PCR based flow control\n"
+		"\t-a                    read the media file ahead asynchronously, in a separate thread\n"
 		"\t-h                    print this help text\n");
 }
 
@@ -461,7 +463,7 @@ static int talker_nonblocking(struct avb_stream_handle *stream_h, int stream_fd,
 
 	printf("Starting talker loop, non-blocking mode\n");
 
-	b = malloc(sizeof(struct file_buffer));
+	b = calloc(1, sizeof(struct file_buffer));
 	if (!b) {
 		printf("%s() cannot allocate file_buffer\n", __func__);
 		rc = -1;
@@ -469,6 +471,8 @@ static int talker_nonblocking(struct avb_stream_handle *stream_h, int stream_fd,
 	}
 
 loop:
+	file_buffer_async_stop(b);
+
 	lseek(file_src, 0, SEEK_SET);
 
 	if (ts_parser_enabled) {
@@ -480,6 +484,13 @@ loop:
 	} else
 		file_buffer_init(b, 1);
 
+	if (app.config & FLAG_ASYNC) {
+		if (file_buffer_async_start(b, file_src) < 0) {
+			rc = -1;
+			goto exit;
+		}
+	}
+
 	byte_count = 0;
 
 	/*
@@ -555,7 +566,7 @@ loop:
 							rc = file_buffer_write(b, file_src, 1000000);
 							if (rc <= 0) {
 								if (!rc) {
-									printf("loop\n");
+									printf("loop (file buffer stalls: %llu)\n", b->stalls);
 
 									talker_stream_flush(stream_h, NULL);
 
@@ -616,6 +627,7 @@ loop:
 	}
 
 exit:
+	file_buffer_async_stop(b);
 	free(b);
 
 err_malloc:
@@ -703,7 +715,7 @@ int main(int argc, char *argv[])
 	app.mode = MODE_AVDECC; app.config = 0; /* default is AVDECC, NON-BLOCKING, SINGLE BUFFER */
 	app.connected_stream_index = -1;
 
-	while ((option = getopt(argc, argv,"m:bif:ht")) != -1) {
+	while ((option = getopt(argc, argv,"m:bif:hta")) != -1) {
 		switch (option) {
 		case 'm':
 			if (!strcasecmp(optarg, "listener"))
@@ -738,6 +750,10 @@ int main(int argc, char *argv[])
 			ts_parser_enabled = 1;
 			break;
 
+		case 'a':
+			app.config |= FLAG_ASYNC;
+			break;
+
 		case 'h':
 		default:
 			usage();
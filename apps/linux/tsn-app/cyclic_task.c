@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2020 NXP
+ * Copyright 2019-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -22,12 +22,19 @@
 #endif
 
 static bool reset_stats;
+static const char *trace_file;
 
 void cyclic_stats_reset_handler(void)
 {
     reset_stats = true;
 }
 
+/* Per cycle trace file (see cyclic_trace.h), must be set before cyclic_task_init() */
+void cyclic_task_set_trace_file(const char *path)
+{
+	trace_file = path;
+}
+
 void socket_stats_print(struct socket *sock)
 {
 	if (sock->stats_snap.pending) {
@@ -42,6 +49,7 @@ void socket_stats_print(struct socket *sock)
 
 		stats_print(&sock->stats_snap.traffic_latency);
 		hist_print(&sock->stats_snap.traffic_latency_hist);
+		hdr_hist_print(&sock->stats_snap.traffic_latency_hdr, "traffic latency");
 
 		opcua_update_cyclic_socket(sock);
 
@@ -105,6 +113,7 @@ static void cyclic_task_stats_reset(struct cyclic_task *c_task)
 
 		stats_init(&c_task->rx_socket[i].stats.traffic_latency, 31, "traffic latency", NULL);
 		hist_reset(&c_task->rx_socket[i].stats.traffic_latency_hist);
+		hdr_hist_reset(&c_task->rx_socket[i].stats.traffic_latency_hdr);
 	}
 }
 
@@ -123,66 +132,115 @@ static void cyclic_task_take_trace_snapshot(struct cyclic_task *c_task)
 
 #endif
 
+static void cyclic_socket_receive(struct cyclic_task *c_task, struct socket *sock, struct tsn_common_hdr *hdr)
+{
+	uint32_t traffic_latency;
+
+	traffic_latency = sock->net_sock->ts - hdr->sched_time;
+
+	stats_update(&sock->stats.traffic_latency, traffic_latency);
+	hist_update(&sock->stats.traffic_latency_hist, traffic_latency);
+	hdr_hist_update(&sock->stats.traffic_latency_hdr, traffic_latency);
+
+	if (traffic_latency > sock->stats.traffic_latency_max)
+		sock->stats.traffic_latency_max = traffic_latency;
+
+	if (traffic_latency < sock->stats.traffic_latency_min)
+		sock->stats.traffic_latency_min = traffic_latency;
+
+	sock->stats.valid_frames++;
+	sock->stats.link_status = 1;
+
+	if (c_task->trace.rec)
+		c_task->trace.rec->rx_frames++;
+
+	if (c_task->net_rx_func)
+		c_task->net_rx_func(c_task->ctx, hdr->msg_id, hdr->src_id,
+				    hdr + 1, hdr->len);
+}
+
+/*
+ * Receives the frame of the current cycle from all peers. All the peers are received in a single batched zero-copy
+ * receive. Peers with a stale frame (previous cycle, unexpected source) are received again in the next batch, until
+ * their frame queue is drained.
+ */
 static void cyclic_net_receive(struct cyclic_task *c_task)
 {
-	int i;
-	int status;
-	struct socket *sock;
 	struct tsn_task *task = c_task->task;
+	struct socket *pending[MAX_PEERS];
+	struct net_socket *net_sock[MAX_PEERS];
+	int status[MAX_PEERS];
+	bool rx_frame[MAX_PEERS];
 	struct tsn_common_hdr *hdr;
-	int rx_frame;
-	uint32_t traffic_latency;
+	struct socket *sock;
+	unsigned int n_pending, n, i;
 
 	for (i = 0; i < c_task->num_peers; i++) {
-		sock = &c_task->rx_socket[i];
-		rx_frame = 0;
-	retry:
-		status = tsn_net_receive_sock(sock->net_sock);
-		if (status == NET_NO_FRAME && !rx_frame) {
-			sock->stats.err_underflow++;
-#ifdef TRACE_SNAPSHOT
-			cyclic_task_take_trace_snapshot(c_task);
-#endif
-		}
+		pending[i] = &c_task->rx_socket[i];
+		rx_frame[i] = false;
+	}
 
-		if (status != NET_OK) {
-			sock->stats.link_status = 0;
-			continue;
-		}
+	n_pending = c_task->num_peers;
 
-		rx_frame = 1;
+	while (n_pending) {
+		for (i = 0; i < n_pending; i++)
+			net_sock[i] = pending[i]->net_sock;
 
-		hdr = tsn_net_sock_buf(sock->net_sock);
-		if (hdr->sched_time != (tsn_task_get_time(task) - task->params->transfer_time_ns)) {
-			sock->stats.err_ts++;
-			goto retry;
-		}
+		tsn_net_receive_batch(task, net_sock, status, n_pending);
 
-		if (hdr->src_id != sock->peer_id) {
-			sock->stats.err_id++;
-			goto retry;
-		}
+		if (c_task->trace.rec)
+			c_task->trace.rec->rx_batches++;
+
+		n = 0;
 
-		traffic_latency = sock->net_sock->ts - hdr->sched_time;
+		for (i = 0; i < n_pending; i++) {
+			sock = pending[i];
+
+			if (status[i] == NET_NO_FRAME && !rx_frame[sock->id]) {
+				sock->stats.err_underflow++;
+#ifdef TRACE_SNAPSHOT
+				cyclic_task_take_trace_snapshot(c_task);
+#endif
+			}
 
-		stats_update(&sock->stats.traffic_latency, traffic_latency);
-		hist_update(&sock->stats.traffic_latency_hist, traffic_latency);
+			if (status[i] != NET_OK) {
+				sock->stats.link_status = 0;
+				continue;
+			}
 
-		if (traffic_latency > sock->stats.traffic_latency_max)
-			sock->stats.traffic_latency_max = traffic_latency;
+			rx_frame[sock->id] = true;
 
-		if (traffic_latency < sock->stats.traffic_latency_min)
-			sock->stats.traffic_latency_min = traffic_latency;
+			hdr = tsn_net_sock_buf(sock->net_sock);
+			if (hdr->sched_time != (tsn_task_get_time(task) - task->params->transfer_time_ns)) {
+				sock->stats.err_ts++;
+				pending[n++] = sock;
+				continue;
+			}
 
-		sock->stats.valid_frames++;
-		sock->stats.link_status = 1;
+			if (hdr->src_id != sock->peer_id) {
+				sock->stats.err_id++;
+				pending[n++] = sock;
+				continue;
+			}
 
-		if (c_task->net_rx_func)
-			c_task->net_rx_func(c_task->ctx, hdr->msg_id, hdr->src_id,
-					    hdr + 1, hdr->len);
+			cyclic_socket_receive(c_task, sock, hdr);
+		}
+
+		n_pending = n;
 	}
 }
 
+static void cyclic_trace_time(struct cyclic_task *c_task, int32_t *field)
+{
+	struct tsn_task *task = c_task->task;
+	uint64_t now;
+
+	if (genavb_clock_gettime64(task->params->clk_id, &now) < 0)
+		return;
+
+	*field = now - c_task->trace.rec->sched_time;
+}
+
 int cyclic_net_transmit(struct cyclic_task *c_task, int msg_id, void *buf, int len)
 {
 	struct tsn_task *task = c_task->task;
@@ -208,6 +266,9 @@ int cyclic_net_transmit(struct cyclic_task *c_task, int msg_id, void *buf, int l
 	if (status != NET_OK)
 		goto err;
 
+	if (c_task->trace.rec)
+		cyclic_trace_time(c_task, &c_task->trace.rec->tx_done);
+
 	return 0;
 
 err:
@@ -239,6 +300,8 @@ static int main_cyclic(void *data, unsigned int events)
 
 	tsn_task_stats_start(task, (int)n_time, now);
 
+	cyclic_trace_begin(&c_task->trace, tsn_task_get_time(task), now);
+
 #ifdef TRACE_SNAPSHOT
 	if ((now - task->sched_time) > TRACE_SNAPSHOT_THRESHOLD) {
 		cyclic_task_take_trace_snapshot(c_task);
@@ -250,12 +313,20 @@ static int main_cyclic(void *data, unsigned int events)
 	 */
 	cyclic_net_receive(c_task);
 
+	if (c_task->trace.rec)
+		cyclic_trace_time(c_task, &c_task->trace.rec->rx_done);
+
 	/*
 	 * Main loop
 	 */
 	if (c_task->loop_func)
 		c_task->loop_func(c_task->ctx, 0);
 
+	if (c_task->trace.rec)
+		cyclic_trace_time(c_task, &c_task->trace.rec->proc_done);
+
+	cyclic_trace_end(&c_task->trace);
+
 	tsn_task_stats_end(task);
 
 	if (!(task->stats.sched % num_sched_stats)) {
@@ -305,8 +376,11 @@ int cyclic_task_set_num_peers(struct cyclic_task *c_task, unsigned int num_peers
 	if (!num_peers)
 		return 0;
 
-	if (num_peers > MAX_PEERS)
+	/* Peers without a configured rx_socket entry would silently use stream 0 and peer 0 */
+	if (num_peers > c_task->max_peers) {
+		ERR("invalid number of peers(%u), only %u configured\n", num_peers, c_task->max_peers);
 		return -1;
+	}
 
 	c_task->num_peers = num_peers;
 
@@ -403,10 +477,15 @@ int cyclic_task_init(struct cyclic_task *c_task,
 
 		stats_init(&c_task->rx_socket[i].stats.traffic_latency, 31, "traffic latency", NULL);
 		hist_init(&c_task->rx_socket[i].stats.traffic_latency_hist, 100, 1000);
+		hdr_hist_reset(&c_task->rx_socket[i].stats.traffic_latency_hdr);
 	}
 
 	c_task->tx_socket.net_sock = tsn_net_sock_tx(c_task->task, 0);
 
+	/* Tracing is optional, the task runs without it */
+	if (trace_file)
+		cyclic_trace_open(&c_task->trace, trace_file, c_task->id, c_task->num_peers, params->task_period_ns);
+
 	INF("success\n");
 
 	opcua_init_params(c_task);
@@ -420,4 +499,6 @@ err:
 void cyclic_task_exit(struct cyclic_task *c_task)
 {
 	tsn_task_deregister(c_task->task);
+
+	cyclic_trace_close(&c_task->trace);
 }
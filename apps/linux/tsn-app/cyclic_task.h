@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2020 NXP
+ * Copyright 2019-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -9,6 +9,7 @@
 
 #include "tsn_task.h"
 #include "tsn_tasks_config.h"
+#include "cyclic_trace.h"
 
 //#define TRACE_SNAPSHOT 1   // Uncomment to trigger a kernel ftrace snapshot on some latency errors (see cyclic_task.c)
 
@@ -24,6 +25,7 @@ struct socket_stats {
 	unsigned int traffic_latency_min;
 	struct stats traffic_latency;
 	struct hist traffic_latency_hist;
+	struct hdr_hist traffic_latency_hdr;
 	bool pending;
 };
 
@@ -42,11 +44,13 @@ struct cyclic_task {
 	int type;
 	int id;
 	int num_peers;
+	unsigned int max_peers;	/* number of rx_socket entries configured (see tsn_tasks_config.c) */
 	struct socket rx_socket[MAX_PEERS];
 	struct socket tx_socket;
 	void (*net_rx_func)(void *ctx, int msg_id, int src_id, void *buf, int len);
 	void (*loop_func)(void *ctx, int timer_status);
 	void *ctx;
+	struct cyclic_trace trace;
 #ifdef TRACE_SNAPSHOT
 	int trace_snapshot_fd;
 #endif
@@ -63,6 +67,7 @@ void cyclic_task_get_monitoring(struct cyclic_task *task, uint32_t *sched_err_ma
 				uint32_t *traffic_latency_min, uint32_t num_socket_monitored);
 void cyclic_stats_print(struct cyclic_task *c_task);
 void cyclic_stats_reset_handler(void);
+void cyclic_task_set_trace_file(const char *path);
 void cyclic_task_init_trace_snapshot(struct cyclic_task *c_task);
 void cyclic_task_set_period(struct cyclic_task *c_task, unsigned int period_ns);
 int cyclic_task_set_num_peers(struct cyclic_task *c_task, unsigned int num_peers);
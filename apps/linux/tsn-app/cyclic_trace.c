@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+#include "cyclic_trace.h"
+
+#include "../common/log.h"
+
+/** Creates the trace of a cyclic task. The trace file is created here, and only written by cyclic_trace_close(). The
+ * ring is allocated in anonymous memory, faulted in and locked here, not during the cycles.
+ * \return	0 on success, -1 on error
+ * \param trace		pointer to trace context
+ * \param path		trace file path
+ * \param task_id	cyclic task id
+ * \param num_peers	cyclic task number of peers
+ * \param period_ns	cyclic task period
+ */
+int cyclic_trace_open(struct cyclic_trace *trace, const char *path, unsigned int task_id, unsigned int num_peers, unsigned int period_ns)
+{
+	unsigned long size = sizeof(struct cyclic_trace_header) + CYCLIC_TRACE_RECORDS * sizeof(struct cyclic_trace_record);
+	struct cyclic_trace_header *header;
+	int fd;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0) {
+		ERR("open(%s) failed: %s\n", path, strerror(errno));
+		goto err_open;
+	}
+
+	header = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+	if (header == MAP_FAILED) {
+		ERR("mmap() failed: %s\n", strerror(errno));
+		goto err_mmap;
+	}
+
+	if (mlock(header, size) < 0) {
+		ERR("mlock() failed: %s\n", strerror(errno));
+		goto err_mlock;
+	}
+
+	memset(header, 0, size);
+
+	header->magic = CYCLIC_TRACE_MAGIC;
+	header->version = CYCLIC_TRACE_VERSION;
+	header->record_size = sizeof(struct cyclic_trace_record);
+	header->n_records = CYCLIC_TRACE_RECORDS;
+	header->task_id = task_id;
+	header->num_peers = num_peers;
+	header->period_ns = period_ns;
+
+	trace->header = header;
+	trace->rec = NULL;
+	trace->size = size;
+	trace->fd = fd;
+
+	INF("cycle trace: %s, %u records, written at exit\n", path, CYCLIC_TRACE_RECORDS);
+
+	return 0;
+
+err_mlock:
+	munmap(header, size);
+
+err_mmap:
+	close(fd);
+
+err_open:
+	return -1;
+}
+
+/** Writes the trace to its file, and frees it. Must be called once the cyclic task has stopped.
+ * \param trace		pointer to trace context
+ */
+void cyclic_trace_close(struct cyclic_trace *trace)
+{
+	unsigned long offset = 0;
+	ssize_t rc;
+
+	if (!trace->header)
+		return;
+
+	while (offset < trace->size) {
+		rc = write(trace->fd, (char *)trace->header + offset, trace->size - offset);
+		if (rc < 0) {
+			if (errno == EINTR)
+				continue;
+
+			ERR("trace file write failed: %s\n", strerror(errno));
+			break;
+		}
+
+		offset += rc;
+	}
+
+	close(trace->fd);
+
+	munmap(trace->header, trace->size);
+	trace->header = NULL;
+	trace->rec = NULL;
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2026 NXP
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*
+ * Per cycle trace of a cyclic task, for offline analysis of the cycle budget (e.g. with a growing number of peers).
+ *
+ * The trace holds a header followed by a ring of fixed size records, one per cycle. Once the ring is full the oldest
+ * records are overwritten: the last record written is at index (count - 1) % n_records, and the oldest valid one at
+ * count % n_records (or 0, if count < n_records).
+ * All fields are in host byte order, times in ns of the task clock.
+ *
+ * The ring is kept in locked anonymous memory while the task runs, so that the cyclic task never takes a page fault
+ * (e.g. on file writeback), and is written to the trace file when the task exits.
+ */
+
+#ifndef _CYCLIC_TRACE_H_
+#define _CYCLIC_TRACE_H_
+
+#include <stdint.h>
+
+#define CYCLIC_TRACE_MAGIC	0x54435943	/* "CYCT" */
+#define CYCLIC_TRACE_VERSION	1
+#define CYCLIC_TRACE_RECORDS	(1 << 16)	/* ~131 s at the default 2 ms period */
+
+struct cyclic_trace_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t record_size;
+	uint32_t n_records;	/* ring size */
+	uint32_t task_id;
+	uint32_t num_peers;
+	uint32_t period_ns;
+	uint32_t reserved;
+	uint64_t count;		/* records written since the start */
+};
+
+struct cyclic_trace_record {
+	uint64_t sched_time;	/* cycle scheduled time */
+	int32_t wake;		/* task wake up, relative to sched_time */
+	int32_t rx_done;	/* all peers received, relative to sched_time */
+	int32_t proc_done;	/* processing (task loop function) done, relative to sched_time */
+	int32_t tx_done;	/* last transmit done, relative to sched_time. 0 if no transmit in the cycle */
+	uint16_t rx_frames;	/* valid frames received */
+	uint16_t rx_batches;	/* batched receive rounds (more than one if stale frames were drained) */
+	uint32_t reserved;
+};
+
+struct cyclic_trace {
+	struct cyclic_trace_header *header;
+	struct cyclic_trace_record *rec;	/* record of the current cycle, NULL if none */
+	unsigned long size;
+	int fd;					/* trace file, written by cyclic_trace_close() */
+};
+
+int cyclic_trace_open(struct cyclic_trace *trace, const char *path, unsigned int task_id, unsigned int num_peers, unsigned int period_ns);
+void cyclic_trace_close(struct cyclic_trace *trace);
+
+/* Starts the record of a cycle */
+static inline struct cyclic_trace_record *cyclic_trace_begin(struct cyclic_trace *trace, uint64_t sched_time, uint64_t now)
+{
+	struct cyclic_trace_header *header = trace->header;
+	struct cyclic_trace_record *rec;
+
+	if (!header)
+		return NULL;
+
+	rec = (struct cyclic_trace_record *)(header + 1) + (header->count % header->n_records);
+
+	rec->sched_time = sched_time;
+	rec->wake = now - sched_time;
+	rec->rx_done = 0;
+	rec->proc_done = 0;
+	rec->tx_done = 0;
+	rec->rx_frames = 0;
+	rec->rx_batches = 0;
+
+	trace->rec = rec;
+
+	return rec;
+}
+
+/* Completes the record of a cycle */
+static inline void cyclic_trace_end(struct cyclic_trace *trace)
+{
+	if (!trace->rec)
+		return;
+
+	trace->header->count++;
+	trace->rec = NULL;
+}
+
+#endif /* _CYCLIC_TRACE_H_ */
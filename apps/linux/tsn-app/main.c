@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 NXP
+ * Copyright 2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -198,8 +198,9 @@ static void usage(void)
 	       "\t-r <role>          supported role: \"controller\", \"io_device_0\" or \"io_device_1\" (default: \"controller\")\n"
 	       "\t-s <sleep handler> supported sleep handlers: \"epoll\" or \"nanosleep\" (default: \"nanosleep\")\n"
 	       "\t-p <period>        task period in nanoseconds (default: 2000000 ns)\n"
-	       "\t-n <peers number>  number of IO devices (default: 1, only used if role is set to \"controller\"\n"
+	       "\t-n <peers number>  number of IO devices (default: 1, max: 2, only used if role is set to \"controller\"\n"
 	       "\t-f <file name>     pts file name (default: don't write pts file name, only used if mode is set to \"serial\")\n"
+	       "\t-t <file name>     per cycle trace file, binary ring of records written at exit (default: no trace)\n"
 		"\t-x                use AF_XDP sockets instead of standard raw sockets\n");
 };
 
@@ -227,7 +228,7 @@ int main(int argc, char *argv[])
 
 	//setlinebuf(stdout);
 
-	while ((option = getopt(argc, argv, "hf:m:p:r:n:s:x")) != -1) {
+	while ((option = getopt(argc, argv, "hf:m:p:r:n:s:t:x")) != -1) {
 		switch (option) {
 
 		case 'f':
@@ -288,6 +289,10 @@ int main(int argc, char *argv[])
 			}
 			break;
 
+		case 't':
+			cyclic_task_set_trace_file(optarg);
+			break;
+
 		case 'x':
 			flags = GENAVB_FLAGS_NET_XDP;
 			break;
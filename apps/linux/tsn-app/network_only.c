@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 NXP
+ * Copyright 2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -62,7 +62,7 @@ struct network_only_ctx *network_only_init(unsigned int role, unsigned int perio
 
 	if (c_task->type == CYCLIC_CONTROLLER) {
 		if (cyclic_task_set_num_peers(c_task, num_peers) < 0) {
-			ERR("cyclic_task_set_period() failed\n");
+			ERR("cyclic_task_set_num_peers() failed\n");
 			goto err_free;
 		}
 	}
@@ -1,5 +1,5 @@
 /*
- * Copyright 2021 NXP
+ * Copyright 2021, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -269,7 +269,7 @@ void opcua_init_params(struct cyclic_task *task)
 	for (i = 0; i < task->num_peers; i++)
 		opcua_update_dir(task->rx_socket[i].net_sock->dir, nid_net[i].direction);
 
-	opcua_update_dir(task->tx_socket.net_sock->dir, nid_net[2].direction);
+	opcua_update_dir(task->tx_socket.net_sock->dir, nid_net[MAX_RX_SOCKET].direction);
 }
 
 static void opcua_update_stats(struct stats *stats, struct stats_nid *nid)
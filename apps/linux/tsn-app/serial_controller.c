@@ -1,5 +1,5 @@
 /*
- * Copyright 2020 NXP
+ * Copyright 2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -218,7 +218,7 @@ struct serial_controller_ctx *serial_controller_init(unsigned int period_ns, uns
 #endif
 
 	if (cyclic_task_set_num_peers(c_task, num_peers) < 0) {
-		ERR("cyclic_task_set_period() failed\n");
+		ERR("cyclic_task_set_num_peers() failed\n");
 		goto err_free;
 	}
 
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2020 NXP
+ * Copyright 2019-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -22,12 +22,15 @@ void tsn_task_stats_init(struct tsn_task *task)
 {
 	stats_init(&task->stats.sched_err, 31, "sched err", NULL);
 	hist_init(&task->stats.sched_err_hist, 100, 10000);
+	hdr_hist_reset(&task->stats.sched_err_hdr);
 
 	stats_init(&task->stats.proc_time, 31, "processing time", NULL);
 	hist_init(&task->stats.proc_time_hist, 100, 1000);
+	hdr_hist_reset(&task->stats.proc_time_hdr);
 
 	stats_init(&task->stats.total_time, 31, "total time", NULL);
 	hist_init(&task->stats.total_time_hist, 100, 1000);
+	hdr_hist_reset(&task->stats.total_time_hdr);
 
 	task->stats.sched_err_max = 0;
 }
@@ -36,12 +39,15 @@ void tsn_task_stats_reset(struct tsn_task *task)
 {
 	stats_init(&task->stats.sched_err, 31, "sched err", NULL);
 	hist_reset(&task->stats.sched_err_hist);
+	hdr_hist_reset(&task->stats.sched_err_hdr);
 
 	stats_init(&task->stats.proc_time, 31, "processing time", NULL);
 	hist_reset(&task->stats.proc_time_hist);
+	hdr_hist_reset(&task->stats.proc_time_hdr);
 
 	stats_init(&task->stats.total_time, 31, "total time", NULL);
 	hist_reset(&task->stats.total_time_hist);
+	hdr_hist_reset(&task->stats.total_time_hdr);
 
 	task->stats.sched = 0;
 	task->stats.sched_early = 0;
@@ -77,6 +83,7 @@ void tsn_task_stats_start(struct tsn_task *task, int count, uint64_t now)
 
 		stats_update(&task->stats.sched_err, sched_err);
 		hist_update(&task->stats.sched_err_hist, sched_err);
+		hdr_hist_update(&task->stats.sched_err_hdr, sched_err);
 
 		if (sched_err > task->stats.sched_err_max)
 			task->stats.sched_err_max = sched_err;
@@ -100,9 +107,11 @@ void tsn_task_stats_end(struct tsn_task *task)
 
 		stats_update(&task->stats.proc_time, proc_time);
 		hist_update(&task->stats.proc_time_hist, proc_time);
+		hdr_hist_update(&task->stats.proc_time_hdr, proc_time);
 
 		stats_update(&task->stats.total_time, total_time);
 		hist_update(&task->stats.total_time_hist, total_time);
+		hdr_hist_update(&task->stats.total_time_hdr, total_time);
 	}
 }
 
@@ -126,12 +135,15 @@ void tsn_task_stats_print(struct tsn_task *task)
 
 		stats_print(&stats->sched_err);
 		hist_print(&stats->sched_err_hist);
+		hdr_hist_print(&stats->sched_err_hdr, "sched err");
 
 		stats_print(&stats->proc_time);
 		hist_print(&stats->proc_time_hist);
+		hdr_hist_print(&stats->proc_time_hdr, "processing time");
 
 		stats_print(&stats->total_time);
 		hist_print(&stats->total_time_hist);
+		hdr_hist_print(&stats->total_time_hdr, "total time");
 
 		stats->pending = false;
 
@@ -189,25 +201,34 @@ void tsn_stats_dump(struct tsn_task *task)
 		net_socket_stats_dump(&task->sock_tx[i]);
 }
 
-int tsn_net_receive_sock(struct net_socket *sock)
+/*
+ * Receives the next frame of each socket of the list, in a single batched zero-copy receive. On success (NET_OK status),
+ * the socket buffer points to the frame data, valid until the next receive on the same socket.
+ */
+void tsn_net_receive_batch(struct tsn_task *task, struct net_socket **sock, int *status, unsigned int n)
 {
-	struct tsn_task *task = container_of(sock, struct tsn_task, sock_rx[sock->id]);
-	int len;
-	int status;
-
-	len = genavb_socket_rx(sock->genavb_rx, sock->buf, task->params->rx_buf_size, &sock->ts);
-	if (len > 0) {
-		status = NET_OK;
-		sock->len = len;
-		sock->stats.frames++;
-	} else if (len == -GENAVB_ERR_SOCKET_AGAIN) {
-		status = NET_NO_FRAME;
-	} else {
-		status = NET_ERR;
-		sock->stats.err++;
+	struct genavb_socket_batch_rx rx[MAX_RX_SOCKET];
+	unsigned int i;
+
+	for (i = 0; i < n; i++)
+		rx[i].sock = sock[i]->genavb_rx;
+
+	genavb_socket_batch_receive(rx, n);
+
+	for (i = 0; i < n; i++) {
+		if ((rx[i].rc > 0) && (rx[i].rc <= task->params->rx_buf_size)) {
+			status[i] = NET_OK;
+			sock[i]->buf = rx[i].buf;
+			sock[i]->len = rx[i].rc;
+			sock[i]->ts = rx[i].ts;
+			sock[i]->stats.frames++;
+		} else if (rx[i].rc == -GENAVB_ERR_SOCKET_AGAIN) {
+			status[i] = NET_NO_FRAME;
+		} else {
+			status[i] = NET_ERR;
+			sock[i]->stats.err++;
+		}
 	}
-
-	return status;
 }
 
 int tsn_net_transmit_sock(struct net_socket *sock)
@@ -537,20 +558,13 @@ static int tsn_task_net_init(struct tsn_task *task)
 		sock->id = i;
 		sock->dir = RX;
 
-		rc = genavb_socket_rx_open(&sock->genavb_rx, GENAVB_SOCKF_NONBLOCK,
+		rc = genavb_socket_rx_open(&sock->genavb_rx, GENAVB_SOCKF_NONBLOCK | GENAVB_SOCKF_ZEROCOPY,
 					   &task->params->rx_params[i]);
 		if (rc != GENAVB_SUCCESS) {
 			ERR("genavb_socket_rx_open error: %s\n", genavb_strerror(rc));
 			goto close_sock_rx;
 		}
 
-		sock->buf = malloc(task->params->rx_buf_size);
-		if (!sock->buf) {
-			genavb_socket_rx_close(sock->genavb_rx);
-			ERR("error allocating rx_buff\n");
-			goto close_sock_rx;
-		}
-
 #ifdef SRP_RESERVATION
 		tsn_net_rx_srp_register(&task->params->rx_params[i]);
 #endif
@@ -601,7 +615,6 @@ close_sock_rx:
 #ifdef SRP_RESERVATION
 		tsn_net_rx_srp_deregister(&task->params->rx_params[k]);
 #endif
-		free(sock->buf);
 		genavb_socket_rx_close(sock->genavb_rx);
 	}
 
@@ -618,7 +631,6 @@ static void tsn_task_net_exit(struct tsn_task *task)
 #ifdef SRP_RESERVATION
 		tsn_net_rx_srp_deregister(&task->params->rx_params[i]);
 #endif
-		free(sock->buf);
 		genavb_socket_rx_close(sock->genavb_rx);
 	}
 
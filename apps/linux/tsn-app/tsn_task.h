@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2020 NXP
+ * Copyright 2019-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -14,7 +14,7 @@
 #include <genavb/clock.h>
 #include <genavb/socket.h>
 
-#define MAX_RX_SOCKET 2
+#define MAX_RX_SOCKET 16
 #define MAX_TX_SOCKET 2
 
 #define RX 0
@@ -59,10 +59,13 @@ struct net_socket_stats {
 struct tsn_task_stats {
 	struct stats sched_err;
 	struct hist sched_err_hist;
+	struct hdr_hist sched_err_hdr;
 	struct stats proc_time;
 	struct hist proc_time_hist;
+	struct hdr_hist proc_time_hdr;
 	struct stats total_time;
 	struct hist total_time_hist;
+	struct hdr_hist total_time_hdr;
 	bool stats_valid;
 	unsigned int sched;
 	unsigned int sched_early;
@@ -82,7 +85,7 @@ struct net_socket {
 		struct genavb_socket_rx *genavb_rx;
 		struct genavb_socket_tx *genavb_tx;
 	};
-	void *buf;
+	void *buf;		/* rx: last frame received, in the stack receive buffer (zero-copy) */
 	int len;
 	uint64_t ts;
 
@@ -153,7 +156,7 @@ void tsn_task_stop(struct tsn_task *task);
 int tsn_net_receive_set_cb(struct net_socket *sock,
 			   void (*net_rx_cb)(void *));
 int tsn_net_receive_enable_cb(struct net_socket *sock);
-int tsn_net_receive_sock(struct net_socket *sock);
+void tsn_net_receive_batch(struct tsn_task *task, struct net_socket **sock, int *status, unsigned int n);
 int tsn_net_transmit_sock(struct net_socket *sock);
 void tsn_stats_dump(struct tsn_task *task);
 void tsn_task_stats_start(struct tsn_task *task, int count, uint64_t now);
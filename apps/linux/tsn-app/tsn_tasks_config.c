@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2020 NXP
+ * Copyright 2019-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -82,6 +82,7 @@ struct cyclic_task cyclic_tasks[MAX_TASK_CONFIGS] = {
 		.id = CONTROLLER_0,
 		.params = CYCLIC_TASK_DEFAULT_PARAMS(0),
 		.num_peers = 1,
+		.max_peers = 2,
 		.rx_socket = {
 			[0] = {
 				.peer_id = IO_DEVICE_0,
@@ -101,6 +102,7 @@ struct cyclic_task cyclic_tasks[MAX_TASK_CONFIGS] = {
 		.id = IO_DEVICE_0,
 		.params = CYCLIC_TASK_DEFAULT_PARAMS(NET_DELAY_OFFSET),
 		.num_peers = 1,
+		.max_peers = 1,
 		.rx_socket = {
 			[0] = {
 				.peer_id = CONTROLLER_0,
@@ -116,6 +118,7 @@ struct cyclic_task cyclic_tasks[MAX_TASK_CONFIGS] = {
 		.id = IO_DEVICE_1,
 		.params = CYCLIC_TASK_DEFAULT_PARAMS(NET_DELAY_OFFSET),
 		.num_peers = 1,
+		.max_peers = 1,
 		.rx_socket = {
 			[0] = {
 				.peer_id = CONTROLLER_0,
@@ -1,5 +1,5 @@
 /*
- * Copyright 2019-2020 NXP
+ * Copyright 2019-2020, 2026 NXP
  *
  * SPDX-License-Identifier: BSD-3-Clause
  */
@@ -10,7 +10,7 @@
 #include "genavb/tsn.h"
 #include "genavb/qos.h"
 
-#define MAX_PEERS	   2
+#define MAX_PEERS	   16	/* up to MAX_RX_SOCKET, peers actually usable are limited by the task configuration (max_peers) */
 #define MAX_TASK_CONFIGS   4
 #define MAX_TSN_STREAMS	   8
 #define ETHERTYPE_MOTOROLA 0x818D
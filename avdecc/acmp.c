@@ -1023,7 +1023,7 @@ __init unsigned int acmp_data_size(struct avdecc_entity_config *cfg)
 	if (!cfg->milan_mode)
 		return acmp_ieee_data_size(cfg);
 	else
-		return 0;
+		return acmp_milan_data_size(cfg);
 }
 
 __init int acmp_init(struct acmp_ctx *acmp, void *data, struct avdecc_entity_config *cfg)
@@ -1054,7 +1054,7 @@ __init int acmp_init(struct acmp_ctx *acmp, void *data, struct avdecc_entity_con
 	if (!avdecc->milan_mode)
 		rc = acmp_ieee_init(acmp, data, cfg);
 	else
-		rc = acmp_milan_init(acmp);
+		rc = acmp_milan_init(acmp, data);
 
 	if (rc < 0)
 		goto exit;
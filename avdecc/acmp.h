@@ -32,6 +32,11 @@ struct acmp_ctx {
 			struct talker_stream_info *talker_info;     /* AVDECC 1722.1 use: array of talkers stream information */
 			unsigned int max_listener_pairs;            /* AVDECC 1722.1 use: Maximum number of connected listeners per talker */
 		} ieee;
+
+		struct {
+			struct acmp_milan_stream_id_index listener_index; /* MILAN use: stream ID to listener unique ID index */
+			struct acmp_milan_stream_id_index talker_index;   /* MILAN use: stream ID to talker unique ID index */
+		} milan;
 	} u;
 };
 
@@ -1,5 +1,5 @@
 /*
-* Copyright 2021-2023 NXP
+* Copyright 2021-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -43,11 +43,9 @@
 #define ACMP_MILAN_TALKER_TMR_SRP_WITHDRAW_GRANULARITY_MS	100
 
 #define ACMP_MILAN_TALKER_ASYNC_UNSOLICITED_NOTIFICATION_MS			1000 /* 1 second timer */
-#define ACMP_MILAN_TALKER_ASYNC_UNSOLICITED_NOTIFICATION_GRANULARITY_MS	100
 
 /* Listener's unsolicited notification timer should be lower than all the timers in the listener state machines so we don't miss any states changes */
 #define ACMP_MILAN_LISTENER_ASYNC_UNSOLICITED_NOTIFICATION_MS			100 /* 100ms timer */
-#define ACMP_MILAN_LISTENER_ASYNC_UNSOLICITED_NOTIFICATION_GRANULARITY_MS	10
 
 #define acmp_milan_listener_sink_srp_state_clear(stream_input_dynamic) \
 		acmp_milan_set_stream_input_srp_params((stream_input_dynamic), NULL); \
@@ -193,8 +191,7 @@ int acmp_milan_get_command_timeout_ms(acmp_message_type_t msg_type)
  */
 static void acmp_milan_listener_register_async_get_stream_info_notification(struct stream_input_dynamic_desc *stream_input_dynamic)
 {
-	if (!timer_is_running(&stream_input_dynamic->u.milan.async_unsolicited_notification_timer))
-		timer_start(&stream_input_dynamic->u.milan.async_unsolicited_notification_timer, ACMP_MILAN_LISTENER_ASYNC_UNSOLICITED_NOTIFICATION_MS);
+	aecp_async_notification_schedule(&stream_input_dynamic->u.milan.async_notification);
 }
 
 /** Send unbind message through the media stack ipc channel
@@ -303,6 +300,87 @@ static void acmp_milan_set_stream_input_binding_params(struct stream_input_dynam
 	}
 }
 
+static unsigned int acmp_milan_stream_id_hash(u64 stream_id)
+{
+	return rotating_hash_u8((u8 *)&stream_id, sizeof(stream_id), 0) & (ACMP_MILAN_STREAM_ID_HASH_SIZE - 1);
+}
+
+static void acmp_milan_stream_id_index_init(struct acmp_milan_stream_id_index *index, u16 *next, unsigned int max_streams)
+{
+	int i;
+
+	index->next = next;
+
+	for (i = 0; i < ACMP_MILAN_STREAM_ID_HASH_SIZE; i++)
+		index->head[i] = ACMP_MILAN_UNIQUE_ID_NONE;
+
+	for (i = 0; i < max_streams; i++)
+		index->next[i] = ACMP_MILAN_UNIQUE_ID_NONE;
+}
+
+static void acmp_milan_stream_id_index_add(struct acmp_milan_stream_id_index *index, u16 unique_id, u64 stream_id)
+{
+	unsigned int bucket = acmp_milan_stream_id_hash(stream_id);
+
+	index->next[unique_id] = index->head[bucket];
+	index->head[bucket] = unique_id;
+}
+
+static void acmp_milan_stream_id_index_del(struct acmp_milan_stream_id_index *index, u16 unique_id, u64 stream_id)
+{
+	u16 *cur = &index->head[acmp_milan_stream_id_hash(stream_id)];
+
+	while (*cur != ACMP_MILAN_UNIQUE_ID_NONE) {
+		if (*cur == unique_id) {
+			*cur = index->next[unique_id];
+			index->next[unique_id] = ACMP_MILAN_UNIQUE_ID_NONE;
+			break;
+		}
+
+		cur = &index->next[*cur];
+	}
+}
+
+/** Lookup the unique ID of the stream matching the stream ID.
+ * If several streams share the same stream ID, the lowest unique ID is returned (same as a linear scan).
+ * \return                     0 on success, negative otherwise
+ * \param      entity          pointer to entity struct
+ * \param      index           pointer to the stream ID index to search
+ * \param      desc_type       stream descriptor type (AEM_DESC_TYPE_STREAM_INPUT or AEM_DESC_TYPE_STREAM_OUTPUT)
+ * \param      stream_id       stream ID (in network order)
+ * \param[out] unique_id       pointer to variable holding the matching unique ID on success.
+ */
+static int acmp_milan_stream_id_index_lookup(struct entity *entity, struct acmp_milan_stream_id_index *index, u16 desc_type, u64 stream_id, u16 *unique_id)
+{
+	u16 cur = index->head[acmp_milan_stream_id_hash(stream_id)];
+	u16 found = ACMP_MILAN_UNIQUE_ID_NONE;
+	void *desc;
+	u64 *desc_stream_id;
+
+	while (cur != ACMP_MILAN_UNIQUE_ID_NONE) {
+		desc = aem_get_descriptor(entity->aem_dynamic_descs, desc_type, cur, NULL);
+		if (!desc)
+			break;
+
+		if (desc_type == AEM_DESC_TYPE_STREAM_INPUT)
+			desc_stream_id = &((struct stream_input_dynamic_desc *)desc)->stream_id;
+		else
+			desc_stream_id = &((struct stream_output_dynamic_desc *)desc)->stream_id;
+
+		if (cmp_64(desc_stream_id, &stream_id) && (cur < found))
+			found = cur;
+
+		cur = index->next[cur];
+	}
+
+	if (found == ACMP_MILAN_UNIQUE_ID_NONE || !unique_id)
+		return -1;
+
+	*unique_id = found;
+
+	return 0;
+}
+
 /* Per AVNU.IO.CONTRONL v1.1a - Corrigendum 1: When already bound, restart binding process only
  * if talker_entity_id and talker_unique_id fields are not equal to those saved for the current binding
  */
@@ -317,8 +395,12 @@ static bool acmp_milan_need_binding_restart(struct stream_input_dynamic_desc *st
 
 static void acmp_milan_set_stream_input_srp_params(struct stream_input_dynamic_desc *stream_input_dynamic, struct acmp_pdu *pdu)
 {
+	struct acmp_milan_stream_id_index *index = &stream_input_dynamic->u.milan.entity->acmp.u.milan.listener_index;
+	u16 unique_id = stream_input_dynamic->u.milan.unique_id;
 	u8 invalid_stream_dest_mac[6] = {0};
 
+	acmp_milan_stream_id_index_del(index, unique_id, get_64(&stream_input_dynamic->stream_id));
+
 	if (!pdu) {
 		stream_input_dynamic->stream_vlan_id = 0;
 		stream_input_dynamic->stream_id = 0;
@@ -329,6 +411,8 @@ static void acmp_milan_set_stream_input_srp_params(struct stream_input_dynamic_d
 		os_memcpy(stream_input_dynamic->stream_dest_mac, pdu->stream_dest_mac, 6);
 	}
 
+	acmp_milan_stream_id_index_add(index, unique_id, get_64(&stream_input_dynamic->stream_id));
+
 	/* Register send of an asynchronous GET_STREAM_INFO unsolicited notification per AVNU.IO.CONTROL 7.5.2
 	 * to notify changes in the STREAM_INPUT descriptor state (stream_id, stream_dest_mac, stream_vlan_id)
 	 */
@@ -522,14 +606,6 @@ static void acmp_listener_sink_tk_timer_handler(void *data)
 	acmp_milan_listener_sink_event(stream_input_dynamic->u.milan.entity, stream_input_dynamic->u.milan.unique_id, ACMP_LISTENER_SINK_SM_EVENT_TMR_NO_TK);
 }
 
-static void acmp_milan_listener_async_unsolicited_notification_timer_handler(void *data)
-{
-	struct stream_input_dynamic_desc *stream_input_dynamic = (struct stream_input_dynamic_desc *)data;
-	struct entity *entity = stream_input_dynamic->u.milan.entity;
-
-	aecp_aem_send_async_unsolicited_notification(&entity->aecp, AECP_AEM_CMD_GET_STREAM_INFO, AEM_DESC_TYPE_STREAM_INPUT, stream_input_dynamic->u.milan.unique_id);
-}
-
 __init static int acmp_milan_listener_sink_init_timers(struct entity *entity, u16 listener_unique_id)
 {
 	struct stream_input_dynamic_desc *stream_input_dynamic = aem_get_descriptor(entity->aem_dynamic_descs,
@@ -553,11 +629,9 @@ __init static int acmp_milan_listener_sink_init_timers(struct entity *entity, u1
 	if (timer_create(entity->avdecc->timer_ctx, &stream_input_dynamic->u.milan.acmp_talker_registration_timer, 0, ACMP_MILAN_LISTENER_TMR_NO_TK_GRANULARITY_MS) < 0)
 		goto err_tk_timer;
 
-	stream_input_dynamic->u.milan.async_unsolicited_notification_timer.func = acmp_milan_listener_async_unsolicited_notification_timer_handler;
-	stream_input_dynamic->u.milan.async_unsolicited_notification_timer.data = stream_input_dynamic;
-
-	if (timer_create(entity->avdecc->timer_ctx, &stream_input_dynamic->u.milan.async_unsolicited_notification_timer, 0,
-				ACMP_MILAN_LISTENER_ASYNC_UNSOLICITED_NOTIFICATION_GRANULARITY_MS) < 0)
+	if (aecp_async_notification_init(&entity->aecp, &stream_input_dynamic->u.milan.async_notification, AECP_AEM_CMD_GET_STREAM_INFO,
+				AEM_DESC_TYPE_STREAM_INPUT, listener_unique_id,
+				ACMP_MILAN_LISTENER_ASYNC_UNSOLICITED_NOTIFICATION_MS) < 0)
 		goto err_notification_timer;
 
 	return 0;
@@ -583,7 +657,7 @@ __exit static void acmp_milan_listener_sink_exit_timers(struct entity *entity, u
 	timer_destroy(&stream_input_dynamic->u.milan.acmp_retry_timer);
 	timer_destroy(&stream_input_dynamic->u.milan.acmp_delay_timer);
 	timer_destroy(&stream_input_dynamic->u.milan.acmp_talker_registration_timer);
-	timer_destroy(&stream_input_dynamic->u.milan.async_unsolicited_notification_timer);
+	aecp_async_notification_exit(&stream_input_dynamic->u.milan.async_notification);
 }
 
 /** Helper function to check if a stream input or output is running
@@ -704,23 +778,8 @@ exit:
  */
 int acmp_milan_get_listener_unique_id(struct entity *entity, u64 stream_id, u16 *listener_unique_id)
 {
-	int i;
-	int rc = -1;
-	struct acmp_ctx *acmp = &entity->acmp;
-	struct stream_input_dynamic_desc *stream_input_dynamic;
-
-	for (i = 0; i < acmp->max_listener_streams; i++) {
-		stream_input_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_INPUT, i, NULL);
-
-		if (cmp_64(&stream_input_dynamic->stream_id, &stream_id) && listener_unique_id) {
-			*listener_unique_id = i;
-			rc = 0;
-			goto exit;
-		}
-	}
-
-exit:
-	return rc;
+	return acmp_milan_stream_id_index_lookup(entity, &entity->acmp.u.milan.listener_index, AEM_DESC_TYPE_STREAM_INPUT,
+						 stream_id, listener_unique_id);
 }
 
 /** Main SRP state machine for a listener sink.
@@ -1482,8 +1541,7 @@ err:
  */
 static void acmp_milan_talker_register_async_get_stream_info_notification(struct stream_output_dynamic_desc *stream_output_dynamic)
 {
-	if (!timer_is_running(&stream_output_dynamic->u.milan.async_unsolicited_notification_timer))
-		timer_start(&stream_output_dynamic->u.milan.async_unsolicited_notification_timer, ACMP_MILAN_TALKER_ASYNC_UNSOLICITED_NOTIFICATION_MS);
+	aecp_async_notification_schedule(&stream_output_dynamic->u.milan.async_notification);
 }
 
 /** Get a talker index matching the stream ID
@@ -1494,20 +1552,28 @@ static void acmp_milan_talker_register_async_get_stream_info_notification(struct
  */
 int acmp_milan_get_talker_unique_id(struct entity *entity, u64 stream_id, u16 *talker_unique_id)
 {
-	int i;
-	struct acmp_ctx *acmp = &entity->acmp;
-	struct stream_output_dynamic_desc *stream_output_dynamic;
+	return acmp_milan_stream_id_index_lookup(entity, &entity->acmp.u.milan.talker_index, AEM_DESC_TYPE_STREAM_OUTPUT,
+						 stream_id, talker_unique_id);
+}
 
-	for (i = 0; i < acmp->max_talker_streams; i++) {
-		stream_output_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_OUTPUT, i, NULL);
-		if (cmp_64(&stream_output_dynamic->stream_id, &stream_id) && talker_unique_id) {
+/** Update a talker stream ID, keeping the stream ID index in sync.
+ * \return                             none
+ * \param      entity                  pointer to entity struct
+ * \param      talker_unique_id        talker index (host order)
+ * \param      stream_id               new stream ID (in network order)
+ */
+void acmp_milan_talker_set_stream_id(struct entity *entity, u16 talker_unique_id, u64 stream_id)
+{
+	struct acmp_milan_stream_id_index *index = &entity->acmp.u.milan.talker_index;
+	struct stream_output_dynamic_desc *stream_output_dynamic;
 
-			*talker_unique_id = i;
-			return 0;
-		}
-	}
+	stream_output_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_OUTPUT, talker_unique_id, NULL);
+	if (!stream_output_dynamic)
+		return;
 
-	return -1;
+	acmp_milan_stream_id_index_del(index, talker_unique_id, get_64(&stream_output_dynamic->stream_id));
+	copy_64(&stream_output_dynamic->stream_id, &stream_id);
+	acmp_milan_stream_id_index_add(index, talker_unique_id, stream_id);
 }
 
 /** Perform SRP and AVTP talker connection if not already connected.
@@ -1844,6 +1910,8 @@ exit:
 }
 
 /** Starts the MAAP address allocation for all talkers in the entity.
+ * Consecutive talkers on the same interface are allocated with a single request, their ranges share one MAAP
+ * probe/announce sequence.
  * \return              0 on success, negative otherwise.
  * \param      entity   pointer to entity struct
  */
@@ -1854,26 +1922,42 @@ int acmp_milan_talkers_maap_start(struct entity *entity)
 	struct acmp_ctx *acmp = &entity->acmp;
 	struct stream_descriptor *stream_output;
 	struct ipc_desc *desc;
-	int i, rc = 0;
+	u16 port_id;
+	int i, j, n, rc = 0;
+
+	for (i = 0; i < acmp->max_talker_streams; i += n) {
+		n = 1;
 
-	for (i = 0; i < acmp->max_talker_streams; i++) {
 		stream_output_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_OUTPUT, i, NULL);
 
 		if (stream_output_dynamic->u.milan.maap_started)
 			continue;
 
 		stream_output = aem_get_descriptor(entity->aem_descs, AEM_DESC_TYPE_STREAM_OUTPUT, i, NULL);
+		port_id = ntohs(stream_output->avb_interface_index);
+
+		/* Group the following talkers on the same interface */
+		while (((i + n) < acmp->max_talker_streams) && (n < MAAP_CREATE_RANGES_MAX)) {
+			stream_output_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_OUTPUT, i + n, NULL);
+			stream_output = aem_get_descriptor(entity->aem_descs, AEM_DESC_TYPE_STREAM_OUTPUT, i + n, NULL);
 
-		desc = ipc_alloc(&avdecc->ipc_tx_maap, sizeof(struct genavb_msg_maap_create));
+			if (stream_output_dynamic->u.milan.maap_started || (ntohs(stream_output->avb_interface_index) != port_id))
+				break;
+
+			n++;
+		}
+
+		desc = ipc_alloc(&avdecc->ipc_tx_maap, sizeof(struct genavb_msg_maap_create_ranges));
 		if (desc) {
-			desc->type = GENAVB_MSG_MAAP_CREATE_RANGE;
-			desc->len = sizeof(struct genavb_msg_maap_create);
+			desc->type = GENAVB_MSG_MAAP_CREATE_RANGES;
+			desc->len = sizeof(struct genavb_msg_maap_create_ranges);
 			desc->flags = 0;
 
-			desc->u.maap_create.flag = 0;
-			desc->u.maap_create.port_id = ntohs(stream_output->avb_interface_index);
-			desc->u.maap_create.range_id = CFG_ACMP_DEFAULT_MAAP_BASE_RANGE_ID + i;
-			desc->u.maap_create.count = CFG_ACMP_DEFAULT_MAAP_COUNT_PER_RANGE;
+			desc->u.maap_create_ranges.flag = 0;
+			desc->u.maap_create_ranges.port_id = port_id;
+			desc->u.maap_create_ranges.range_id = CFG_ACMP_DEFAULT_MAAP_BASE_RANGE_ID + i;
+			desc->u.maap_create_ranges.n_ranges = n;
+			desc->u.maap_create_ranges.count = CFG_ACMP_DEFAULT_MAAP_COUNT_PER_RANGE;
 
 			rc = ipc_tx(&avdecc->ipc_tx_maap, desc);
 			if (rc < 0) {
@@ -1883,7 +1967,10 @@ int acmp_milan_talkers_maap_start(struct entity *entity)
 				goto exit;
 			}
 
-			stream_output_dynamic->u.milan.maap_started = true;
+			for (j = i; j < (i + n); j++) {
+				stream_output_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_OUTPUT, j, NULL);
+				stream_output_dynamic->u.milan.maap_started = true;
+			}
 		} else {
 			os_log(LOG_ERR, "ipc_alloc() failed\n");
 			rc = -1;
@@ -2031,14 +2118,6 @@ static void acmp_talker_probe_tx_reception_timer_handler(void *data)
 	acmp_milan_talker_update(entity, stream_output_dynamic->u.milan.unique_id);
 }
 
-static void acmp_milan_talker_async_unsolicited_notification_timer_handler(void *data)
-{
-	struct stream_output_dynamic_desc *stream_output_dynamic = (struct stream_output_dynamic_desc *)data;
-	struct entity *entity = stream_output_dynamic->u.milan.entity;
-
-	aecp_aem_send_async_unsolicited_notification(&entity->aecp, AECP_AEM_CMD_GET_STREAM_INFO, AEM_DESC_TYPE_STREAM_OUTPUT, stream_output_dynamic->u.milan.unique_id);
-}
-
 __init static int acmp_milan_talker_init_timers(struct entity *entity, u16 talker_unique_id)
 {
 	struct stream_output_dynamic_desc *stream_output_dynamic = aem_get_descriptor(entity->aem_dynamic_descs,
@@ -2059,11 +2138,9 @@ __init static int acmp_milan_talker_init_timers(struct entity *entity, u16 talke
 				ACMP_MILAN_TALKER_TMR_SRP_WITHDRAW_GRANULARITY_MS) < 0)
 		goto err_srp_talker_withdraw_timer;
 
-	stream_output_dynamic->u.milan.async_unsolicited_notification_timer.func = acmp_milan_talker_async_unsolicited_notification_timer_handler;
-	stream_output_dynamic->u.milan.async_unsolicited_notification_timer.data = stream_output_dynamic;
-
-	if (timer_create(entity->avdecc->timer_ctx, &stream_output_dynamic->u.milan.async_unsolicited_notification_timer, 0,
-				ACMP_MILAN_TALKER_ASYNC_UNSOLICITED_NOTIFICATION_GRANULARITY_MS) < 0)
+	if (aecp_async_notification_init(&entity->aecp, &stream_output_dynamic->u.milan.async_notification, AECP_AEM_CMD_GET_STREAM_INFO,
+				AEM_DESC_TYPE_STREAM_OUTPUT, talker_unique_id,
+				ACMP_MILAN_TALKER_ASYNC_UNSOLICITED_NOTIFICATION_MS) < 0)
 		goto err_notification_timer;
 
 	return 0;
@@ -2083,18 +2160,39 @@ __exit static void acmp_milan_talker_exit_timers(struct entity *entity, u16 talk
 
 	timer_destroy(&stream_output_dynamic->u.milan.probe_tx_reception_timer);
 	timer_destroy(&stream_output_dynamic->u.milan.srp_talker_withdraw_timer);
-	timer_destroy(&stream_output_dynamic->u.milan.async_unsolicited_notification_timer);
+	aecp_async_notification_exit(&stream_output_dynamic->u.milan.async_notification);
+}
+
+__init unsigned int acmp_milan_data_size(struct avdecc_entity_config *cfg)
+{
+	return (cfg->max_listener_streams + cfg->max_talker_streams) * sizeof(u16);
 }
 
-__init int acmp_milan_init(struct acmp_ctx *acmp)
+__init int acmp_milan_init(struct acmp_ctx *acmp, void *data)
 {
 	struct entity *entity = container_of(acmp, struct entity, acmp);
 	struct stream_input_dynamic_desc *stream_input_dynamic;
 	struct stream_output_dynamic_desc *stream_output_dynamic;
 	struct stream_descriptor *stream_output;
 	struct avb_interface_descriptor *avb_itf;
+	u64 stream_id;
 	int i, j;
 
+	if (!data && (acmp->max_listener_streams || acmp->max_talker_streams)) {
+		os_log(LOG_ERR, "acmp(%p) No allocated memory for stream ID index\n", acmp);
+		return -1;
+	}
+
+	acmp_milan_stream_id_index_init(&acmp->u.milan.listener_index, (u16 *)data, acmp->max_listener_streams);
+	acmp_milan_stream_id_index_init(&acmp->u.milan.talker_index, (u16 *)data + acmp->max_listener_streams, acmp->max_talker_streams);
+
+	/* Dynamic descriptors are zero initialized, index all the streams with a null stream ID */
+	for (i = 0; i < acmp->max_listener_streams; i++)
+		acmp_milan_stream_id_index_add(&acmp->u.milan.listener_index, i, 0);
+
+	for (j = 0; j < acmp->max_talker_streams; j++)
+		acmp_milan_stream_id_index_add(&acmp->u.milan.talker_index, j, 0);
+
 	for (i = 0; i < acmp->max_listener_streams; i++) {
 		stream_input_dynamic = aem_get_descriptor(entity->aem_dynamic_descs, AEM_DESC_TYPE_STREAM_INPUT, i, NULL);
 		if (!stream_input_dynamic) {
@@ -2153,9 +2251,10 @@ __init int acmp_milan_init(struct acmp_ctx *acmp)
 			goto err_talkers_init;
 		}
 
-		os_memset(&stream_output_dynamic->stream_id, 0, sizeof(stream_output_dynamic->stream_id));
-		os_memcpy(&stream_output_dynamic->stream_id, avb_itf->mac_address, 6);
-		*(((u16 *)&stream_output_dynamic->stream_id) + 3) = stream_output->descriptor_index;
+		stream_id = 0;
+		os_memcpy(&stream_id, avb_itf->mac_address, 6);
+		*(((u16 *)&stream_id) + 3) = stream_output->descriptor_index;
+		acmp_milan_talker_set_stream_id(entity, j, stream_id);
 
 		stream_output_dynamic->u.milan.srp_talker_withdraw_in_progress = false;
 		stream_output_dynamic->u.milan.talker_stack_connected = false;
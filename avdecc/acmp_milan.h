@@ -62,19 +62,34 @@ typedef enum{
 #define ACMP_MILAN_IS_LISTENER_SINK_SETTLED(stream_input_dynamic) (((stream_input_dynamic)->u.milan.state == ACMP_LISTENER_SINK_SM_STATE_SETTLED_NO_RSV) || \
 									((stream_input_dynamic)->u.milan.state == ACMP_LISTENER_SINK_SM_STATE_SETTLED_RSV_OK))
 
+#define ACMP_MILAN_STREAM_ID_HASH_SIZE	64	/* Must be a power of 2 */
+#define ACMP_MILAN_UNIQUE_ID_NONE	0xffff
+
+/* Stream ID to unique ID index, used to resolve SRP indications without walking all the stream descriptors.
+ * Each bucket is a singly linked list of unique IDs, chained through the next array (one entry per stream).
+ * The stream ID itself is not duplicated here, it is always read back from the stream dynamic descriptor.
+ */
+struct acmp_milan_stream_id_index {
+	u16 head[ACMP_MILAN_STREAM_ID_HASH_SIZE];
+	u16 *next;
+};
+
 struct avdecc_ctx;
 struct acmp_ctx;
 struct entity;
+struct avdecc_entity_config;
 
 int acmp_milan_talker_rcv(struct acmp_ctx *acmp, struct acmp_pdu *pdu, u8 msg_type, u8 status, unsigned int port_id);
 int acmp_milan_listener_sink_event(struct entity *entity, u16 listener_unique_id, acmp_milan_listener_sink_sm_event_t event);
 int acmp_milan_listener_rcv(struct acmp_ctx *acmp, struct acmp_pdu *pdu, u8 msg_type, u8 status, unsigned int port_id);
 int acmp_milan_get_listener_unique_id(struct entity *entity, u64 stream_id, u16 *listener_unique_id);
 int acmp_milan_get_talker_unique_id(struct entity *entity, u64 stream_id, u16 *talker_unique_id);
+void acmp_milan_talker_set_stream_id(struct entity *entity, u16 talker_unique_id, u64 stream_id);
 void acmp_milan_listener_srp_state_sm(struct entity *entity, u16 listener_unique_id, struct genavb_msg_listener_status *ipc_listener_status);
 void acmp_milan_talker_update_status(struct entity *entity, u16 talker_unique_id, struct genavb_msg_talker_status *ipc_talker_status);
 void acmp_milan_talker_update_declaration(struct entity *entity, u16 talker_unique_id, struct genavb_msg_talker_declaration_status *ipc_talker_declaration_status);
-int acmp_milan_init(struct acmp_ctx *acmp);
+unsigned int acmp_milan_data_size(struct avdecc_entity_config *cfg);
+int acmp_milan_init(struct acmp_ctx *acmp, void *data);
 int acmp_milan_exit(struct acmp_ctx *acmp);
 int acmp_milan_get_command_timeout_ms(acmp_message_type_t msg_type);
 bool acmp_milan_is_stream_running(struct entity *entity, u16 stream_desc_type, u16 stream_desc_index);
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -389,6 +389,11 @@ static void inline adp_discovery_put(struct entity_discovery *entity_disc)
 				acmp_ieee_listener_talker_left(&avdecc->entities[i]->acmp, entity_disc->info.entity_id);
 	}
 
+	/* Departed (or power-cycled) entity, cached descriptors can no longer be trusted */
+	entity = avdecc_get_local_controller_any(avdecc);
+	if (entity)
+		aecp_descriptor_cache_invalidate_entity(&entity->aecp, entity_disc->info.entity_id);
+
 	entity_disc->in_use = 0;
 	entity_disc->disc->num_discovered_entities--;
 	os_memset(&entity_disc->info, 0 , sizeof(struct entity_info));
@@ -399,6 +404,7 @@ static void adp_discovery_update_entity(struct adp_discovery_ctx *disc, struct e
 	struct avdecc_port *port = discovery_to_avdecc_port(disc);
 	struct avdecc_ctx *avdecc = avdecc_port_to_context(port);
 	struct entity *entity = avdecc_get_local_controller(avdecc, port->port_id);
+	struct entity *cache_entity = avdecc_get_local_controller_any(avdecc); /* Descriptor cache owner, see avdecc_ipc_rx_controller() */
 	bool send_ipc = false;
 
 	if ((info->entity_id != pdu->entity_id) ||
@@ -419,8 +425,15 @@ static void adp_discovery_update_entity(struct adp_discovery_ctx *disc, struct e
 		/* The discovered entity has changed, notify the controller if existing. */
 		if (entity)
 			send_ipc = true;
+
+		/* The ENTITY descriptor mirrors most of the advertised fields */
+		if (cache_entity)
+			aecp_descriptor_cache_invalidate(&cache_entity->aecp, pdu->entity_id, htons(AEM_DESC_TYPE_ENTITY), 0);
 	}
 
+	if (cache_entity && (info->available_index != pdu->available_index))
+		aecp_descriptor_cache_set_available_index(&cache_entity->aecp, pdu->entity_id, pdu->available_index);
+
 	info->entity_id = pdu->entity_id;
 	info->entity_model_id = pdu->entity_model_id;
 	info->entity_capabilities = pdu->entity_capabilities;
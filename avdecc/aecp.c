@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2023 NXP
+* Copyright 2020-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -198,6 +198,7 @@ __init static void aecp_unsolicited_init(struct aecp_ctx *aecp)
 	for (i = 0; i < aecp->max_unsolicited_registrations; i++) {
 		list_add(&aecp->free_unsolicited, &aecp->unsolicited_storage[i].list);
 		os_memset(aecp->unsolicited_storage[i].mac_dst, 0, 6);
+		aecp->unsolicited_storage[i].stats_export = NULL;
 	}
 
 	os_log(LOG_INIT, "aecp(%p) %d unsolicited registration max\n", aecp, aecp->max_unsolicited_registrations);
@@ -229,6 +230,59 @@ static struct unsolicited_ctx *aecp_unsolicited_find(struct aecp_ctx *aecp, u64
 }
 
 
+static const char * const aecp_controller_counter_names[] = {
+	"NotificationsSent",
+	"NotificationsFailed",
+};
+
+#define AECP_CONTROLLER_COUNTERS	(sizeof(aecp_controller_counter_names) / sizeof(char *))
+
+static const char * const aecp_entity_counter_names[] = {
+	"RegisteredControllers",
+	"NotificationsSent",
+	"NotificationsFailed",
+	"AsyncNotificationsSent",
+	"AsyncNotificationsCoalesced",
+	"DescriptorCacheHits",
+	"DescriptorCacheMisses",
+};
+
+#define AECP_ENTITY_COUNTERS	(sizeof(aecp_entity_counter_names) / sizeof(char *))
+
+/** Allocates the statistics region section of a controller registered for unsolicited notifications.
+ * \return	none
+ * \param aecp	AECP context of the entity
+ * \param entry	unsolicited entry of the controller
+ */
+static void aecp_unsolicited_stats_export_alloc(struct aecp_ctx *aecp, struct unsolicited_ctx *entry)
+{
+	struct entity *entity = container_of(aecp, struct entity, aecp);
+	struct stats_export_id id = {
+		.name = "aecp_controller",
+		.label = {
+			{ .name = "entity_id", .flags = STATS_EXPORT_LABEL_HEX },
+			{ .name = "controller_id", .flags = STATS_EXPORT_LABEL_HEX },
+		},
+		.n_labels = 2,
+	};
+
+	if (!aecp->stats_export)
+		return;
+
+	id.label[0].value = ntohll(entity->desc->entity_id);
+	id.label[1].value = ntohll(entry->controller_id);
+
+	entry->stats_export = stats_export_alloc(&id, aecp_controller_counter_names, AECP_CONTROLLER_COUNTERS, NULL, 0);
+}
+
+static void aecp_unsolicited_stats_export_free(struct unsolicited_ctx *entry)
+{
+	if (entry->stats_export) {
+		stats_export_free(entry->stats_export);
+		entry->stats_export = NULL;
+	}
+}
+
 /** Add an unsolicited entry to the list.
  * \param	aecp		AECP context where the entry should be added.
  * \param	mac_dst		Pointer to the MAC address of the controller to add to the list.
@@ -261,9 +315,13 @@ static int aecp_unsolicited_add(struct aecp_ctx *aecp, u8 *mac_dst, u64 controll
 		entry->controller_id = controller_id;
 		entry->sequence_id = 0; /* Per AVNU.IO.CONTROL 7.3.21 */
 		entry->aecp = aecp;
+		entry->notifications_sent = 0;
+		entry->notifications_failed = 0;
 
 		list_add(&aecp->unsolicited, &entry->list);
 
+		aecp_unsolicited_stats_export_alloc(aecp, entry);
+
 		/* Monitor timer. Per AVNU.IO.CONTROL 7.5.3 */
 		entry->monitor_timer.func = aecp_monitor_timer_handler;
 		entry->monitor_timer.data = entry;
@@ -299,11 +357,16 @@ static int aecp_unsolicited_remove(struct aecp_ctx *aecp, u64 controller_id, uns
 	struct unsolicited_ctx *entry = aecp_unsolicited_find(aecp, controller_id, port_id);
 
 	if (entry) {
+		os_log(LOG_INFO, "aecp(%p) port(%u) controller(%016"PRIx64") unsolicited notifications sent: %u failed: %u\n",
+			aecp, entry->port_id, ntohll(entry->controller_id), entry->notifications_sent, entry->notifications_failed);
+
 		list_del(&entry->list);
 		list_add(&aecp->free_unsolicited, &entry->list);
 
 		timer_destroy(&entry->monitor_timer);
 
+		aecp_unsolicited_stats_export_free(entry);
+
 		return 0;
 	} else {
 		return -1;
@@ -498,6 +561,229 @@ exit:
 	return rc;
 }
 
+__init static void aecp_descriptor_cache_init(struct aecp_ctx *aecp, struct aecp_descriptor_cache_entry *storage)
+{
+	int i;
+
+	list_head_init(&aecp->descriptor_cache);
+	list_head_init(&aecp->free_descriptor_cache);
+
+	for (i = 0; i < aecp->max_descriptor_cache; i++)
+		list_add(&aecp->free_descriptor_cache, &storage[i].list);
+
+	aecp->descriptor_cache_hits = 0;
+	aecp->descriptor_cache_misses = 0;
+
+	if (aecp->max_descriptor_cache)
+		os_log(LOG_INIT, "aecp(%p) %u remote descriptors cache entries\n", aecp, aecp->max_descriptor_cache);
+}
+
+/** Find a cached remote descriptor.
+ * \return	pointer to the matching cache entry, or NULL if none found.
+ * \param	aecp			AECP context of the controller entity.
+ * \param	entity_id		remote entity ID (in network order).
+ * \param	configuration_index	(in network order).
+ * \param	descriptor_type		(in network order).
+ * \param	descriptor_index	(in network order).
+ */
+static struct aecp_descriptor_cache_entry *aecp_descriptor_cache_find(struct aecp_ctx *aecp, u64 entity_id, u16 configuration_index, u16 descriptor_type, u16 descriptor_index)
+{
+	struct list_head *list_entry;
+	struct aecp_descriptor_cache_entry *entry;
+
+	list_entry = list_first(&aecp->descriptor_cache);
+
+	while (list_entry != &aecp->descriptor_cache) {
+		entry = container_of(list_entry, struct aecp_descriptor_cache_entry, list);
+
+		if ((entry->entity_id == entity_id) && (entry->descriptor_type == descriptor_type)
+		&& (entry->descriptor_index == descriptor_index) && (entry->configuration_index == configuration_index))
+			return entry;
+
+		list_entry = list_next(list_entry);
+	}
+
+	return NULL;
+}
+
+/** Store a successful READ_DESCRIPTOR response received from a remote entity.
+ * The least recently used entry is evicted if the cache is full.
+ * \param	aecp	AECP context of the controller entity.
+ * \param	pdu	pointer to the received AECP AEM response PDU.
+ * \param	len	length of the AECP AEM response PDU.
+ */
+static void aecp_descriptor_cache_store(struct aecp_ctx *aecp, struct aecp_aem_pdu *pdu, u16 len)
+{
+	struct aecp_aem_read_desc_rsp_pdu *read_desc_rsp = (struct aecp_aem_read_desc_rsp_pdu *)(pdu + 1);
+	struct aem_desc_header {
+		u16 descriptor_type;
+		u16 descriptor_index;
+	} __attribute__ ((packed)) *desc_hdr = (struct aem_desc_header *)(read_desc_rsp + 1);
+	struct aecp_descriptor_cache_entry *entry;
+	struct list_head *list_entry;
+
+	if (!aecp->max_descriptor_cache)
+		return;
+
+	if ((len < (sizeof(struct aecp_aem_pdu) + sizeof(struct aecp_aem_read_desc_rsp_pdu) + sizeof(*desc_hdr)))
+	|| (len > AVB_AECP_MAX_MSG_SIZE))
+		return;
+
+	entry = aecp_descriptor_cache_find(aecp, pdu->entity_id, read_desc_rsp->configuration_index,
+					   desc_hdr->descriptor_type, desc_hdr->descriptor_index);
+	if (entry) {
+		list_del(&entry->list);
+	} else if (!list_empty(&aecp->free_descriptor_cache)) {
+		list_entry = list_first(&aecp->free_descriptor_cache);
+		entry = container_of(list_entry, struct aecp_descriptor_cache_entry, list);
+		list_del(list_entry);
+	} else {
+		list_entry = list_last(&aecp->descriptor_cache);
+		entry = container_of(list_entry, struct aecp_descriptor_cache_entry, list);
+		list_del(list_entry);
+	}
+
+	copy_64(&entry->entity_id, &pdu->entity_id);
+	entry->configuration_index = read_desc_rsp->configuration_index;
+	entry->descriptor_type = desc_hdr->descriptor_type;
+	entry->descriptor_index = desc_hdr->descriptor_index;
+	entry->len = len;
+	os_memcpy(entry->pdu, pdu, len);
+
+	list_add(&aecp->descriptor_cache, &entry->list);
+}
+
+/** Invalidate cached descriptors of a remote entity, for all configurations.
+ * \param	aecp			AECP context of the controller entity.
+ * \param	entity_id		remote entity ID (in network order).
+ * \param	descriptor_type		(in network order).
+ * \param	descriptor_index	(in network order).
+ */
+void aecp_descriptor_cache_invalidate(struct aecp_ctx *aecp, u64 entity_id, u16 descriptor_type, u16 descriptor_index)
+{
+	struct list_head *list_entry, *next;
+	struct aecp_descriptor_cache_entry *entry;
+
+	for (list_entry = list_first(&aecp->descriptor_cache); next = list_next(list_entry), list_entry != &aecp->descriptor_cache; list_entry = next) {
+		entry = container_of(list_entry, struct aecp_descriptor_cache_entry, list);
+
+		if ((entry->entity_id == entity_id) && (entry->descriptor_type == descriptor_type)
+		&& (entry->descriptor_index == descriptor_index)) {
+			list_del(list_entry);
+			list_add(&aecp->free_descriptor_cache, list_entry);
+		}
+	}
+}
+
+/** Invalidate all the cached descriptors of a remote entity.
+ * \param	aecp			AECP context of the controller entity.
+ * \param	entity_id		remote entity ID (in network order).
+ */
+void aecp_descriptor_cache_invalidate_entity(struct aecp_ctx *aecp, u64 entity_id)
+{
+	struct list_head *list_entry, *next;
+	struct aecp_descriptor_cache_entry *entry;
+
+	for (list_entry = list_first(&aecp->descriptor_cache); next = list_next(list_entry), list_entry != &aecp->descriptor_cache; list_entry = next) {
+		entry = container_of(list_entry, struct aecp_descriptor_cache_entry, list);
+
+		if (entry->entity_id == entity_id) {
+			list_del(list_entry);
+			list_add(&aecp->free_descriptor_cache, list_entry);
+		}
+	}
+}
+
+/** Update the available index of the cached ENTITY descriptors of a remote entity.
+ * The available index changes with every ADP advertisement, so the cached descriptors are patched in place
+ * instead of being invalidated.
+ * \param	aecp			AECP context of the controller entity.
+ * \param	entity_id		remote entity ID (in network order).
+ * \param	available_index		advertised available index (in network order).
+ */
+void aecp_descriptor_cache_set_available_index(struct aecp_ctx *aecp, u64 entity_id, u32 available_index)
+{
+	struct list_head *list_entry;
+	struct aecp_descriptor_cache_entry *entry;
+	struct entity_descriptor *desc;
+
+	for (list_entry = list_first(&aecp->descriptor_cache); list_entry != &aecp->descriptor_cache; list_entry = list_next(list_entry)) {
+		entry = container_of(list_entry, struct aecp_descriptor_cache_entry, list);
+
+		if ((entry->entity_id != entity_id) || (entry->descriptor_type != htons(AEM_DESC_TYPE_ENTITY)))
+			continue;
+
+		desc = (struct entity_descriptor *)(entry->pdu + sizeof(struct aecp_aem_pdu) + sizeof(struct aecp_aem_read_desc_rsp_pdu));
+
+		if (((u8 *)&desc->available_index + sizeof(desc->available_index)) <= (entry->pdu + entry->len))
+			desc->available_index = available_index;
+	}
+}
+
+/** Update the descriptor cache based on a response received from a remote entity.
+ * Successful READ_DESCRIPTOR responses are cached. Commands changing the entity state invalidate
+ * the descriptor they target (or the whole entity for configuration changes), whether they were
+ * sent by us (solicited response) or by another controller (unsolicited notification).
+ * \param	aecp	AECP context of the controller entity.
+ * \param	pdu	pointer to the received AECP AEM response PDU.
+ * \param	status	AECP status of the response.
+ * \param	len	length of the AECP AEM response PDU.
+ */
+static void aecp_descriptor_cache_update(struct aecp_ctx *aecp, struct aecp_aem_pdu *pdu, u8 status, u16 len)
+{
+	u16 *desc_type_index = (u16 *)(pdu + 1);
+	u16 cmd_type = AECP_AEM_GET_CMD_TYPE(pdu);
+
+	if (!aecp->max_descriptor_cache || (status != AECP_AEM_SUCCESS))
+		return;
+
+	switch (cmd_type) {
+	case AECP_AEM_CMD_READ_DESCRIPTOR:
+		if (!AECP_AEM_GET_U(pdu))
+			aecp_descriptor_cache_store(aecp, pdu, len);
+		break;
+
+	case AECP_AEM_CMD_SET_CONFIGURATION:
+	case AECP_AEM_CMD_REBOOT:
+		aecp_descriptor_cache_invalidate_entity(aecp, pdu->entity_id);
+		break;
+
+	case AECP_AEM_CMD_WRITE_DESCRIPTOR:
+	case AECP_AEM_CMD_SET_STREAM_FORMAT:
+	case AECP_AEM_CMD_SET_VIDEO_FORMAT:
+	case AECP_AEM_CMD_SET_SENSOR_FORMAT:
+	case AECP_AEM_CMD_SET_STREAM_INFO:
+	case AECP_AEM_CMD_GET_STREAM_INFO: /* Milan notifies stream format changes through GET_STREAM_INFO */
+	case AECP_AEM_CMD_SET_NAME:
+	case AECP_AEM_CMD_SET_ASSOCIATION_ID:
+	case AECP_AEM_CMD_SET_SAMPLING_RATE:
+	case AECP_AEM_CMD_SET_CLOCK_SOURCE:
+	case AECP_AEM_CMD_SET_CONTROL:
+	case AECP_AEM_CMD_INCREMENT_CONTROL:
+	case AECP_AEM_CMD_DECREMENT_CONTROL:
+	case AECP_AEM_CMD_SET_SIGNAL_SELECTOR:
+	case AECP_AEM_CMD_SET_MIXER:
+	case AECP_AEM_CMD_SET_MATRIX:
+	case AECP_AEM_CMD_ADD_AUDIO_MAPPINGS:
+	case AECP_AEM_CMD_REMOVE_AUDIO_MAPPINGS:
+	case AECP_AEM_CMD_ADD_VIDEO_MAPPINGS:
+	case AECP_AEM_CMD_REMOVE_VIDEO_MAPPINGS:
+	case AECP_AEM_CMD_ADD_SENSOR_MAPPINGS:
+	case AECP_AEM_CMD_REMOVE_SENSOR_MAPPINGS:
+	case AECP_AEM_CMD_SET_MEMORY_OBJECT_LENGTH:
+		if ((cmd_type == AECP_AEM_CMD_GET_STREAM_INFO) && !AECP_AEM_GET_U(pdu))
+			break;
+
+		/* All these commands start with the target descriptor type and index */
+		if (len >= (sizeof(struct aecp_aem_pdu) + 2 * sizeof(u16)))
+			aecp_descriptor_cache_invalidate(aecp, pdu->entity_id, desc_type_index[0], desc_type_index[1]);
+		break;
+
+	default:
+		break;
+	}
+}
+
 /** Send an AECP AEM message through an IPC channel.
  *
  * \return 0 on success or -1 on failure.
@@ -645,6 +931,30 @@ static inline int aecp_mvu_net_tx_response(struct aecp_ctx *aecp, struct avdecc_
 	return aecp_aem_net_tx(aecp, port, desc, AECP_VENDOR_UNIQUE_RESPONSE, status, mac_dst, len);
 }
 
+/** Find a command in-flight on the network.
+ * \return	pointer to the matching inflight entry, or NULL if none found.
+ * \param	aecp		AECP context the command was sent from.
+ * \param	sequence_id	sequence ID of the received response, in host byte order.
+ */
+static struct inflight_ctx *aecp_inflight_network_find(struct aecp_ctx *aecp, u16 sequence_id)
+{
+	struct inflight_ctx *entry = aecp->inflight_network_ring[sequence_id & aecp->inflight_network_ring_mask];
+
+	if (entry && (entry->data.sequence_id == sequence_id))
+		return entry;
+
+	return NULL;
+}
+
+static void aecp_inflight_network_remove(struct aecp_ctx *aecp, struct inflight_ctx *entry)
+{
+	struct entity *entity = container_of(aecp, struct entity, aecp);
+
+	aecp->inflight_network_ring[entry->data.sequence_id & aecp->inflight_network_ring_mask] = NULL;
+
+	avdecc_inflight_remove(entity, entry);
+}
+
 static int aecp_aem_inflight_network_timeout(struct inflight_ctx *entry)
 {
 	struct aecp_ctx *aecp = container_of(entry->list_head, struct aecp_ctx, inflight_network);
@@ -710,9 +1020,11 @@ static int aecp_aem_inflight_network_timeout(struct inflight_ctx *entry)
 			break;
 		}
 
-		/* Send error response back to app */
-		if (send_ipc)
+		/* Send error response back to app, with the sequence ID it used for the command */
+		if (send_ipc) {
+			entry->data.pdu.aem.sequence_id = htons(entry->data.orig_seq_id);
 			aecp_aem_ipc_tx_response(aecp, &entry->data.pdu.aem, AECP_AEM_TIMEOUT, entry->data.len, (void *)entry->data.priv[0], (unsigned int)entry->data.priv[1]);
+		}
 
 		rc = AVDECC_INFLIGHT_TIMER_STOP;
 	}
@@ -737,6 +1049,9 @@ static int aecp_aem_inflight_network_timeout(struct inflight_ctx *entry)
 		}
 	}
 
+	if (rc == AVDECC_INFLIGHT_TIMER_STOP)
+		aecp->inflight_network_ring[entry->data.sequence_id & aecp->inflight_network_ring_mask] = NULL;
+
 	return rc;
 }
 
@@ -864,6 +1179,15 @@ static int aecp_aem_send_command(struct aecp_ctx *aecp, struct avdecc_port *port
 	os_log(LOG_DEBUG, "aecp(%p) pdu(%p) desc(%p) len(%u) ipc_tx(%p) seq_id(%d)\n", aecp, pdu, desc, len, ipc, aecp->sequence_id);
 
 	entry = avdecc_inflight_get(entity);
+	if (entry) {
+		/* Skip sequence IDs whose slot is still used by a long running (IN_PROGRESS) command.
+		 * The ring is larger than the number of inflight entries, so a free slot always exists. */
+		while (aecp->inflight_network_ring[aecp->sequence_id & aecp->inflight_network_ring_mask])
+			aecp->sequence_id++;
+
+		/* Responses are forwarded to the application with its own sequence ID */
+		entry->data.orig_seq_id = ntohs(pdu->sequence_id);
+	}
 
 	pdu->sequence_id = htons(aecp->sequence_id);
 	if (entry) {
@@ -882,13 +1206,17 @@ static int aecp_aem_send_command(struct aecp_ctx *aecp, struct avdecc_port *port
 		os_memcpy(entry->data.mac_dst, mac_dst, 6);
 		entry->data.port_id = port->port_id;
 
-		if(avdecc_inflight_start(&aecp->inflight_network, entry, AECP_COMMANDS_TIMEOUT) < 0)
+		if(avdecc_inflight_start(&aecp->inflight_network, entry, AECP_COMMANDS_TIMEOUT) < 0) {
 			os_log(LOG_ERR, "aecp(%p) Could not start inflight\n", aecp);
-		else
+			net_tx_free(desc);
+		} else {
+			aecp->inflight_network_ring[aecp->sequence_id & aecp->inflight_network_ring_mask] = entry;
 			rc = aecp_aem_net_tx_command(aecp, port, desc, mac_dst, len);
+		}
 	}
 	else {
 		os_log(LOG_ERR, "aecp(%p) Could not allocate inflight\n", aecp);
+		net_tx_free(desc);
 	}
 	aecp->sequence_id++;
 
@@ -996,10 +1324,12 @@ static int aecp_aem_send_sync_unsolicited_notification(struct aecp_ctx *aecp, st
 								unsolicited_entry->mac_dst, len) < 0) {
 				os_log(LOG_ERR, "avdecc(%p) port(%u) couldn't send notification to registered controller (%016"PRIx64")\n",
 					avdecc, unsolicited_entry->port_id, ntohll(unsolicited_entry->controller_id));
+				unsolicited_entry->notifications_failed++;
 				goto err;
 			}
 
 			unsolicited_entry->sequence_id++;
+			unsolicited_entry->notifications_sent++;
 		}
 
 		list_entry = list_next(list_entry);
@@ -1341,6 +1671,7 @@ static int aecp_aem_send_unsolicited_notification(struct aecp_ctx *aecp, struct
 				os_log(LOG_ERR,"aecp(%p) port(%u) couldn't prepare and send unsolicited notification (%x, %s) to controller(%016"PRIx64").\n",
 						aecp, unsolicited_entry->port_id, notification_type, aecp_aem_cmdtype2string(notification_type), ntohll(unsolicited_entry->controller_id));
 
+				unsolicited_entry->notifications_failed++;
 				goto err_prepare_rsp;
 			}
 		} else {
@@ -1351,12 +1682,14 @@ static int aecp_aem_send_unsolicited_notification(struct aecp_ctx *aecp, struct
 				os_log(LOG_ERR,"aecp(%p) port(%u) couldn't send unsolicited notification (%x, %s) to last controller(%016"PRIx64").\n",
 						aecp, unsolicited_entry->port_id, notification_type, aecp_aem_cmdtype2string(notification_type), ntohll(unsolicited_entry->controller_id));
 
+				unsolicited_entry->notifications_failed++;
 				goto err_send_rsp;
 			}
 		}
 
 		/* Incrementing the sequence_id per AVNU.IO.CONTROL 7.5.1 */
 		unsolicited_entry->sequence_id++;
+		unsolicited_entry->notifications_sent++;
 
 		os_log(LOG_DEBUG,"aecp(%p) port(%u) sent unsolicited notification (%x, %s) to controller(%016"PRIx64").\n",
 				aecp, unsolicited_entry->port_id, notification_type, aecp_aem_cmdtype2string(notification_type), ntohll(unsolicited_entry->controller_id));
@@ -1478,6 +1811,8 @@ int aecp_aem_send_async_unsolicited_notification(struct aecp_ctx *aecp, u16 noti
 		goto err_send_rsp;
 	}
 
+	aecp->async_notifications_sent++;
+
 exit:
 	return 0;
 
@@ -1489,6 +1824,69 @@ err_tx_alloc:
 	return -1;
 }
 
+static void aecp_async_notification_timer_handler(void *data)
+{
+	struct aecp_async_notification *notification = (struct aecp_async_notification *)data;
+
+	/* The notification is built from the current descriptor state, so all the changes
+	 * made since the notification was scheduled are reported at once.
+	 */
+	aecp_aem_send_async_unsolicited_notification(notification->aecp, notification->notification_type,
+						     notification->descriptor_type, notification->descriptor_index);
+}
+
+/** Initialize a coalesced asynchronous unsolicited notification for a given descriptor.
+ *
+ * \return 		0 on success or negative value otherwise.
+ * \param aecp			pointer to the aecp context
+ * \param notification		pointer to the notification to initialize
+ * \param notification_type	type of the notification (IEEE Std 1722.1-2013 7.5.2)
+ * \param descriptor_type	type of the descriptor the notification reports
+ * \param descriptor_index	index of the descriptor the notification reports
+ * \param default_interval_ms	minimum interval between two notifications for this descriptor (Milan default). A
+ *				configured entity interval can only shorten it, so that the notifications still
+ *				reach the controllers within the Milan timings.
+ */
+int aecp_async_notification_init(struct aecp_ctx *aecp, struct aecp_async_notification *notification, u16 notification_type,
+				 u16 descriptor_type, u16 descriptor_index, unsigned int default_interval_ms)
+{
+	struct entity *entity = container_of(aecp, struct entity, aecp);
+
+	notification->aecp = aecp;
+	notification->notification_type = notification_type;
+	notification->descriptor_type = descriptor_type;
+	notification->descriptor_index = descriptor_index;
+
+	if (aecp->async_notification_interval_ms)
+		notification->interval_ms = min(aecp->async_notification_interval_ms, default_interval_ms);
+	else
+		notification->interval_ms = default_interval_ms;
+
+	notification->timer.func = aecp_async_notification_timer_handler;
+	notification->timer.data = notification;
+
+	return timer_create(entity->avdecc->timer_ctx, &notification->timer, 0, max(notification->interval_ms / 10, 1U));
+}
+
+void aecp_async_notification_exit(struct aecp_async_notification *notification)
+{
+	timer_destroy(&notification->timer);
+}
+
+/** Mark a descriptor as changed. The notification is sent once the interval elapses,
+ * further changes in the meantime are merged into the pending notification.
+ *
+ * \return 		none
+ * \param notification	pointer to the notification to schedule
+ */
+void aecp_async_notification_schedule(struct aecp_async_notification *notification)
+{
+	if (timer_is_running(&notification->timer))
+		notification->aecp->async_notifications_coalesced++;
+	else
+		timer_start(&notification->timer, notification->interval_ms);
+}
+
 /** Main AECP AEM receive function for controller's AECP command
  * Follows the AVDECC entity model state machine (9.2.2.3.1.4).
  * \return 	0 on success, negative otherwise
@@ -1531,6 +1929,10 @@ static int aecp_aem_received_controller_command(struct aecp_ctx *aecp, struct ae
 		void *desc;
 		u16 desc_len;
 
+		/* Descriptors are kept in network order and SET_* commands (and ADP, for the
+		 * entity available_index) update them in place, so the stored copy is always
+		 * the ready to send response payload and is served as is.
+		 */
 		desc = aem_get_descriptor(entity->aem_descs, ntohs(read_desc_cmd->descriptor_type), ntohs(read_desc_cmd->descriptor_index), &desc_len);
 		if (desc) {
 			struct aecp_aem_read_desc_rsp_pdu *read_desc_rsp = (struct aecp_aem_read_desc_rsp_pdu *)(aecp_rsp + 1);
@@ -2108,7 +2510,11 @@ static int aecp_aem_received_controller_command(struct aecp_ctx *aecp, struct ae
 			if (set_stream_info_cmd->flags & htonl(AECP_STREAM_FLAG_STREAM_ID_VALID)) {
 				/* Update the dynamic descriptor stream_id and send the unsolicited notification (AVNU.IO.CONTROL 7.5.2) only on stream_id change*/
 				if (!cmp_64(&stream_out_dynamic_desc->stream_id, &set_stream_info_cmd->stream_id)) {
-					copy_64(&stream_out_dynamic_desc->stream_id, &set_stream_info_cmd->stream_id);
+					if (entity->milan_mode)
+						acmp_milan_talker_set_stream_id(entity, ntohs(set_stream_info_cmd->descriptor_index),
+										get_64(&set_stream_info_cmd->stream_id));
+					else
+						copy_64(&stream_out_dynamic_desc->stream_id, &set_stream_info_cmd->stream_id);
 					send_unsolicited_notification = true;
 				}
 			}
@@ -2921,13 +3327,15 @@ static int aecp_aem_received_entity_response(struct aecp_ctx *aecp, struct aecp_
 	struct ipc_tx *ipc =  &avdecc->ipc_tx_controller;
 	unsigned int ipc_dst = IPC_DST_ALL;
 	struct inflight_ctx *entry;
+	u16 orig_seq_id = 0;
 	int rc;
 
 	if (!AECP_AEM_GET_U(pdu)) {
-		entry = avdecc_inflight_find(&aecp->inflight_network, ntohs(pdu->sequence_id));
+		entry = aecp_inflight_network_find(aecp, ntohs(pdu->sequence_id));
 		if (entry) {
 			ipc = (void *)entry->data.priv[0];
 			ipc_dst = (unsigned int)entry->data.priv[1];
+			orig_seq_id = entry->data.orig_seq_id;
 
 			// Handle IN_PROGRESS responses
 			if (status == AECP_AEM_IN_PROGRESS) {
@@ -2936,7 +3344,7 @@ static int aecp_aem_received_entity_response(struct aecp_ctx *aecp, struct aecp_
 				goto exit;
 			}
 			else
-				avdecc_inflight_remove(entity, entry);
+				aecp_inflight_network_remove(aecp, entry);
 
 		} else {
 			rc = -1;
@@ -2944,6 +3352,12 @@ static int aecp_aem_received_entity_response(struct aecp_ctx *aecp, struct aecp_
 		}
 	}
 
+	aecp_descriptor_cache_update(aecp, pdu, status, len);
+
+	/* Let the application match the response against the command it sent */
+	if (!AECP_AEM_GET_U(pdu))
+		pdu->sequence_id = htons(orig_seq_id);
+
 	if (ipc)
 		rc = aecp_aem_ipc_tx_response(aecp, pdu, status, len, ipc, ipc_dst);
 	else
@@ -2964,12 +3378,11 @@ exit:
  */
 static int aecp_aem_received_controller_response(struct aecp_ctx *aecp, struct aecp_aem_pdu *pdu, u8 status, u16 len, unsigned int port_id)
 {
-	struct entity *entity = container_of(aecp, struct entity, aecp);
 	struct inflight_ctx *entry;
 	int rc = 0;
 
 	if (!AECP_AEM_GET_U(pdu)) {
-		entry = avdecc_inflight_find(&aecp->inflight_network, ntohs(pdu->sequence_id));
+		entry = aecp_inflight_network_find(aecp, ntohs(pdu->sequence_id));
 		if (entry) {
 			switch (AECP_AEM_GET_CMD_TYPE(pdu)) {
 			case AECP_AEM_CMD_CONTROLLER_AVAILABLE:
@@ -2996,7 +3409,7 @@ static int aecp_aem_received_controller_response(struct aecp_ctx *aecp, struct a
 				break;
 			}
 
-			avdecc_inflight_remove(entity, entry);
+			aecp_inflight_network_remove(aecp, entry);
 
 			rc = 0;
 			goto exit;
@@ -3011,9 +3424,101 @@ exit:
 	return rc;
 }
 
+/* Smallest power of two strictly greater than the number of inflight entries */
+__init static unsigned int aecp_inflight_network_ring_size(struct avdecc_entity_config *cfg)
+{
+	unsigned int size = 1;
+
+	while (size <= cfg->max_inflights)
+		size <<= 1;
+
+	return size;
+}
+
 __init unsigned int aecp_data_size(struct avdecc_entity_config *cfg)
 {
-	return cfg->max_unsolicited_registrations * sizeof(struct unsolicited_ctx);
+	return cfg->max_unsolicited_registrations * sizeof(struct unsolicited_ctx)
+		+ cfg->max_descriptor_cache * sizeof(struct aecp_descriptor_cache_entry)
+		+ aecp_inflight_network_ring_size(cfg) * sizeof(struct inflight_ctx *);
+}
+
+/** Publishes the entity and registered controllers unsolicited notification counters to the statistics region
+ * \return	none
+ * \param aecp	AECP context of the entity
+ */
+void aecp_stats_export(struct aecp_ctx *aecp)
+{
+	struct unsolicited_ctx *entry;
+	struct list_head *list_entry;
+	u32 controllers = 0, sent = 0, failed = 0;
+	s64 *counters;
+
+	if (!aecp->stats_export)
+		return;
+
+	for (list_entry = list_first(&aecp->unsolicited); list_entry != &aecp->unsolicited; list_entry = list_next(list_entry)) {
+		entry = container_of(list_entry, struct unsolicited_ctx, list);
+
+		controllers++;
+		sent += entry->notifications_sent;
+		failed += entry->notifications_failed;
+
+		if (!entry->stats_export)
+			continue;
+
+		stats_export_begin(entry->stats_export);
+
+		counters = stats_export_counters(entry->stats_export);
+		counters[0] = entry->notifications_sent;
+		counters[1] = entry->notifications_failed;
+
+		stats_export_end(entry->stats_export);
+	}
+
+	stats_export_begin(aecp->stats_export);
+
+	counters = stats_export_counters(aecp->stats_export);
+	counters[0] = controllers;
+	counters[1] = sent;
+	counters[2] = failed;
+	counters[3] = aecp->async_notifications_sent;
+	counters[4] = aecp->async_notifications_coalesced;
+	counters[5] = aecp->descriptor_cache_hits;
+	counters[6] = aecp->descriptor_cache_misses;
+
+	stats_export_end(aecp->stats_export);
+}
+
+/** Allocates the entity statistics region section.
+ * Does nothing if statistics export is disabled (see stats_export_init()).
+ * \return	none
+ * \param aecp	AECP context of the entity
+ */
+__init static void aecp_stats_export_init(struct aecp_ctx *aecp)
+{
+	struct entity *entity = container_of(aecp, struct entity, aecp);
+	struct stats_export_id id = {
+		.name = "aecp_entity",
+		.label = {
+			{ .name = "entity_id", .flags = STATS_EXPORT_LABEL_HEX },
+		},
+		.n_labels = 1,
+	};
+
+	id.label[0].value = ntohll(entity->desc->entity_id);
+
+	aecp->stats_export = stats_export_alloc(&id, aecp_entity_counter_names, AECP_ENTITY_COUNTERS, NULL, 0);
+}
+
+__exit static void aecp_stats_export_exit(struct aecp_ctx *aecp)
+{
+	struct list_head *list_entry;
+
+	for (list_entry = list_first(&aecp->unsolicited); list_entry != &aecp->unsolicited; list_entry = list_next(list_entry))
+		aecp_unsolicited_stats_export_free(container_of(list_entry, struct unsolicited_ctx, list));
+
+	if (aecp->stats_export)
+		stats_export_free(aecp->stats_export);
 }
 
 __init int aecp_init(struct aecp_ctx *aecp, void *data, struct avdecc_entity_config *cfg)
@@ -3026,6 +3531,20 @@ __init int aecp_init(struct aecp_ctx *aecp, void *data, struct avdecc_entity_con
 
 	aecp_unsolicited_init(aecp);
 
+	aecp->max_descriptor_cache = cfg->max_descriptor_cache;
+
+	aecp_descriptor_cache_init(aecp, (struct aecp_descriptor_cache_entry *)(aecp->unsolicited_storage + aecp->max_unsolicited_registrations));
+
+	aecp->inflight_network_ring = (struct inflight_ctx **)((struct aecp_descriptor_cache_entry *)(aecp->unsolicited_storage + aecp->max_unsolicited_registrations) + aecp->max_descriptor_cache);
+	aecp->inflight_network_ring_mask = aecp_inflight_network_ring_size(cfg) - 1;
+	os_memset(aecp->inflight_network_ring, 0, aecp_inflight_network_ring_size(cfg) * sizeof(struct inflight_ctx *));
+
+	aecp->async_notification_interval_ms = cfg->unsolicited_notification_interval;
+	aecp->async_notifications_sent = 0;
+	aecp->async_notifications_coalesced = 0;
+
+	aecp_stats_export_init(aecp);
+
 	os_log(LOG_INIT, "aecp(%p) done\n", aecp);
 
 	return 0;
@@ -3033,6 +3552,11 @@ __init int aecp_init(struct aecp_ctx *aecp, void *data, struct avdecc_entity_con
 
 __exit int aecp_exit(struct aecp_ctx *aecp)
 {
+	if (aecp->max_descriptor_cache)
+		os_log(LOG_INFO, "aecp(%p) descriptor cache hits: %u misses: %u\n", aecp, aecp->descriptor_cache_hits, aecp->descriptor_cache_misses);
+
+	aecp_stats_export_exit(aecp);
+
 	os_log(LOG_INIT, "done\n");
 
 	return 0;
@@ -3167,6 +3691,40 @@ int aecp_ipc_rx_controller(struct entity *entity, struct ipc_aecp_msg *aecp_msg,
 		goto exit;
 	}
 
+	if (entity->aecp.max_descriptor_cache && (aecp_msg->msg_type == AECP_AEM_COMMAND)
+	&& (AECP_AEM_GET_CMD_TYPE(aecp_msg_pdu) == AECP_AEM_CMD_READ_DESCRIPTOR)
+	&& (aecp_msg->len >= (sizeof(struct aecp_aem_pdu) + sizeof(struct aecp_aem_read_desc_cmd_pdu)))) {
+		struct aecp_aem_read_desc_cmd_pdu *read_desc_cmd = (struct aecp_aem_read_desc_cmd_pdu *)(aecp_msg_pdu + 1);
+		struct aecp_descriptor_cache_entry *cache_entry;
+
+		cache_entry = aecp_descriptor_cache_find(&entity->aecp, entity_disc->info.entity_id, read_desc_cmd->configuration_index,
+							 read_desc_cmd->descriptor_type, read_desc_cmd->descriptor_index);
+		if (cache_entry) {
+			struct aecp_aem_pdu *cached_rsp = (struct aecp_aem_pdu *)cache_entry->pdu;
+
+			/* Keep most recently used entries first */
+			list_del(&cache_entry->list);
+			list_add(&entity->aecp.descriptor_cache, &cache_entry->list);
+
+			entity->aecp.descriptor_cache_hits++;
+
+			/* Answer with the sequence id of the application command, as for a network response */
+			cached_rsp->sequence_id = aecp_msg_pdu->sequence_id;
+
+			rc = aecp_aem_ipc_tx_response(&entity->aecp, cached_rsp, AECP_AEM_SUCCESS, cache_entry->len, ipc, ipc_dst);
+			goto exit;
+		}
+
+		entity->aecp.descriptor_cache_misses++;
+	}
+
+	/* Inflight window full, let the application retry once some responses have been received */
+	if (list_empty(&entity->free_inflight)) {
+		os_log(LOG_DEBUG, "avdecc(%p) No more inflight entries available, rejecting command\n", avdecc);
+		rc = aecp_aem_ipc_tx_response(&entity->aecp, aecp_msg_pdu, AECP_AEM_NO_RESOURCES, aecp_msg->len, ipc, ipc_dst);
+		goto exit;
+	}
+
 	tx_desc = aecp_net_tx_prepare(aecp_msg->buf, &aecp_msg->len, (void **)&aecp_cmd);
 	if (!tx_desc) {
 		os_log(LOG_ERR, "avdecc(%p) Cannot alloc tx descriptor\n", avdecc);
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014-2015 Freescale Semiconductor, Inc.
-* Copyright 2020-2023 NXP
+* Copyright 2020-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -19,11 +19,13 @@
 #include "common/ipc.h"
 #include "common/random.h"
 #include "common/timer.h"
+#include "common/stats_export.h"
 
 #define MILAN_PROTOCOL_VERSION 1
 #define MONITOR_TIMER_GRANULARITY		100 /* Software timer granularity */
 #define MONITOR_TIMER_INTERVAL_MIN		30000 /* 30sec */
 #define MONITOR_TIMER_INTERVAL_MAX		60000 /* 60sec */
+
 #define MONITOR_TIMER_INTERVAL ((unsigned int)random_range(MONITOR_TIMER_INTERVAL_MIN, MONITOR_TIMER_INTERVAL_MAX - MONITOR_TIMER_GRANULARITY))
 
 #define MILAN_CERTIFICATION_VERSION(a, b, c, d) ((u32)((u32)a << 24 | (u32)b << 16 | (u32)c << 8 | (u32)d))
@@ -36,6 +38,38 @@ struct unsolicited_ctx {
 	u16 sequence_id;	/**< Sequence id of the next unsolicited notifications. */
 	struct timer monitor_timer; /**< Timer to monitor if the controller is still available. Per AVNU.IO.CONTROL 7.5.3 */
 	struct aecp_ctx *aecp; /**< Parent AECP context. */
+
+	u32 notifications_sent;		/**< Number of unsolicited notifications sent to this controller. */
+	u32 notifications_failed;	/**< Number of unsolicited notifications that could not be sent to this controller. */
+	struct stats_export_section *stats_export;	/**< Statistics region section of this controller, NULL if disabled. */
+};
+
+/**
+ * Coalesced asynchronous unsolicited notification for a single (descriptor_type, descriptor_index).
+ * Changes mark the notification as pending, and at most one notification (reflecting the latest
+ * descriptor state) is sent to all registered controllers per interval.
+ */
+struct aecp_async_notification {
+	struct timer timer;
+	struct aecp_ctx *aecp;		/**< Parent AECP context. */
+	u16 notification_type;		/**< Command type of the notification (IEEE Std 1722.1-2013 7.5.2) */
+	u16 descriptor_type;
+	u16 descriptor_index;
+	unsigned int interval_ms;	/**< Minimum interval between two notifications */
+};
+
+/**
+ * Remote entity descriptor, as returned by a successful READ_DESCRIPTOR response, cached by a controller entity.
+ * The full AECP AEM response PDU is kept so that it can be sent back to the application as is.
+ */
+struct aecp_descriptor_cache_entry {
+	struct list_head list;
+	u64 entity_id;			/**< Remote entity ID (in network order) */
+	u16 configuration_index;	/**< (in network order) */
+	u16 descriptor_type;		/**< (in network order) */
+	u16 descriptor_index;		/**< (in network order) */
+	u16 len;			/**< Length of the AECP AEM response PDU */
+	u8 pdu[AVB_AECP_MAX_MSG_SIZE];
 };
 
 /**
@@ -46,9 +80,22 @@ struct aecp_ctx {
 	struct list_head inflight_application;		/**< List of AECP commands in-flight within the application (response expected from the local application) */
 	struct list_head unsolicited;			/**< List of controllers that have registered to received unsolicited notifications from this entity. */
 	u16 sequence_id;				/**< Sequence ID to use for commands, in host byte order. */
+	struct inflight_ctx **inflight_network_ring;	/**< Commands in-flight on the network, indexed by sequence ID modulo the ring size. */
+	u16 inflight_network_ring_mask;
 	struct unsolicited_ctx *unsolicited_storage;
 	struct list_head free_unsolicited;
 	unsigned int max_unsolicited_registrations;
+
+	struct list_head descriptor_cache;		/**< Cached remote entity descriptors, most recently used first. */
+	struct list_head free_descriptor_cache;
+	unsigned int max_descriptor_cache;
+	u32 descriptor_cache_hits;
+	u32 descriptor_cache_misses;
+
+	unsigned int async_notification_interval_ms;	/**< Configured interval between two async notifications for a descriptor, 0 for the defaults. */
+	u32 async_notifications_sent;			/**< Number of async unsolicited notifications sent. */
+	u32 async_notifications_coalesced;		/**< Number of descriptor changes merged into an already pending async notification. */
+	struct stats_export_section *stats_export;	/**< Statistics region section of this entity, NULL if disabled. */
 };
 
 struct avdecc_port;
@@ -62,5 +109,13 @@ int aecp_net_rx(struct avdecc_port *port, struct aecp_pdu *pdu, u8 msg_type, u8
 int aecp_ipc_rx_controller(struct entity *entity, struct ipc_aecp_msg *aecp_msg, u32 len, struct ipc_tx *ipc, unsigned int ipc_dst);
 void aecp_ipc_rx_controlled(struct entity *entity, struct ipc_aecp_msg *aecp_msg, u32 len);
 int aecp_aem_send_async_unsolicited_notification(struct aecp_ctx *aecp, u16 response_type, u16 descriptor_type, u16 descriptor_index);
+int aecp_async_notification_init(struct aecp_ctx *aecp, struct aecp_async_notification *notification, u16 notification_type,
+				 u16 descriptor_type, u16 descriptor_index, unsigned int default_interval_ms);
+void aecp_async_notification_exit(struct aecp_async_notification *notification);
+void aecp_async_notification_schedule(struct aecp_async_notification *notification);
+void aecp_stats_export(struct aecp_ctx *aecp);
+void aecp_descriptor_cache_invalidate(struct aecp_ctx *aecp, u64 entity_id, u16 descriptor_type, u16 descriptor_index);
+void aecp_descriptor_cache_set_available_index(struct aecp_ctx *aecp, u64 entity_id, u32 available_index);
+void aecp_descriptor_cache_invalidate_entity(struct aecp_ctx *aecp, u64 entity_id);
 
 #endif /* _AECP_H_ */
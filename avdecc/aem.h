@@ -23,6 +23,7 @@
 #include "adp_milan.h"
 #include "adp_ieee.h"
 #include "acmp.h"
+#include "aecp.h"
 
 typedef enum {
 	RELEASED,
@@ -101,7 +102,7 @@ struct stream_output_dynamic_desc {
 			bool probe_tx_valid; /**< True if we received a PROBE_TX_COMMAND in the last 15 sec. */
 			bool srp_talker_withdraw_in_progress; /**< True if we are still waiting two LeaveALL periods after withdrawing the talker attribute */
 
-			struct timer async_unsolicited_notification_timer; /**< Timer used to regulate AECP PDUs sent as async unsolicited notification upon descriptor changes. */
+			struct aecp_async_notification async_notification; /**< Regulates AECP PDUs sent as async unsolicited notification upon descriptor changes. */
 
 			struct entity *entity; /**< Pointer to the parent entity struct */
 			u16 unique_id;         /**< Unique ID of the talker source */
@@ -147,7 +148,7 @@ struct stream_input_dynamic_desc {
 			u32 msrp_accumulated_latency;				/**< The accumulated_latency from the talker advertise. */
 			struct msrp_failure_information failure;		/**< The MSRP failure information from the talker failed. */
 
-			struct timer async_unsolicited_notification_timer; /**< Timer used to regulate AECP PDUs sent as async unsolicited notification upon descriptor changes. */
+			struct aecp_async_notification async_notification; /**< Regulates AECP PDUs sent as async unsolicited notification upon descriptor changes. */
 
 			struct entity *entity; /**< Pointer to the parent entity struct */
 			u16 unique_id;         /**< Unique ID of the listener sink */
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2023 NXP
+* Copyright 2020-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -798,6 +798,22 @@ void avdecc_ipc_rx_maap(struct ipc_rx const *rx, struct ipc_desc *desc)
 
 		break;
 
+	case GENAVB_MSG_MAAP_CREATE_RANGES_RESPONSE:
+		status = desc->u.maap_create_ranges_response.status;
+		range_id = desc->u.maap_create_ranges_response.range_id;
+		port_id = desc->u.maap_create_ranges_response.port_id;
+
+		if (status != MAAP_RESPONSE_SUCCESS) {
+			os_log(LOG_ERR, "avdecc(%p) port(%u) ranges(%u, %u) error on ranges creation\n", avdecc, port_id, range_id,
+				desc->u.maap_create_ranges_response.n_ranges);
+			goto exit;
+		}
+
+		os_log(LOG_DEBUG, "avdecc(%p) port(%u) ranges(%u, %u) ranges creation success\n", avdecc, port_id, range_id,
+			desc->u.maap_create_ranges_response.n_ranges);
+
+		break;
+
 	case GENAVB_MSG_MAAP_DELETE_RANGE_RESPONSE:
 		status = desc->u.maap_delete_response.status;
 		range_id = desc->u.maap_delete_response.range_id;
@@ -1752,6 +1768,53 @@ __exit static void avdecc_ports_exit(struct avdecc_ctx *avdecc)
 	os_log(LOG_INIT, "done\n");
 }
 
+static void avdecc_stats_export_timer_handler(void *data)
+{
+	struct avdecc_ctx *avdecc = (struct avdecc_ctx *)data;
+	int i;
+
+	for (i = 0; i < avdecc->num_entities; i++)
+		aecp_stats_export(&avdecc->entities[i]->aecp);
+
+	timer_restart(&avdecc->stats_export_timer, CFG_AVDECC_STATS_EXPORT_PERIOD_MS);
+}
+
+/** Starts the periodic update of the entities statistics region sections.
+ * Does nothing if statistics export is disabled (see stats_export_init()).
+ * \return	none
+ * \param avdecc	pointer to the AVDECC context
+ */
+__init static void avdecc_stats_export_init(struct avdecc_ctx *avdecc)
+{
+	int i;
+
+	for (i = 0; i < avdecc->num_entities; i++)
+		if (avdecc->entities[i]->aecp.stats_export)
+			break;
+
+	if (i == avdecc->num_entities)
+		return;
+
+	avdecc->stats_export_timer.func = avdecc_stats_export_timer_handler;
+	avdecc->stats_export_timer.data = avdecc;
+	if (timer_create(avdecc->timer_ctx, &avdecc->stats_export_timer, TIMER_TYPE_SYS, 0) < 0) {
+		os_log(LOG_ERR, "avdecc(%p) stats export timer creation failed\n", avdecc);
+		return;
+	}
+
+	timer_start(&avdecc->stats_export_timer, CFG_AVDECC_STATS_EXPORT_PERIOD_MS);
+
+	avdecc->stats_export = true;
+}
+
+__exit static void avdecc_stats_export_exit(struct avdecc_ctx *avdecc)
+{
+	if (!avdecc->stats_export)
+		return;
+
+	timer_destroy(&avdecc->stats_export_timer);
+}
+
 __init void *avdecc_init(struct avdecc_config *cfg, unsigned long priv)
 {
 	struct avdecc_ctx *avdecc;
@@ -1762,7 +1825,7 @@ __init void *avdecc_init(struct avdecc_config *cfg, unsigned long priv)
 	if (cfg->num_entities == 0)
 		cfg->num_entities = 1;
 
-	timer_n = cfg->port_max * cfg->num_entities * CFG_AVDECC_MAX_TIMERS_PER_ENTITY;
+	timer_n = cfg->port_max * cfg->num_entities * CFG_AVDECC_MAX_TIMERS_PER_ENTITY + 1; /* stats export timer */
 
 	avdecc = avdecc_alloc(timer_n, cfg->port_max, cfg->max_entities_discovery);
 	if (!avdecc)
@@ -1840,6 +1903,8 @@ __init void *avdecc_init(struct avdecc_config *cfg, unsigned long priv)
 			avdecc_ipc_srp_deregister_all(&avdecc->port[j]);
 	}
 
+	avdecc_stats_export_init(avdecc);
+
 	os_log(LOG_INIT, "avdecc(%p) done, loaded %d entities.\n", avdecc, avdecc->num_entities);
 
 	return avdecc;
@@ -1896,6 +1961,8 @@ __exit int avdecc_exit(void *avdecc_h)
 	struct avdecc_ctx *avdecc = (struct avdecc_ctx *)avdecc_h;
 	int i;
 
+	avdecc_stats_export_exit(avdecc);
+
 	/* De-init entities in reverse order while decrementing the num_entities
 	 * counter to protect against access to the freed entity (on avdecc_net_tx_loopback())
 	 */
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2023 NXP
+* Copyright 2020-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -114,6 +114,8 @@ struct avdecc_ctx {
 
 	void *adp_discovery_data;
 	struct timer_ctx *timer_ctx;
+	struct timer stats_export_timer;
+	bool stats_export;
 	struct entity *entities[CFG_AVDECC_NUM_ENTITIES]; //make this an array to pointer to avoid saving the dynamic allocations pointers (for later free) and keep the allocated space starting with the parent.
 	unsigned int num_entities;
 	unsigned int port_max;
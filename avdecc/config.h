@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -19,19 +19,29 @@
 
 #define avdecc_CFG_LOG	CFG_LOG
 
-#define CFG_AVDECC_MAX_TIMERS_PER_ENTITY	6
+#define CFG_AVDECC_MAX_TIMERS_PER_ENTITY	7
 
 #define AVDECC_CFG_INFLIGHT_TIMER_RESOLUTION	10
 
 #define AVDECC_CFG_ENTITY_LOCK_TIMER_GRANULARITY_MS	100
 #define AVDECC_CFG_ENTITY_LOCK_TIMER_MS			(1000 * 60) /* 1 min entity lock timer. */
 
+#define CFG_AVDECC_STATS_EXPORT_PERIOD_MS	1000	/* counters publication period, to the statistics region (see common/stats_export.h) */
+
 #define AECP_CFG_MAX_AEM_IN_PROGRESS		(10000 / AECP_IN_PROGRESS_TIMEOUT) /* 10000 ms : Maximum IN_PROGRESS responses for AECP CMD before declaring the application unresponsive*/
 
 #define CFG_AECP_DEFAULT_NUM_UNSOLICITED		8
 #define CFG_AECP_MAX_NUM_UNSOLICITED			64
 #define CFG_AECP_MIN_NUM_UNSOLICITED			1
 
+#define CFG_AECP_DEFAULT_DESCRIPTOR_CACHE		0
+#define CFG_AECP_MIN_DESCRIPTOR_CACHE			0
+#define CFG_AECP_MAX_DESCRIPTOR_CACHE			256
+
+#define CFG_AECP_DEFAULT_NOTIFICATION_INTERVAL		0	/* ms, 0 for the Milan defaults */
+#define CFG_AECP_MIN_NOTIFICATION_INTERVAL		0
+#define CFG_AECP_MAX_NOTIFICATION_INTERVAL		10000
+
 #define CFG_ADP_DEFAULT_NUM_ENTITIES_DISCOVERY		16
 #define CFG_ADP_MIN_NUM_ENTITIES_DISCOVERY		8
 #define CFG_ADP_MAX_NUM_ENTITIES_DISCOVERY		128
@@ -1,5 +1,5 @@
 /*
-* Copyright 2018, 2020, 2023 NXP
+* Copyright 2018, 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -65,6 +65,8 @@ const struct avdecc_config avdecc_default_config = {
 	.entity_cfg[0 ... CFG_AVDECC_NUM_ENTITIES - 1].max_talker_streams = 3,
 	.entity_cfg[0 ... CFG_AVDECC_NUM_ENTITIES - 1].max_inflights = CFG_AVDECC_DEFAULT_NUM_INFLIGHTS,
 	.entity_cfg[0 ... CFG_AVDECC_NUM_ENTITIES - 1].max_unsolicited_registrations = CFG_AECP_DEFAULT_NUM_UNSOLICITED,
+	.entity_cfg[0 ... CFG_AVDECC_NUM_ENTITIES - 1].max_descriptor_cache = CFG_AECP_DEFAULT_DESCRIPTOR_CACHE,
+	.entity_cfg[0 ... CFG_AVDECC_NUM_ENTITIES - 1].unsolicited_notification_interval = CFG_AECP_DEFAULT_NOTIFICATION_INTERVAL,
 };
 
 
@@ -93,6 +95,8 @@ __init static void process_avdecc_entity(struct avdecc_entity_config *entity_cfg
 	clip_config_values(&entity_cfg->max_listener_pairs, CFG_ACMP_MIN_NUM_LISTENER_PAIRS, CFG_ACMP_MAX_NUM_LISTENER_PAIRS);
 	clip_config_values(&entity_cfg->max_inflights, CFG_AVDECC_MIN_NUM_INFLIGHTS, CFG_AVDECC_MAX_NUM_INFLIGHTS);
 	clip_config_values(&entity_cfg->max_unsolicited_registrations, CFG_AECP_MIN_NUM_UNSOLICITED, CFG_AECP_MAX_NUM_UNSOLICITED);
+	clip_config_values(&entity_cfg->max_descriptor_cache, CFG_AECP_MIN_DESCRIPTOR_CACHE, CFG_AECP_MAX_DESCRIPTOR_CACHE);
+	clip_config_values(&entity_cfg->unsolicited_notification_interval, CFG_AECP_MIN_NOTIFICATION_INTERVAL, CFG_AECP_MAX_NOTIFICATION_INTERVAL);
 }
 
 /**
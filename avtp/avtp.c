@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -341,6 +341,15 @@ void avtp_stats_dump(void *avtp_ctx, struct process_stats *stats)
 	}
 }
 
+void avtp_stats_export(void *avtp_ctx)
+{
+	struct avtp_ctx *avtp = (struct avtp_ctx *)avtp_ctx;
+	int i;
+
+	for (i = 0; i < avtp->port_max; i++)
+		stream_stats_export(&avtp->port[i]);
+}
+
 void avtp_alternative_header_init(struct avtp_alternative_hdr *avtp_alt, u8 subtype, u8 h)
 {
 	avtp_alt->subtype = subtype;
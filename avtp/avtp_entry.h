@@ -1,5 +1,5 @@
 /*
-* Copyright 2019-2020, 2023 NXP
+* Copyright 2019-2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -28,6 +28,7 @@ struct process_stats {
 void *avtp_init(struct avtp_config *cfg, unsigned long priv);
 int avtp_exit(void *avtp_ctx);
 void avtp_stats_dump(void *avtp_ctx, struct process_stats *stats);
+void avtp_stats_export(void *avtp_ctx);
 void avtp_media_event(void *data);
 void avtp_net_tx_event(void *data);
 void stats_ipc_rx(struct ipc_rx const *rx, struct ipc_desc *desc);
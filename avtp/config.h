@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -26,4 +26,6 @@
 #define CFG_AVTP_AAF_AES3_MAX_STREAMS	10
 #define CFG_AVTP_AAF_AES3_MAX_FRAMES	256  /* Matches 1 packet per interval for SR Class C at 192KHz and SR Class D at 176.4KHz */
 
+#define CFG_AVTP_LATENCY_HIST	1	/* Listener streams latency histograms/percentiles, ~8KB per stream */
+
 #endif /* _AVTP_CFG_H_ */
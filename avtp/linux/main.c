@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -40,6 +40,7 @@
 #define EPOLL_TIMEOUT_MS	10
 #define IPC_POOLING_PERIOD_NS	(10ULL * NSECS_PER_MS)
 #define STATS_PERIOD_NS		(10ULL * NSECS_PER_SEC)
+#define STATS_EXPORT_PERIOD_NS	(100ULL * NSECS_PER_MS)
 
 /* Linux specific AVTP code entry points */
 
@@ -160,7 +161,7 @@ void *avtp_thread_main(void *arg)
 		.sched_priority = AVTP_CFG_PRIORITY,
 	};
 	struct timespec tp;
-	u64 current_time = 0, previous_time = 0, ipc_time = 0, stats_time = 0;
+	u64 current_time = 0, previous_time = 0, ipc_time = 0, stats_time = 0, stats_export_time = 0;
 	struct process_stats stats;
 	int rc;
 
@@ -278,6 +279,11 @@ void *avtp_thread_main(void *arg)
 				ipc_time = current_time;
 			}
 
+			if ((current_time - stats_export_time) > STATS_EXPORT_PERIOD_NS) {
+				avtp_stats_export(avtp);
+				stats_export_time = current_time;
+			}
+
 			if ((current_time - stats_time) > STATS_PERIOD_NS) {
 				avtp_stats_dump(avtp, &stats);
 				stats_time = current_time;
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -14,6 +14,7 @@
 #include "os/stdlib.h"
 #include "os/clock.h"
 #include "os/assert.h"
+#include "os/string.h"
 
 #include "common/log.h"
 #include "common/avtp.h"
@@ -34,6 +35,18 @@
 
 #define STREAM_DESTROYED_FREE_DELAY_NS	1000000		/* Time delay between destroying and freeing stream */
 
+#if CFG_AVTP_LATENCY_HIST
+/* Receive latency, tail percentiles */
+static const u32 avb_delay_ppm[STREAM_LATENCY_PCT_N] = {
+	HDR_HIST_PPM(50), HDR_HIST_PPM(99), HDR_HIST_PPM(99.9), HDR_HIST_PPM(99.99)
+};
+
+/* Presentation time margin, low percentiles */
+static const u32 avtp_delay_ppm[STREAM_LATENCY_PCT_N] = {
+	HDR_HIST_PPM(0.01), HDR_HIST_PPM(0.1), HDR_HIST_PPM(1), HDR_HIST_PPM(50)
+};
+#endif
+
 static const unsigned int sr_class_max_pending_packets[SR_CLASS_MAX + 1] = {
 	[SR_CLASS_A] = 8, // 1ms
 	[SR_CLASS_B] = 4, // 1ms
@@ -206,9 +219,21 @@ err_format:
 
 void avtp_latency_stats(struct stream_listener *stream, struct avtp_rx_desc *desc)
 {
-	stats_update(&stream->stats.avb_delay, stream->gptp_current - desc->desc.ts);
+	s32 avb_delay = stream->gptp_current - desc->desc.ts;
+	s32 avtp_delay = desc->avtp_timestamp - stream->gptp_current;
+
+	stats_update(&stream->stats.avb_delay, avb_delay);
 
-	stats_update(&stream->stats.avtp_delay, desc->avtp_timestamp - stream->gptp_current);
+	stats_update(&stream->stats.avtp_delay, avtp_delay);
+
+	if (avtp_delay < 0)
+		stream->stats.late++;
+
+#if CFG_AVTP_LATENCY_HIST
+	/* Negative delays are counted as 0 (late frames are also counted separately, in stats.late) */
+	hdr_hist_update(&stream->avb_delay_hist, (avb_delay > 0) ? avb_delay : 0);
+	hdr_hist_update(&stream->avtp_delay_hist, (avtp_delay > 0) ? avtp_delay : 0);
+#endif
 }
 
 void stream_talker_stats_print(struct ipc_avtp_talker_stats *msg)
@@ -275,11 +300,19 @@ void stream_listener_stats_print(struct ipc_avtp_listener_stats *msg)
 	os_log(LOG_INFO, "lost: %10u, mr:    %10u, tu: %10u, subformat err: %10u, dropped: %10u\n",
 		stats->pkt_lost, stats->mr, stats->tu, stats->format_err, stats->media_tx_dropped);
 
+	os_log(LOG_INFO, "late: %10u\n", stats->late);
+
 	os_log(LOG_INFO,"now-rx_ts %4d/%4d/%4d     avtp_ts-now %4d/%4d/%4d (us)     batch %2d/%2d/%2d/%2"PRIu64"\n",
 		stats->avb_delay.min/1000, stats->avb_delay.mean/1000, stats->avb_delay.max/1000,
 		stats->avtp_delay.min/1000, stats->avtp_delay.mean/1000, stats->avtp_delay.max/1000,
 		stats->batch.min, stats->batch.mean, stats->batch.max, stats->batch.variance);
 
+#if CFG_AVTP_LATENCY_HIST
+	os_log(LOG_INFO, "now-rx_ts p50/p99/p99.9/p99.99 %4u/%4u/%4u/%4u     avtp_ts-now p0.01/p0.1/p1/p50 %4u/%4u/%4u/%4u (us)\n",
+		stats->avb_delay_pct[0] / 1000, stats->avb_delay_pct[1] / 1000, stats->avb_delay_pct[2] / 1000, stats->avb_delay_pct[3] / 1000,
+		stats->avtp_delay_pct[0] / 1000, stats->avtp_delay_pct[1] / 1000, stats->avtp_delay_pct[2] / 1000, stats->avtp_delay_pct[3] / 1000);
+#endif
+
 	if (msg->clock_rec_enabled)
 		media_clock_rec_stats_print(&msg->clock_stats);
 }
@@ -289,6 +322,9 @@ static void stream_listener_stats_dump(struct stream_listener *stream, struct ip
 {
 	struct ipc_desc *desc;
 	struct ipc_avtp_listener_stats *msg;
+#if CFG_AVTP_LATENCY_HIST
+	int i;
+#endif
 
 	desc = ipc_alloc(tx, sizeof(*msg));
 	if (!desc)
@@ -303,6 +339,19 @@ static void stream_listener_stats_dump(struct stream_listener *stream, struct ip
 	msg->stream_id = stream->id;
 	os_memcpy(&msg->stats, &stream->stats, sizeof(stream->stats));
 
+#if CFG_AVTP_LATENCY_HIST
+	for (i = 0; i < STREAM_LATENCY_PCT_N; i++) {
+		msg->stats.avb_delay_pct[i] = hdr_hist_percentile(&stream->avb_delay_hist, avb_delay_ppm[i]);
+		msg->stats.avtp_delay_pct[i] = hdr_hist_percentile(&stream->avtp_delay_hist, avtp_delay_ppm[i]);
+	}
+
+	hdr_hist_merge(&stream->avb_delay_hist_total, &stream->avb_delay_hist);
+	hdr_hist_merge(&stream->avtp_delay_hist_total, &stream->avtp_delay_hist);
+
+	hdr_hist_reset(&stream->avb_delay_hist);
+	hdr_hist_reset(&stream->avtp_delay_hist);
+#endif
+
 	if (stream->source) {
 		struct clock_grid_producer_stream *producer = &stream->source->grid.producer.u.stream;
 
@@ -329,6 +378,159 @@ err_ipc_alloc:
 	return;
 }
 
+/* See stream_talker_stats_export() */
+static const char * const talker_counter_names[] = {
+	"Tx",
+	"TxErr",
+	"MediaRx",
+	"MediaErr",
+	"MediaUnderrun",
+	"ClockRx",
+	"ClockErr",
+	"Partial",
+	"ClockInvalid",
+	"GptpErr",
+};
+
+#define TALKER_COUNTERS	(sizeof(talker_counter_names) / sizeof(char *))
+
+/* See stream_listener_stats_export() */
+static const char * const listener_counter_names[] = {
+	"Rx",
+	"MediaTx",
+	"ClockTx",
+	"PktLost",
+	"Mr",
+	"Tu",
+	"SubtypeErr",
+	"FormatErr",
+	"MediaTxErr",
+	"MediaTxDropped",
+	"GptpErr",
+	"Late",
+};
+
+#define LISTENER_COUNTERS	(sizeof(listener_counter_names) / sizeof(char *))
+
+#if CFG_AVTP_LATENCY_HIST
+/* Since the stream creation */
+static const char * const listener_hist_names[] = {
+	"AvbDelayNs",
+	"AvtpDelayNs",
+};
+
+#define LISTENER_HISTS	2
+
+/* Exported histogram scratch, only used by the avtp thread */
+static struct hdr_hist listener_hist_export;
+#else
+static const char * const *listener_hist_names = NULL;
+
+#define LISTENER_HISTS	0
+#endif
+
+static void stream_stats_export_init(struct stream_common *common, const char *name, u64 stream_id, u16 port,
+				     const char * const *counter_names, unsigned int n_counters,
+				     const char * const *hist_names, unsigned int n_hists)
+{
+	struct stats_export_id id = {
+		.label = {
+			{ .name = "stream_id", .flags = STATS_EXPORT_LABEL_HEX, .value = ntohll(stream_id) },
+			{ .name = "port", .value = port },
+		},
+		.n_labels = 2,
+	};
+
+	os_memcpy(id.name, name, os_strnlen(name, STATS_EXPORT_NAME_MAX - 1));
+
+	common->stats_export = stats_export_alloc(&id, counter_names, n_counters, hist_names, n_hists);
+}
+
+static void stream_stats_export_exit(struct stream_common *common)
+{
+	if (common->stats_export)
+		stats_export_free(common->stats_export);
+}
+
+static void stream_talker_stats_export(struct stream_talker *stream)
+{
+	struct stats_export_section *s = stream->common.stats_export;
+	s64 *counters;
+
+	if (!s)
+		return;
+
+	stats_export_begin(s);
+
+	counters = stats_export_counters(s);
+	counters[0] = stream->stats.tx;
+	counters[1] = stream->stats.tx_err;
+	counters[2] = stream->stats.media_rx;
+	counters[3] = stream->stats.media_err;
+	counters[4] = stream->stats.media_underrun;
+	counters[5] = stream->stats.clock_rx;
+	counters[6] = stream->stats.clock_err;
+	counters[7] = stream->stats.partial;
+	counters[8] = stream->stats.clock_invalid;
+	counters[9] = stream->stats.gptp_err;
+
+	stats_export_end(s);
+}
+
+static void stream_listener_stats_export(struct stream_listener *stream)
+{
+	struct stats_export_section *s = stream->common.stats_export;
+	s64 *counters;
+
+	if (!s)
+		return;
+
+	stats_export_begin(s);
+
+	counters = stats_export_counters(s);
+	counters[0] = stream->stats.rx;
+	counters[1] = stream->stats.media_tx;
+	counters[2] = stream->stats.clock_tx;
+	counters[3] = stream->stats.pkt_lost;
+	counters[4] = stream->stats.mr;
+	counters[5] = stream->stats.tu;
+	counters[6] = stream->stats.subtype_err;
+	counters[7] = stream->stats.format_err;
+	counters[8] = stream->stats.media_tx_err;
+	counters[9] = stream->stats.media_tx_dropped;
+	counters[10] = stream->stats.gptp_err;
+	counters[11] = stream->stats.late;
+
+#if CFG_AVTP_LATENCY_HIST
+	/* Cumulative, so that exported values never go backwards: previous stats dump periods plus the current one */
+	os_memcpy(&listener_hist_export, &stream->avb_delay_hist_total, sizeof(listener_hist_export));
+	hdr_hist_merge(&listener_hist_export, &stream->avb_delay_hist);
+	stats_export_hist(s, 0, &listener_hist_export);
+
+	os_memcpy(&listener_hist_export, &stream->avtp_delay_hist_total, sizeof(listener_hist_export));
+	hdr_hist_merge(&listener_hist_export, &stream->avtp_delay_hist);
+	stats_export_hist(s, 1, &listener_hist_export);
+#endif
+
+	stats_export_end(s);
+}
+
+/** Publishes the port streams counters to the statistics region
+ *
+ * \return		none
+ * \param port		pointer to port context
+ */
+void stream_stats_export(struct avtp_port *port)
+{
+	struct list_head *entry;
+
+	for (entry = list_first(&port->talker); entry != &port->talker; entry = list_next(entry))
+		stream_talker_stats_export(container_of(entry, struct stream_talker, common.list));
+
+	for (entry = list_first(&port->listener); entry != &port->listener; entry = list_next(entry))
+		stream_listener_stats_export(container_of(entry, struct stream_listener, common.list));
+}
+
 void stream_stats_dump(struct avtp_port *port, struct ipc_tx *tx)
 {
 	struct stream_talker *stream_talker;
@@ -401,6 +603,12 @@ static unsigned int stream_tx_batch(const struct stream_talker *stream)
 		/* align wakeup period to whole packets */
 		align_batch = stream->frames_per_interval;
 
+		/* Software shaped transmit, wake up every class interval to send the reserved frames */
+		if (stream->tx_shaped) {
+			tx_batch = align_batch;
+			break;
+		}
+
 		/* Set wakeup period so that generated packet number, per period, is less than half the maximum supported transmit burst */
 		max_batch = ((NET_TX_BATCH / 2) / align_batch) * align_batch;
 
@@ -452,6 +660,44 @@ err:
 	return 0;
 }
 
+/** Enables software shaping of the stream transmit context, if the network backend doesn't shape SR streams
+ *
+ * \return		0 on success, -1 on error
+ * \param stream	pointer to talker stream context
+ */
+static int stream_tx_shaper_config(struct stream_talker *stream)
+{
+	unsigned int frame_size, idle_slope, interval;
+	int rc;
+
+	/* Clock reference streams use a fixed transmit batch */
+	if (stream->subtype == AVTP_SUBTYPE_CRF)
+		return 0;
+
+	frame_size = stream->header_len + stream->payload_size + ETHER_FCS;
+	if (frame_size < ETHER_MIN_FRAME_SIZE)
+		frame_size = ETHER_MIN_FRAME_SIZE;
+
+	frame_size += ETHER_IFG + ETHER_PREAMBLE;
+
+	idle_slope = ((u64)frame_size * 8 * stream->frames_per_interval * sr_class_interval_q(stream->class) * NSECS_PER_SEC) / sr_class_interval_p(stream->class);
+
+	interval = sr_class_interval_p(stream->class) / sr_class_interval_q(stream->class);
+
+	rc = net_tx_shaper_config(&stream->tx, idle_slope, interval);
+	if (rc < 0) {
+		os_log(LOG_ERR, "talker(%p) net_tx_shaper_config() failed\n", stream);
+		return -1;
+	}
+
+	stream->tx_shaped = (rc > 0);
+
+	if (stream->tx_shaped)
+		os_log(LOG_INFO, "talker(%p) software shaping, idle slope %u bits/s\n", stream, idle_slope);
+
+	return 0;
+}
+
 int stream_clock_consumer_enable(struct stream_talker *stream)
 {
 	unsigned int ts_freq_p, ts_freq_q, packet_freq_p, packet_freq_q;
@@ -683,6 +929,9 @@ struct stream_talker *stream_talker_create(struct avtp_ctx *avtp, struct avtp_po
 	if (os_clock_gettime32(stream->clock_gptp, &stream->gptp_current) < 0)
 		stream->stats.gptp_err++;
 
+	if (stream_tx_shaper_config(stream) < 0)
+		goto err_tx_shaper;
+
 	stream->tx_batch = stream_tx_batch(stream);
 	if (!stream->tx_batch)
 		goto err_tx_batch;
@@ -694,6 +943,8 @@ struct stream_talker *stream_talker_create(struct avtp_ctx *avtp, struct avtp_po
 		if (media_rx_init(&stream->media, &stream->id, avtp->priv, flags, stream->header_len, stream_presentation_offset(stream->class, stream->latency)) < 0)
 			goto err_rx_init;
 
+	stream_stats_export_init(&stream->common, "avtp_talker", stream->id, stream->port, talker_counter_names, TALKER_COUNTERS, NULL, 0);
+
 	stream_talker_add(port, stream);
 
 	os_log(LOG_INFO, "talker_stream_id(%016"PRIx64") class(%d) format(%016"PRIx64") domain(%p): %d\n",
@@ -706,6 +957,7 @@ err_rx_init:
 
 err_clock_enable:
 err_tx_batch:
+err_tx_shaper:
 	net_tx_exit(&stream->tx);
 
 err_tx_init:
@@ -729,6 +981,8 @@ void stream_talker_destroy(struct stream_talker *stream, struct ipc_tx *tx)
 	if (tx)
 		stream_talker_stats_dump(stream, tx);
 
+	stream_stats_export_exit(&stream->common);
+
 	stream_clock_consumer_disable(stream);
 
 	if (!(stream->common.flags & STREAM_FLAG_NO_MEDIA))
@@ -935,6 +1189,16 @@ struct stream_listener *stream_listener_create(struct avtp_ctx *avtp, struct avt
 	stats_init(&stream->stats.avtp_delay, 31, NULL, NULL);
 	stats_init(&stream->stats.batch, 31, NULL, NULL);
 
+#if CFG_AVTP_LATENCY_HIST
+	hdr_hist_reset(&stream->avb_delay_hist);
+	hdr_hist_reset(&stream->avtp_delay_hist);
+	hdr_hist_reset(&stream->avb_delay_hist_total);
+	hdr_hist_reset(&stream->avtp_delay_hist_total);
+#endif
+
+	stream_stats_export_init(&stream->common, "avtp_listener", stream->id, stream->port, listener_counter_names, LISTENER_COUNTERS,
+				 listener_hist_names, LISTENER_HISTS);
+
 	stream_listener_add(port, stream);
 
 	os_log(LOG_INFO, "listener_stream_id(%016"PRIx64") class(%d) format(%016"PRIx64") domain(%p): %d\n",
@@ -995,6 +1259,8 @@ void stream_listener_destroy(struct stream_listener *stream, struct ipc_tx *tx)
 
 	if (tx)
 		stream_listener_stats_dump(stream, tx);
+
+	stream_stats_export_exit(&stream->common);
 }
 
 void stream_free_all(struct avtp_ctx *avtp)
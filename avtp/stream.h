@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -16,6 +16,7 @@
 
 #include "os/sys_types.h"
 #include "common/list.h"
+#include "common/stats_export.h"
 
 #include "avtp.h"
 
@@ -25,6 +26,8 @@
 
 #define HEADER_TEMPLATE_SIZE 64
 
+#define STREAM_LATENCY_PCT_N	4
+
 #define STREAM_FLAG_VLAN		(1 << 0)	/* Stream is vlan tagged */
 #define STREAM_FLAG_SR			(1 << 1)	/* Stream has a stream reservation */
 #define STREAM_FLAG_MEDIA_WAKEUP	(1 << 2)	/* Stream processing started by media interface (instead of clock generation) */
@@ -42,6 +45,7 @@ struct stream_common {
 	struct list_head list;
 	u64 destroy_time;
 	unsigned int flags;
+	struct stats_export_section *stats_export;	/* statistics region section */
 };
 
 /** Listener stream context.
@@ -128,11 +132,26 @@ struct stream_listener {
 		unsigned int media_tx_err;
 		unsigned int media_tx_dropped;
 		unsigned int gptp_err;
+		unsigned int late;	/* Frames received after their presentation time */
 
 		struct stats avb_delay;
 		struct stats avtp_delay;
 		struct stats batch;
+
+		/* Latency percentiles (ns), since the previous stats dump (see stream_listener_stats_dump()) */
+		u32 avb_delay_pct[STREAM_LATENCY_PCT_N];
+		u32 avtp_delay_pct[STREAM_LATENCY_PCT_N];
 	} stats;
+
+#if CFG_AVTP_LATENCY_HIST
+	/* Since the previous stats dump */
+	struct hdr_hist avb_delay_hist;
+	struct hdr_hist avtp_delay_hist;
+
+	/* Previous stats dump periods, since the stream creation (see stream_listener_stats_export()) */
+	struct hdr_hist avb_delay_hist_total;
+	struct hdr_hist avtp_delay_hist_total;
+#endif
 };
 
 /** Talker stream context
@@ -188,6 +207,7 @@ struct stream_talker {
 	unsigned int header_len;
 
 	unsigned int tx_event_enabled;
+	bool tx_shaped;		/* transmit paced in software against the stream reservation (see net_tx_shaper_config()) */
 	unsigned long priv;
 
 	union {
@@ -275,6 +295,7 @@ int stream_media_rx(struct stream_talker *stream, struct media_rx_desc **media_d
 int stream_tx_flow_control(struct stream_talker *stream, unsigned int *tx_batch);
 
 void stream_stats_dump(struct avtp_port *port, struct ipc_tx *tx);
+void stream_stats_export(struct avtp_port *port);
 void stream_talker_stats_print(struct ipc_avtp_talker_stats *msg);
 void stream_listener_stats_print(struct ipc_avtp_listener_stats *msg);
 
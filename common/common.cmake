@@ -5,6 +5,8 @@ genavb_add_library(NAME common
   log.c
   managed_objects.c
   stats.c
+  stats_export.c
+  stats_export_read.c
   timer.c
   random.c
   )
@@ -43,3 +45,12 @@ genavb_target_add_srcs(TARGET genavb
 
 genavb_link_libraries(TARGET ${avb} LIB common)
 genavb_link_libraries(TARGET ${tsn} LIB common)
+genavb_link_libraries(TARGET ${gptp_sim} LIB common)
+genavb_link_libraries(TARGET ${gptp_replay} LIB common)
+genavb_link_libraries(TARGET ${cbs_sim} LIB common)
+genavb_link_libraries(TARGET ${net_shaper_bench} LIB common)
+genavb_link_libraries(TARGET ${mclock_rec_sim} LIB common)
+genavb_link_libraries(TARGET ${clock_bench} LIB common)
+genavb_link_libraries(TARGET ${phc_calib} LIB common)
+genavb_link_libraries(TARGET ${ptp_ratio_test} LIB common)
+genavb_link_libraries(TARGET ${stats} LIB common)
@@ -277,6 +277,8 @@ enum {
 /* MAAP messages */
 #define ipc_maap_create genavb_msg_maap_create
 #define ipc_maap_create_response genavb_msg_maap_create_response
+#define ipc_maap_create_ranges genavb_msg_maap_create_ranges
+#define ipc_maap_create_ranges_response genavb_msg_maap_create_ranges_response
 #define ipc_maap_delete genavb_msg_maap_delete
 #define ipc_maap_delete_response genavb_msg_maap_delete_response
 #define ipc_maap_status genavb_maap_status
@@ -398,6 +400,8 @@ struct ipc_desc {
 
 		struct ipc_maap_create maap_create;
 		struct ipc_maap_create_response maap_create_response;
+		struct ipc_maap_create_ranges maap_create_ranges;
+		struct ipc_maap_create_ranges_response maap_create_ranges_response;
 		struct ipc_maap_delete maap_delete;
 		struct ipc_maap_delete_response maap_delete_response;
 		struct ipc_maap_status maap_status;
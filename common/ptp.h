@@ -1,6 +1,6 @@
 /*
 * Copyright 2014-2015 Freescale Semiconductor, Inc.
-* Copyright 2016-2022, 2023 NXP
+* Copyright 2016-2022, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -172,6 +172,19 @@ struct __attribute__ ((packed)) ptp_time_interval {
 
 typedef double ptp_double;
 
+/* Rate ratios (ratio of two clock frequencies, close to 1.0).
+ * With CONFIG_GPTP_FIXED_POINT, signed Q2.62 fixed point (range [-2, 2), resolution 2^-62), for bit exact rate ratio
+ * propagation (cumulativeScaledRateOffset, residence time correction). CONFIG_GPTP_FIXED_POINT only covers this, it
+ * does not make gPTP FPU-less: ptp_double, the neighbor rate ratio estimation (pdelay_est), the sync/follow-up
+ * processing (converting back with ptp_ratio_to_double()), the filters and the clock servos still use double.
+ * Only use the ptp_ratio_*() helpers to operate on them.
+ */
+#ifdef CONFIG_GPTP_FIXED_POINT
+typedef s64 ptp_ratio;
+#else
+typedef double ptp_ratio;
+#endif
+
 
 /*
 * TLV types (1588-2008 - Table 34)
@@ -475,7 +488,7 @@ struct ptp_port_params {
 	* 802.1AS-2020 - Table 10.1
 	*/
 	u8 begin;
-	ptp_double neighbor_rate_ratio;
+	ptp_ratio neighbor_rate_ratio;
 	struct ptp_u_scaled_ns mean_link_delay;
 	struct ptp_scaled_ns delay_asymmetry;
 	bool compute_neighbor_rate_ratio;
@@ -580,7 +593,7 @@ struct ptp_instance_params {
 	ptp_double clock_source_last_gm_freq_change;
 	struct ptp_u_scaled_ns current_time;
 	u8 gm_present;
-	ptp_double gm_rate_ratio;
+	ptp_ratio gm_rate_ratio;
 	u16 gm_time_base_indicator;
 	struct ptp_scaled_ns last_gm_phase_change;
 	ptp_double last_gm_freq_change;
@@ -660,7 +673,7 @@ struct port_sync_sync
 	s8 logMessageInterval;
 	struct ptp_timestamp preciseOriginTimestamp;
 	struct ptp_u_scaled_ns upstreamTxTime;
-	ptp_double rateRatio;
+	ptp_ratio rateRatio;
 	u16 gmTimeBaseIndicator;
 	struct ptp_scaled_ns lastGmPhaseChange;
 	ptp_double lastGmFreqChange;
@@ -884,7 +897,7 @@ struct port_sync_sync_receive_sm
 	the LocalClock entity of the time-aware system at the remote end of the link attached to that port to the
 	frequency of the LocalClock entity of this time-aware system.
 	*/
-	ptp_double rateRatio;
+	ptp_ratio rateRatio;
 };
 
 
@@ -939,7 +952,7 @@ struct port_sync_sync_send_sm
 	the rateRatio member of the most recently received PortSyncSync structure. The
 	data type for lastRateRatio is Double.
 	*/
-	ptp_double last_rate_ratio;
+	ptp_ratio last_rate_ratio;
 
 	/*
 	the upstreamTxTime of the most recently received PortSyncSync
@@ -1625,7 +1638,7 @@ struct md_sync_receive {
 	u8 logMessageInterval;
 	struct ptp_timestamp preciseOriginTimestamp;
 	struct ptp_u_scaled_ns upstreamTxTime;
-	ptp_double rateRatio;
+	ptp_ratio rateRatio;
 	u16 gmTimeBaseIndicator;
 	struct ptp_scaled_ns lastGmPhaseChange;
 	double lastGmFreqChange;
@@ -1644,7 +1657,7 @@ struct md_sync_send {
 	s8 logMessageInterval;
 	struct ptp_timestamp preciseOriginTimestamp;
 	struct ptp_u_scaled_ns upstreamTxTime;
-	ptp_double rateRatio;
+	ptp_ratio rateRatio;
 	u16 gmTimeBaseIndicator;
 	struct ptp_scaled_ns lastGmPhaseChange;
 	ptp_double lastGmFreqChange;
@@ -2125,7 +2138,7 @@ system, relative to an arbitrary epoch
 struct ptp_local_clock_entity {
 	/* Non standard */
 	unsigned int phase_discont;	 /* Incremented for each offset adjustment of the local clock */
-	ptp_double rate_ratio_adjustment; /* current rate ratio adjustment applied to the local clock */
+	ptp_ratio rate_ratio_adjustment; /* current rate ratio adjustment applied to the local clock */
 };
 
 
@@ -434,6 +434,219 @@ static inline void double_scaled_ns_mul(struct ptp_scaled_ns *result, ptp_double
 
 }
 
+/*
+ * Rate ratio operations, see ptp_ratio definition.
+ * Rate ratios are close to 1.0 (802.1AS requires clock frequencies within +/-100ppm), the fixed point
+ * implementation assumes all ratios (and their quotients) are in [0, 2).
+ */
+#ifdef CONFIG_GPTP_FIXED_POINT
+
+#define PTP_RATIO_FRAC_BITS	62
+#define PTP_RATIO_ONE		((ptp_ratio)1 << PTP_RATIO_FRAC_BITS)
+
+/* 64 x 64 -> 128 bits unsigned multiplication */
+static inline void u64_mul_u128(u64 a, u64 b, u64 *hi, u64 *lo)
+{
+#ifdef __SIZEOF_INT128__
+	unsigned __int128 r = (unsigned __int128)a * b;
+
+	*hi = (u64)(r >> 64);
+	*lo = (u64)r;
+#else
+	u64 a_lo = a & 0xffffffff, a_hi = a >> 32;
+	u64 b_lo = b & 0xffffffff, b_hi = b >> 32;
+	u64 p0 = a_lo * b_lo;
+	u64 p1 = a_lo * b_hi;
+	u64 p2 = a_hi * b_lo;
+	u64 mid = (p0 >> 32) + (p1 & 0xffffffff) + (p2 & 0xffffffff);
+
+	*lo = (p0 & 0xffffffff) | (mid << 32);
+	*hi = a_hi * b_hi + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+#endif
+}
+
+/* (a x b) >> shift, 0 < shift < 64 and the result must fit in 64 bits */
+static inline u64 u64_mul_shift(u64 a, u64 b, unsigned int shift)
+{
+	u64 hi, lo;
+
+	u64_mul_u128(a, b, &hi, &lo);
+
+	return (hi << (64 - shift)) | (lo >> shift);
+}
+
+static inline u64 ptp_ratio_abs(s64 r)
+{
+	return (r < 0) ? -(u64)r : (u64)r;
+}
+
+static inline ptp_ratio ptp_ratio_from_double(double d)
+{
+	return (ptp_ratio)(d * (double)PTP_RATIO_ONE);
+}
+
+static inline double ptp_ratio_to_double(ptp_ratio r)
+{
+	return (double)r / (double)PTP_RATIO_ONE;
+}
+
+static inline ptp_ratio ptp_ratio_mul(ptp_ratio a, ptp_ratio b)
+{
+	u64 r = u64_mul_shift(ptp_ratio_abs(a), ptp_ratio_abs(b), PTP_RATIO_FRAC_BITS);
+
+	return ((a < 0) != (b < 0)) ? -(ptp_ratio)r : (ptp_ratio)r;
+}
+
+/* a / b, b must not be 0 */
+static inline ptp_ratio ptp_ratio_div(ptp_ratio a, ptp_ratio b)
+{
+	u64 n = ptp_ratio_abs(a), d = ptp_ratio_abs(b);
+	u64 q = n / d, rem = n % d;
+	int i;
+
+	/* Long division, one quotient bit at a time (rem < d < 2^63, so rem << 1 doesn't overflow) */
+	for (i = 0; i < PTP_RATIO_FRAC_BITS; i++) {
+		rem <<= 1;
+		q <<= 1;
+
+		if (rem >= d) {
+			rem -= d;
+			q |= 1;
+		}
+	}
+
+	return ((a < 0) != (b < 0)) ? -(ptp_ratio)q : (ptp_ratio)q;
+}
+
+/* a + (b - 1.0), accumulates the frequency offset of b into a */
+static inline ptp_ratio ptp_ratio_add_offset(ptp_ratio a, ptp_ratio b)
+{
+	return a + (b - PTP_RATIO_ONE);
+}
+
+/* Rate ratio from a frequency offset in 2^-41 units (cumulativeScaledRateOffset, 802.1AS - 11.4.4.3.6) */
+static inline ptp_ratio ptp_ratio_from_scaled_rate_offset(s32 offset)
+{
+	return PTP_RATIO_ONE + (ptp_ratio)offset * ((ptp_ratio)1 << (PTP_RATIO_FRAC_BITS - 41));
+}
+
+/* Frequency offset in 2^-41 units, truncated toward zero like the floating point implementation */
+static inline s32 ptp_ratio_to_scaled_rate_offset(ptp_ratio r)
+{
+	return (s32)((r - PTP_RATIO_ONE) / ((ptp_ratio)1 << (PTP_RATIO_FRAC_BITS - 41)));
+}
+
+/* Rate ratio from a frequency offset in ppb */
+static inline ptp_ratio ptp_ratio_from_ppb(s64 ppb)
+{
+	/* ppb x 2^62 / 10^9 = ppb x 2^53 / 1953125, in two steps to keep all intermediates in 64 bits */
+	u64 n = ptp_ratio_abs(ppb) << 32;
+	u64 frac = ((n / 1953125) << 21) + (((n % 1953125) << 21) / 1953125);
+
+	return (ppb < 0) ? PTP_RATIO_ONE - (ptp_ratio)frac : PTP_RATIO_ONE + (ptp_ratio)frac;
+}
+
+/* Frequency offset in ppb, truncated toward zero */
+static inline s64 ptp_ratio_to_ppb(ptp_ratio r)
+{
+	ptp_ratio offset = r - PTP_RATIO_ONE;
+	u64 ppb = u64_mul_shift(ptp_ratio_abs(offset), NSECS_PER_SEC, PTP_RATIO_FRAC_BITS);
+
+	return (offset < 0) ? -(s64)ppb : (s64)ppb;
+}
+
+/* result = a x b, with b a signed 96 bit scaled ns value */
+static inline void ptp_ratio_scaled_ns_mul(struct ptp_scaled_ns *result, ptp_ratio a, struct ptp_scaled_ns b)
+{
+	struct ptp_u_scaled_ns u;
+	u64 m_hi, m_lo, p_hi_hi, p_hi_lo, p_lo_hi, p_lo_lo, w1, w2;
+	bool negative = (s16)b.u.s.nanoseconds_msb < 0;
+	u64 r = ptp_ratio_abs(a);
+
+	scaled_ns_to_u_scaled_ns(&u, &b);
+	if (negative)
+		minus_u_scaled_ns(&u, &u);
+
+	/* 96 bit magnitude, split in 32 (msb) and 64 (lsb) bits */
+	m_hi = ((u64)u.u.s.nanoseconds_msb << 16) | (u.u.s.nanoseconds >> 48);
+	m_lo = (u.u.s.nanoseconds << 16) | u.u.s.fractional_nanoseconds;
+
+	/* 192 bit product, then >> 62 and keep the 96 lsb */
+	u64_mul_u128(m_lo, r, &p_lo_hi, &p_lo_lo);
+	u64_mul_u128(m_hi, r, &p_hi_hi, &p_hi_lo);
+
+	w1 = p_lo_hi + p_hi_lo;
+	w2 = p_hi_hi + (w1 < p_lo_hi);
+
+	m_lo = (w1 << (64 - PTP_RATIO_FRAC_BITS)) | (p_lo_lo >> PTP_RATIO_FRAC_BITS);
+	m_hi = (w2 << (64 - PTP_RATIO_FRAC_BITS)) | (w1 >> PTP_RATIO_FRAC_BITS);
+
+	u.u.s.nanoseconds_msb = (u16)(m_hi >> 16);
+	u.u.s.nanoseconds = (m_hi << 48) | (m_lo >> 16);
+	u.u.s.fractional_nanoseconds = (u16)m_lo;
+
+	if (negative != (a < 0))
+		minus_u_scaled_ns(&u, &u);
+
+	u_scaled_ns_to_scaled_ns(result, &u);
+}
+
+#else
+
+#define PTP_RATIO_ONE		1.0
+
+static inline ptp_ratio ptp_ratio_from_double(double d)
+{
+	return d;
+}
+
+static inline double ptp_ratio_to_double(ptp_ratio r)
+{
+	return r;
+}
+
+static inline ptp_ratio ptp_ratio_mul(ptp_ratio a, ptp_ratio b)
+{
+	return a * b;
+}
+
+static inline ptp_ratio ptp_ratio_div(ptp_ratio a, ptp_ratio b)
+{
+	return a / b;
+}
+
+static inline ptp_ratio ptp_ratio_add_offset(ptp_ratio a, ptp_ratio b)
+{
+	return a + (b - 1.0);
+}
+
+static inline ptp_ratio ptp_ratio_from_scaled_rate_offset(s32 offset)
+{
+	return ((double)offset / POW_2_41) + 1.0;
+}
+
+static inline s32 ptp_ratio_to_scaled_rate_offset(ptp_ratio r)
+{
+	return (s32)((r - 1.0) * POW_2_41);
+}
+
+static inline ptp_ratio ptp_ratio_from_ppb(s64 ppb)
+{
+	return 1.0 + ppb / 1.0e9;
+}
+
+static inline s64 ptp_ratio_to_ppb(ptp_ratio r)
+{
+	return (s64)(1.0e9 * (r - 1.0));
+}
+
+static inline void ptp_ratio_scaled_ns_mul(struct ptp_scaled_ns *result, ptp_ratio a, struct ptp_scaled_ns b)
+{
+	double_scaled_ns_mul(result, a, b);
+}
+
+#endif /* CONFIG_GPTP_FIXED_POINT */
+
 static inline u64 log_to_ns (signed char log_val)
 {
 	u64 ns;
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -14,6 +14,8 @@
 #include "stats.h"
 #include "common/log.h"
 
+#include "os/string.h"
+
 void stats_reset(struct stats *s)
 {
 	s->current_count = 0;
@@ -107,3 +109,114 @@ void stats_compute(struct stats *s)
 	s->min = s->current_min;
 	s->max = s->current_max;
 }
+
+/** Reset a HDR histogram.
+ * @h: handler for the histogram
+ */
+void hdr_hist_reset(struct hdr_hist *h)
+{
+	os_memset(h, 0, sizeof(*h));
+	h->min = 0xffffffff;
+}
+
+static inline unsigned int hdr_hist_index(u32 val)
+{
+	unsigned int shift;
+
+	if (val < HDR_HIST_SUB)
+		return val;
+
+	/* Top HDR_HIST_SUB_BITS bits of the value, in [HDR_HIST_SUB / 2, HDR_HIST_SUB) */
+	shift = (31 - __builtin_clz(val)) - HDR_HIST_SUB_BITS + 1;
+
+	return shift * (HDR_HIST_SUB / 2) + (val >> shift);
+}
+
+/* Highest value counted in a bucket */
+static inline u32 hdr_hist_value(unsigned int index)
+{
+	unsigned int shift;
+
+	if (index < HDR_HIST_SUB)
+		return index;
+
+	shift = (index - HDR_HIST_SUB / 2) / (HDR_HIST_SUB / 2);
+
+	return (((index - shift * (HDR_HIST_SUB / 2)) + 1) << shift) - 1;
+}
+
+/** Update a HDR histogram with a given sample.
+ * @h: handler for the histogram
+ * @val: sample to be added
+ *
+ * Lock-free for a single writer: counters are only written by the caller, with single word stores, and may be read
+ * concurrently (e.g. by hdr_hist_merge()) by other threads.
+ */
+void hdr_hist_update(struct hdr_hist *h, u32 val)
+{
+	u32 *bucket = &h->bucket[hdr_hist_index(val)];
+
+	__atomic_store_n(bucket, *bucket + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&h->count, h->count + 1, __ATOMIC_RELAXED);
+
+	if (val < h->min)
+		__atomic_store_n(&h->min, val, __ATOMIC_RELAXED);
+
+	if (val > h->max)
+		__atomic_store_n(&h->max, val, __ATOMIC_RELAXED);
+}
+
+/** Merge a HDR histogram into another one.
+ * @dst: handler for the destination histogram
+ * @src: handler for the histogram to be merged, may be updated concurrently by its writer
+ */
+void hdr_hist_merge(struct hdr_hist *dst, struct hdr_hist const *src)
+{
+	u32 val;
+	int i;
+
+	for (i = 0; i < HDR_HIST_BUCKETS; i++)
+		dst->bucket[i] += __atomic_load_n(&src->bucket[i], __ATOMIC_RELAXED);
+
+	dst->count += __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+
+	val = __atomic_load_n(&src->min, __ATOMIC_RELAXED);
+	if (val < dst->min)
+		dst->min = val;
+
+	val = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+	if (val > dst->max)
+		dst->max = val;
+}
+
+/** Compute a percentile of a HDR histogram.
+ * @h: handler for the histogram
+ * @ppm: percentile, in parts per million (see HDR_HIST_PPM())
+ *
+ * Returns the highest value of the bucket containing the percentile (bounded by the maximum value), 0 if the histogram
+ * is empty.
+ */
+u32 hdr_hist_percentile(struct hdr_hist const *h, u32 ppm)
+{
+	u64 target, sum = 0;
+	int i;
+
+	if (!h->count)
+		return 0;
+
+	target = ((u64)h->count * ppm + 999999) / 1000000;
+	if (!target)
+		target = 1;
+
+	for (i = 0; i < HDR_HIST_BUCKETS; i++) {
+		sum += h->bucket[i];
+
+		if (sum >= target)
+			break;
+	}
+
+	if ((i == HDR_HIST_BUCKETS) || (hdr_hist_value(i) > h->max))
+		return h->max;
+
+	return hdr_hist_value(i);
+}
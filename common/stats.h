@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -40,11 +40,31 @@ struct stats {
 	void (*func)(struct stats *s);
 };
 
+/* Log-linear (HDR) histogram, for tail latencies: values are counted in HDR_HIST_SUB / 2 buckets per power of 2
+ * (exact below HDR_HIST_SUB), with a bounded relative error (< 2 / HDR_HIST_SUB) over the whole u32 range. */
+#define HDR_HIST_SUB_BITS	5
+#define HDR_HIST_SUB		(1U << HDR_HIST_SUB_BITS)
+#define HDR_HIST_BUCKETS	((32 - HDR_HIST_SUB_BITS) * (HDR_HIST_SUB / 2) + HDR_HIST_SUB)
+
+#define HDR_HIST_PPM(pct)	((u32)((pct) * 10000))	/* percentile, in parts per million */
+
+struct hdr_hist {
+	u32 count;
+	u32 min;
+	u32 max;
+	u32 bucket[HDR_HIST_BUCKETS];
+};
+
 void stats_reset(struct stats *s);
 void stats_print(struct stats *s);
 void stats_update(struct stats *s, s32 val);
 void stats_compute(struct stats *s);
 
+void hdr_hist_reset(struct hdr_hist *h);
+void hdr_hist_update(struct hdr_hist *h, u32 val);
+void hdr_hist_merge(struct hdr_hist *dst, struct hdr_hist const *src);
+u32 hdr_hist_percentile(struct hdr_hist const *h, u32 ppm);
+
 
 /** Initialize a stats structure.
  * @s: 			Pointer to structure to be initialized
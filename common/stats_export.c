@@ -0,0 +1,215 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Live statistics export, writer side
+ @details The reader side is in stats_export_read.c, so that readers do not link the writer dependencies.
+*/
+
+#include "stats_export.h"
+
+#include "common/log.h"
+
+#include "os/clock.h"
+#include "os/string.h"
+
+static struct stats_export_header *export_header;
+
+static unsigned int stats_export_section_size(unsigned int n_counters, unsigned int n_hists)
+{
+	unsigned int size;
+
+	size = sizeof(struct stats_export_section) + (n_counters + n_hists) * STATS_EXPORT_NAME_MAX
+		+ n_counters * sizeof(s64) + n_hists * sizeof(struct hdr_hist);
+
+	return (size + 7) & ~7;
+}
+
+static void stats_export_name(char *dst, const char *src)
+{
+	unsigned int len = os_strnlen(src, STATS_EXPORT_NAME_MAX - 1);
+
+	os_memcpy(dst, src, len);
+	os_memset(dst + len, 0, STATS_EXPORT_NAME_MAX - len);
+}
+
+/* Checks if a section has the given counter and histogram names */
+static bool stats_export_names_match(struct stats_export_section *s, const char * const *counter_names, unsigned int n_counters,
+				     const char * const *hist_names, unsigned int n_hists)
+{
+	char name[STATS_EXPORT_NAME_MAX];
+	unsigned int i;
+
+	if ((s->n_counters != n_counters) || (s->n_hists != n_hists))
+		return false;
+
+	for (i = 0; i < n_counters + n_hists; i++) {
+		stats_export_name(name, (i < n_counters) ? counter_names[i] : hist_names[i - n_counters]);
+
+		if (os_memcmp(name, stats_export_counter_name(s, i), STATS_EXPORT_NAME_MAX))
+			return false;
+	}
+
+	return true;
+}
+
+/** Initializes the statistics region of the process. Must be called before any section allocation.
+ * \return	0 on success, -1 on error
+ * \param region	pointer to the region memory, zeroed
+ * \param size		region size, in bytes
+ */
+int stats_export_init(void *region, unsigned int size)
+{
+	struct stats_export_header *header = region;
+
+	if (size <= sizeof(*header))
+		return -1;
+
+	header->size = size;
+	header->used = 0;
+	header->hist_buckets = HDR_HIST_BUCKETS;
+	header->version = STATS_EXPORT_VERSION;
+
+	/* Readers check the magic last */
+	__atomic_store_n(&header->magic, STATS_EXPORT_MAGIC, __ATOMIC_RELEASE);
+
+	export_header = header;
+
+	return 0;
+}
+
+/** Stops the statistics export. Must be called once all writers have stopped.
+ */
+void stats_export_exit(void)
+{
+	export_header = NULL;
+}
+
+/** Allocates a statistics section. Thread safe.
+ * \return	pointer to the section on success, NULL on error (or if statistics export is disabled)
+ * \param id		section name and labels
+ * \param counter_names	array of counter names
+ * \param n_counters	number of counters
+ * \param hist_names	array of histogram names
+ * \param n_hists	number of histograms
+ */
+struct stats_export_section *stats_export_alloc(const struct stats_export_id *id, const char * const *counter_names, unsigned int n_counters,
+						const char * const *hist_names, unsigned int n_hists)
+{
+	struct stats_export_header *header = export_header;
+	unsigned int size = stats_export_section_size(n_counters, n_hists);
+	struct stats_export_section *s;
+	u32 state, used;
+	unsigned int i;
+
+	if (!header || (id->n_labels > STATS_EXPORT_LABEL_MAX) || (n_counters > 0xffff) || (n_hists > 0xffff))
+		goto err;
+
+	/* Reuse a freed section with the same layout */
+	used = __atomic_load_n(&header->used, __ATOMIC_ACQUIRE);
+
+	for (i = 0; i < used; i += s->size) {
+		s = (struct stats_export_section *)((char *)(header + 1) + i);
+
+		if (!__atomic_load_n(&s->size, __ATOMIC_ACQUIRE))
+			break;
+
+		state = STATS_EXPORT_SECTION_FREE;
+
+		if ((s->size == size) && (__atomic_load_n(&s->state, __ATOMIC_ACQUIRE) == STATS_EXPORT_SECTION_FREE)
+		&& stats_export_names_match(s, counter_names, n_counters, hist_names, n_hists)
+		&& __atomic_compare_exchange_n(&s->state, &state, STATS_EXPORT_SECTION_INIT, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			goto init;
+	}
+
+	/* Append a new section */
+	used = __atomic_load_n(&header->used, __ATOMIC_RELAXED);
+
+	do {
+		if ((used + size) > (header->size - sizeof(*header)))
+			goto err_full;
+	} while (!__atomic_compare_exchange_n(&header->used, &used, used + size, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+	s = (struct stats_export_section *)((char *)(header + 1) + used);
+
+	s->n_counters = n_counters;
+	s->n_hists = n_hists;
+
+	for (i = 0; i < n_counters; i++)
+		stats_export_name((char *)stats_export_counter_name(s, i), counter_names[i]);
+
+	for (i = 0; i < n_hists; i++)
+		stats_export_name((char *)stats_export_hist_name(s, i), hist_names[i]);
+
+	/* Readers skip the section until it is active */
+	__atomic_store_n(&s->size, size, __ATOMIC_RELEASE);
+
+init:
+	stats_export_begin(s);
+
+	os_memcpy(&s->id, id, sizeof(*id));
+	s->id.name[STATS_EXPORT_NAME_MAX - 1] = '\0';
+
+	os_memset(stats_export_counters(s), 0, n_counters * sizeof(s64));
+
+	for (i = 0; i < n_hists; i++)
+		hdr_hist_reset(&stats_export_hists(s)[i]);
+
+	stats_export_end(s);
+
+	__atomic_store_n(&s->state, STATS_EXPORT_SECTION_ACTIVE, __ATOMIC_RELEASE);
+
+	return s;
+
+err_full:
+	os_log(LOG_ERR, "%s: statistics region full\n", id->name);
+
+err:
+	return NULL;
+}
+
+/** Frees a statistics section, for reuse by a later allocation.
+ * \param s	pointer to statistics section
+ */
+void stats_export_free(struct stats_export_section *s)
+{
+	__atomic_store_n(&s->state, STATS_EXPORT_SECTION_FREE, __ATOMIC_RELEASE);
+}
+
+/** Starts an update of the section values. Only called by the section writer.
+ * \param s	pointer to statistics section
+ */
+void stats_export_begin(struct stats_export_section *s)
+{
+	u64 now;
+
+	__atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	if (os_clock_gettime64(OS_CLOCK_SYSTEM_MONOTONIC, &now) < 0)
+		now = 0;
+
+	s->time = now;
+}
+
+/** Completes an update of the section values. Only called by the section writer.
+ * \param s	pointer to statistics section
+ */
+void stats_export_end(struct stats_export_section *s)
+{
+	__atomic_store_n(&s->seq, s->seq + 1, __ATOMIC_RELEASE);
+}
+
+/** Updates a section histogram. Must be called between stats_export_begin() and stats_export_end().
+ * \param s	pointer to statistics section
+ * \param index	histogram index
+ * \param h	pointer to histogram
+ */
+void stats_export_hist(struct stats_export_section *s, unsigned int index, const struct hdr_hist *h)
+{
+	os_memcpy(&stats_export_hists(s)[index], h, sizeof(*h));
+}
@@ -0,0 +1,136 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Live statistics export
+ @details Stack threads publish their counters and histograms in a statistics region, shared (read-only) with
+ external consumers (see linux/stats_shm.h), which can sample them at any rate, without IPC or log parsing.
+
+ The region starts with a versioned header, followed by sections appended at run time. Each section is owned by a
+ single thread (the writer), is identified by a name and a few labels (e.g. port, domain, stream ID), and holds a
+ fixed set of named counters (s64) and HDR histograms (see common/stats.h).
+ Values are updated under a sequence counter (odd while being written): the writer never waits, readers retry.
+
+ Sections freed (e.g. on stream destruction) are reused by later allocations of the same layout.
+*/
+
+#ifndef _COMMON_STATS_EXPORT_H_
+#define _COMMON_STATS_EXPORT_H_
+
+#include "common/types.h"
+#include "common/stats.h"
+
+#define STATS_EXPORT_MAGIC	0x47415653	/* "SVAG" */
+#define STATS_EXPORT_VERSION	1
+#define STATS_EXPORT_NAME_MAX	48
+#define STATS_EXPORT_LABEL_NAME_MAX	16
+#define STATS_EXPORT_LABEL_MAX	2
+
+#define STATS_EXPORT_LABEL_HEX	(1 << 0)	/* label value displayed in hexadecimal */
+
+#define STATS_EXPORT_READ_RETRY	8
+
+enum {
+	STATS_EXPORT_SECTION_INIT = 0,	/* being allocated */
+	STATS_EXPORT_SECTION_ACTIVE,
+	STATS_EXPORT_SECTION_FREE,
+};
+
+struct stats_export_header {
+	u32 magic;
+	u32 version;
+	u32 size;		/* region size, bytes, including the header */
+	u32 used;		/* bytes allocated to sections, following the header */
+	u32 hist_buckets;	/* HDR_HIST_BUCKETS, histograms layout */
+	u32 reserved;
+};
+
+struct stats_export_label {
+	char name[STATS_EXPORT_LABEL_NAME_MAX];
+	u32 flags;		/* STATS_EXPORT_LABEL_* */
+	u32 reserved;
+	u64 value;
+};
+
+struct stats_export_id {
+	char name[STATS_EXPORT_NAME_MAX];
+	struct stats_export_label label[STATS_EXPORT_LABEL_MAX];
+	u32 n_labels;
+	u32 reserved;
+};
+
+struct stats_export_section {
+	u32 size;		/* section size, bytes, including the section header. 0 for the end of the sections */
+	u32 state;		/* one of STATS_EXPORT_SECTION_* */
+	u32 seq;		/* sequence counter, odd while the values (or the id) are being written */
+	u16 n_counters;
+	u16 n_hists;
+	u64 time;		/* last update time, monotonic system clock, ns */
+	struct stats_export_id id;
+
+	/*
+	 * Followed by:
+	 * char counter_names[n_counters][STATS_EXPORT_NAME_MAX]
+	 * char hist_names[n_hists][STATS_EXPORT_NAME_MAX]
+	 * s64 counters[n_counters]
+	 * struct hdr_hist hists[n_hists]
+	 */
+};
+
+int stats_export_init(void *region, unsigned int size);
+void stats_export_exit(void);
+
+struct stats_export_section *stats_export_alloc(const struct stats_export_id *id, const char * const *counter_names, unsigned int n_counters,
+						const char * const *hist_names, unsigned int n_hists);
+void stats_export_free(struct stats_export_section *s);
+void stats_export_begin(struct stats_export_section *s);
+void stats_export_end(struct stats_export_section *s);
+void stats_export_hist(struct stats_export_section *s, unsigned int index, const struct hdr_hist *h);
+
+/* Readers, see stats_export_read.c */
+const struct stats_export_section *stats_export_next(const struct stats_export_header *header, const struct stats_export_section *s);
+int stats_export_read(const struct stats_export_section *s, struct stats_export_id *id, s64 *counters, struct hdr_hist *hists, u64 *time);
+
+/** Returns a counter name of a section
+ * \return	pointer to the counter name
+ * \param s	pointer to statistics section
+ * \param index	counter index
+ */
+static inline const char *stats_export_counter_name(const struct stats_export_section *s, unsigned int index)
+{
+	return (const char *)(s + 1) + index * STATS_EXPORT_NAME_MAX;
+}
+
+/** Returns a histogram name of a section
+ * \return	pointer to the histogram name
+ * \param s	pointer to statistics section
+ * \param index	histogram index
+ */
+static inline const char *stats_export_hist_name(const struct stats_export_section *s, unsigned int index)
+{
+	return stats_export_counter_name(s, s->n_counters + index);
+}
+
+/** Returns the counters of a section, to be written between stats_export_begin() and stats_export_end()
+ * \return	pointer to the first counter
+ * \param s	pointer to statistics section
+ */
+static inline s64 *stats_export_counters(struct stats_export_section *s)
+{
+	return (s64 *)((char *)(s + 1) + (s->n_counters + s->n_hists) * STATS_EXPORT_NAME_MAX);
+}
+
+/** Returns the histograms of a section
+ * \return	pointer to the first histogram
+ * \param s	pointer to statistics section
+ */
+static inline struct hdr_hist *stats_export_hists(const struct stats_export_section *s)
+{
+	return (struct hdr_hist *)((char *)(s + 1) + (s->n_counters + s->n_hists) * STATS_EXPORT_NAME_MAX + s->n_counters * sizeof(s64));
+}
+
+#endif /* _COMMON_STATS_EXPORT_H_ */
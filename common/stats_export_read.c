@@ -0,0 +1,87 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Live statistics export, reader side
+ @details Only depends on os/string.h, so that readers (e.g. genavb-stats) do not link the writer side.
+*/
+
+#include "stats_export.h"
+
+#include "os/string.h"
+
+/** Iterates over the active sections of a statistics region (for readers)
+ * \return	pointer to the next active section, NULL if none
+ * \param header	pointer to the statistics region
+ * \param s		pointer to the current section, NULL to get the first one
+ */
+const struct stats_export_section *stats_export_next(const struct stats_export_header *header, const struct stats_export_section *s)
+{
+	u32 used = __atomic_load_n(&header->used, __ATOMIC_ACQUIRE);
+	u32 offset, size;
+
+	offset = s ? ((const char *)s - (const char *)(header + 1)) + s->size : 0;
+
+	while ((offset + sizeof(*s)) <= used) {
+		s = (const struct stats_export_section *)((const char *)(header + 1) + offset);
+
+		size = __atomic_load_n(&s->size, __ATOMIC_ACQUIRE);
+		if (!size || ((offset + size) > used))
+			break;
+
+		if (__atomic_load_n(&s->state, __ATOMIC_ACQUIRE) == STATS_EXPORT_SECTION_ACTIVE)
+			return s;
+
+		offset += size;
+	}
+
+	return NULL;
+}
+
+/** Reads a consistent snapshot of the section values (for readers)
+ * \return	0 on success, -1 if the section is no longer active or keeps being updated
+ * \param s		pointer to statistics section
+ * \param id		pointer to the section name and labels, may be NULL
+ * \param counters	counters array (n_counters), may be NULL
+ * \param hists		histograms array (n_hists), may be NULL
+ * \param time		pointer to the update time, may be NULL
+ */
+int stats_export_read(const struct stats_export_section *s, struct stats_export_id *id, s64 *counters, struct hdr_hist *hists, u64 *time)
+{
+	u32 seq;
+	int i;
+
+	for (i = 0; i < STATS_EXPORT_READ_RETRY; i++) {
+		seq = __atomic_load_n(&s->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1)
+			continue;
+
+		if (id)
+			os_memcpy(id, &s->id, sizeof(*id));
+
+		if (counters)
+			os_memcpy(counters, stats_export_counters((struct stats_export_section *)s), s->n_counters * sizeof(s64));
+
+		if (hists)
+			os_memcpy(hists, stats_export_hists(s), s->n_hists * sizeof(struct hdr_hist));
+
+		if (time)
+			*time = s->time;
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (__atomic_load_n(&s->seq, __ATOMIC_RELAXED) != seq)
+			continue;
+
+		if (__atomic_load_n(&s->state, __ATOMIC_ACQUIRE) != STATS_EXPORT_SECTION_ACTIVE)
+			return -1;
+
+		return 0;
+	}
+
+	return -1;
+}
@@ -0,0 +1,7 @@
+/* Auto-generated file. Do not edit !*/
+#ifndef _VERSION_H_
+#define _VERSION_H_
+
+#define GENAVB_VERSION "master-0e07939-dirty"
+
+#endif /* _VERSION_H_ */
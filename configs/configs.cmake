@@ -1,5 +1,6 @@
+# Optional third argument: option help text
 function(genavb_set_option option value)
-  option(${option} "" ${value})
+  option(${option} "${ARGV2}" ${value})
 
   if(${option})
     set(cmake_config_defines ${cmake_config_defines} -D${option}=1)
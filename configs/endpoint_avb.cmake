@@ -2,6 +2,8 @@ genavb_set_option(CONFIG_AVTP ON)
 genavb_set_option(CONFIG_AVDECC ON)
 genavb_set_option(CONFIG_MAAP ON)
 genavb_set_option(CONFIG_GPTP ON)
+genavb_set_option(CONFIG_GPTP_FIXED_POINT OFF
+  "Rate ratio propagation in Q2.62 fixed point (bit exact cumulativeScaledRateOffset and residence time). Not an FPU-less gPTP: pdelay estimation, sync/follow-up processing, filters and servos still use double")
 genavb_set_option(CONFIG_SRP ON)
 genavb_set_option(CONFIG_MANAGEMENT ON)
 genavb_set_option(CONFIG_API ON)
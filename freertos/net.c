@@ -329,6 +329,12 @@ err:
 		return -1;
 }
 
+int net_tx_shaper_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval)
+{
+	/* SR streams are shaped by the network port layer */
+	return 0;
+}
+
 int net_tx(struct net_tx *tx, struct net_tx_desc *desc)
 {
 	int rc;
@@ -31,7 +31,7 @@ static const char *clock_master_sync_send_event_str[] = {
 
 
 /* 10.2.8.2.1 */
-static struct port_sync_sync *set_pssync_cmss(struct gptp_instance *instance, ptp_double gm_rate_ratio)
+static struct port_sync_sync *set_pssync_cmss(struct gptp_instance *instance, ptp_ratio gm_rate_ratio)
 {
 	struct ptp_instance_params *params = &instance->params;
 	ptp_double follow_up_correction_field_double;
@@ -50,7 +50,7 @@ static struct port_sync_sync *set_pssync_cmss(struct gptp_instance *instance, pt
 	u_scaled_ns_sub(&dt_u_scaled_ns, &params->current_time, &params->local_time);
 	u_scaled_ns_to_scaled_ns(&dt_scaled_ns, &dt_u_scaled_ns);
 	scaled_ns_to_ptp_double(&dt_double, &dt_scaled_ns);
-	follow_up_correction_field_double = params->master_time.fractional_nanoseconds_lsb + gm_rate_ratio * dt_double;
+	follow_up_correction_field_double = params->master_time.fractional_nanoseconds_lsb + ptp_ratio_to_double(gm_rate_ratio) * dt_double;
 	ptp_double_to_scaled_ns(&instance->clock_master.pssync.followUpCorrectionField, follow_up_correction_field_double);
 
 	os_memcpy(&instance->clock_master.pssync.sourcePortIdentity.clock_identity, &instance->params.this_clock, sizeof(struct ptp_clock_identity));
@@ -118,7 +118,7 @@ int clock_master_sync_send_sm(struct gptp_instance *instance, ptp_clock_master_s
 			/* FIXME - Temporary WA to emulate event received from ClockSource entity in order to update the localClock (clock_master_sync_receive_sm).
 			To be removed once the required support of application interface per 9.1 is implemented. */
 			instance->clock_master.sync_receive_sm.rcvd_local_clock_tick = TRUE;
-			instance->params.gm_rate_ratio = 1.0;
+			instance->params.gm_rate_ratio = PTP_RATIO_ONE;
 			clock_master_sync_receive_sm(instance);
 
 			clock_master_sync_send_sm_send_sync_indication(instance);
@@ -161,11 +161,11 @@ static ptp_double compute_clock_source_freq_offset(struct gptp_instance *instanc
 		scaled_ns_to_ptp_double(&dt_double, &dt_scaled_ns);
 		scaled_ns_to_ptp_double(&dt_local_double, &dt_local_scaled_ns);
 
-		ratio = dt_local_double / (dt_double * gptp->local_clock.rate_ratio_adjustment);
+		ratio = dt_local_double / (dt_double * ptp_ratio_to_double(gptp->local_clock.rate_ratio_adjustment));
 
 		instance->clock_master.ratio_average = 0.1 * ratio + 0.9 * instance->clock_master.ratio_average;
 
-		os_log(LOG_DEBUG, "clock_source_freq_offset + 1.0 = %.16f(%.16f) %.16f\n", instance->clock_master.ratio_average, ratio, gptp->local_clock.rate_ratio_adjustment);
+		os_log(LOG_DEBUG, "clock_source_freq_offset + 1.0 = %.16f(%.16f) %.16f\n", instance->clock_master.ratio_average, ratio, ptp_ratio_to_double(gptp->local_clock.rate_ratio_adjustment));
 	} else {
 		instance->clock_master.ratio_average = 1.0;
 	}
@@ -254,7 +254,7 @@ static void compute_gm_rate_ratio(struct gptp_instance *instance)
 
 	/* Since we don't implement ClockSource entity and our time comes from LocalClock, here we set the ratio to 1.0 */
 
-	params->gm_rate_ratio = 1.0;
+	params->gm_rate_ratio = PTP_RATIO_ONE;
 }
 
 /* 10.2.10.2.2 updateMasterTime(): updates the global variable masterTime (see 10.2.3.21), based on
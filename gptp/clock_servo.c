@@ -0,0 +1,219 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Target clock servos
+ @details PI, gain scheduled PI and Kalman filter servos, used to slave a target clock to the grandmaster phase.
+*/
+
+#include "clock_servo.h"
+
+#include "common/log.h"
+#include "os/stdlib.h"
+#include "os/string.h"
+
+/*
+ * PI servo
+ *
+ * 2nd order PLL, type 2:
+ * integral(n) = integral(n-1) + (e(n - 1) + e(n)) / 2
+ * u(n) = e(n) * kp + integral(n) * ki
+ *
+ * e(n) is the phase error per unit of time, in ppb, u(n) the target clock rate (10^9 + ppb)
+ * kp = 1 / kp_div and ki = 1 / ki_div. The adaptive servo divides the loop bandwidth by 2 at each stage,
+ * keeping the same damping (ki_div = 4 * kp_div^2).
+ */
+static const struct {
+	unsigned int kp_div;
+	unsigned int ki_div;
+} pi_stages[] = {
+	{ 2, 16 },
+	{ 4, 64 },
+	{ 8, 256 },
+};
+
+#define PI_STAGE_MAX	(sizeof(pi_stages) / sizeof(pi_stages[0]) - 1)
+
+static void pi_init(struct clock_servo *servo, s64 ppb)
+{
+	struct clock_servo_pi *pi = &servo->u.pi;
+
+	pi->stage = 0;
+	pi->stable_samples = 0;
+	pi->integral = (ppb + 1000000000LL) * pi_stages[pi->stage].ki_div;
+	pi->previous_err = 0;
+}
+
+static s64 pi_output(struct clock_servo_pi *pi, s64 err_ns, s64 dt_ns)
+{
+	s64 err;
+	s64 ppb;
+
+	err = (err_ns * 1000000000LL) / dt_ns;
+	pi->integral += (err + pi->previous_err) / 2;
+
+	ppb = ((err / (s64)pi_stages[pi->stage].kp_div) + (pi->integral / (s64)pi_stages[pi->stage].ki_div)) - 1000000000LL;
+
+	pi->previous_err = err;
+
+	return ppb;
+}
+
+static s64 pi_sample(struct clock_servo *servo, s64 err_ns, s64 dt_ns)
+{
+	return pi_output(&servo->u.pi, err_ns, dt_ns);
+}
+
+static void pi_reset(struct clock_servo *servo)
+{
+	os_memset(&servo->u.pi, 0, sizeof(servo->u.pi));
+}
+
+static void pi_set_stage(struct clock_servo_pi *pi, unsigned int stage)
+{
+	/* Keep the integral term output unchanged */
+	pi->integral = (pi->integral / pi_stages[pi->stage].ki_div) * pi_stages[stage].ki_div;
+	pi->stage = stage;
+	pi->stable_samples = 0;
+}
+
+static s64 adaptive_pi_sample(struct clock_servo *servo, s64 err_ns, s64 dt_ns)
+{
+	struct clock_servo_pi *pi = &servo->u.pi;
+	u64 abs_err_ns = os_llabs(err_ns);
+
+	if (abs_err_ns > CFG_GPTP_SERVO_ADAPTIVE_PI_LOOSEN_THRESH) {
+		if (pi->stage)
+			pi_set_stage(pi, 0);
+	} else if (abs_err_ns < CFG_GPTP_SERVO_ADAPTIVE_PI_TIGHTEN_THRESH) {
+		if ((pi->stage < PI_STAGE_MAX) && (++pi->stable_samples >= CFG_GPTP_SERVO_ADAPTIVE_PI_STABLE_SAMPLES))
+			pi_set_stage(pi, pi->stage + 1);
+	} else {
+		pi->stable_samples = 0;
+	}
+
+	return pi_output(pi, err_ns, dt_ns);
+}
+
+/*
+ * Kalman servo
+ *
+ * State: x = [phase error (ns), frequency adjustment needed to track the grandmaster (ppb)]
+ * phase(n) = phase(n-1) + (freq(n-1) - u(n-1)) * dt, with u the frequency adjustment applied during the interval
+ * freq(n) = freq(n-1), both with random walk process noise
+ * The measurement is the phase error. The output removes the estimated phase error over a few sync intervals.
+ * Computed in double precision, so not available with CONFIG_GPTP_FIXED_POINT.
+ */
+#ifndef CONFIG_GPTP_FIXED_POINT
+#define KALMAN_INITIAL_FREQ_VAR		10000.0	/* ppb^2, initial estimate comes from the measured rate ratio */
+#define KALMAN_PHASE_CORRECTION_INTERVALS	4
+
+static void kalman_init(struct clock_servo *servo, s64 ppb)
+{
+	struct clock_servo_kalman *k = &servo->u.kalman;
+
+	k->phase = 0.0;
+	k->freq = ppb;
+	k->p[0][0] = CFG_GPTP_SERVO_KALMAN_MEAS_NOISE;
+	k->p[0][1] = 0.0;
+	k->p[1][0] = 0.0;
+	k->p[1][1] = KALMAN_INITIAL_FREQ_VAR;
+	k->ppb = ppb;
+}
+
+static s64 kalman_sample(struct clock_servo *servo, s64 err_ns, s64 dt_ns)
+{
+	struct clock_servo_kalman *k = &servo->u.kalman;
+	double dt = dt_ns / 1.0e9;
+	double p00, p01, p10, p11;
+	double s, k0, k1, innovation;
+
+	/* Predict */
+	k->phase += (k->freq - k->ppb) * dt;
+
+	p00 = k->p[0][0] + dt * (k->p[0][1] + k->p[1][0]) + dt * dt * k->p[1][1] + CFG_GPTP_SERVO_KALMAN_PHASE_NOISE * dt;
+	p01 = k->p[0][1] + dt * k->p[1][1];
+	p10 = k->p[1][0] + dt * k->p[1][1];
+	p11 = k->p[1][1] + CFG_GPTP_SERVO_KALMAN_FREQ_NOISE * dt;
+
+	/* Update */
+	s = p00 + CFG_GPTP_SERVO_KALMAN_MEAS_NOISE;
+	k0 = p00 / s;
+	k1 = p10 / s;
+
+	innovation = err_ns - k->phase;
+
+	k->phase += k0 * innovation;
+	k->freq += k1 * innovation;
+
+	k->p[0][0] = (1.0 - k0) * p00;
+	k->p[0][1] = (1.0 - k0) * p01;
+	k->p[1][0] = p10 - k1 * p00;
+	k->p[1][1] = p11 - k1 * p01;
+
+	k->ppb = (s64)(k->freq + k->phase / (dt * KALMAN_PHASE_CORRECTION_INTERVALS));
+
+	return k->ppb;
+}
+
+static void kalman_reset(struct clock_servo *servo)
+{
+	os_memset(&servo->u.kalman, 0, sizeof(servo->u.kalman));
+}
+#endif
+
+static const struct clock_servo_ops clock_servos[CFG_GPTP_SERVO_MAX] = {
+	[CFG_GPTP_SERVO_PI] = {
+		.name = "pi",
+		.init = pi_init,
+		.sample = pi_sample,
+		.reset = pi_reset,
+	},
+
+	[CFG_GPTP_SERVO_ADAPTIVE_PI] = {
+		.name = "adaptive_pi",
+		.init = pi_init,
+		.sample = adaptive_pi_sample,
+		.reset = pi_reset,
+	},
+
+#ifndef CONFIG_GPTP_FIXED_POINT
+	[CFG_GPTP_SERVO_KALMAN] = {
+		.name = "kalman",
+		.init = kalman_init,
+		.sample = kalman_sample,
+		.reset = kalman_reset,
+	},
+#endif
+};
+
+/** Initialize a clock servo.
+ * \return	0 on success, -1 if the servo type is invalid or not available in this build (in which case the PI servo is used)
+ * \param servo	pointer to the servo
+ * \param type	servo type, one of CFG_GPTP_SERVO_*
+ */
+int clock_servo_init(struct clock_servo *servo, unsigned int type)
+{
+	int rc = 0;
+
+	if ((type >= CFG_GPTP_SERVO_MAX) || !clock_servos[type].sample) {
+		os_log(LOG_ERR, "invalid servo type %u, using %s\n", type, clock_servos[CFG_GPTP_SERVO_PI].name);
+		type = CFG_GPTP_SERVO_PI;
+		rc = -1;
+	}
+
+	servo->type = type;
+	servo->ops = &clock_servos[type];
+	servo->ops->reset(servo);
+
+	return rc;
+}
+
+const char *clock_servo_name(struct clock_servo *servo)
+{
+	return servo->ops->name;
+}
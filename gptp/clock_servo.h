@@ -0,0 +1,94 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Target clock servo header file
+ @details Definition of the clock servo interface and of the available servo implementations.
+*/
+
+#ifndef _CLOCK_SERVO_H_
+#define _CLOCK_SERVO_H_
+
+#include "os/sys_types.h"
+
+#include "config.h"
+
+struct clock_servo;
+
+/**
+ * Clock servo operations.
+ * All servos work on the phase error (in ns) between the grandmaster and the target clock, measured on each sync,
+ * and output the frequency adjustment (in ppb) to apply to the target clock.
+ */
+struct clock_servo_ops {
+	const char *name;
+
+	/** Start tracking, after the initial offset adjustment of the target clock.
+	 * \param servo	pointer to the servo
+	 * \param ppb	initial frequency adjustment estimate, in ppb
+	 */
+	void (*init)(struct clock_servo *servo, s64 ppb);
+
+	/** Process a new phase error sample.
+	 * \return	frequency adjustment to apply, in ppb
+	 * \param servo		pointer to the servo
+	 * \param err_ns	phase error (grandmaster time - target time), in ns
+	 * \param dt_ns		time elapsed since the previous sample, in ns
+	 */
+	s64 (*sample)(struct clock_servo *servo, s64 err_ns, s64 dt_ns);
+
+	/** Drop all servo state (e.g. on phase discontinuity or grandmaster change).
+	 * \param servo	pointer to the servo
+	 */
+	void (*reset)(struct clock_servo *servo);
+};
+
+struct clock_servo_pi {
+	s64 integral;
+	s64 previous_err;
+
+	/* gain schedule (adaptive PI only) */
+	unsigned int stage;
+	unsigned int stable_samples;
+};
+
+struct clock_servo_kalman {
+	double phase;		/* estimated phase error, in ns */
+	double freq;		/* estimated frequency adjustment needed to track the grandmaster, in ppb */
+	double p[2][2];		/* estimate covariance */
+	s64 ppb;		/* last frequency adjustment output */
+};
+
+struct clock_servo {
+	const struct clock_servo_ops *ops;
+	unsigned int type;
+
+	union {
+		struct clock_servo_pi pi;
+		struct clock_servo_kalman kalman;
+	} u;
+};
+
+int clock_servo_init(struct clock_servo *servo, unsigned int type);
+const char *clock_servo_name(struct clock_servo *servo);
+
+static inline void clock_servo_start(struct clock_servo *servo, s64 ppb)
+{
+	servo->ops->init(servo, ppb);
+}
+
+static inline s64 clock_servo_sample(struct clock_servo *servo, s64 err_ns, s64 dt_ns)
+{
+	return servo->ops->sample(servo, err_ns, dt_ns);
+}
+
+static inline void clock_servo_reset(struct clock_servo *servo)
+{
+	servo->ops->reset(servo);
+}
+
+#endif /* _CLOCK_SERVO_H_ */
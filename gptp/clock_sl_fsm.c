@@ -155,7 +155,8 @@ static void clock_slave_sync_sm_send_indication(struct gptp_port *port)
 
 	if (clock_slave->rcvdPSSync) {
 		ptp_double neighbor_prop_delay_double, upstream_tx_time_double;
-		ptp_double neighborRateRatio = get_neighbor_rate_ratio(port);
+		ptp_ratio neighborRateRatio = get_neighbor_rate_ratio(port);
+		ptp_double rate_ratio_double = ptp_ratio_to_double(clock_slave->rcvdPSSyncPtr->rateRatio);
 		ptp_double delay_asymmetry_double;
 		u64 sync_receipt_time_u64, sync_receipt_local_time_u64;
 		ptp_double neighbor_transit_time_double;
@@ -174,7 +175,7 @@ static void clock_slave_sync_sm_send_indication(struct gptp_port *port)
 
 		/* mean_link_delay should be small, but may have fractional nanoseconds so use a double */
 		u_scaled_ns_to_ptp_double(&neighbor_prop_delay_double, get_mean_link_delay(port));
-		neighbor_transit_time_double = neighbor_prop_delay_double * (clock_slave->rcvdPSSyncPtr->rateRatio / neighborRateRatio);
+		neighbor_transit_time_double = neighbor_prop_delay_double * ptp_ratio_to_double(ptp_ratio_div(clock_slave->rcvdPSSyncPtr->rateRatio, neighborRateRatio));
 		ptp_double_to_u_scaled_ns(&neighbor_transit_time_u_scaled_ns, neighbor_transit_time_double);
 		u_scaled_ns_add(&sync_receipt_time_u_scaled_ns, &sync_receipt_time_u_scaled_ns, &neighbor_transit_time_u_scaled_ns);
 
@@ -188,7 +189,7 @@ static void clock_slave_sync_sm_send_indication(struct gptp_port *port)
 
 		/* syncReceiptLocalTime */
 		scaled_ns_to_ptp_double(&delay_asymmetry_double, get_delay_asymmetry(port));
-		upstream_tx_time_double = (neighbor_prop_delay_double / neighborRateRatio) + (delay_asymmetry_double / clock_slave->rcvdPSSyncPtr->rateRatio);
+		upstream_tx_time_double = (neighbor_prop_delay_double / ptp_ratio_to_double(neighborRateRatio)) + (delay_asymmetry_double / rate_ratio_double);
 		ptp_double_to_u_scaled_ns(&params->sync_receipt_local_time, upstream_tx_time_double);
 		u_scaled_ns_add(&params->sync_receipt_local_time, &params->sync_receipt_local_time, &clock_slave->rcvdPSSyncPtr->upstreamTxTime);
 		u_scaled_ns_to_u64(&sync_receipt_local_time_u64, &params->sync_receipt_local_time);
@@ -200,7 +201,7 @@ static void clock_slave_sync_sm_send_indication(struct gptp_port *port)
 			sync_receipt_local_time_u64);
 
 		/* cumulativeRateRatio 14.4.2 */
-		instance->cumulativeRateRatio = (s32)((clock_slave->rcvdPSSyncPtr->rateRatio - 1.0) * POW_2_41);
+		instance->cumulativeRateRatio = ptp_ratio_to_scaled_rate_offset(clock_slave->rcvdPSSyncPtr->rateRatio);
 
 		/* 14.3.8, 14.3.9 */
 		if (params->gm_time_base_indicator != clock_slave->rcvdPSSyncPtr->gmTimeBaseIndicator) {
@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2020-2023 NXP
+* Copyright 2020-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -27,6 +27,8 @@
 #define CFG_GPTP_DEFAULT_LOG_LEVEL "info"
 #define CFG_GPTP_DEFAULT_LOG_MONOTONIC "disabled"
 
+#define CFG_GPTP_STATS_EXPORT_PERIOD_MS	100	/* counters publication period, to the statistics region (see common/stats_export.h) */
+
 
 /*
  * gPTP profile selection
@@ -35,6 +37,26 @@
 #define CFG_GPTP_PROFILE_AUTOMOTIVE	1 /* e.g implements gptp per Avnu AutoCDCFunctionalSpec 1.1 */
 #define CFG_GPTP_DEFAULT_PROFILE_NAME	"standard"
 
+/*
+ * Target clock servo selection (per domain)
+ */
+#define CFG_GPTP_SERVO_PI		0 /* fixed gains PI controller */
+#define CFG_GPTP_SERVO_ADAPTIVE_PI	1 /* PI controller with gains reduced once locked */
+#define CFG_GPTP_SERVO_KALMAN		2 /* Kalman filter phase/frequency estimator */
+#define CFG_GPTP_SERVO_MAX		3
+#define CFG_GPTP_DEFAULT_SERVO		CFG_GPTP_SERVO_PI
+#define CFG_GPTP_DEFAULT_SERVO_NAME	"pi"
+
+/* Adaptive PI: samples within threshold before moving to the next (lower gains) stage */
+#define CFG_GPTP_SERVO_ADAPTIVE_PI_STABLE_SAMPLES	16
+#define CFG_GPTP_SERVO_ADAPTIVE_PI_TIGHTEN_THRESH	100 /* ns */
+#define CFG_GPTP_SERVO_ADAPTIVE_PI_LOOSEN_THRESH	1000 /* ns */
+
+/* Kalman: measurement noise (ns^2), phase (ns^2/s) and frequency (ppb^2/s) process noise */
+#define CFG_GPTP_SERVO_KALMAN_MEAS_NOISE	400
+#define CFG_GPTP_SERVO_KALMAN_PHASE_NOISE	10
+#define CFG_GPTP_SERVO_KALMAN_FREQ_NOISE	1
+
 /*
  * Port configuration
  */
@@ -152,4 +174,14 @@
 #define CFG_GPTP_MIN_ALLOWED_LOST_RESP	(1)
 #define CFG_GPTP_MAX_ALLOWED_LOST_RESP	(255)
 
+/* path delay and neighbor rate ratio estimation window, in pdelay turnarounds.
+ * 2 is the standard computation, without outlier rejection. Larger windows are opt-in. */
+#define CFG_GPTP_DFLT_PDELAY_WINDOW	(2)
+#define CFG_GPTP_MIN_PDELAY_WINDOW	(2)
+#define CFG_GPTP_MAX_PDELAY_WINDOW	(16)
+
+#define CFG_GPTP_PDELAY_OUTLIER_MIN_SAMPLES	(4)	/* window samples needed before outliers are rejected */
+#define CFG_GPTP_PDELAY_OUTLIER_MAD_FACTOR	(3)	/* rejection threshold, in scaled median absolute deviations */
+#define CFG_GPTP_PDELAY_OUTLIER_MIN_THRESH	(40)	/* minimum rejection threshold, in ns */
+
 #endif /* _GPTP_CFG_H_ */
@@ -100,6 +100,7 @@ const struct fgptp_config gptp_default_config = {
 			.delayMechanism[1 ... CFG_MAX_GPTP_DOMAINS - 1] = COMMON_P2P,
 #endif
 			.allowedLostResponses = CFG_GPTP_DFLT_ALLOWED_LOST_RESP_2020,
+			.pdelayWindow = CFG_GPTP_DFLT_PDELAY_WINDOW,
 		},
 	},
 
@@ -119,6 +120,8 @@ const struct fgptp_config gptp_default_config = {
 			.clockClass = CFG_GPTP_DEFAULT_CLOCK_CLASS,
 			.clockAccuracy = CFG_GPTP_DEFAULT_CLOCK_ACCURACY,
 			.offsetScaledLogVariance = CFG_GPTP_DEFAULT_CLOCK_VARIANCE,
+
+			.servo = CFG_GPTP_DEFAULT_SERVO,
 		},
 #if CFG_MAX_GPTP_DOMAINS > 1
 		[1 ... CFG_MAX_GPTP_DOMAINS - 1] = {
@@ -130,6 +133,8 @@ const struct fgptp_config gptp_default_config = {
 			.clockClass = CFG_GPTP_DEFAULT_CLOCK_CLASS,
 			.clockAccuracy = CFG_GPTP_DEFAULT_CLOCK_ACCURACY,
 			.offsetScaledLogVariance = CFG_GPTP_DEFAULT_CLOCK_VARIANCE,
+
+			.servo = CFG_GPTP_DEFAULT_SERVO,
 		},
 #endif
 	},
@@ -185,6 +190,8 @@ __init static void process_section_general(struct fgptp_config *cfg, int instanc
 
 	cfg->domain_cfg[instance_index].domain_number = check_bounds_int(cfg->domain_cfg[instance_index].domain_number, -1, PTP_DOMAIN_NUMBER_MAX);
 
+	cfg->domain_cfg[instance_index].servo = check_bounds_unsigned_int(cfg->domain_cfg[instance_index].servo, 0, CFG_GPTP_SERVO_MAX - 1);
+
 	cfg->neighborPropDelayThreshold = check_bounds_uint64_t(cfg->neighborPropDelayThreshold, CFG_GPTP_NEIGH_THRESH_MIN_DEFAULT, CFG_GPTP_NEIGH_THRESH_MAX_DEFAULT);
 
 	cfg->rsync = check_bounds_unsigned_int(cfg->rsync, CFG_GPTP_RSYNC_ENABLE_MIN_DEFAULT, CFG_GPTP_RSYNC_ENABLE_MAX_DEFAULT);
@@ -251,6 +258,8 @@ __init static void process_section_port_params(struct fgptp_config *cfg)
 		cfg->port_cfg[i].operLogSyncInterval = check_bounds_int(cfg->port_cfg[i].operLogSyncInterval, CFG_GPTP_MIN_LOG_INTERVAL, CFG_GPTP_MAX_LOG_INTERVAL);
 
 		cfg->port_cfg[i].allowedLostResponses = check_bounds_unsigned_int(cfg->port_cfg[i].allowedLostResponses, CFG_GPTP_MIN_ALLOWED_LOST_RESP, CFG_GPTP_MAX_ALLOWED_LOST_RESP);
+
+		cfg->port_cfg[i].pdelayWindow = check_bounds_unsigned_int(cfg->port_cfg[i].pdelayWindow, CFG_GPTP_MIN_PDELAY_WINDOW, CFG_GPTP_MAX_PDELAY_WINDOW);
 	}
 }
 
@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2018, 2020-2023 NXP
+* Copyright 2018, 2020-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -12,6 +12,7 @@
 */
 
 #include "os/clock.h"
+#include "os/string.h"
 #include "os/sys_types.h"
 
 #include "gptp.h"
@@ -21,6 +22,7 @@
 #include "clock_ms_fsm.h"
 #include "target_clock_adj.h"
 #include "common/ptp_time_ops.h"
+#include "common/stats_export.h"
 #include "bmca.h"
 #include "site_fsm.h"
 #include "port_fsm.h"
@@ -203,7 +205,7 @@ struct ptp_u_scaled_ns *get_mean_link_delay(struct gptp_port *port)
 /*
 Retrieve either the per instance specific neighbor rate ratio or the cmlds's link port one associated to the port
 */
-ptp_double get_neighbor_rate_ratio(struct gptp_port *port)
+ptp_ratio get_neighbor_rate_ratio(struct gptp_port *port)
 {
 	struct gptp_port_common *c;
 
@@ -1596,6 +1598,286 @@ static void gptp_stats_exit_timers(struct gptp_ctx *gptp)
 		timer_destroy(&gptp->stats_timer);
 }
 
+/* See gptp_stats_export() */
+static const char * const gptp_net_port_counter_names[] = {
+	"PortStatRxPkts",
+	"PortStatTxPkts",
+	"PortStatTxErr",
+	"PortStatTxErrAlloc",
+	"PortStatRxErrEtype",
+	"PortStatRxErrPortId",
+	"PortStatRxErrDomain",
+	"PortStatRxErrSdoId",
+	"PortStatErrDomainUnknown",
+	"PortStatHwTsRequest",
+	"PortStatHwTsHandler",
+};
+
+#define GPTP_NET_PORT_COUNTERS	(sizeof(gptp_net_port_counter_names) / sizeof(char *))
+
+/* See gptp_stats_export_port() */
+static const char * const gptp_port_counter_names[] = {
+	"PortStatRxPdelayRequest",
+	"PortStatRxPdelayResponse",
+	"PortStatRxPdelayResponseFollowUp",
+	"PortStatRxPTPPacketDiscard",
+	"rxPdelayRespLostExceeded",
+	"PortStatTxPdelayRequest",
+	"PortStatTxPdelayResponse",
+	"PortStatTxPdelayResponseFollowUp",
+	"PortStatMdPdelayReqSmReset",
+	"PdelayDelayOutliers",
+	"PdelayRateRatioOutliers",
+	"PeerClockIdentity",
+};
+
+#define GPTP_PORT_COUNTERS	(sizeof(gptp_port_counter_names) / sizeof(char *))
+
+/* See gptp_stats_export() */
+static const char * const gptp_instance_port_counter_names[] = {
+	"PortStatRxPkts",
+	"PortStatRxSyncCount",
+	"PortStatRxSyncReceiptTimeouts",
+	"PortStatRxFollowUpCount",
+	"PortStatRxFollowUpTimeouts",
+	"PortStatRxAnnounce",
+	"PortStatAnnounceReceiptDropped",
+	"PortStatAnnounceReceiptTimeouts",
+	"PortStatRxSignaling",
+	"PortStatTxPkts",
+	"PortStatTxSyncCount",
+	"PortStatTxFollowUpCount",
+	"PortStatTxAnnounce",
+	"PortStatTxSignaling",
+	"PortStatMdSyncRcvSmReset",
+	"PortStatNumNotAsCapable",
+	"PortStatAdjustOnSync",
+	"PortStatNumSynchronizationLoss",
+	"Role",
+	"AsCapable",
+};
+
+#define GPTP_INSTANCE_PORT_COUNTERS	(sizeof(gptp_instance_port_counter_names) / sizeof(char *))
+
+static void gptp_stats_export_free(struct gptp_ctx *gptp);
+
+static struct stats_export_section *gptp_stats_export_alloc(const char *name, unsigned int domain, unsigned int port_id,
+								const char * const *counter_names, unsigned int n_counters)
+{
+	struct stats_export_id id = {
+		.label = {
+			{ .name = "port", .value = port_id },
+			{ .name = "domain", .value = domain },
+		},
+		.n_labels = (domain == (unsigned int)-1) ? 1 : 2,
+	};
+
+	os_memcpy(id.name, name, os_strnlen(name, STATS_EXPORT_NAME_MAX - 1));
+
+	return stats_export_alloc(&id, counter_names, n_counters, NULL, 0);
+}
+
+static void gptp_stats_export_port(struct gptp_port_common *c)
+{
+	struct stats_export_section *s = c->stats_export;
+	s64 *counters;
+
+	if (!s)
+		return;
+
+	stats_export_begin(s);
+
+	counters = stats_export_counters(s);
+	counters[0] = c->stats.num_rx_pdelayreq;
+	counters[1] = c->stats.num_rx_pdelayresp;
+	counters[2] = c->stats.num_rx_pdelayrespfup;
+	counters[3] = c->stats.num_rx_ptp_packet_discard;
+	counters[4] = c->stats.num_rx_pdelayresp_lost_exceeded;
+	counters[5] = c->stats.num_tx_pdelayreq;
+	counters[6] = c->stats.num_tx_pdelayresp;
+	counters[7] = c->stats.num_tx_pdelayrespfup;
+	counters[8] = c->stats.num_md_pdelay_req_sm_reset;
+	counters[9] = c->stats.num_pdelay_delay_outliers;
+	counters[10] = c->stats.num_pdelay_rate_ratio_outliers;
+	counters[11] = c->stats.peer_clock_id;
+
+	stats_export_end(s);
+}
+
+/** Publishes gptp counters to the statistics region (net ports, peer delay ports, instance ports and target clocks)
+* \return	none
+* \param gptp	pointer to the main gptp context
+*/
+static void gptp_stats_export(struct gptp_ctx *gptp)
+{
+	struct gptp_instance *instance;
+	struct gptp_port *port;
+	struct gptp_net_port_stats *net_stats;
+	struct stats_export_section *s;
+	s64 *counters;
+	unsigned int i, j;
+
+	for (i = 0; i < gptp->port_max; i++) {
+		s = gptp->net_ports[i].stats_export;
+		if (!s)
+			continue;
+
+		net_stats = &gptp->net_ports[i].stats;
+
+		stats_export_begin(s);
+
+		counters = stats_export_counters(s);
+		counters[0] = net_stats->num_rx_pkts;
+		counters[1] = net_stats->num_tx_pkts;
+		counters[2] = net_stats->num_tx_err;
+		counters[3] = net_stats->num_tx_err_alloc;
+		counters[4] = net_stats->num_rx_err_etype;
+		counters[5] = net_stats->num_rx_err_portid;
+		counters[6] = net_stats->num_rx_err_domain;
+		counters[7] = net_stats->num_rx_err_sdoid;
+		counters[8] = net_stats->num_err_domain_unknown;
+		counters[9] = net_stats->num_hwts_request;
+		counters[10] = net_stats->num_hwts_handler;
+
+		stats_export_end(s);
+
+		gptp_stats_export_port(&gptp->common_ports[i]);
+		gptp_stats_export_port(get_cmlds_port_common(gptp, i));
+	}
+
+	for (i = 0; i < gptp->domain_max; i++) {
+		instance = gptp->instances[i];
+
+		target_clkadj_stats_export(&instance->target_clkadj_params);
+
+		for (j = 0; j < instance->numberPorts; j++) {
+			port = &instance->ports[j];
+
+			s = port->stats_export;
+			if (!s)
+				continue;
+
+			stats_export_begin(s);
+
+			counters = stats_export_counters(s);
+			counters[0] = port->stats.num_rx_pkts;
+			counters[1] = port->stats.num_rx_sync;
+			counters[2] = port->stats.num_rx_sync_timeout;
+			counters[3] = port->stats.num_rx_fup;
+			counters[4] = port->stats.num_rx_fup_timeout;
+			counters[5] = port->stats.num_rx_announce;
+			counters[6] = port->stats.num_rx_announce_dropped;
+			counters[7] = port->stats.num_rx_announce_timeout;
+			counters[8] = port->stats.num_rx_sig;
+			counters[9] = port->stats.num_tx_pkts;
+			counters[10] = port->stats.num_tx_sync;
+			counters[11] = port->stats.num_tx_fup;
+			counters[12] = port->stats.num_tx_announce;
+			counters[13] = port->stats.num_tx_sig;
+			counters[14] = port->stats.num_md_sync_rcv_sm_reset;
+			counters[15] = port->stats.num_not_as_capable;
+			counters[16] = instance->stats.num_adjust_on_sync;
+			counters[17] = instance->stats.num_synchro_loss;
+			counters[18] = instance->params.selected_role[get_port_identity_number(port)];
+			counters[19] = port->params.as_capable;
+
+			stats_export_end(s);
+		}
+	}
+}
+
+static void gptp_stats_export_timer_handler(void *data)
+{
+	struct gptp_ctx *gptp = (struct gptp_ctx *)data;
+
+	gptp_stats_export(gptp);
+
+	timer_restart(&gptp->stats_export_timer, CFG_GPTP_STATS_EXPORT_PERIOD_MS);
+}
+
+/** Allocates the gptp statistics region sections, and starts their periodic update.
+* Does nothing if statistics export is disabled (see stats_export_init()).
+* \return	none
+* \param gptp	pointer to the main gptp context
+*/
+__init static void gptp_stats_export_init(struct gptp_ctx *gptp)
+{
+	struct gptp_instance *instance;
+	unsigned int i, j;
+
+	for (i = 0; i < gptp->port_max; i++) {
+		gptp->net_ports[i].stats_export = gptp_stats_export_alloc("gptp_net_port", -1, i, gptp_net_port_counter_names, GPTP_NET_PORT_COUNTERS);
+		if (!i && !gptp->net_ports[i].stats_export)
+			return;
+
+		gptp->common_ports[i].stats_export = gptp_stats_export_alloc("gptp_port", -1, i, gptp_port_counter_names, GPTP_PORT_COUNTERS);
+		get_cmlds_port_common(gptp, i)->stats_export = gptp_stats_export_alloc("gptp_cmlds_port", -1, i, gptp_port_counter_names, GPTP_PORT_COUNTERS);
+	}
+
+	for (i = 0; i < gptp->domain_max; i++) {
+		instance = gptp->instances[i];
+
+		target_clkadj_stats_export_init(&instance->target_clkadj_params);
+
+		for (j = 0; j < instance->numberPorts; j++)
+			instance->ports[j].stats_export = gptp_stats_export_alloc("gptp_instance_port", i, instance->ports[j].port_id,
+										  gptp_instance_port_counter_names, GPTP_INSTANCE_PORT_COUNTERS);
+	}
+
+	gptp->stats_export_timer.func = gptp_stats_export_timer_handler;
+	gptp->stats_export_timer.data = gptp;
+	if (timer_create(gptp->timer_ctx, &gptp->stats_export_timer, TIMER_TYPE_SYS, 0) < 0)
+		goto err_timer;
+
+	timer_start(&gptp->stats_export_timer, CFG_GPTP_STATS_EXPORT_PERIOD_MS);
+
+	gptp->stats_export = true;
+
+	return;
+
+err_timer:
+	os_log(LOG_ERR, "gptp(%p) stats export timer creation failed\n", gptp);
+
+	gptp_stats_export_free(gptp);
+}
+
+static void gptp_stats_export_section_free(struct stats_export_section *s)
+{
+	if (s)
+		stats_export_free(s);
+}
+
+static void gptp_stats_export_free(struct gptp_ctx *gptp)
+{
+	struct gptp_instance *instance;
+	unsigned int i, j;
+
+	for (i = 0; i < gptp->port_max; i++) {
+		gptp_stats_export_section_free(gptp->net_ports[i].stats_export);
+		gptp_stats_export_section_free(gptp->common_ports[i].stats_export);
+		gptp_stats_export_section_free(get_cmlds_port_common(gptp, i)->stats_export);
+	}
+
+	for (i = 0; i < gptp->domain_max; i++) {
+		instance = gptp->instances[i];
+
+		target_clkadj_stats_export_exit(&instance->target_clkadj_params);
+
+		for (j = 0; j < instance->numberPorts; j++)
+			gptp_stats_export_section_free(instance->ports[j].stats_export);
+	}
+}
+
+static void gptp_stats_export_exit(struct gptp_ctx *gptp)
+{
+	if (!gptp->stats_export)
+		return;
+
+	timer_destroy(&gptp->stats_export_timer);
+
+	gptp_stats_export_free(gptp);
+}
+
 
 __init static int gptp_instance_init_timers(struct gptp_instance *instance)
 {
@@ -1620,7 +1902,8 @@ static void gptp_port_common_exit_timers(struct gptp_port_common *port)
 
 __exit static void gptp_port_exit_timers(struct gptp_port *port)
 {
-	timer_destroy(&port->rsync_timer);
+	if (port->instance->gptp->cfg.rsync)
+		timer_destroy(&port->rsync_timer);
 
 	if (!port->instance->gptp->force_2011) {
 		timer_destroy(&port->gptp_capable_transmit_sm.timeout_timer);
@@ -1741,6 +2024,8 @@ static void gptp_port_common_set_config_parameters(struct gptp_port_common *port
 
 	stats_init(&port->pdelay_stats, 31, "Pdelay (ns)", NULL);
 
+	pdelay_est_init(&port->pdelay_est, cfg->port_cfg[port->port_id].pdelayWindow);
+
 	port->md.globals.allowedLostResponses = cfg->port_cfg[port->port_id].allowedLostResponses;
 	port->md.globals.initialLogPdelayReqInterval = cfg->port_cfg[port->port_id].initialLogPdelayReqInterval;
 	u64_to_u_scaled_ns(&port->md.globals.meanLinkDelayThresh, cfg->neighborPropDelayThreshold);
@@ -1980,7 +2265,9 @@ static void gptp_dump_port_counters(struct gptp_port_common *port, const char *p
 		"\tPortStatTxPdelayRequest %u\n"
 		"\tPortStatTxPdelayResponse %u\n"
 		"\tPortStatTxPdelayResponseFollowUp %u\n"
-		"\tPortStatMdPdelayReqSmReset %u\n",
+		"\tPortStatMdPdelayReqSmReset %u\n"
+		"\tPdelayDelayOutliers %u\n"
+		"\tPdelayRateRatioOutliers %u\n",
 		prefix,
 		port->port_id,
 		stats->peer_clock_id,
@@ -1991,7 +2278,9 @@ static void gptp_dump_port_counters(struct gptp_port_common *port, const char *p
 		stats->num_tx_pdelayreq,
 		stats->num_tx_pdelayresp,
 		stats->num_tx_pdelayrespfup,
-		stats->num_md_pdelay_req_sm_reset
+		stats->num_md_pdelay_req_sm_reset,
+		stats->num_pdelay_delay_outliers,
+		stats->num_pdelay_rate_ratio_outliers
 	);
 }
 
@@ -2566,7 +2855,7 @@ static int gptp_instance_init(struct gptp_ctx *gptp, int instance_index, struct
 	instance->clock_target = cfg->domain_cfg[instance->index].clock_target;
 	instance->clock_source = cfg->domain_cfg[instance->index].clock_source;
 
-	target_clkadj_params_init(&instance->target_clkadj_params, instance->clock_target, &gptp->local_clock, instance->index, instance->domain.domain_number);
+	target_clkadj_params_init(&instance->target_clkadj_params, instance->clock_target, &gptp->local_clock, instance->index, instance->domain.domain_number, cfg->domain_cfg[instance->index].servo);
 
 	for (port_index = 0; port_index < instance->numberPorts; port_index++) {
 		port = &instance->ports[port_index];
@@ -2821,6 +3110,7 @@ __init void *gptp_init(struct fgptp_config *cfg, unsigned long priv)
 		goto err_config;
 
 	timer_n = CFG_GPTP_MAX_TIMERS_PER_DOMAIN_AND_PORT * cfg->domain_max * cfg->port_max + (CFG_GPTP_MAX_TIMERS_PER_CMLDS_AND_PORT * cfg->port_max);
+	timer_n += 2; /* stats and stats export timers */
 	gptp = gptp_alloc(cfg->domain_max, cfg->port_max, timer_n);
 	if (!gptp)
 		goto err_malloc;
@@ -2919,6 +3209,8 @@ __init void *gptp_init(struct fgptp_config *cfg, unsigned long priv)
 
 	gptp_managed_objects_init(&gptp->module, gptp);
 
+	gptp_stats_export_init(gptp);
+
 	/* For domain 0, in case of static as_capable (e.g.: automotive profile), as_capable is already
 	 * (and always) set to TRUE, so all state machines dependending on this flag are started
 	 */
@@ -3043,6 +3335,8 @@ __exit int gptp_exit(void *gptp_ctx)
 		ipc_rx_exit(&gptp->ipc_rx_mac_service);
 	}
 
+	gptp_stats_export_exit(gptp);
+
 	for (i = 0; i < gptp->domain_max; i++)
 		gptp_instance_exit(gptp->instances[i]);
 
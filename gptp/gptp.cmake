@@ -9,6 +9,8 @@ if (CONFIG_GPTP)
     port_fsm.c
     clock_sl_fsm.c
     target_clock_adj.c
+    pdelay_est.c
+    clock_servo.c
     bmca.c
     site_fsm.c
     clock_ms_fsm.c
@@ -17,5 +19,7 @@ if (CONFIG_GPTP)
     )
 
   genavb_link_libraries(TARGET ${tsn} LIB gptp)
+  genavb_link_libraries(TARGET ${gptp_sim} LIB gptp)
+  genavb_link_libraries(TARGET ${gptp_replay} LIB gptp)
 
 endif ()
@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2018, 2020-2021, 2023 NXP
+* Copyright 2018, 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -31,6 +31,7 @@
 
 #include "config.h"
 #include "target_clock_adj.h"
+#include "pdelay_est.h"
 
 #include "gptp/gptp_entry.h"
 
@@ -104,6 +105,10 @@ struct gptp_port_stats {
 	u32 num_tx_pdelayrespfup;
 
 	u32 num_md_pdelay_req_sm_reset;
+
+	/* Non standard */
+	u32 num_pdelay_delay_outliers;
+	u32 num_pdelay_rate_ratio_outliers;
 };
 
 /* Per common port parameters */
@@ -153,8 +158,11 @@ struct gptp_port_common {
 	double initial_neighborPropDelay;
 
 	struct gptp_port_stats stats;
+	struct stats_export_section *stats_export;
 	struct stats pdelay_stats;
 
+	struct pdelay_est pdelay_est;
+
 	struct ptp_signaling_pdu signaling_rx;
 };
 
@@ -272,6 +280,7 @@ struct gptp_port {
 	unsigned int ratio_last_num_tx_pdelayresp;
 
 	struct gptp_instance_port_stats stats;
+	struct stats_export_section *stats_export;
 };
 
 
@@ -369,6 +378,7 @@ struct gptp_net_port {
 	int tx_delay_compensation;
 
 	struct gptp_net_port_stats stats;
+	struct stats_export_section *stats_export;
 };
 
 
@@ -434,6 +444,8 @@ struct gptp_ctx {
 	struct timer_ctx *timer_ctx;
 
 	struct timer stats_timer;
+	struct timer stats_export_timer;
+	bool stats_export;
 
 	void (*sync_indication)(struct gptp_sync_info *info);
 	void (*gm_indication)(struct gptp_gm_info *info);
@@ -474,7 +486,7 @@ const char *gptp_port_role2string(ptp_port_role_t port_role);
 void gptp_instance_priority_vector_update(void *data);
 
 struct ptp_u_scaled_ns *get_mean_link_delay(struct gptp_port *port);
-ptp_double get_neighbor_rate_ratio(struct gptp_port *port);
+ptp_ratio get_neighbor_rate_ratio(struct gptp_port *port);
 struct ptp_scaled_ns *get_delay_asymmetry(struct gptp_port *port);
 
 struct ptp_port_identity *get_port_identity(struct gptp_port *port);
@@ -108,14 +108,13 @@ static void offset_scaled_log_variance_handler(void *data, struct leaf *l, enum
 static void neighbor_rate_ratio_handler(void *data, struct leaf *l, enum node_operation operation, uint8_t *buf, uintptr_t base)
 {
 	struct gptp_port *port = (struct gptp_port *)base;
-	double ratio;
+	ptp_ratio ratio;
 	s32 ratio_s32;
 
 	switch (operation) {
 	case NODE_GET:
-		ratio = *((double *)((uintptr_t)port->c + (uintptr_t)l->val));
-		ratio = (ratio - 1.0) * POW_2_41;
-		ratio_s32 = (s32)ratio;
+		ratio = *((ptp_ratio *)((uintptr_t)port->c + (uintptr_t)l->val));
+		ratio_s32 = ptp_ratio_to_scaled_rate_offset(ratio);
 		os_memcpy(buf, &ratio_s32, sizeof(s32));
 		break;
 
@@ -282,4 +281,6 @@ __init void gptp_managed_objects_init(struct gptp_managed_objects *module, struc
 	LEAF_INIT(&module->port_parameter_statistics.port[0], txPdelayResponseCount, LEAF_UINT32, LEAF_R, (void *)offset_of(struct gptp_port_common, stats.num_tx_pdelayresp), ptp_port_common_handler, NULL);
 	LEAF_INIT(&module->port_parameter_statistics.port[0], txPdelayResponseFollowUpCount, LEAF_UINT32, LEAF_R, (void *)offset_of(struct gptp_port_common, stats.num_tx_pdelayrespfup), ptp_port_common_handler, NULL);
 	LEAF_INIT(&module->port_parameter_statistics.port[0], txAnnounceCount, LEAF_UINT32, LEAF_R, (void *)offset_of(struct gptp_port, stats.num_tx_announce), NULL, NULL);
+	LEAF_INIT(&module->port_parameter_statistics.port[0], pdelayDelayOutlierCount, LEAF_UINT32, LEAF_R, (void *)offset_of(struct gptp_port_common, stats.num_pdelay_delay_outliers), ptp_port_common_handler, NULL);
+	LEAF_INIT(&module->port_parameter_statistics.port[0], pdelayRateRatioOutlierCount, LEAF_UINT32, LEAF_R, (void *)offset_of(struct gptp_port_common, stats.num_pdelay_rate_ratio_outliers), ptp_port_common_handler, NULL);
 }
@@ -22,7 +22,7 @@
 #define GPTP_PARENT_PARAMETER_NUM_LEAVES 8
 #define GPTP_TIME_PROPERTIES_NUM_LEAVES 7
 #define GPTP_PORT_PARAMETER_DATA_SET_NUM_LEAVES 21
-#define GPTP_PORT_PARAMETER_STATS_NUM_LEAVES 17
+#define GPTP_PORT_PARAMETER_STATS_NUM_LEAVES 19
 
 
 /* Managed object tree definition, 802.1AS-2011, section 14 */
@@ -123,6 +123,8 @@ MODULE(gptp_managed_objects, GPTP_MAX_NODES,
 			LEAF(txPdelayResponseCount);
 			LEAF(txPdelayResponseFollowUpCount);
 			LEAF(txAnnounceCount);
+			LEAF(pdelayDelayOutlierCount);		/* Non standard */
+			LEAF(pdelayRateRatioOutlierCount);	/* Non standard */
 		);
 	);
 );
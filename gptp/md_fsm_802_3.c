@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -156,7 +156,7 @@ static void get_static_rate_ratio(struct gptp_port_common *port)
 {
 	struct ptp_port_params *params = &port->params;
 
-	params->neighbor_rate_ratio = 1.00;
+	params->neighbor_rate_ratio = PTP_RATIO_ONE;
 }
 
 
@@ -237,7 +237,7 @@ static struct ptp_follow_up_pdu * md_set_follow_up(struct gptp_port *port)
 	u64_to_u_scaled_ns(&sync_tx_ts_u_scaled_ns, port->sync_tx_ts);
 	u_scaled_ns_sub(&residence_and_delay_u_scaled_ns, &sync_tx_ts_u_scaled_ns, &md->sync_snd.upstreamTxTime);
 	u_scaled_ns_to_scaled_ns(&tmp_scaled_ns, &residence_and_delay_u_scaled_ns);
-	double_scaled_ns_mul(&tmp_scaled_ns, md->sync_snd.rateRatio, tmp_scaled_ns);
+	ptp_ratio_scaled_ns_mul(&tmp_scaled_ns, md->sync_snd.rateRatio, tmp_scaled_ns);
 	scaled_ns_to_u_scaled_ns(&residence_and_delay_u_scaled_ns, &tmp_scaled_ns);
 
 	scaled_ns_to_u_scaled_ns(&tmp_u_scaled_ns, &md->sync_snd.followUpCorrectionField);
@@ -313,7 +313,7 @@ static struct ptp_follow_up_pdu * md_set_follow_up(struct gptp_port *port)
 	/* 11.4.4.3.6 - The value of cumulativeScaledRateOffset is equal to (rateRatio - 1.0) x (2e41 ), truncated to the next smaller
     signed integer, where rateRatio is the ratio of the frequency of the grandMaster to the frequency of the
     LocalClock entity in the time-aware system that sends the message */
-	msg->tlv.cumulative_scaled_rate_offset = htonl((s32)((md->sync_snd.rateRatio - 1.0) * (1ULL << 41)));
+	msg->tlv.cumulative_scaled_rate_offset = htonl(ptp_ratio_to_scaled_rate_offset(md->sync_snd.rateRatio));
 
 	/* 11.2.14.2.3 g) */
 	/* 11.4.4.3.7 - The value of gmTimeBaseIndicator is the timeBaseIndicator of the ClockSource entity for the current
@@ -628,16 +628,21 @@ static int md_pdelay_req_is_resp_fup_valid(struct ptp_md_entity_pdelay_req_sm *s
 */
 
 /** Computes the rate ratio between this node and the remote end of the link (IEEE 802.1AS-2020 section 11.2.19.3.3)
+ * Non standard: the rate ratio is the least squares fit over the last pdelay turnarounds (instead of the last two),
+ * excluding outliers (e.g. responses delayed on a congested link).
  */
 
 #define MAX_RATE_RATIO_DEVIATION	0.01
 
-static int md_pdelay_req_compute_pdelay_rate_ratio(struct gptp_port_common *port, ptp_double *rate_ratio)
+static int md_pdelay_req_compute_pdelay_rate_ratio(struct gptp_port_common *port, ptp_ratio *rate_ratio)
 {
 	struct ptp_md_entity_pdelay_req_sm *sm = &port->md.pdelay_req_sm;
 	struct gptp_ctx *gptp = port->gptp;
 	u64 corrected_responder_event_timestamp, pdelay_response_event_ingress_timestamp;
+	double rr = ptp_ratio_to_double(*rate_ratio);
 	int phase_discont = 0;
+	int restart = 1;
+	int rc;
 
 	os_log(LOG_DEBUG, "Port(%u)\n", port->port_id);
 
@@ -667,15 +672,28 @@ static int md_pdelay_req_compute_pdelay_rate_ratio(struct gptp_port_common *port
 		&& (corrected_responder_event_timestamp > sm->prev_corrected_responder_event_timestamp)) {
 
 			/*
-			 * r = (t3 - t3') / (t4 - t4')
+			 * r = (t3 - t3') / (t4 - t4'), fitted over the estimation window
 			 */
-			*rate_ratio = ((ptp_double)corrected_responder_event_timestamp - sm->prev_corrected_responder_event_timestamp)
-					/ (pdelay_response_event_ingress_timestamp - sm->prev_pdelay_response_event_ingress_timestamp);
+			rc = pdelay_est_rate_ratio(&port->pdelay_est, corrected_responder_event_timestamp, pdelay_response_event_ingress_timestamp, &rr);
+			if (rc > 0) {
+				port->stats.num_pdelay_rate_ratio_outliers++;
+				os_log(LOG_DEBUG, "Port(%u): rate ratio outlier rejected\n", port->port_id);
+			}
+
+			restart = 0;
 
-			if (os_fabs(1 - *rate_ratio) > MAX_RATE_RATIO_DEVIATION) {
-				os_log(LOG_ERR, "Port(%u): NeighborRateRatio %1.16f ignored\n", port->port_id, *rate_ratio);
-				*rate_ratio = 1;
+			/* No usable estimate (estimation restarted), keep the rate ratio invalid until the next turnaround */
+			if (rc < 0) {
+				sm->neighborRateRatioValid = FALSE;
+				goto exit;
 			}
+
+			if (os_fabs(1 - rr) > MAX_RATE_RATIO_DEVIATION) {
+				os_log(LOG_ERR, "Port(%u): NeighborRateRatio %1.16f ignored\n", port->port_id, rr);
+				rr = 1;
+			}
+
+			*rate_ratio = ptp_ratio_from_double(rr);
 			sm->neighborRateRatioValid = TRUE;
 		}
 		else
@@ -686,9 +704,13 @@ static int md_pdelay_req_compute_pdelay_rate_ratio(struct gptp_port_common *port
 			port->port_id, sm->prev_pdelay_response_event_ingress_timestamp, sm->prev_corrected_responder_event_timestamp);
 	os_log(LOG_DEBUG, "Port(%u): pdelay_response_event_ingress_timestamp(%"PRIu64") corrected_responder_event_timestamp(%"PRIu64")\n",
 			port->port_id, pdelay_response_event_ingress_timestamp, corrected_responder_event_timestamp);
-	os_log(LOG_DEBUG, "Port(%u): NeighborRateRatio %1.16f (%f ppb)\n", port->port_id, *rate_ratio, (*rate_ratio - 1)*1000000000);
+	os_log(LOG_DEBUG, "Port(%u): NeighborRateRatio %1.16f (%f ppb)\n", port->port_id, rr, (rr - 1)*1000000000);
 
 exit:
+	/* Timestamps not comparable with the previous ones, restart estimation from the current ones */
+	if (restart)
+		pdelay_est_rate_ratio_restart(&port->pdelay_est, corrected_responder_event_timestamp, pdelay_response_event_ingress_timestamp);
+
 	/*
 	 * Save timings.
 	 * t3' = sm->prev_pdelay_response_event_ingress_timestamp
@@ -703,15 +725,17 @@ exit:
 
 
 /** Computes the mean propagation delay on the link attached to MD entity (11.2.15.2.4)
- *
+ * Non standard: delay samples far from the median of the last pdelay turnarounds are not used.
  */
-static void md_pdelay_req_compute_prop_time(struct gptp_port_common *port, ptp_double r, struct ptp_u_scaled_ns *d)
+static void md_pdelay_req_compute_prop_time(struct gptp_port_common *port, ptp_ratio rate_ratio, struct ptp_u_scaled_ns *d)
 {
 	struct ptp_md_entity_pdelay_req_sm *sm = &port->md.pdelay_req_sm;
 	struct gptp_ctx *gptp = port->gptp;
 	struct ptp_timestamp ptp_ts;
+	ptp_double r = ptp_ratio_to_double(rate_ratio);
 	ptp_double delay, raw_delay;
 	ptp_double current_delay_ns, previous_delay_ns;
+	bool invalid = false;
 
 	os_log(LOG_DEBUG, "Port(%u)\n", port->port_id);
 
@@ -758,9 +782,17 @@ static void md_pdelay_req_compute_prop_time(struct gptp_port_common *port, ptp_d
 			if (raw_delay < (-MAX_MEASURE_ERROR_NS)) {
 				os_log(LOG_DEBUG, "invalid pdelay %4.2f\n", raw_delay);
 				raw_delay += 0xFFFFFFFF;
+				invalid = true;
 			}
 		}
 
+		/* Invalid values must still go through, to make the link not asCapable */
+		if (!invalid && pdelay_est_delay(&port->pdelay_est, raw_delay)) {
+			port->stats.num_pdelay_delay_outliers++;
+			os_log(LOG_DEBUG, "Port(%u): PDelay outlier %4.2f ns rejected\n", port->port_id, raw_delay);
+			return;
+		}
+
 		delay = filter(&sm->pdelay_filter, raw_delay);
 		ptp_double_to_u_scaled_ns(d, delay);
 		os_log(LOG_DEBUG, "Port(%u): PDelay %4.2f ns (%4.2f ns)\n", port->port_id, delay, raw_delay);
@@ -850,7 +882,7 @@ static void md_pdelay_req_sm_initial_send(struct gptp_port_common *port)
 	u64 pdelay_req_interval_ns;
 
 	sm->initPdelayRespReceived = FALSE;
-	params->neighbor_rate_ratio = 1.0;
+	params->neighbor_rate_ratio = PTP_RATIO_ONE;
 	sm->rcvdMDTimestampReceive = FALSE;
 	sm->lostResponses = 0;
 	globals->isMeasuringDelay = FALSE;
@@ -860,6 +892,7 @@ static void md_pdelay_req_sm_initial_send(struct gptp_port_common *port)
 	sm->prev_corrected_responder_event_timestamp = PTP_TS_UNSET_U64_VALUE;
 	sm->neighborRateRatioValid = FALSE;
 	filter_exp_decay_init(&sm->pdelay_filter, PDELAY_EXP_FILTER_DECAY);
+	pdelay_est_delay_reset(&port->pdelay_est);
 	//filter_mean_init(&sm->.pdelay_filter, PDELAY_MEAN_FILTER_WINDOW);
 
 	sm->pdelayReqSequenceId = sequence_id_random();
@@ -971,6 +1004,7 @@ static void md_pdelay_req_sm_waiting_interval(struct gptp_port_common*port)
 		gptp_as_capable_across_domains_up(port);
 	} else {
 		filter_reset(&sm->pdelay_filter);
+		pdelay_est_delay_reset(&port->pdelay_est);
 		gptp_as_capable_across_domains_down(port);
 	}
 
@@ -1382,8 +1416,8 @@ static struct md_sync_receive * md_sync_rcv_set_md_sync_receive(struct gptp_port
 
 	/* rateRatio is set equal to the quantity (cumulativeScaledRateOffset x 2^-41 )+1.0, where the
 	cumulativeScaledRateOffset field is for the most recently received Follow_Up message (see 11.4.4.3.6) */
-	md->sync_rcv.rateRatio = ((double)(s32)ntohl(fup->tlv.cumulative_scaled_rate_offset) / (1ULL << 41)) + 1.0;
-	os_log(LOG_DEBUG, "Port(%u): rateRatio %1.16f\n", port->port_id, md->sync_rcv.rateRatio);
+	md->sync_rcv.rateRatio = ptp_ratio_from_scaled_rate_offset((s32)ntohl(fup->tlv.cumulative_scaled_rate_offset));
+	os_log(LOG_DEBUG, "Port(%u): rateRatio %1.16f\n", port->port_id, ptp_ratio_to_double(md->sync_rcv.rateRatio));
 
 	/* upstreamTxTime is set equal to the <syncEventIngressTimestamp> for the most recently received
 	Sync message, minus the mean propagation time on the link attached to this port
@@ -1401,7 +1435,7 @@ static struct md_sync_receive * md_sync_rcv_set_md_sync_receive(struct gptp_port
 		md->sync_rcv.upstreamTxTime.u.s.fractional_nanoseconds);
 
 	scaled_ns_to_ptp_double(&delay_asymmetry_double, get_delay_asymmetry(port));
-	ptp_double_to_u_scaled_ns(&tmp_u_scaled_ns, (delay_asymmetry_double / md->sync_rcv.rateRatio));
+	ptp_double_to_u_scaled_ns(&tmp_u_scaled_ns, (delay_asymmetry_double / ptp_ratio_to_double(md->sync_rcv.rateRatio)));
 	u_scaled_ns_sub(&md->sync_rcv.upstreamTxTime, &md->sync_rcv.upstreamTxTime, &tmp_u_scaled_ns);
 
 	os_log(LOG_DEBUG, "Port(%u): upstreamTxTime %u:%"PRIu64":%u\n", port->port_id,
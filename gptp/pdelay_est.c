@@ -0,0 +1,279 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Path delay and neighbor rate ratio estimation
+ @details Windowed least squares rate ratio and median/MAD outlier rejection, over the last pdelay turnarounds.
+*/
+
+#include "pdelay_est.h"
+
+#include "common/log.h"
+#include "os/stdlib.h"
+#include "os/string.h"
+
+/* Scales the MAD into a standard deviation estimate, for normally distributed samples */
+#define MAD_TO_SIGMA	1.4826
+
+/** Median of an array of samples, the array is sorted in place
+ * \return	median value
+ * \param v	array of samples
+ * \param n	number of samples (must be > 0)
+ */
+static double median(double *v, unsigned int n)
+{
+	unsigned int i, j;
+	double tmp;
+
+	/* insertion sort, arrays are small */
+	for (i = 1; i < n; i++) {
+		tmp = v[i];
+
+		for (j = i; (j > 0) && (v[j - 1] > tmp); j--)
+			v[j] = v[j - 1];
+
+		v[j] = tmp;
+	}
+
+	if (n & 1)
+		return v[n / 2];
+	else
+		return (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+/** Median and outlier rejection threshold of an array of samples, the array is modified
+ * \param v		array of samples
+ * \param n		number of samples (must be > 0)
+ * \param med		pointer to the returned median value
+ * \param thresh	pointer to the returned rejection threshold (maximum distance to the median)
+ */
+static void median_threshold(double *v, unsigned int n, double *med, double *thresh)
+{
+	unsigned int i;
+
+	*med = median(v, n);
+
+	for (i = 0; i < n; i++)
+		v[i] = os_fabs(v[i] - *med);
+
+	*thresh = CFG_GPTP_PDELAY_OUTLIER_MAD_FACTOR * MAD_TO_SIGMA * median(v, n);
+	if (*thresh < CFG_GPTP_PDELAY_OUTLIER_MIN_THRESH)
+		*thresh = CFG_GPTP_PDELAY_OUTLIER_MIN_THRESH;
+}
+
+static unsigned int rr_index(struct pdelay_est *est, unsigned int i)
+{
+	return (est->rr_pos + est->window - est->rr_count + i) % est->window;
+}
+
+/* Coordinates of a (t3, t4) pair, relative to the oldest pair in the window.
+ * y is the responder time deviation from the local time, to keep double precision for the fit.
+ */
+static void rr_point(struct pdelay_est *est, unsigned int index, double *x, double *y)
+{
+	unsigned int ref = rr_index(est, 0);
+
+	*x = (double)(s64)(est->t4[index] - est->t4[ref]);
+	*y = (double)(s64)((est->t3[index] - est->t3[ref]) - (est->t4[index] - est->t4[ref]));
+}
+
+/** Least squares fit of y = a + b * x over the inlier pairs in the window
+ * \return	number of pairs used
+ * \param est	pointer to the estimator
+ * \param skip	window index of a pair to exclude from the fit, or CFG_GPTP_MAX_PDELAY_WINDOW
+ * \param a	pointer to the returned intercept
+ * \param b	pointer to the returned slope
+ */
+static unsigned int rr_fit(struct pdelay_est *est, unsigned int skip, double *a, double *b)
+{
+	double x, y, sx = 0, sy = 0, sxx = 0, sxy = 0, d;
+	unsigned int i, index, n = 0;
+
+	for (i = 0; i < est->rr_count; i++) {
+		index = rr_index(est, i);
+
+		if ((index == skip) || est->outlier[index])
+			continue;
+
+		rr_point(est, index, &x, &y);
+
+		sx += x;
+		sy += y;
+		sxx += x * x;
+		sxy += x * y;
+		n++;
+	}
+
+	*a = 0;
+	*b = 0;
+
+	if (n < 2)
+		goto exit;
+
+	d = n * sxx - sx * sx;
+	if (d <= 0)
+		goto exit;
+
+	*b = (n * sxy - sx * sy) / d;
+	*a = (sy - *b * sx) / n;
+
+exit:
+	return n;
+}
+
+/** Checks if the last (t3, t4) pair is an outlier, based on the fit over the previous inlier pairs
+ * \return	1 if the pair is an outlier, 0 otherwise
+ * \param est	pointer to the estimator
+ * \param last	window index of the last pair
+ */
+static int rr_is_outlier(struct pdelay_est *est, unsigned int last)
+{
+	double residual[CFG_GPTP_MAX_PDELAY_WINDOW];
+	double a, b, x, y, med, thresh;
+	unsigned int i, index, n = 0;
+
+	if (rr_fit(est, last, &a, &b) < CFG_GPTP_PDELAY_OUTLIER_MIN_SAMPLES)
+		return 0;
+
+	for (i = 0; i < est->rr_count; i++) {
+		index = rr_index(est, i);
+
+		if ((index == last) || est->outlier[index])
+			continue;
+
+		rr_point(est, index, &x, &y);
+		residual[n++] = y - (a + b * x);
+	}
+
+	median_threshold(residual, n, &med, &thresh);
+
+	rr_point(est, last, &x, &y);
+
+	return (os_fabs(y - (a + b * x) - med) > thresh);
+}
+
+static void rr_add(struct pdelay_est *est, u64 t3, u64 t4)
+{
+	est->t3[est->rr_pos] = t3;
+	est->t4[est->rr_pos] = t4;
+	est->outlier[est->rr_pos] = false;
+
+	est->rr_pos = (est->rr_pos + 1) % est->window;
+	if (est->rr_count < est->window)
+		est->rr_count++;
+}
+
+/** Restarts rate ratio estimation from a single (t3, t4) pair.
+ * Used when the previous timestamps can no longer be compared with new ones (phase discontinuity, link down, ...)
+ * \param est	pointer to the estimator
+ * \param t3	corrected responder event timestamp, in ns
+ * \param t4	pdelay response event ingress timestamp, in ns
+ */
+void pdelay_est_rate_ratio_restart(struct pdelay_est *est, u64 t3, u64 t4)
+{
+	est->rr_count = 0;
+	est->rr_pos = 0;
+
+	rr_add(est, t3, t4);
+}
+
+/** Adds a (t3, t4) pair and computes the neighbor rate ratio.
+ * \return	0 on success, 1 if the new pair was rejected as an outlier (rate ratio computed over the previous pairs),
+ *		-1 if there are not enough pairs to compute the rate ratio (rate_ratio is left untouched)
+ * \param est		pointer to the estimator
+ * \param t3		corrected responder event timestamp, in ns
+ * \param t4		pdelay response event ingress timestamp, in ns
+ * \param rate_ratio	pointer to the returned rate ratio
+ */
+int pdelay_est_rate_ratio(struct pdelay_est *est, u64 t3, u64 t4, double *rate_ratio)
+{
+	unsigned int last = est->rr_pos;
+	unsigned int i, outliers = 0;
+	double a, b;
+	int rc = 0;
+
+	rr_add(est, t3, t4);
+
+	if (rr_is_outlier(est, last)) {
+		est->outlier[last] = true;
+		rc = 1;
+
+		for (i = 0; i < est->rr_count; i++)
+			if (est->outlier[rr_index(est, i)])
+				outliers++;
+
+		/* Most of the window rejected, the neighbor time base most likely changed */
+		if (2 * outliers > est->rr_count) {
+			os_log(LOG_INFO, "rate ratio outliers %u/%u, restarting estimation\n", outliers, est->rr_count);
+			pdelay_est_rate_ratio_restart(est, t3, t4);
+			return -1;
+		}
+	}
+
+	if (rr_fit(est, CFG_GPTP_MAX_PDELAY_WINDOW, &a, &b) < 2)
+		return -1;
+
+	*rate_ratio = 1.0 + b;
+
+	return rc;
+}
+
+/** Drops all path delay samples.
+ * \param est	pointer to the estimator
+ */
+void pdelay_est_delay_reset(struct pdelay_est *est)
+{
+	est->delay_count = 0;
+	est->delay_pos = 0;
+}
+
+/** Adds a raw path delay sample.
+ * All samples are kept in the window, so that a persistent path delay change is accepted once it affects
+ * most of the window.
+ * \return	1 if the sample is an outlier and should not be used, 0 otherwise
+ * \param est	pointer to the estimator
+ * \param delay	raw path delay, in ns
+ */
+int pdelay_est_delay(struct pdelay_est *est, double delay)
+{
+	double v[CFG_GPTP_MAX_PDELAY_WINDOW];
+	double med, thresh;
+	int rc = 0;
+
+	if (est->delay_count >= CFG_GPTP_PDELAY_OUTLIER_MIN_SAMPLES) {
+		os_memcpy(v, est->delay, est->delay_count * sizeof(double));
+
+		median_threshold(v, est->delay_count, &med, &thresh);
+
+		if (os_fabs(delay - med) > thresh)
+			rc = 1;
+	}
+
+	est->delay[est->delay_pos] = delay;
+
+	est->delay_pos = (est->delay_pos + 1) % est->window;
+	if (est->delay_count < est->window)
+		est->delay_count++;
+
+	return rc;
+}
+
+/** Initializes the estimator.
+ * \param est		pointer to the estimator
+ * \param window	number of pdelay turnarounds used for estimation, clipped to
+ *			[CFG_GPTP_MIN_PDELAY_WINDOW, CFG_GPTP_MAX_PDELAY_WINDOW]
+ */
+void pdelay_est_init(struct pdelay_est *est, unsigned int window)
+{
+	if (window < CFG_GPTP_MIN_PDELAY_WINDOW)
+		window = CFG_GPTP_MIN_PDELAY_WINDOW;
+	else if (window > CFG_GPTP_MAX_PDELAY_WINDOW)
+		window = CFG_GPTP_MAX_PDELAY_WINDOW;
+
+	os_memset(est, 0, sizeof(*est));
+	est->window = window;
+}
@@ -0,0 +1,50 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Path delay and neighbor rate ratio estimation header file
+ @details Windowed estimators with outlier rejection, used by the MDPdelayReq state machine.
+*/
+
+#ifndef _PDELAY_EST_H_
+#define _PDELAY_EST_H_
+
+#include "common/types.h"
+
+#include "config.h"
+
+/**
+ * Path delay and neighbor rate ratio estimator.
+ * Keeps the last pdelay turnarounds in fixed size rings:
+ * - rate ratio: (t3, t4) timestamp pairs, the rate ratio is the least squares slope over the inlier pairs.
+ *   A new pair is an outlier if it is too far from the line fitted over the previous inlier pairs.
+ * - path delay: raw delay samples, a new sample is an outlier if it is too far from the window median.
+ * In both cases the rejection threshold is a multiple of the median absolute deviation (MAD).
+ */
+struct pdelay_est {
+	unsigned int window;
+
+	/* rate ratio */
+	u64 t3[CFG_GPTP_MAX_PDELAY_WINDOW];
+	u64 t4[CFG_GPTP_MAX_PDELAY_WINDOW];
+	bool outlier[CFG_GPTP_MAX_PDELAY_WINDOW];
+	unsigned int rr_count;
+	unsigned int rr_pos;
+
+	/* path delay */
+	double delay[CFG_GPTP_MAX_PDELAY_WINDOW];
+	unsigned int delay_count;
+	unsigned int delay_pos;
+};
+
+void pdelay_est_init(struct pdelay_est *est, unsigned int window);
+void pdelay_est_rate_ratio_restart(struct pdelay_est *est, u64 t3, u64 t4);
+int pdelay_est_rate_ratio(struct pdelay_est *est, u64 t3, u64 t4, double *rate_ratio);
+void pdelay_est_delay_reset(struct pdelay_est *est);
+int pdelay_est_delay(struct pdelay_est *est, double delay);
+
+#endif /* _PDELAY_EST_H_ */
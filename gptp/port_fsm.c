@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -160,7 +160,7 @@ e) the function argument rateRatio is set equal to the local variable rateRatio
 invoking setPSSyncReceive (see Figure 10-4). The rateRatio member of the PortSyncSync structure
 is then set equal to the function argument rateRatio.
 */
-static struct port_sync_sync * sync_rcv_set_pssync_pssr(struct gptp_port *port, struct md_sync_receive *sync_rcv, struct ptp_u_scaled_ns syncReceiptTimeoutInterval, ptp_double rateRatio)
+static struct port_sync_sync * sync_rcv_set_pssync_pssr(struct gptp_port *port, struct md_sync_receive *sync_rcv, struct ptp_u_scaled_ns syncReceiptTimeoutInterval, ptp_ratio rateRatio)
 {
 	struct ptp_port_sync_entity *port_sync = &port->port_sync;
 	u64 timeout;
@@ -223,9 +223,9 @@ static void port_sync_sync_rcv_sm_mdsync_received(struct gptp_port *port)
 
 	port_sync->sync_receive_sm.rcvdMDSync = FALSE;
 	port_sync->sync_receive_sm.rateRatio = port_sync->sync_receive_sm.rcvdMDSyncPtr->rateRatio;
-	port_sync->sync_receive_sm.rateRatio += (get_neighbor_rate_ratio(port) - 1.0);
+	port_sync->sync_receive_sm.rateRatio = ptp_ratio_add_offset(port_sync->sync_receive_sm.rateRatio, get_neighbor_rate_ratio(port));
 
-	os_log(LOG_DEBUG, "Port(%u): rateRatio %1.16f\n", port->port_id, port_sync->sync_receive_sm.rateRatio);
+	os_log(LOG_DEBUG, "Port(%u): rateRatio %1.16f\n", port->port_id, ptp_ratio_to_double(port_sync->sync_receive_sm.rateRatio));
 
 	sync_receipt_timeout_time_interval = (ptp_double)((u64)port->sync_receipt_timeout *  log_to_ns(port_sync->sync_receive_sm.rcvdMDSyncPtr->logMessageInterval));
 	ptp_double_to_u_scaled_ns(&port->params.sync_receipt_timeout_time_interval, sync_receipt_timeout_time_interval);
@@ -262,7 +262,7 @@ int port_sync_sync_rcv_sm(struct gptp_port *port, ptp_port_sync_sync_rcv_sm_even
 	!port->params.as_capable)) {
 		/* FIXME Where else should this go?
 		   (This is not required by the spec but needed for hardware clock adjustment) */
-		port->port_sync.sync_receive_sm.rateRatio = 1.0;
+		port->port_sync.sync_receive_sm.rateRatio = PTP_RATIO_ONE;
 
 		port_sync_sync_rcv_sm_discard(port);
 		goto exit;
@@ -1057,6 +1057,9 @@ static void port_announce_transmit_sm_transmit_init(struct gptp_port *port)
 
 	sm->number_announce_transmissions = 0;
 
+	/* interval2 is only set on transmission, the IDLE state entered from here needs a valid period */
+	sm->interval2 = port->params.announce_interval;
+
 	sm->state = PORT_ANNOUNCE_TRANSMIT_SM_STATE_TRANSMIT_INIT;
 }
 
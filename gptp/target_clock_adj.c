@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2019-2021, 2023 NXP
+* Copyright 2019-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -16,6 +16,7 @@
 #include "common/ptp.h"
 #include "common/ptp_time_ops.h"
 #include "common/stats.h"
+#include "common/stats_export.h"
 #include "common/log.h"
 #include "os/stdlib.h"
 
@@ -27,6 +28,7 @@
 static void target_clkadj_params_unlock(struct target_clkadj_params *target_clkadj_params)
 {
 	target_clkadj_params->state = TARGET_PLL_UNLOCKED;
+	clock_servo_reset(&target_clkadj_params->servo);
 }
 
 static void target_clkadj_params_reset(struct target_clkadj_params *target_clkadj_params)
@@ -37,7 +39,7 @@ static void target_clkadj_params_reset(struct target_clkadj_params *target_clkad
 	target_clkadj_params->freq_change = 1;
 	target_clkadj_params->last_ppb = 0;
 
-	target_clkadj_params->local_clock->rate_ratio_adjustment = 1.0 + target_clkadj_params->last_ppb / 1.0e9;
+	target_clkadj_params->local_clock->rate_ratio_adjustment = ptp_ratio_from_ppb(target_clkadj_params->last_ppb);
 
 	if (target_clkadj_params->mode & OS_CLOCK_ADJUST_MODE_HW_OFFSET)
 		target_clkadj_params->local_clock->phase_discont++;
@@ -58,16 +60,79 @@ void target_clkadj_dump_stats(struct target_clkadj_params *target_clkadj_params)
 	stats_compute(freq_stats);
 	stats_compute(diff_stats);
 
-	os_log(LOG_INFO_RAW, "domain(%u, %u) Correction applied to target clock (ppb): min %6d avg %6d max %6d variance %5"PRIu64"\n",
-		target_clkadj_params->instance_index, target_clkadj_params->domain, freq_stats->min, freq_stats->mean, freq_stats->max, freq_stats->variance);
+	os_log(LOG_INFO_RAW, "domain(%u, %u) Correction applied to target clock (ppb): min %6d avg %6d max %6d variance %5"PRIu64" (servo %s)\n",
+		target_clkadj_params->instance_index, target_clkadj_params->domain, freq_stats->min, freq_stats->mean, freq_stats->max, freq_stats->variance,
+		clock_servo_name(&target_clkadj_params->servo));
 
-	os_log(LOG_INFO_RAW, "domain(%u, %u) Offset between GM and target clock (ns):  min %6d avg %6d max %6d variance %5"PRIu64"\n",
-		target_clkadj_params->instance_index, target_clkadj_params->domain, diff_stats->min, diff_stats->mean, diff_stats->max, diff_stats->variance);
+	os_log(LOG_INFO_RAW, "domain(%u, %u) Offset between GM and target clock (ns):  min %6d avg %6d max %6d variance %5"PRIu64" (servo %s)\n",
+		target_clkadj_params->instance_index, target_clkadj_params->domain, diff_stats->min, diff_stats->mean, diff_stats->max, diff_stats->variance,
+		clock_servo_name(&target_clkadj_params->servo));
 
 	stats_reset(freq_stats);
 	stats_reset(diff_stats);
 }
 
+static const char * const target_clkadj_counter_names[] = {
+	"State",
+	"FreqAdjustPpb",
+	"OffsetNs",
+};
+
+static const char * const target_clkadj_hist_names[] = {
+	"OffsetAbsNs",
+};
+
+/** Allocates the target clock adjustment statistics export section
+ * \return	none
+ * \param target_clkadj_params	pointer to the adjustments parameters structure
+ */
+void target_clkadj_stats_export_init(struct target_clkadj_params *target_clkadj_params)
+{
+	struct stats_export_id id = {
+		.name = "gptp_target_clock",
+		.label = {
+			{ .name = "domain", .value = target_clkadj_params->instance_index },
+		},
+		.n_labels = 1,
+	};
+
+	target_clkadj_params->stats_export = stats_export_alloc(&id, target_clkadj_counter_names, 3, target_clkadj_hist_names, 1);
+}
+
+/** Frees the target clock adjustment statistics export section
+ * \return	none
+ * \param target_clkadj_params	pointer to the adjustments parameters structure
+ */
+void target_clkadj_stats_export_exit(struct target_clkadj_params *target_clkadj_params)
+{
+	if (target_clkadj_params->stats_export)
+		stats_export_free(target_clkadj_params->stats_export);
+}
+
+/** Publishes target clock adjustment statistics
+ * \return	none
+ * \param target_clkadj_params	pointer to the adjustments parameters structure
+ */
+void target_clkadj_stats_export(struct target_clkadj_params *target_clkadj_params)
+{
+	struct stats_export_section *s = target_clkadj_params->stats_export;
+	s64 *counters;
+
+	if (!s)
+		return;
+
+	stats_export_begin(s);
+
+	counters = stats_export_counters(s);
+	counters[0] = target_clkadj_params->state;
+	counters[1] = target_clkadj_params->last_ppb;
+	counters[2] = target_clkadj_params->last_err_ns;
+
+	stats_export_hist(s, 0, &target_clkadj_params->offset_hist);
+
+	stats_export_end(s);
+}
+
 
 /** Call to signal a domain grandmaster change
  * \return	none
@@ -99,9 +164,12 @@ void target_clkadj_system_role_change(struct target_clkadj_params *target_clkadj
  * \param target_clkadj_params	pointer to the adjustments parameters structure
  * \param clk_id 		clock identifier of the adjusted clock
  * \param local_clock		Local clock entity. Used to track target clock adjustment side effects on the local clock.
+ * \param servo_type		servo used to compute frequency adjustments, one of CFG_GPTP_SERVO_*
  */
-void target_clkadj_params_init(struct target_clkadj_params *target_clkadj_params, os_clock_id_t clk_id, struct ptp_local_clock_entity *local_clock, u8 instance_index, u8 domain)
+void target_clkadj_params_init(struct target_clkadj_params *target_clkadj_params, os_clock_id_t clk_id, struct ptp_local_clock_entity *local_clock, u8 instance_index, u8 domain, unsigned int servo_type)
 {
+	clock_servo_init(&target_clkadj_params->servo, servo_type);
+
 	target_clkadj_params->clock = clk_id;
 	target_clkadj_params->local_clock = local_clock;
 	target_clkadj_params->mode = os_clock_adjust_mode(clk_id);
@@ -111,6 +179,8 @@ void target_clkadj_params_init(struct target_clkadj_params *target_clkadj_params
 	target_clkadj_params->instance_index = instance_index;
 	target_clkadj_params->domain = domain;
 
+	hdr_hist_reset(&target_clkadj_params->offset_hist);
+
 	target_clkadj_params_reset(target_clkadj_params);
 }
 
@@ -124,7 +194,8 @@ void target_clkadj_params_exit(struct target_clkadj_params *target_clkadj_params
 }
 
 /**
- *  One slaving algorithm for the target clock, so it tracks grandmaster gptp clock phase:
+ *  Slaving algorithm for the target clock, so it tracks grandmaster gptp clock phase.
+ *  Once locked, frequency adjustments are computed by the domain servo (see clock_servo.c). The default servo is a
  *  2nd order PLL, type 2, which basically contains a PI controller:
  *  u(t) = e(t) * kp + integral (e(t)) * ki
  *  e(t) is the measured phase error between the grandmaster clock and our target clock (i.e, gptp time received in sync messages and the target time at which the message arrived)
@@ -177,19 +248,17 @@ void target_clkadj_params_exit(struct target_clkadj_params *target_clkadj_params
  * \param sync_receipt_local_time	64-bit local timestamp when the sync message is received
  * \param gm_rate_ratio		rate ratio between the local clock and the grandmaster conveyed within the sync message
  */
-int target_clock_adjust_on_sync(struct target_clkadj_params *target_clkadj_params, u64 sync_receipt_time, u64 sync_receipt_local_time, ptp_double gm_rate_ratio)
+int target_clock_adjust_on_sync(struct target_clkadj_params *target_clkadj_params, u64 sync_receipt_time, u64 sync_receipt_local_time, ptp_ratio gm_rate_ratio)
 {
-	s64 err_ns, dt_ns, err;
+	s64 err_ns, dt_ns;
 	s64 ppb;
 	u64 abs_err_ns;
 	int freq_change = 0;
 	int phase_change = 0;
 	s64 dt_local, ratio;
 
-#define _kp	2	/* kp = 1 / _kp */
-#define _ki	16	/* ki = 1 / _ki */
-
 	err_ns = sync_receipt_time - sync_receipt_local_time;
+	target_clkadj_params->last_err_ns = err_ns;
 	dt_ns = sync_receipt_time - target_clkadj_params->previous_receipt_time;
 	abs_err_ns = os_llabs(err_ns);
 
@@ -212,7 +281,7 @@ start:
 		if (!target_clkadj_params->mode) {
 
 			/* Lock immediately, gm_rate_ratio can be used as is (not dependent on local rate adjustment) */
-			ppb = (s64)(1.0e9 * (gm_rate_ratio - 1.0));
+			ppb = ptp_ratio_to_ppb(gm_rate_ratio);
 
 		} else {
 			/* Wait for two syncs, without an offset or rate adjustment, to get a good ratio estimate and trying to lock */
@@ -254,8 +323,7 @@ start:
 			phase_change = 1;
 		}
 
-		target_clkadj_params->integral = (ppb + 1000000000LL) * _ki;
-		err = 0;
+		clock_servo_start(&target_clkadj_params->servo, ppb);
 
 		target_clkadj_params->state = TARGET_PLL_LOCKED;
 
@@ -267,18 +335,13 @@ start:
 			goto start;
 		}
 
-		/*
-		 * PLL with PI filter
-		 *
-		 * integral(n) = integral(n-1) + (e(n - 1) + e(n)) / 2
-		 * u(n) = e(n) * kp + integral(n) * ki
-		 *
-		 * if e(n) is in nanoseconds, ppb(n) = u(n) - 10^9
-		 */
-		err = (err_ns * 1000000000LL) / dt_ns;
-		target_clkadj_params->integral += (err + target_clkadj_params->previous_err) / 2;
+		/* Duplicate or reordered sync, the servo needs a positive interval */
+		if (dt_ns <= 0) {
+			os_log(LOG_ERR, "domain(%u, %u) Invalid sync receipt interval: %"PRId64"\n", target_clkadj_params->instance_index, target_clkadj_params->domain, dt_ns);
+			goto exit;
+		}
 
-		ppb = ((err / _kp) + (target_clkadj_params->integral / _ki)) - 1000000000LL;
+		ppb = clock_servo_sample(&target_clkadj_params->servo, err_ns, dt_ns);
 
 		break;
 	}
@@ -289,14 +352,14 @@ start:
 		target_clkadj_params->last_ppb = ppb;
 	}
 
-	target_clkadj_params->previous_err = err;
-
-	os_log(LOG_DEBUG, "domain(%u, %u) err: %"PRId64", dt: %"PRId64", err_ppb: %"PRId64", integral_ppb: %lld, ppb: %"PRId64"\n",
-	target_clkadj_params->instance_index, target_clkadj_params->domain, err_ns, dt_ns, err / _kp, target_clkadj_params->integral / _ki - 1000000000LL, ppb);
+	os_log(LOG_DEBUG, "domain(%u, %u) servo %s err: %"PRId64", dt: %"PRId64", ppb: %"PRId64"\n",
+	target_clkadj_params->instance_index, target_clkadj_params->domain, clock_servo_name(&target_clkadj_params->servo), err_ns, dt_ns, ppb);
 
 	stats_update(&target_clkadj_params->freq_stats, ppb);
 	stats_update(&target_clkadj_params->diff_stats, err_ns);
 
+	hdr_hist_update(&target_clkadj_params->offset_hist, (os_llabs(err_ns) < 0xffffffff) ? os_llabs(err_ns) : 0xffffffff);
+
 exit:
 	target_clkadj_params->freq_change = freq_change;
 	target_clkadj_params->phase_change = phase_change;
@@ -305,7 +368,7 @@ exit:
 	target_clkadj_params->previous_receipt_local_time = sync_receipt_local_time;
 
 	if (freq_change && (target_clkadj_params->mode & OS_CLOCK_ADJUST_MODE_HW_RATIO)) {
-		target_clkadj_params->local_clock->rate_ratio_adjustment = 1.0 + target_clkadj_params->last_ppb / 1.0e9;
+		target_clkadj_params->local_clock->rate_ratio_adjustment = ptp_ratio_from_ppb(target_clkadj_params->last_ppb);
 		os_log(LOG_ERR, "domain(%u, %u) should no longer be executed\n", target_clkadj_params->instance_index, target_clkadj_params->domain);
 	}
 
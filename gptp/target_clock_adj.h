@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2019-2021, 2023 NXP
+* Copyright 2019-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -17,10 +17,12 @@
 #include "genavb/init.h"
 
 #include "common/stats.h"
+#include "common/stats_export.h"
 #include "common/ptp.h"
 #include "os/clock.h"
 
 #include "config.h"
+#include "clock_servo.h"
 
 #define PTP_PHASE_DISCONT_THRESHOLD	4000ULL // in ns
 
@@ -48,19 +50,25 @@ struct target_clkadj_params {
 	u64 previous_receipt_time;
 	u64 previous_receipt_local_time;
 
-	s64 integral;
-	s64 previous_err;
+	struct clock_servo servo;	/* computes frequency adjustments once locked */
 	s64 last_ppb;
+	s64 last_err_ns;		/* offset (grandmaster time - target clock time) measured on the last sync */
 
 	struct stats freq_stats;
 	struct stats diff_stats;
+
+	struct hdr_hist offset_hist;	/* absolute offset (ns), since init */
+	struct stats_export_section *stats_export;
 };
 
 
-void target_clkadj_params_init(struct target_clkadj_params *target_clkadj_params, os_clock_id_t clk_id, struct ptp_local_clock_entity *local_clock, u8 instance_index, u8 domain);
+void target_clkadj_params_init(struct target_clkadj_params *target_clkadj_params, os_clock_id_t clk_id, struct ptp_local_clock_entity *local_clock, u8 instance_index, u8 domain, unsigned int servo_type);
 void target_clkadj_params_exit(struct target_clkadj_params *target_clkadj_params);
-int target_clock_adjust_on_sync(struct target_clkadj_params *target_clkadj_params, u64 sync_receipt_time, u64 sync_receipt_local_time, ptp_double gm_rate_ratio);
+int target_clock_adjust_on_sync(struct target_clkadj_params *target_clkadj_params, u64 sync_receipt_time, u64 sync_receipt_local_time, ptp_ratio gm_rate_ratio);
 void target_clkadj_dump_stats(struct target_clkadj_params *target_clkadj_params);
+void target_clkadj_stats_export_init(struct target_clkadj_params *target_clkadj_params);
+void target_clkadj_stats_export_exit(struct target_clkadj_params *target_clkadj_params);
+void target_clkadj_stats_export(struct target_clkadj_params *target_clkadj_params);
 void target_clkadj_gm_change(struct target_clkadj_params *target_clkadj_params);
 void target_clkadj_system_role_change(struct target_clkadj_params *target_clkadj_params, unsigned int is_grandmaster);
 
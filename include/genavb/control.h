@@ -67,6 +67,8 @@ typedef enum {
 	GENAVB_MSG_MEDIA_STACK_UNBIND,		/**< Stream unbind message (from GenAVB stack to media stack/application). Valid in ::GENAVB_CTRL_AVDECC_MEDIA_STACK channel. */
 	GENAVB_MSG_ERROR_RESPONSE,		/**< Generic error response. Receive valid in all control channels. */
 	GENAVB_MSG_DEREGISTER_ALL,		/**< MSRP deregister all stream declarations command. Send valid in ::GENAVB_CTRL_MSRP channel. */
+	GENAVB_MSG_MAAP_CREATE_RANGES,		/**< MAAP create multiple ranges command. Send valid in ::GENAVB_CTRL_MAAP channel. */
+	GENAVB_MSG_MAAP_CREATE_RANGES_RESPONSE,	/**< MAAP create multiple ranges response. Receive valid in ::GENAVB_CTRL_MAAP channel. */
 	GENAVB_MSG_TYPE_MAX
 } genavb_msg_type_t;
 
@@ -156,6 +158,9 @@ int genavb_control_open(struct genavb_handle const *genavb, struct genavb_contro
 
 /** Send control message to the avb stack
  * \ingroup control
+ * Responses, if any, are returned by ::genavb_control_receive. On a ::GENAVB_CTRL_AVDECC_CONTROLLER channel, several AECP commands can be
+ * in flight at the same time (up to the controller entity max_inflights), the response to each command carrying the sequence_id used in the command.
+ * Commands sent while all the inflight entries are used are answered with a ::AECP_AEM_NO_RESOURCES status.
  * \return 		::GENAVB_SUCCESS or negative error code
  * \param handle	control handle returned by ::genavb_control_open.
  * \param msg_type	type of message sent.
@@ -1,5 +1,5 @@
 /*
- * Copyright 2021, 2023 NXP
+ * Copyright 2021, 2023, 2026 NXP
  * All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -10,7 +10,7 @@
  \brief GenAVB public control API
  \details MAAP control API definition for the GenAVB library
 
- \copyright Copyright 2021, 2023 NXP
+ \copyright Copyright 2021, 2023, 2026 NXP
 */
 
 #ifndef _GENAVB_PUBLIC_CONTROL_MAAP_API_H_
@@ -57,6 +57,29 @@ struct genavb_msg_maap_create {
 	avb_u8 base_address[6];		/**< First address of the range */
 };
 
+/**
+ * \ingroup control
+ * Maximum number of ranges in a ::GENAVB_MSG_MAAP_CREATE_RANGES command
+ */
+#define MAAP_CREATE_RANGES_MAX	64
+
+/**
+ * \ingroup control
+ * MAAP multiple ranges command.
+ * Allocates n_ranges ranges of count addresses, with consecutive range ids, as a single contiguous block of addresses.
+ * The block is probed and defended as one MAAP range (one PDU sequence and one set of timers), range i starts at
+ * base_address + i x count. Status indications are sent per range. Each range can be deleted independently with
+ * ::GENAVB_MSG_MAAP_DELETE_RANGE, the block addresses are released once all its ranges are deleted.
+ */
+struct genavb_msg_maap_create_ranges {
+	avb_u8 flag;		/**< Prefered block flag. 1 to allocate the block at base_address, 0 to let the stack choose it */
+	avb_u16 port_id;
+	avb_u32 range_id;	/**< Id of the first range, the ranges use ids range_id to (range_id + n_ranges - 1) */
+	avb_u16 n_ranges;	/**< Number of ranges. max = ::MAAP_CREATE_RANGES_MAX */
+	avb_u16 count;		/**< Number of consecutive addresses in each range. max n_ranges x count = 65024 */
+	avb_u8 base_address[6];		/**< First address of the block */
+};
+
 /**
  * \ingroup control
  * MAAP generic command
@@ -78,6 +101,19 @@ struct genavb_msg_maap_create_response {
 	avb_u8 base_address[6];		/**< First address of the range */
 };
 
+/**
+ * \ingroup control
+ * MAAP multiple ranges response
+ */
+struct genavb_msg_maap_create_ranges_response {
+	avb_u16 status;		/**< ::genavb_maap_response_status_t */
+	avb_u16 port_id;
+	avb_u32 range_id;	/**< Id of the first range */
+	avb_u16 n_ranges;	/**< Number of ranges */
+	avb_u16 count;		/**< Number of consecutive addresses in each range */
+	avb_u8 base_address[6];		/**< First address of the block, range i starts at base_address + i x count */
+};
+
 /**
  * \ingroup control
  * MAAP generic response
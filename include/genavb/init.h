@@ -1,5 +1,5 @@
 /*
- * Copyright 2018-2023 NXP
+ * Copyright 2018-2023, 2026 NXP
  * All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -61,6 +61,8 @@ struct avdecc_entity_config {
 	unsigned int max_listener_pairs;
 	unsigned int max_inflights;
 	unsigned int max_unsolicited_registrations;
+	unsigned int max_descriptor_cache;			/* Number of remote entity descriptors cached by a controller entity, 0 to disable */
+	unsigned int unsolicited_notification_interval;		/* Minimum interval (ms) between two async unsolicited notifications for a stream descriptor, capped to the Milan defaults, 0 for the Milan defaults */
 	bool milan_mode;
 	void *aem;
 };
@@ -156,6 +158,7 @@ struct fgptp_port_config {
 	/* For all domains */
 	uint8_t delayMechanism[CFG_MAX_GPTP_DOMAINS];
 	uint8_t allowedLostResponses;
+	uint8_t pdelayWindow;	/* number of pdelay turnarounds used for path delay and rate ratio estimation */
 };
 
 /**
@@ -169,6 +172,8 @@ struct fgptp_domain_config {
 	unsigned int clock_target;
 	unsigned int clock_source;
 
+	unsigned int servo;	/* target clock servo (CFG_GPTP_SERVO_*) */
+
 	/* Grandmaster params */
 	uint8_t gmCapable;	/* set to 1 if this device is grandmaster capable */
 	uint8_t priority1;
@@ -1,5 +1,5 @@
 /*
- * Copyright 2018, 2023 NXP
+ * Copyright 2018, 2023, 2026 NXP
  * All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -10,7 +10,7 @@
  \brief GenAVB public API
  \details Socket API definition for the GenAVB library
 
- \copyright Copyright 2018, 2023 NXP
+ \copyright Copyright 2018, 2023, 2026 NXP
 */
 
 #ifndef _GENAVB_PUBLIC_SOCKET_API_H_
@@ -82,6 +82,35 @@ int genavb_socket_tx(struct genavb_socket_tx *sock, void *buf, unsigned int len)
  */
 int genavb_socket_rx(struct genavb_socket_rx *sock, void *buf, unsigned int len, uint64_t *ts);
 
+/**
+ * \ingroup socket
+ * Socket batch receive, per socket parameters and results (see ::genavb_socket_batch_receive)
+ */
+struct genavb_socket_batch_rx {
+	struct genavb_socket_rx *sock;	/**< Socket handle, opened with ::GENAVB_SOCKF_ZEROCOPY */
+
+	void *buf;			/**< On return, pointer to the received data, NULL if none */
+	uint64_t ts;			/**< On return, receive timestamp */
+	int rc;				/**< On return, length of the received data (in bytes), or negative error code (as ::genavb_socket_rx) */
+};
+
+/** Socket batch zero-copy receive
+ * \ingroup socket
+ * Receives the next frame of each socket of the array, in a single call. The data is not copied, the frame stays in the
+ * stack receive buffer and remains valid until the next ::genavb_socket_batch_receive call with the same socket,
+ * ::genavb_socket_rx_release or ::genavb_socket_rx_close.
+ * \return		number of frames received, or negative error code.
+ * \param rx		array of sockets (and results)
+ * \param n		length of the rx array
+ */
+int genavb_socket_batch_receive(struct genavb_socket_batch_rx *rx, unsigned int n);
+
+/** Release the frame held by a zero-copy receive socket
+ * \ingroup socket
+ * \param sock		Socket handle
+ */
+void genavb_socket_rx_release(struct genavb_socket_rx *sock);
+
 /** Close rx socket
  * \ingroup socket
  * \param sock		Socket handle
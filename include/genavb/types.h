@@ -1,6 +1,6 @@
 /*
  * Copyright 2014-2016 Freescale Semiconductor, Inc.
- * Copyright 2023 NXP
+ * Copyright 2023, 2026 NXP
  * All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -12,7 +12,7 @@
  \details  Basic types OS abstraction.
 
  \copyright Copyright 2014 Freescale Semiconductor, Inc.
- \copyright Copyright 2023 NXP
+ \copyright Copyright 2023, 2026 NXP
 */
 #ifndef _GENAVB_PUBLIC_TYPES_H_
 #define _GENAVB_PUBLIC_TYPES_H_
@@ -41,7 +41,7 @@ struct genavb_timer;
  */
 typedef enum {
 	GENAVB_SOCKF_NONBLOCK = 0x01, /**< Non-blocking mode (only applies to receive socket) */
-	GENAVB_SOCKF_ZEROCOPY = 0x02, /**< Zero-copy mode (not implemented) */
+	GENAVB_SOCKF_ZEROCOPY = 0x02, /**< Zero-copy mode (only applies to receive socket, see ::genavb_socket_batch_receive) */
 	GENAVB_SOCKF_RAW = 0x04	      /**< Raw socket (only applies to transmit socket) */
 } genavb_sock_f_t;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright 2018, 2023 NXP
+ * Copyright 2018, 2023, 2026 NXP
  * All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -10,7 +10,7 @@
  \brief OS specific GenAVB public API
  \details OS specific API definition for the GenAVB library
 
- \copyright Copyright 2018, 2023 NXP
+ \copyright Copyright 2018, 2023, 2026 NXP
 */
 
 #ifndef _OS_GENAVB_PUBLIC_STREAMING_API_H_
@@ -84,4 +84,97 @@ int genavb_stream_receive_iov(struct genavb_stream_handle const *stream, struct
 int genavb_stream_send_iov(struct genavb_stream_handle const *stream, struct genavb_iovec const *data_iov, unsigned int data_iov_len, struct genavb_event const *event, unsigned int event_len);
 
 
+/** Maximum number of streams in a stream group */
+#define GENAVB_STREAM_GROUP_MAX	32
+
+struct genavb_stream_group;
+
+/** Stream group receive, per stream parameters and results (see ::genavb_stream_group_receive) */
+struct genavb_stream_group_rx {
+	struct genavb_iovec const *data_iov;	/**< iovec array where stream data is to be copied */
+	unsigned int data_iov_len;		/**< length of the data_iov array */
+	struct genavb_iovec const *event_iov;	/**< iovec array where events are to be copied, may be NULL */
+	unsigned int event_iov_len;		/**< length of the event_iov array */
+
+	int rc;					/**< On return, amount copied (in bytes), or negative error code (as ::genavb_stream_receive_iov) */
+	unsigned int event_len;			/**< On return, number of events copied to the event iovecs */
+};
+
+/** Stream group send, per stream parameters and results (see ::genavb_stream_group_send) */
+struct genavb_stream_group_tx {
+	struct genavb_iovec const *data_iov;	/**< iovec array containing the data to send, may be NULL (nothing to send on this stream) */
+	unsigned int data_iov_len;		/**< length of the data_iov array */
+	struct genavb_event const *event;	/**< event structure array timestamps/flags for the data to be sent */
+	unsigned int event_len;			/**< length of the event array */
+
+	int rc;					/**< On return, amount copied (in bytes), or negative error code (as ::genavb_stream_send_iov) */
+};
+
+/** Create a group of AVTP streams, serviced together by ::genavb_stream_group_receive or ::genavb_stream_group_send.
+ * A group services all its streams in a single system call, instead of one per stream. The streams must remain valid
+ * (not destroyed) as long as the group exists.
+ * \ingroup stream
+ * \return		::GENAVB_SUCCESS or negative error code.
+ * \param group		pointer to the group handle, returned on success.
+ * \param streams	array of stream handles returned by ::genavb_stream_create.
+ * \param n		length of the streams array (at most ::GENAVB_STREAM_GROUP_MAX).
+ */
+int genavb_stream_group_create(struct genavb_stream_group **group, struct genavb_stream_handle * const *streams, unsigned int n);
+
+
+/** Destroy a group of AVTP streams. The member streams are not destroyed.
+ * \ingroup stream
+ * \return		::GENAVB_SUCCESS or negative error code.
+ * \param group		group handle returned by ::genavb_stream_group_create.
+ */
+int genavb_stream_group_destroy(struct genavb_stream_group *group);
+
+
+/** Receive media data from all the listener streams of a group, in a single system call.
+ * Each stream is read as with ::genavb_stream_receive_iov, and its result returned in its rx entry.
+ * \ingroup stream
+ * \return		number of streams with data or events received, or negative error code (in which case no stream result is valid).
+ * \param group		group handle returned by ::genavb_stream_group_create.
+ * \param rx		array of per stream parameters/results, in the order of the streams at group creation.
+ */
+int genavb_stream_group_receive(struct genavb_stream_group *group, struct genavb_stream_group_rx *rx);
+
+
+/** Send media data on all the talker streams of a group, in a single system call.
+ * Each stream is written as with ::genavb_stream_send_iov, and its result returned in its tx entry.
+ * \ingroup stream
+ * \return		number of streams with data sent, or negative error code (in which case no stream result is valid).
+ * \param group		group handle returned by ::genavb_stream_group_create.
+ * \param tx		array of per stream parameters/results, in the order of the streams at group creation.
+ */
+int genavb_stream_group_send(struct genavb_stream_group *group, struct genavb_stream_group_tx *tx);
+
+
+/** Create the readiness notifier of a group of AVTP streams.
+ * The notifier is a single file descriptor for all the streams of the group, to be used with poll/select/epoll instead
+ * of the stream file descriptors (::genavb_stream_fd). It becomes readable once, when at least threshold streams
+ * became ready (data available for listener streams, space available for talker streams), e.g. a group of streams
+ * sharing the same media clock wakes up the application once per period, instead of once per stream.
+ * The ready streams are then retrieved with ::genavb_stream_group_ready.
+ * A stream can only be part of a single notifier. The notifier is closed by ::genavb_stream_group_destroy.
+ * \ingroup stream
+ * \return		notifier file descriptor, or negative error code.
+ * \param group		group handle returned by ::genavb_stream_group_create.
+ * \param threshold	number of ready streams for the notifier to become readable, 0 for all the streams of the group.
+ */
+int genavb_stream_group_notify_create(struct genavb_stream_group *group, unsigned int threshold);
+
+
+/** Retrieve the streams of a group which became ready, since the last call.
+ * Does not block, the group notifier file descriptor (::genavb_stream_group_notify_create) must be polled to wait.
+ * Each ready stream is reported once, the application should service all of them (e.g with
+ * ::genavb_stream_group_receive).
+ * \ingroup stream
+ * \return		::GENAVB_SUCCESS or negative error code.
+ * \param group		group handle returned by ::genavb_stream_group_create.
+ * \param ready		On return, bitmap of ready streams, bit n set for the stream at index n in the group.
+ */
+int genavb_stream_group_ready(struct genavb_stream_group *group, unsigned int *ready);
+
+
 #endif /* _OS_GENAVB_PUBLIC_STREAMING_API_H_ */
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -37,6 +37,7 @@
 #include "avb.h"
 #include "init.h"
 #include "log.h"
+#include "stats_shm.h"
 
 #if defined(CONFIG_AVDECC)
 #include "avdecc/config.h"
@@ -317,6 +318,12 @@ static int process_section_avdecc(struct _SECTIONENTRY *configtree, struct avdec
 			if (cfg_get_uint(configtree, section_name, "max_unsolicited_registratons", CFG_AECP_DEFAULT_NUM_UNSOLICITED, CFG_AECP_MIN_NUM_UNSOLICITED, CFG_AECP_MAX_NUM_UNSOLICITED, &entity_cfg->max_unsolicited_registrations))
 				goto err;
 
+			if (cfg_get_uint(configtree, section_name, "max_descriptor_cache", CFG_AECP_DEFAULT_DESCRIPTOR_CACHE, CFG_AECP_MIN_DESCRIPTOR_CACHE, CFG_AECP_MAX_DESCRIPTOR_CACHE, &entity_cfg->max_descriptor_cache))
+				goto err;
+
+			if (cfg_get_uint(configtree, section_name, "unsolicited_notification_interval", CFG_AECP_DEFAULT_NOTIFICATION_INTERVAL, CFG_AECP_MIN_NOTIFICATION_INTERVAL, CFG_AECP_MAX_NOTIFICATION_INTERVAL, &entity_cfg->unsolicited_notification_interval))
+				goto err;
+
 			if (cfg_get_uint(configtree, section_name, "channel_waitmask", 0, 0, 7, &entity_cfg->channel_waitmask))
 				goto err;
 
@@ -709,6 +716,9 @@ int main(int argc, char *argv[])
 	if (rc)
 		os_log(LOG_ERR, "pthread_sigmask(): %s\n", strerror(rc));
 
+	/* Before the stack threads allocate their statistics sections */
+	stats_shm_create("avb");
+
 	if (endpoint_init(avb) < 0)
 		goto err_endpoint_init;
 
@@ -760,6 +770,7 @@ int main(int argc, char *argv[])
 	endpoint_exit(avb);
 
 err_endpoint_init:
+	stats_shm_destroy();
 
 	os_exit();
 
@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -66,6 +66,7 @@ static struct os_clock os_clock[OS_CLOCK_MAX] = {
  * when calling into ->gettime_sw(), ->setfreq(), ->setoffset() and so on...
  */
 static pthread_mutex_t os_clock_mutex;
+static bool os_clock_time_page = true;	/* system.cfg [CLOCK] time_page */
 
 static int clock_gettime64_hw(struct os_clock *c, u64 *ns);
 
@@ -163,6 +164,68 @@ pass_through:
 	return ns_hw;
 }
 
+/*
+ * Hardware clock adjustment currently applied, in ppb.
+ * PHC clocks adjust the hardware clock directly, software clocks track the hardware clock adjustments in ppb_internal.
+ */
+static s32 clock_hw_ppb(struct os_clock *c)
+{
+	if (c->type == CLOCK_TYPE_SW)
+		return -c->ppb_internal;
+	else
+		return c->ppb;
+}
+
+/*
+ * Creates the time page of a clock on its first adjustment, so that only the process adjusting the clock
+ * (the gPTP stack) publishes it.
+ * Note:
+ * - os_clock_mutex must be held before entering this function
+ */
+static void __clock_page_publish(struct os_clock *c)
+{
+	if (!(c->flags & OS_CLOCK_FLAGS_TIME_PAGE) || c->page_w.page || c->page_w.failed)
+		return;
+
+	if (clock_page_create(&c->page_w, c - os_clock) < 0)
+		return;
+
+	if (clock_xts_init(&c->xts, c->clk_device ? c->fd : -1, c->id, CLOCK_XTS_AUTO) < 0) {
+		os_log(LOG_ERR, "clock_id(0x%x) cross timestamp not supported\n", c->id);
+		clock_page_destroy(&c->page_w, c - os_clock);
+		c->page_w.failed = true;
+	}
+}
+
+/*
+ * Updates the time page of a clock, after a clock adjustment
+ * Note:
+ * - os_clock_mutex must be held before entering this function
+ */
+static void __clock_page_update(struct os_clock *c, bool step, bool hw_step)
+{
+	u64 mono, hw;
+	double ratio;
+
+	if (!c->page_w.page)
+		return;
+
+	if (clock_xts_update(&c->xts, clock_hw_ppb(c), hw_step, &mono, &hw) < 0) {
+		/* Stale page, readers fall back to the system call */
+		clock_page_update(&c->page_w, 0, 0, 0, step);
+		return;
+	}
+
+	ratio = c->xts.ratio;
+	if (c->sw_clk.sw.mul)
+		ratio = ratio * c->sw_clk.sw.mul / (double)((u64)1 << c->sw_clk.sw.shift);
+
+	clock_page_update(&c->page_w, mono, __clock_time_from_hw(c, hw), ratio, step);
+
+	if ((mono - c->xts.stats.period_start) >= CLOCK_XTS_STATS_PERIOD)
+		clock_xts_stats_print(&c->xts, c - os_clock);
+}
+
 static int clock_gettime64_sw(struct os_clock *c, u64 *ns)
 {
 	int err;
@@ -207,6 +270,9 @@ int clock_setoffset_sw(struct os_clock *c, s64 offset)
 
 	c->sw_clk.sw.t0 += offset;
 
+	__clock_page_publish(c);
+	__clock_page_update(c, true, false);
+
 	pthread_mutex_unlock(&os_clock_mutex);
 
 	return 0;
@@ -248,6 +314,9 @@ static int clock_setfreq_sw(struct os_clock *c, int32_t ppb)
 
 	__clock_setfreq_sw(c, ppb + c->ppb_internal, t0_hw);
 
+	__clock_page_publish(c);
+	__clock_page_update(c, false, false);
+
 unlock:
 	pthread_mutex_unlock(&os_clock_mutex);
 
@@ -346,9 +415,14 @@ static int clock_setfreq_hw(struct os_clock *c, s32 ppb)
 
 		os_log(LOG_DEBUG, "clock_id(0x%x) adjusted sw frequency by %d ppb\n",
 				 _c->id, _c->ppb - delta_ppb);
+
+		__clock_page_update(_c, false, false);
 	}
 
 	c->ppb = ppb;
+
+	__clock_page_publish(c);
+	__clock_page_update(c, false, false);
 unlock:
 	pthread_mutex_unlock(&os_clock_mutex);
 
@@ -390,8 +464,13 @@ static int clock_setoffset_hw(struct os_clock *c, s64 offset)
 
 		os_log(LOG_DEBUG, "clock_id(0x%x) adjusted hw.t0 offset by %"PRId64" ns\n",
 				 _c->id, offset);
+
+		__clock_page_update(_c, false, true);
 	}
 
+	__clock_page_publish(c);
+	__clock_page_update(c, true, true);
+
 unlock:
 	pthread_mutex_unlock(&os_clock_mutex);
 
@@ -454,6 +533,11 @@ static int _os_clock_init(os_clock_id_t clk_id)
 		break;
 	}
 
+	if (os_clock_time_page
+	    && (((clk_id >= OS_CLOCK_GPTP_EP_0_0) && (clk_id <= OS_CLOCK_GPTP_EP_1_1))
+		|| ((clk_id >= OS_CLOCK_GPTP_BR_0_0) && (clk_id <= OS_CLOCK_GPTP_BR_0_1))))
+		c->flags |= OS_CLOCK_FLAGS_TIME_PAGE;
+
 	if (c->clk_device) {
 		c->fd = open(c->clk_device, O_RDWR);
 		if (c->fd < 0) {
@@ -491,6 +575,9 @@ static int _os_clock_exit(os_clock_id_t clk_id)
 	if (c->fd >= 0)
 		close(c->fd);
 
+	clock_page_destroy(&c->page_w, clk_id);
+	clock_page_close(&c->page_r);
+
 	return 0;
 
 err:
@@ -569,6 +656,10 @@ int os_clock_init(struct os_clock_config *config)
 
 	os_clock_config_init(config);
 
+	os_clock_time_page = config->time_page;
+	if (!os_clock_time_page)
+		os_log(LOG_INIT, "clock time pages disabled, gPTP clocks read with system calls\n");
+
 	for (i = 0; i < OS_CLOCK_MAX; i++)
 		_os_clock_init(i);
 
@@ -588,11 +679,19 @@ void os_clock_exit(void)
 int os_clock_gettime32(os_clock_id_t clk_id, u32 *ns)
 {
 	struct os_clock *c;
+	u64 val;
 
 	c = clock_id_to_clock(clk_id);
 	if (!c)
 		goto err;
 
+	/* Clock adjusted by another process, read the time page it publishes (without system call) */
+	if ((c->flags & OS_CLOCK_FLAGS_TIME_PAGE) && clock_page_is_reader(&c->page_w)
+	    && !clock_page_gettime(&c->page_r, clk_id, &val)) {
+		*ns = (u32)val;
+		return 0;
+	}
+
 	if (c->gettime32)
 		return c->gettime32(c, ns);
 
@@ -608,6 +707,11 @@ int os_clock_gettime64(os_clock_id_t clk_id, u64 *ns)
 	if (!c)
 		goto err;
 
+	/* Clock adjusted by another process, read the time page it publishes (without system call) */
+	if ((c->flags & OS_CLOCK_FLAGS_TIME_PAGE) && clock_page_is_reader(&c->page_w)
+	    && !clock_page_gettime(&c->page_r, clk_id, ns))
+		return 0;
+
 	if (c->gettime64)
 		return c->gettime64(c, ns);
 
@@ -764,3 +868,37 @@ int clock_time_from_hw(os_clock_id_t clk_id, uint64_t hw_ns, uint64_t *ns)
 err:
 	return -1;
 }
+
+/**
+ * Reads the cross timestamp calibration statistics of a clock
+ * Only available for the clocks whose time page is published by this process (see __clock_page_publish()).
+ * \param clk_id	clock id.
+ * \param stats		pointer to the statistics copy.
+ * \param osc_ppb	pointer to the PHC oscillator rate offset, in ppb.
+ * \return		0 on success, or negative value on error.
+ */
+int clock_xts_stats_get(os_clock_id_t clk_id, struct clock_xts_stats *stats, s32 *osc_ppb)
+{
+	struct os_clock *c;
+
+	c = clock_id_to_clock(clk_id);
+	if (!c)
+		goto err;
+
+	pthread_mutex_lock(&os_clock_mutex);
+
+	if (!c->page_w.page) {
+		pthread_mutex_unlock(&os_clock_mutex);
+		goto err;
+	}
+
+	*stats = c->xts.stats;
+	*osc_ppb = c->xts.osc_mono ? (s32)(((c->xts.osc / c->xts.osc_mono) - 1.0) * NSECS_PER_SEC) : 0;
+
+	pthread_mutex_unlock(&os_clock_mutex);
+
+	return 0;
+
+err:
+	return -1;
+}
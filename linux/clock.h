@@ -1,5 +1,5 @@
 /*
-* Copyright 2019-2021, 2023 NXP
+* Copyright 2019-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -18,6 +18,9 @@
 #include "os_config.h"
 #include "os/clock.h"
 
+#include "clock_page.h"
+#include "clock_xts.h"
+
 enum clock_type {
 	CLOCK_TYPE_SYSTEM = 1,
 	CLOCK_TYPE_PHC,
@@ -30,6 +33,8 @@ enum clock_type {
 #define OS_CLOCK_FLAGS_HW_OFFSET (1 << 1)
 /* Clock is a local clock */
 #define OS_CLOCK_FLAGS_IS_LOCAL  (1 << 2)
+/* Clock time is shared through a time page (see clock_page.h) */
+#define OS_CLOCK_FLAGS_TIME_PAGE (1 << 3)
 
 struct os_sw_clock {
 
@@ -64,6 +69,11 @@ struct os_clock {
 	int32_t ppb; /* current frequency adjustment configuration */
 	int32_t ppb_internal;	/* adjustment between sw clock and local clock */
 
+	/* time page, published if the clock is adjusted by this process, read otherwise */
+	struct clock_page_writer page_w;
+	struct clock_page_reader page_r;
+	struct clock_xts xts;	/* hardware clock calibration, for the published time page */
+
 	int (*gettime32)(struct os_clock *c, u32 *ns);
 	int (*gettime64)(struct os_clock *c, u64 *ns);
 	int (*setfreq)(struct os_clock *c, s32 ppb);
@@ -71,6 +81,7 @@ struct os_clock {
 };
 
 int clock_time_from_hw(os_clock_id_t id, uint64_t hw_ns, uint64_t *ns);
+int clock_xts_stats_get(os_clock_id_t id, struct clock_xts_stats *stats, s32 *osc_ppb);
 int os_clock_gettime64_of_parent(os_clock_id_t id, u64 *ns);
 
 int os_clock_init(struct os_clock_config *config);
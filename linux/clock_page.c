@@ -0,0 +1,296 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Linux shared memory clock time pages
+ @details
+*/
+
+#define _GNU_SOURCE
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "common/log.h"
+
+#include "clock_page.h"
+
+#define CLOCK_PAGE_PATH_MAX	64
+
+static void clock_page_path(char *path, unsigned int id)
+{
+	snprintf(path, CLOCK_PAGE_PATH_MAX, CLOCK_PAGE_PATH, id);
+}
+
+static u64 clock_page_mono(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+	return (u64)now.tv_sec * NSECS_PER_SEC + now.tv_nsec;
+}
+
+/** Reads the clock time from a time page
+ * \return	0 on success, -1 if the page can not be used now, -2 if the page is stale
+ * \param page	pointer to time page
+ * \param ns	pointer to the clock time, in ns
+ */
+int clock_page_read(const struct clock_page *page, u64 *ns)
+{
+	u64 mono, mono_ref, ns_ref, mult;
+	unsigned int shift;
+	u32 seq;
+	int i;
+
+	for (i = 0; i < CLOCK_PAGE_READ_RETRY; i++) {
+		seq = __atomic_load_n(&page->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1)
+			continue;
+
+		mono_ref = page->mono_ref;
+		ns_ref = page->ns_ref;
+		mult = page->mult;
+		shift = page->shift;
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if (__atomic_load_n(&page->seq, __ATOMIC_RELAXED) != seq)
+			continue;
+
+		mono = clock_page_mono();
+
+		/* Also bounds the multiplication below (no overflow up to ~4s) */
+		if ((mono < mono_ref) || ((mono - mono_ref) > CLOCK_PAGE_MAX_AGE))
+			return -2;
+
+		if (!mult)
+			return -1;
+
+		*ns = ns_ref + (((mono - mono_ref) * mult) >> shift);
+
+		return 0;
+	}
+
+	return -1;
+}
+
+static void clock_page_write_begin(struct clock_page *page)
+{
+	/* odd sequence, also if a previous instance stopped in the middle of an update */
+	__atomic_store_n(&page->seq, page->seq | 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void clock_page_write_end(struct clock_page *page)
+{
+	__atomic_store_n(&page->seq, page->seq + 1, __ATOMIC_RELEASE);
+}
+
+/** Creates the time page of a clock, for the process adjusting the clock
+ * \return	0 on success, -1 on error
+ * \param w	pointer to time page writer context
+ * \param id	clock id
+ */
+int clock_page_create(struct clock_page_writer *w, unsigned int id)
+{
+	char path[CLOCK_PAGE_PATH_MAX];
+	struct clock_page *page;
+	int fd;
+
+	clock_page_path(path, id);
+
+	fd = open(path, O_RDWR | O_CREAT, 0644);
+	if (fd < 0) {
+		os_log(LOG_ERR, "open(%s) failed: %s\n", path, strerror(errno));
+		goto err_open;
+	}
+
+	if (ftruncate(fd, sizeof(struct clock_page)) < 0) {
+		os_log(LOG_ERR, "ftruncate(%s) failed: %s\n", path, strerror(errno));
+		goto err_truncate;
+	}
+
+	page = mmap(NULL, sizeof(struct clock_page), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (page == MAP_FAILED) {
+		os_log(LOG_ERR, "mmap(%s) failed: %s\n", path, strerror(errno));
+		goto err_mmap;
+	}
+
+	close(fd);
+
+	/* Invalidate a page left by a previous instance, until the first update */
+	clock_page_write_begin(page);
+	page->version = CLOCK_PAGE_VERSION;
+	page->mult = 0;
+	clock_page_write_end(page);
+
+	memset(w, 0, sizeof(*w));
+
+	/* Other threads of the publisher stop reading the page (see clock_page_is_reader()) */
+	__atomic_store_n(&w->page, page, __ATOMIC_RELEASE);
+
+	os_log(LOG_INIT, "clock id: %u, time page %s\n", id, path);
+
+	return 0;
+
+err_mmap:
+err_truncate:
+	close(fd);
+
+err_open:
+	w->failed = true;
+
+	return -1;
+}
+
+/** Destroys the time page of a clock. Readers detect the page is no longer updated (stale) and map the next one.
+ * \param w	pointer to time page writer context
+ * \param id	clock id
+ */
+void clock_page_destroy(struct clock_page_writer *w, unsigned int id)
+{
+	char path[CLOCK_PAGE_PATH_MAX];
+
+	if (!w->page)
+		return;
+
+	munmap(w->page, sizeof(struct clock_page));
+	w->page = NULL;
+
+	clock_page_path(path, id);
+	unlink(path);
+}
+
+/** Updates the time page of a clock
+ * \param w	pointer to time page writer context
+ * \param mono	CLOCK_MONOTONIC_RAW time, in ns
+ * \param ns	clock time, at mono, in ns
+ * \param ratio	clock rate relative to CLOCK_MONOTONIC_RAW, 0 if unknown (readers use the clock system call)
+ * \param step	true if the clock time was stepped since the last update
+ */
+void clock_page_update(struct clock_page_writer *w, u64 mono, u64 ns, double ratio, bool step)
+{
+	struct clock_page *page = w->page;
+
+	clock_page_write_begin(page);
+
+	page->mono_ref = mono;
+	page->ns_ref = ns;
+	page->mult = (u64)(ratio * (double)((u64)1 << CLOCK_PAGE_SHIFT));
+	page->shift = CLOCK_PAGE_SHIFT;
+
+	if (step)
+		page->generation++;
+
+	clock_page_write_end(page);
+}
+
+/** Maps the time page of a clock, published by another process.
+ * Attempts are rate limited to one every CLOCK_PAGE_OPEN_RETRY, and done by a single thread at a time (other threads
+ * keep using the current page, or the clock system call).
+ * A page replaced by a new one (publisher restarted) is not unmapped, as other threads may still be reading it.
+ * \return	0 on success, -1 on error
+ * \param r	pointer to time page reader context
+ * \param id	clock id
+ */
+int clock_page_open(struct clock_page_reader *r, unsigned int id)
+{
+	char path[CLOCK_PAGE_PATH_MAX];
+	struct clock_page *page;
+	struct stat st;
+	u64 now;
+	int fd;
+	int rc = -1;
+
+	if (__atomic_test_and_set(&r->opening, __ATOMIC_ACQUIRE))
+		goto exit;
+
+	now = clock_page_mono();
+	if (now < r->retry)
+		goto unlock;
+
+	r->retry = now + CLOCK_PAGE_OPEN_RETRY;
+
+	clock_page_path(path, id);
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		goto unlock;
+
+	/* Page being created */
+	if ((fstat(fd, &st) < 0) || (st.st_size < (off_t)sizeof(struct clock_page)))
+		goto close;
+
+	/* Still the same page */
+	if (r->page && (r->ino == st.st_ino)) {
+		rc = 0;
+		goto close;
+	}
+
+	page = mmap(NULL, sizeof(struct clock_page), PROT_READ, MAP_SHARED, fd, 0);
+	if (page == MAP_FAILED)
+		goto close;
+
+	if (__atomic_load_n(&page->version, __ATOMIC_ACQUIRE) != CLOCK_PAGE_VERSION) {
+		munmap(page, sizeof(struct clock_page));
+		goto close;
+	}
+
+	r->ino = st.st_ino;
+	__atomic_store_n(&r->page, page, __ATOMIC_RELEASE);
+
+	rc = 0;
+
+close:
+	close(fd);
+
+unlock:
+	__atomic_clear(&r->opening, __ATOMIC_RELEASE);
+
+exit:
+	return rc;
+}
+
+/** Unmaps the time page of a clock. Must not be called while other threads may be reading the page.
+ * \param r	pointer to time page reader context
+ */
+void clock_page_close(struct clock_page_reader *r)
+{
+	if (!r->page)
+		return;
+
+	munmap((void *)r->page, sizeof(struct clock_page));
+	r->page = NULL;
+}
+
+/** Reads the clock time from the time page published by another process
+ * \return	0 on success, negative if the page is not available (the caller must read the clock directly)
+ * \param r	pointer to time page reader context
+ * \param id	clock id
+ * \param ns	pointer to the clock time, in ns
+ */
+int clock_page_gettime(struct clock_page_reader *r, unsigned int id, u64 *ns)
+{
+	const struct clock_page *page = __atomic_load_n(&r->page, __ATOMIC_ACQUIRE);
+	int rc = -1;
+
+	if (page)
+		rc = clock_page_read(page, ns);
+
+	/* No page yet, or publisher stopped/restarted, look for the current page */
+	if (!page || (rc == -2))
+		clock_page_open(r, id);
+
+	return rc;
+}
@@ -0,0 +1,80 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Linux shared memory clock time pages
+ @details The process adjusting a gPTP clock (the gPTP stack) publishes, for that clock, a shared memory page mapping
+ CLOCK_MONOTONIC_RAW time to the clock time. The page is refreshed after each frequency or offset adjustment of the
+ clock (or of its hardware clock), from the hardware clock calibration (see clock_xts.h).
+ Other processes (the AVB stack, applications through the public API) then read the clock time with a CLOCK_MONOTONIC_RAW
+ read (handled in the vDSO, without system call) and a few loads, instead of a clock_gettime() system call on the PHC.
+
+ The clock rate relative to CLOCK_MONOTONIC_RAW is the hardware clock rate (from the calibration), times the software
+ clock ratio (for software clocks).
+
+ The page is updated under a sequence counter (odd while being written). Readers fall back to the system call while
+ the page is missing, has no rate estimate yet, is older than CLOCK_PAGE_MAX_AGE (the clock is no longer adjusted),
+ or keeps being updated.
+*/
+
+#ifndef _LINUX_CLOCK_PAGE_H_
+#define _LINUX_CLOCK_PAGE_H_
+
+#include <stdbool.h>
+
+#include "os/sys_types.h"
+#include "os/clock.h"
+
+#define CLOCK_PAGE_PATH		"/dev/shm/genavb_clock_%u"
+#define CLOCK_PAGE_VERSION	1
+
+#define CLOCK_PAGE_MAX_AGE	(1ULL * NSECS_PER_SEC)	/* readers fall back to the clock system call after */
+#define CLOCK_PAGE_OPEN_RETRY	(1ULL * NSECS_PER_SEC)	/* minimum time between two reader open attempts */
+#define CLOCK_PAGE_READ_RETRY	4
+#define CLOCK_PAGE_SHIFT	32
+
+struct clock_page {
+	u32 version;
+	u32 seq;		/* sequence counter, odd while the page is being written */
+	u32 generation;		/* incremented on each clock time step */
+	u32 shift;
+	u64 mono_ref;		/* CLOCK_MONOTONIC_RAW reference time, ns */
+	u64 ns_ref;		/* clock time at mono_ref, ns */
+	u64 mult;		/* clock rate relative to CLOCK_MONOTONIC_RAW, scaled by (1 << shift). 0 if unknown */
+};
+
+struct clock_page_writer {
+	struct clock_page *page;
+	bool failed;		/* page creation failed, not retried */
+};
+
+struct clock_page_reader {
+	const struct clock_page *page;
+	u64 ino;		/* page file inode */
+	u64 retry;		/* next open attempt, CLOCK_MONOTONIC_RAW ns */
+	bool opening;		/* open in progress, in another thread */
+};
+
+int clock_page_create(struct clock_page_writer *w, unsigned int id);
+void clock_page_destroy(struct clock_page_writer *w, unsigned int id);
+void clock_page_update(struct clock_page_writer *w, u64 mono, u64 ns, double ratio, bool step);
+
+int clock_page_open(struct clock_page_reader *r, unsigned int id);
+void clock_page_close(struct clock_page_reader *r);
+int clock_page_read(const struct clock_page *page, u64 *ns);
+int clock_page_gettime(struct clock_page_reader *r, unsigned int id, u64 *ns);
+
+/** Checks if the time page of a clock must be read by this process
+ * \return	true if this process does not publish the page
+ * \param w	pointer to time page writer context
+ */
+static inline bool clock_page_is_reader(struct clock_page_writer *w)
+{
+	return !__atomic_load_n(&w->page, __ATOMIC_RELAXED);
+}
+
+#endif /* _LINUX_CLOCK_PAGE_H_ */
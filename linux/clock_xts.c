@@ -0,0 +1,363 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Linux PHC/system clock cross timestamp calibration
+ @details
+*/
+
+#define _GNU_SOURCE
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <inttypes.h>
+#include <sys/ioctl.h>
+#include <linux/ptp_clock.h>
+
+#include "common/log.h"
+
+#include "clock_xts.h"
+
+static u64 clock_xts_ts_to_ns(const struct timespec *ts)
+{
+	return (u64)ts->tv_sec * NSECS_PER_SEC + ts->tv_nsec;
+}
+
+static u64 clock_xts_ptp_to_ns(const struct ptp_clock_time *t)
+{
+	return (u64)t->sec * NSECS_PER_SEC + t->nsec;
+}
+
+static u64 clock_xts_mono(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+	return clock_xts_ts_to_ns(&now);
+}
+
+static void clock_xts_stats_reset(struct clock_xts_stats *s, u64 now)
+{
+	s->period_start = now;
+	s->n = 0;
+	s->residual_min = INT64_MAX;
+	s->residual_max = INT64_MIN;
+	s->residual_abs_sum = 0;
+	s->delay_min = UINT64_MAX;
+	s->delay_max = 0;
+	s->delay_sum = 0;
+	s->delay_n = 0;
+}
+
+static int clock_xts_precise(struct clock_xts *x, u64 *mono, u64 *hw, u64 *delay)
+{
+	struct ptp_sys_offset_precise req;
+
+	memset(&req, 0, sizeof(req));
+
+	if (ioctl(x->fd, PTP_SYS_OFFSET_PRECISE, &req) < 0)
+		return -1;
+
+	*mono = clock_xts_ptp_to_ns(&req.sys_monoraw);
+	*hw = clock_xts_ptp_to_ns(&req.device);
+	*delay = 0;
+
+	return 0;
+}
+
+/* CLOCK_REALTIME minus CLOCK_MONOTONIC_RAW, in ns (from the vDSO reads with the smallest delay) */
+static s64 clock_xts_realtime_offset(void)
+{
+	struct timespec real;
+	u64 before, after, delay, delay_min = UINT64_MAX;
+	s64 offset = 0;
+	int i;
+
+	for (i = 0; i < 3; i++) {
+		before = clock_xts_mono();
+		clock_gettime(CLOCK_REALTIME, &real);
+		after = clock_xts_mono();
+
+		delay = after - before;
+		if (delay < delay_min) {
+			delay_min = delay;
+			offset = clock_xts_ts_to_ns(&real) - (before + delay / 2);
+		}
+	}
+
+	return offset;
+}
+
+static int clock_xts_extended(struct clock_xts *x, u64 *mono, u64 *hw, u64 *delay)
+{
+	struct ptp_sys_offset_extended req;
+	u64 before, after, d;
+	s64 offset = 0;
+	int i;
+
+	memset(&req, 0, sizeof(req));
+	req.n_samples = CLOCK_XTS_SAMPLES;
+
+	/* System clock selection (clockid field, Linux >= 6.12), otherwise CLOCK_REALTIME */
+	if (x->extended_monoraw)
+		req.rsv[0] = CLOCK_MONOTONIC_RAW;
+	else
+		offset = clock_xts_realtime_offset();
+
+	if (ioctl(x->fd, PTP_SYS_OFFSET_EXTENDED, &req) < 0)
+		return -1;
+
+	*delay = UINT64_MAX;
+
+	for (i = 0; i < req.n_samples; i++) {
+		before = clock_xts_ptp_to_ns(&req.ts[i][0]);
+		after = clock_xts_ptp_to_ns(&req.ts[i][2]);
+
+		d = after - before;
+		if (d < *delay) {
+			*delay = d;
+			*mono = before + d / 2 - offset;
+			*hw = clock_xts_ptp_to_ns(&req.ts[i][1]);
+		}
+	}
+
+	return 0;
+}
+
+static int clock_xts_syscall(struct clock_xts *x, u64 *mono, u64 *hw, u64 *delay)
+{
+	struct timespec now;
+	u64 before, after, d;
+	int i;
+
+	*delay = UINT64_MAX;
+
+	for (i = 0; i < CLOCK_XTS_SAMPLES; i++) {
+		before = clock_xts_mono();
+
+		if (clock_gettime(x->clk_id, &now) < 0)
+			return -1;
+
+		after = clock_xts_mono();
+
+		d = after - before;
+		if (d < *delay) {
+			*delay = d;
+			*mono = before + d / 2;
+			*hw = clock_xts_ts_to_ns(&now);
+		}
+	}
+
+	return 0;
+}
+
+/** Takes one CLOCK_MONOTONIC_RAW/PHC cross timestamp, with the calibration method.
+ * \return	0 on success, -1 on error
+ * \param x	pointer to calibration context
+ * \param mono	pointer to the CLOCK_MONOTONIC_RAW time, in ns
+ * \param hw	pointer to the PHC time, at mono, in ns
+ * \param delay	pointer to the read delay (cross timestamp uncertainty), in ns
+ */
+int clock_xts_sample(struct clock_xts *x, u64 *mono, u64 *hw, u64 *delay)
+{
+	switch (x->method) {
+	case CLOCK_XTS_PRECISE:
+		return clock_xts_precise(x, mono, hw, delay);
+
+	case CLOCK_XTS_EXTENDED:
+		return clock_xts_extended(x, mono, hw, delay);
+
+	case CLOCK_XTS_SYSCALL:
+		return clock_xts_syscall(x, mono, hw, delay);
+
+	default:
+		return -1;
+	}
+}
+
+static int clock_xts_probe(struct clock_xts *x, clock_xts_method_t method)
+{
+	u64 mono, hw, delay;
+
+	if ((x->fd < 0) && (method != CLOCK_XTS_SYSCALL))
+		return -1;
+
+	x->method = method;
+
+	if (method == CLOCK_XTS_EXTENDED) {
+		x->extended_monoraw = true;
+
+		if (!clock_xts_sample(x, &mono, &hw, &delay))
+			return 0;
+
+		/* Older kernel, CLOCK_REALTIME system time only */
+		if (errno != EINVAL)
+			return -1;
+
+		x->extended_monoraw = false;
+	}
+
+	return clock_xts_sample(x, &mono, &hw, &delay);
+}
+
+/** Initializes a PHC calibration
+ * \return		0 on success, -1 if the method is not supported
+ * \param x		pointer to calibration context
+ * \param fd		PHC device file descriptor, -1 if none (only system call cross timestamps)
+ * \param clk_id	PHC Linux clock id
+ * \param method	cross timestamp method, CLOCK_XTS_AUTO for the most precise one supported
+ */
+int clock_xts_init(struct clock_xts *x, int fd, int clk_id, clock_xts_method_t method)
+{
+	memset(x, 0, sizeof(*x));
+	x->fd = fd;
+	x->clk_id = clk_id;
+
+	if (method == CLOCK_XTS_AUTO) {
+		for (method = CLOCK_XTS_PRECISE; method < CLOCK_XTS_METHOD_MAX; method++)
+			if (!clock_xts_probe(x, method))
+				break;
+
+		if (method == CLOCK_XTS_METHOD_MAX)
+			goto err;
+	} else if (clock_xts_probe(x, method) < 0) {
+		goto err;
+	}
+
+	clock_xts_stats_reset(&x->stats, clock_xts_mono());
+
+	os_log(LOG_INIT, "clock id: 0x%x, cross timestamp method: %s%s\n", clk_id, clock_xts_method_str(x->method),
+	       ((x->method == CLOCK_XTS_EXTENDED) && !x->extended_monoraw) ? " (realtime)" : "");
+
+	return 0;
+
+err:
+	x->method = CLOCK_XTS_AUTO;
+
+	return -1;
+}
+
+/** Predicts the PHC time from the calibration
+ * \return	true on success, false if the calibration is not complete
+ * \param x	pointer to calibration context
+ * \param mono	CLOCK_MONOTONIC_RAW time, in ns
+ * \param hw	pointer to the PHC time, at mono, in ns
+ */
+bool clock_xts_predict(struct clock_xts *x, u64 mono, u64 *hw)
+{
+	if (!x->mono || !x->ratio)
+		return false;
+
+	*hw = x->hw + (s64)((double)(s64)(mono - x->mono) * x->ratio);
+
+	return true;
+}
+
+/** Updates the calibration with a new cross timestamp. Must be called after each PHC adjustment.
+ * \return		0 on success, -1 on error
+ * \param x		pointer to calibration context
+ * \param hw_ppb	PHC frequency adjustment, in ppb, now applied
+ * \param hw_step	true if the PHC time was stepped since the last update
+ * \param mono		pointer to the CLOCK_MONOTONIC_RAW time, in ns
+ * \param hw		pointer to the PHC time, at mono, in ns
+ */
+int clock_xts_update(struct clock_xts *x, s32 hw_ppb, bool hw_step, u64 *mono, u64 *hw)
+{
+	struct clock_xts_stats *s = &x->stats;
+	u64 delay, predicted, residual_abs;
+	s64 d_hw;
+
+	if (clock_xts_sample(x, mono, hw, &delay) < 0) {
+		s->errors++;
+		return -1;
+	}
+
+	s->samples++;
+	s->delay = delay;
+	if (delay < s->delay_min)
+		s->delay_min = delay;
+	if (delay > s->delay_max)
+		s->delay_max = delay;
+	s->delay_sum += delay;
+	s->delay_n++;
+
+	if (x->mono && !hw_step && (*mono > x->mono)) {
+		/* Residual error, against the rate applying since the last update */
+		if (clock_xts_predict(x, *mono, &predicted)) {
+			s->residual = *hw - predicted;
+			if (s->residual < s->residual_min)
+				s->residual_min = s->residual;
+			if (s->residual > s->residual_max)
+				s->residual_max = s->residual;
+			residual_abs = (s->residual < 0) ? -s->residual : s->residual;
+			s->residual_abs_sum += residual_abs;
+			s->n++;
+
+			s->residuals++;
+			s->residual_abs_total += residual_abs;
+			if (residual_abs > s->residual_abs_max)
+				s->residual_abs_max = residual_abs;
+		}
+
+		/* PHC oscillator rate, the adjustment applied during the interval removed */
+		d_hw = *hw - x->hw;
+
+		if (d_hw > 0) {
+			x->osc += (double)d_hw / (1.0 + x->hw_ppb / (double)NSECS_PER_SEC);
+			x->osc_mono += (double)(*mono - x->mono);
+
+			if (x->osc_mono > CLOCK_XTS_RATE_WINDOW) {
+				x->osc /= 2;
+				x->osc_mono /= 2;
+			}
+		}
+	}
+
+	x->mono = *mono;
+	x->hw = *hw;
+	x->hw_ppb = hw_ppb;
+
+	if (x->osc_mono >= CLOCK_XTS_RATE_MIN)
+		x->ratio = (x->osc / x->osc_mono) * (1.0 + hw_ppb / (double)NSECS_PER_SEC);
+	else
+		x->ratio = 0;
+
+	return 0;
+}
+
+/** Logs the calibration statistics, and starts a new statistics period
+ * \param x	pointer to calibration context
+ * \param id	clock id
+ */
+void clock_xts_stats_print(struct clock_xts *x, unsigned int id)
+{
+	struct clock_xts_stats *s = &x->stats;
+
+	os_log(LOG_INFO, "clock id: %u, cross timestamp (%s) samples %" PRIu64 " errors %" PRIu64 ", residual (ns) min %" PRId64 " max %" PRId64 " mean abs %" PRIu64 ", delay (ns) min %" PRIu64 " mean %" PRIu64 " max %" PRIu64 ", oscillator %+.3f ppm\n",
+	       id, clock_xts_method_str(x->method), s->samples, s->errors,
+	       s->n ? s->residual_min : 0, s->n ? s->residual_max : 0, s->n ? s->residual_abs_sum / s->n : 0,
+	       s->delay_n ? s->delay_min : 0, s->delay_n ? s->delay_sum / s->delay_n : 0, s->delay_max,
+	       x->osc_mono ? ((x->osc / x->osc_mono) - 1.0) * 1000000.0 : 0.0);
+
+	clock_xts_stats_reset(s, clock_xts_mono());
+}
+
+const char *clock_xts_method_str(clock_xts_method_t method)
+{
+	switch (method) {
+	case CLOCK_XTS_PRECISE:
+		return "precise";
+	case CLOCK_XTS_EXTENDED:
+		return "extended";
+	case CLOCK_XTS_SYSCALL:
+		return "syscall";
+	default:
+		return "none";
+	}
+}
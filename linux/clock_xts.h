@@ -0,0 +1,97 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Linux PHC/system clock cross timestamp calibration
+ @details Cross timestamps a hardware clock (PHC) against CLOCK_MONOTONIC_RAW, using the most precise method supported
+ by the PHC driver:
+ - PTP_SYS_OFFSET_PRECISE, hardware cross timestamp (e.g. PCIe PTM, ART), no read delay
+ - PTP_SYS_OFFSET_EXTENDED, system time read by the driver just before and after the PHC register read. The sample
+   with the smallest delay is kept.
+ - clock_gettime() system calls, the PHC read between two CLOCK_MONOTONIC_RAW reads. The sample with the smallest delay
+   is kept.
+
+ The calibration continuously estimates the PHC time offset and rate relative to CLOCK_MONOTONIC_RAW. The rate is the
+ PHC oscillator rate (known PHC adjustments removed), averaged over CLOCK_XTS_RATE_WINDOW, times the current PHC
+ adjustment. The residual error (each new cross timestamp minus the time predicted from the previous calibration) and
+ the cross timestamp delay are kept as statistics, logged periodically and exported by the stack process (see
+ stats_shm_clock_export()).
+*/
+
+#ifndef _LINUX_CLOCK_XTS_H_
+#define _LINUX_CLOCK_XTS_H_
+
+#include <stdbool.h>
+
+#include "os/sys_types.h"
+#include "os/clock.h"
+
+#define CLOCK_XTS_RATE_WINDOW	(16ULL * NSECS_PER_SEC)	/* PHC oscillator rate averaging */
+#define CLOCK_XTS_RATE_MIN	(100ULL * NSECS_PER_MS)	/* minimum measurement time before the rate is valid */
+#define CLOCK_XTS_STATS_PERIOD	(10ULL * NSECS_PER_SEC)
+#define CLOCK_XTS_SAMPLES	9			/* reads per cross timestamp (extended and system call methods) */
+
+typedef enum {
+	CLOCK_XTS_AUTO = 0,	/* most precise method supported */
+	CLOCK_XTS_PRECISE,	/* PTP_SYS_OFFSET_PRECISE */
+	CLOCK_XTS_EXTENDED,	/* PTP_SYS_OFFSET_EXTENDED */
+	CLOCK_XTS_SYSCALL,	/* clock_gettime() */
+	CLOCK_XTS_METHOD_MAX
+} clock_xts_method_t;
+
+struct clock_xts_stats {
+	u64 samples;
+	u64 errors;		/* cross timestamp failures */
+
+	/* last cross timestamp */
+	s64 residual;		/* PHC time minus predicted PHC time, in ns */
+	u64 delay;		/* read delay, in ns */
+
+	/* since the calibration start */
+	u64 residuals;		/* residuals computed */
+	u64 residual_abs_total;	/* sum of the absolute residuals, in ns */
+	u64 residual_abs_max;	/* in ns */
+
+	/* current period */
+	u64 period_start;	/* CLOCK_MONOTONIC_RAW, in ns */
+	unsigned int n;		/* residuals in the period */
+	s64 residual_min;
+	s64 residual_max;
+	u64 residual_abs_sum;
+	u64 delay_min;
+	u64 delay_max;
+	u64 delay_sum;
+	unsigned int delay_n;
+};
+
+struct clock_xts {
+	int fd;				/* PHC device, -1 if none */
+	int clk_id;			/* Linux clock id */
+	clock_xts_method_t method;
+	bool extended_monoraw;		/* PTP_SYS_OFFSET_EXTENDED returns CLOCK_MONOTONIC_RAW system time */
+
+	/* calibration, at the last cross timestamp */
+	u64 mono;			/* CLOCK_MONOTONIC_RAW time, in ns (0 if none) */
+	u64 hw;				/* PHC time, in ns */
+	s32 hw_ppb;			/* PHC adjustment, since the last cross timestamp */
+	double ratio;			/* PHC rate relative to CLOCK_MONOTONIC_RAW, 0 if unknown */
+
+	/* PHC oscillator rate measurement */
+	double osc;			/* PHC time elapsed, adjustments removed */
+	double osc_mono;		/* CLOCK_MONOTONIC_RAW time elapsed */
+
+	struct clock_xts_stats stats;
+};
+
+int clock_xts_init(struct clock_xts *x, int fd, int clk_id, clock_xts_method_t method);
+int clock_xts_sample(struct clock_xts *x, u64 *mono, u64 *hw, u64 *delay);
+int clock_xts_update(struct clock_xts *x, s32 hw_ppb, bool hw_step, u64 *mono, u64 *hw);
+bool clock_xts_predict(struct clock_xts *x, u64 mono, u64 *hw);
+void clock_xts_stats_print(struct clock_xts *x, unsigned int id);
+const char *clock_xts_method_str(clock_xts_method_t method);
+
+#endif /* _LINUX_CLOCK_XTS_H_ */
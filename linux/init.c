@@ -1,5 +1,5 @@
 /*
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -16,12 +16,14 @@
 #include "clock.h"
 #include "os_config.h"
 #include "net_logical_port.h"
+#include "net_shaper.h"
 #include "rtnetlink.h"
 
 __attribute__((weak)) int shmem_init(struct os_net_config *config) { return 0; };
 __attribute__((weak)) void shmem_exit(void) { };
 __attribute__((weak)) int net_init(struct os_net_config *config, struct os_xdp_config *xdp_config) { return 0; };
 __attribute__((weak)) void net_exit(void) { };
+__attribute__((weak)) void net_shaper_config_init(struct os_net_shaper_config *config) { };
 __attribute__((weak)) int fdb_init(struct os_net_config *config) { return 0; };
 __attribute__((weak)) void fdb_exit(void) { };
 __attribute__((weak)) int fqtss_init(struct os_net_config *config) { return 0; };
@@ -49,6 +51,8 @@ int os_init(struct os_net_config *net_config)
 
 	logical_port_init(&config.logical_port_config);
 
+	net_shaper_config_init(&config.net_shaper_config);
+
 	/*
 	* Clock layer global init.
 	*/
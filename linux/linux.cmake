@@ -24,11 +24,14 @@ genavb_add_executable(NAME ${avb}
   timer.c
   ipc.c
   clock.c
+  clock_page.c
+  clock_xts.c
   cfgfile.c
   epoll.c
   init.c
   os_config.c
   net_logical_port.c
+  stats_shm.c
   )
 
 set(genavb genavb)
@@ -38,6 +41,8 @@ genavb_add_shared_library(NAME ${genavb}
   ipc.c
   log.c
   clock.c
+  clock_page.c
+  clock_xts.c
   string.c
   stdlib.c
   epoll.c
@@ -58,6 +63,8 @@ genavb_add_executable(NAME ${tsn}
   log.c
   timer.c
   clock.c
+  clock_page.c
+  clock_xts.c
   cfgfile.c
   epoll.c
   ipc.c
@@ -66,17 +73,171 @@ genavb_add_executable(NAME ${tsn}
   os_config.c
   net_logical_port.c
   vlan.c
+  stats_shm.c
 )
 
 # Backward compatibility
 genavb_add_executable_alias("${tsn}" "fgptp")
 
+option(BUILD_GPTP_SIM "Build gPTP network simulator" OFF)
+
+if(CONFIG_GPTP AND BUILD_GPTP_SIM)
+  set(gptp_sim gptp-sim)
+  set(gptp_replay gptp-replay)
+endif()
+
+# gPTP stack running over simulated clocks, timers and links
+genavb_add_executable(NAME ${gptp_sim}
+  SRCS
+  sim/sim.c
+  sim/sim_net.c
+  sim/gptp_sim.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+# gPTP stack fed with captured frames
+genavb_add_executable(NAME ${gptp_replay}
+  SRCS
+  sim/sim.c
+  sim/sim_net.c
+  sim/pcap.c
+  sim/gptp_replay.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+option(BUILD_GPTP_TESTS "Build gPTP unit tests" OFF)
+
+if(CONFIG_GPTP AND BUILD_GPTP_TESTS)
+  set(ptp_ratio_test ptp-ratio-test)
+endif()
+
+# gPTP fixed point rate ratio operations, against a floating point reference
+genavb_add_executable(NAME ${ptp_ratio_test}
+  SRCS
+  sim/ptp_ratio_test.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+if(ptp_ratio_test)
+  target_compile_definitions(${ptp_ratio_test} PRIVATE CONFIG_GPTP_FIXED_POINT=1)
+
+  enable_testing()
+  add_test(NAME ${ptp_ratio_test} COMMAND ${ptp_ratio_test})
+endif()
+
+option(BUILD_CBS_SIM "Build transmit shaper and media clock recovery simulators" OFF)
+
+if(BUILD_CBS_SIM)
+  set(cbs_sim cbs-sim)
+  set(net_shaper_bench net-shaper-bench)
+  set(mclock_rec_sim mclock-rec-sim)
+endif()
+
+# AVB kernel module transmit scheduler, built in userspace
+genavb_add_executable(NAME ${cbs_sim}
+  SRCS
+  modules/avb/net_tx_sched.c
+  modules/avb/pi.c
+  ../freertos/rational.c
+  sim/cbs_sim.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+# Standard socket/AF_XDP backends software shaper
+genavb_add_executable(NAME ${net_shaper_bench}
+  SRCS
+  net_shaper.c
+  net_logical_port.c
+  sim/net_shaper_bench.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+# AVB kernel module media clock recovery control loop, built in userspace
+genavb_add_executable(NAME ${mclock_rec_sim}
+  SRCS
+  modules/avb/media_clock_rec_pll_ctrl.c
+  modules/avb/pi.c
+  ../freertos/rational.c
+  sim/mclock_rec_sim.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+option(BUILD_CLOCK_BENCH "Build clock read benchmark and PHC calibration tool" OFF)
+
+if(BUILD_CLOCK_BENCH)
+  set(clock_bench clock-bench)
+  set(phc_calib phc-calib)
+endif()
+
+# PHC system call and shared memory time page clock reads
+genavb_add_executable(NAME ${clock_bench}
+  SRCS
+  clock_page.c
+  clock_xts.c
+  sim/clock_bench.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+# PHC/system clock cross timestamp calibration quality, per PHC
+genavb_add_executable(NAME ${phc_calib}
+  SRCS
+  clock_xts.c
+  sim/phc_calib.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+option(BUILD_STATS "Build live statistics reader" ON)
+
+if(BUILD_STATS)
+  set(stats genavb-stats)
+endif()
+
+# Statistics region (linux/stats_shm.c) reader
+genavb_add_executable(NAME ${stats}
+  SRCS
+  stats_main.c
+  stdlib.c
+  string.c
+  log.c
+  assert.c
+)
+
+if(BUILD_CBS_SIM)
+  target_compile_definitions(${cbs_sim} PRIVATE NET_TX_SCHED_USERSPACE)
+  target_include_directories(${cbs_sim} PRIVATE ${CMAKE_CURRENT_LIST_DIR}/sim ${CMAKE_CURRENT_LIST_DIR}/../common/os)
+  target_include_directories(${mclock_rec_sim} PRIVATE ${CMAKE_CURRENT_LIST_DIR}/sim ${CMAKE_CURRENT_LIST_DIR}/../common/os)
+endif()
+
 genavb_add_dependencies(TARGET ${avb} DEP modules-dir)
 genavb_add_dependencies(TARGET ${tsn} DEP modules-dir)
 genavb_add_dependencies(TARGET genavb DEP modules-dir)
 
 # net_std files for tsn process
-genavb_target_add_srcs(TARGET ${tsn} SRCS net_std.c net_std_socket_filters.c rtnetlink.c fqtss.c fqtss_std.c fdb_std.c)
+genavb_target_add_srcs(TARGET ${tsn} SRCS net_std.c net_std_socket_filters.c net_shaper.c rtnetlink.c fqtss.c fqtss_std.c fdb_std.c)
 # net_avb files for avb and tsn processes
 genavb_target_add_srcs(TARGET ${avb} SRCS net_avb.c shmem.c)
 genavb_target_add_srcs(TARGET ${tsn} SRCS net_avb.c shmem.c fqtss.c fqtss_avb.c)
@@ -91,7 +252,7 @@ if(CONFIG_SOCKET)
   include(CheckIncludeFile)
 
   # net_std for genavb shared lib
-  genavb_target_add_srcs(TARGET genavb SRCS net.c net_std.c net_std_socket_filters.c)
+  genavb_target_add_srcs(TARGET genavb SRCS net.c net_std.c net_std_socket_filters.c net_shaper.c)
 
   # Check that we have libbpf headers: either from sysroot or kernel directory
   list(APPEND CMAKE_REQUIRED_INCLUDES "${KERNELDIR}/tools/lib")
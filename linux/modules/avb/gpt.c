@@ -1,6 +1,6 @@
 /*
  * AVB GPT driver
- * Copyright 2016 - 2023 NXP
+ * Copyright 2016 - 2023, 2026 NXP
  *
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
@@ -559,9 +559,9 @@ static int gpt_probe(struct platform_device *pdev)
 		}
 
 		rec->pll_ref_freq = clk_get_rate(drv->clk_gpt) / drv->prescale;
-		rec->max_adjust = GPT_REC_MAX_ADJUST_PPB;
+		rec->ctrl.max_adjust = GPT_REC_MAX_ADJUST_PPB;
 		rec->pll_timer_clk_div = clk_get_rate(drv->rec.pll.clk_audio_pll) / rec->pll_ref_freq;
-		pi_init(&rec->pi, GPT_REC_I_FACTOR, GPT_REC_P_FACTOR);
+		pi_init(&rec->ctrl.pi, GPT_REC_I_FACTOR, GPT_REC_P_FACTOR);
 
 		//FIXME register 2 devices, a REC and a GEN
 		clock_dev->type = REC;
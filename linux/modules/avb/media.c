@@ -1,7 +1,7 @@
 /*
  * AVB media interface driver
  * Copyright 2014-2015 Freescale Semiconductor, Inc.
- * Copyright 2023 NXP
+ * Copyright 2023, 2026 NXP
  *
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
@@ -10,6 +10,8 @@
 #include <linux/slab.h>
 #include <linux/poll.h>
 #include <linux/sched.h>
+#include <linux/file.h>
+#include <linux/anon_inodes.h>
 
 #include "genavb/media.h"
 #include "genavb/types.h"
@@ -49,6 +51,96 @@ static inline int need_to_wake_up_listener_queue(struct media_queue * mqueue)
 	return (media_queue_avail(mqueue) >= mqueue->batch_size) || queue_full(&mqueue->queue) || media_queue_eofs(mqueue);
 }
 
+static inline int media_queue_api_ready(struct media_queue *mqueue)
+{
+	if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK)
+		return 0;
+
+	if (mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER)
+		return (media_queue_remaining(mqueue) >= mqueue->batch_size) || queue_empty(&mqueue->queue);
+	else
+		return need_to_wake_up_listener_queue(mqueue);
+}
+
+/* Stream group readiness notifier, a single wait queue for all the member streams */
+struct media_notifier {
+	struct media_drv *drv;
+	wait_queue_head_t wait;
+	u32 members;				/* bitmap of member streams */
+	u32 ready;				/* bitmap of members ready since the last read */
+	unsigned int threshold;			/* number of ready members to wake up */
+	struct media_queue *mqueue[MEDIA_GROUP_MAX];
+};
+
+/**
+ * media_queue_notify() - signals a ready media queue to the readiness notifier of its stream group
+ * @mqueue - media queue pointer
+ *
+ * The notifier is only woken up when the number of ready members reaches the threshold, i.e once for all the streams
+ * becoming ready together.
+ */
+static void media_queue_notify(struct media_queue *mqueue)
+{
+	struct media_drv *drv = mqueue->drv;
+	struct media_notifier *notifier;
+	u32 bit;
+
+	if (!READ_ONCE(mqueue->notifier))
+		return;
+
+	spin_lock(&drv->notify_lock);
+
+	notifier = mqueue->notifier;
+	if (!notifier)
+		goto unlock;
+
+	bit = 1U << mqueue->notifier_bit;
+	if (notifier->ready & bit)
+		goto unlock;
+
+	notifier->ready |= bit;
+
+	if (hweight32(notifier->ready) == notifier->threshold)
+		wake_up(&notifier->wait);
+
+unlock:
+	spin_unlock(&drv->notify_lock);
+}
+
+/**
+ * media_queue_notifier_detach() - removes a media queue from its stream group readiness notifier
+ * @mqueue - media queue pointer
+ *
+ * The notifier threshold is lowered if it can no longer be reached by the remaining members.
+ */
+static void media_queue_notifier_detach(struct media_queue *mqueue)
+{
+	struct media_drv *drv = mqueue->drv;
+	struct media_notifier *notifier;
+	u32 bit;
+
+	spin_lock(&drv->notify_lock);
+
+	notifier = mqueue->notifier;
+	if (!notifier)
+		goto unlock;
+
+	bit = 1U << mqueue->notifier_bit;
+
+	notifier->members &= ~bit;
+	notifier->ready &= ~bit;
+	notifier->mqueue[mqueue->notifier_bit] = NULL;
+	mqueue->notifier = NULL;
+
+	if (notifier->threshold > hweight32(notifier->members))
+		notifier->threshold = hweight32(notifier->members);
+
+	wake_up(&notifier->wait);
+
+unlock:
+	spin_unlock(&drv->notify_lock);
+}
+
 /**
  * media_queue_alloc() - allocates media queue
  * @drv - media driver pointer
@@ -115,6 +207,8 @@ static void media_queue_free(struct media_queue *mqueue)
 	if (mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK)
 		list_del(&mqueue->list);
 
+	media_queue_notifier_detach(mqueue);
+
 	kfree(mqueue);
 }
 
@@ -266,6 +360,8 @@ static ssize_t media_drv_net_write(struct file *file, const char __user *buf, si
 		if (need_to_wake_up_listener_queue(mqueue)) {
 			if (waitqueue_active(&mqueue->api_wait))
 				wake_up(&mqueue->api_wait);
+
+			media_queue_notify(mqueue);
 		}
 	}
 
@@ -342,6 +438,8 @@ static ssize_t media_drv_net_read(struct file *file, char __user *buf, size_t le
 	if ((media_queue_remaining(mqueue) >= mqueue->batch_size) || queue_empty(&mqueue->queue)) {
 		if (waitqueue_active(&mqueue->api_wait))
 			wake_up(&mqueue->api_wait);
+
+		media_queue_notify(mqueue);
 	}
 
 	if (n)
@@ -1434,6 +1532,327 @@ early_exit:
 }
 
 
+static int media_drv_api_rx_check(struct media_queue *mqueue)
+{
+	if (mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER)
+		return -EPERM;
+
+	if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK)
+		return -EPIPE;
+
+	return 0;
+}
+
+static int media_drv_api_tx_check(struct media_queue *mqueue)
+{
+	if (!(mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER))
+		return -EPERM;
+
+	if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK)
+		return -EPIPE;
+
+	return 0;
+}
+
+static const struct file_operations media_drv_api_fops;
+
+/**
+ * media_drv_api_group_get() - media queue of a stream group member
+ * @fd - media queue file descriptor of the stream
+ * @file - returned file pointer, to be released with fput()
+ *
+ * Return: media queue pointer, or NULL if fd is not a media queue file descriptor.
+ */
+static struct media_queue *media_drv_api_group_get(int fd, struct file **file)
+{
+	*file = fget(fd);
+	if (!*file)
+		return NULL;
+
+	if ((*file)->f_op != &media_drv_api_fops) {
+		fput(*file);
+		return NULL;
+	}
+
+	return (*file)->private_data;
+}
+
+/**
+ * media_drv_api_rx_group() - media listener streams read, for a group of streams
+ * @group - stream group
+ *
+ * Reads each stream of the group in turn (as media_drv_api_rx()), in a single ioctl. The result of each stream is returned
+ * in its entry, an error on one stream does not prevent reading the others.
+ *
+ * Return: number of streams with data or events read, or negative error code if the group could not be accessed.
+ */
+static int media_drv_api_rx_group(struct media_queue_group *group)
+{
+	struct media_queue_rx_entry __user *entries = (struct media_queue_rx_entry __user *)group->entries;
+	struct media_queue_rx_entry entry;
+	struct media_queue *mqueue;
+	struct file *file;
+	unsigned int i;
+	int n = 0;
+
+	if (group->len > MEDIA_GROUP_MAX)
+		return -EINVAL;
+
+	for (i = 0; i < group->len; i++) {
+		if (copy_from_user(&entry, &entries[i], sizeof(struct media_queue_rx_entry)))
+			return -EFAULT;
+
+		entry.rx.data_read = 0;
+		entry.rx.event_read = 0;
+
+		mqueue = media_drv_api_group_get(entry.fd, &file);
+		if (!mqueue) {
+			entry.rc = -EBADF;
+			goto copy;
+		}
+
+		entry.rc = media_drv_api_rx_check(mqueue);
+		if (entry.rc < 0)
+			goto put;
+
+		entry.rc = media_drv_api_rx(mqueue, &entry.rx);
+
+		if (entry.rx.data_read || entry.rx.event_read)
+			n++;
+
+	put:
+		fput(file);
+
+	copy:
+		if (copy_to_user(&entries[i], &entry, sizeof(struct media_queue_rx_entry)))
+			return -EFAULT;
+	}
+
+	return n;
+}
+
+/**
+ * media_drv_api_tx_group() - media talker streams write, for a group of streams
+ * @group - stream group
+ *
+ * Writes each stream of the group in turn (as media_drv_api_tx()), in a single ioctl. The result of each stream is returned
+ * in its entry, an error on one stream does not prevent writing the others.
+ *
+ * Return: number of streams with data written, or negative error code if the group could not be accessed.
+ */
+static int media_drv_api_tx_group(struct media_queue_group *group)
+{
+	struct media_queue_tx_entry __user *entries = (struct media_queue_tx_entry __user *)group->entries;
+	struct media_queue_tx_entry entry;
+	struct media_queue *mqueue;
+	struct file *file;
+	unsigned int i;
+	int n = 0;
+
+	if (group->len > MEDIA_GROUP_MAX)
+		return -EINVAL;
+
+	for (i = 0; i < group->len; i++) {
+		if (copy_from_user(&entry, &entries[i], sizeof(struct media_queue_tx_entry)))
+			return -EFAULT;
+
+		mqueue = media_drv_api_group_get(entry.fd, &file);
+		if (!mqueue) {
+			entry.rc = -EBADF;
+			goto copy;
+		}
+
+		entry.rc = media_drv_api_tx_check(mqueue);
+		if (entry.rc < 0)
+			goto put;
+
+		entry.rc = media_drv_api_tx(mqueue, &entry.tx);
+
+		if (entry.rc > 0)
+			n++;
+
+	put:
+		fput(file);
+
+	copy:
+		if (put_user(entry.rc, &entries[i].rc))
+			return -EFAULT;
+	}
+
+	return n;
+}
+
+static void media_notifier_detach_all(struct media_notifier *notifier)
+{
+	struct media_drv *drv = notifier->drv;
+	unsigned int i;
+
+	spin_lock(&drv->notify_lock);
+
+	for (i = 0; i < MEDIA_GROUP_MAX; i++) {
+		if (notifier->mqueue[i]) {
+			notifier->mqueue[i]->notifier = NULL;
+			notifier->mqueue[i] = NULL;
+		}
+	}
+
+	notifier->members = 0;
+
+	spin_unlock(&drv->notify_lock);
+}
+
+/**
+ * media_drv_notifier_read() - stream group readiness read
+ * @buf - u32 bitmap of the member streams ready since the last read (bit n for the stream at index n at creation)
+ * @len - length of buf (in bytes)
+ *
+ * Never blocks, poll() is used to wait for the group to become ready.
+ */
+static ssize_t media_drv_notifier_read(struct file *file, char __user *buf, size_t len, loff_t *off)
+{
+	struct media_notifier *notifier = file->private_data;
+	struct media_drv *drv = notifier->drv;
+	u32 ready;
+
+	if (len < sizeof(u32))
+		return -EINVAL;
+
+	spin_lock(&drv->notify_lock);
+
+	ready = notifier->ready;
+	notifier->ready = 0;
+
+	spin_unlock(&drv->notify_lock);
+
+	if (put_user(ready, (u32 __user *)buf))
+		return -EFAULT;
+
+	return sizeof(u32);
+}
+
+static unsigned int media_drv_notifier_poll(struct file *file, poll_table *poll)
+{
+	struct media_notifier *notifier = file->private_data;
+	struct media_drv *drv = notifier->drv;
+	unsigned int mask = 0;
+
+	poll_wait(file, &notifier->wait, poll);
+
+	spin_lock(&drv->notify_lock);
+
+	if (!notifier->members)
+		mask |= POLLHUP;
+	else if (hweight32(notifier->ready) >= notifier->threshold)
+		mask |= POLLIN | POLLRDNORM;
+
+	spin_unlock(&drv->notify_lock);
+
+	return mask;
+}
+
+static int media_drv_notifier_release(struct inode *in, struct file *file)
+{
+	struct media_notifier *notifier = file->private_data;
+
+	media_notifier_detach_all(notifier);
+
+	kfree(notifier);
+
+	return 0;
+}
+
+static const struct file_operations media_drv_notifier_fops = {
+	.owner = THIS_MODULE,
+	.release = media_drv_notifier_release,
+	.read = media_drv_notifier_read,
+	.poll = media_drv_notifier_poll,
+	.llseek = noop_llseek,
+};
+
+/**
+ * media_drv_api_notifier_create() - creates a readiness notifier for a group of streams
+ * @drv - media driver pointer
+ * @notify - notifier parameters
+ *
+ * The notifier is a new file descriptor, readable (poll) when at least threshold member streams became ready (data
+ * available for listener streams, space available for talker streams). Reading it returns the bitmap of ready members.
+ * Each stream can be a member of a single notifier.
+ *
+ * Return: notifier file descriptor, or negative error code.
+ */
+static int media_drv_api_notifier_create(struct media_drv *drv, struct media_queue_notify *notify)
+{
+	int const __user *fds = (int const __user *)notify->fd;
+	struct media_notifier *notifier;
+	struct media_queue *mqueue;
+	struct file *file;
+	unsigned int i;
+	int fd, rc;
+
+	if (!notify->len || (notify->len > MEDIA_GROUP_MAX) || (notify->threshold > notify->len))
+		return -EINVAL;
+
+	notifier = kzalloc(sizeof(*notifier), GFP_KERNEL);
+	if (!notifier)
+		return -ENOMEM;
+
+	notifier->drv = drv;
+	notifier->threshold = notify->threshold ? notify->threshold : notify->len;
+	init_waitqueue_head(&notifier->wait);
+
+	for (i = 0; i < notify->len; i++) {
+		if (get_user(fd, &fds[i])) {
+			rc = -EFAULT;
+			goto err_member;
+		}
+
+		mqueue = media_drv_api_group_get(fd, &file);
+		if (!mqueue) {
+			rc = -EBADF;
+			goto err_member;
+		}
+
+		spin_lock(&drv->notify_lock);
+
+		if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK)
+			rc = -EPIPE;
+		else if (mqueue->notifier)
+			rc = -EBUSY;
+		else
+			rc = 0;
+
+		if (!rc) {
+			mqueue->notifier = notifier;
+			mqueue->notifier_bit = i;
+			notifier->mqueue[i] = mqueue;
+			notifier->members |= 1U << i;
+
+			/* Streams already ready */
+			if (media_queue_api_ready(mqueue))
+				notifier->ready |= 1U << i;
+		}
+
+		spin_unlock(&drv->notify_lock);
+
+		fput(file);
+
+		if (rc < 0)
+			goto err_member;
+	}
+
+	rc = anon_inode_getfd("media_notifier", &media_drv_notifier_fops, notifier, O_RDONLY | O_CLOEXEC);
+	if (rc < 0)
+		goto err_member;
+
+	return rc;
+
+err_member:
+	media_notifier_detach_all(notifier);
+	kfree(notifier);
+
+	return rc;
+}
+
 static long media_drv_api_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
 {
 	struct media_queue *mqueue_orig, *mqueue = file->private_data;
@@ -1442,6 +1861,8 @@ static long media_drv_api_ioctl(struct file *file, unsigned int cmd, unsigned lo
 	struct media_queue_api_params params;
 	struct media_queue_rx rx;
 	struct media_queue_tx tx;
+	struct media_queue_group group;
+	struct media_queue_notify notify;
 	struct logical_port *port;
 	int rc = 0;
 
@@ -1506,15 +1927,9 @@ static long media_drv_api_ioctl(struct file *file, unsigned int cmd, unsigned lo
 		break;
 
 	case MEDIA_IOC_RX:
-		if (mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER) {
-			rc = -EPERM;
-			break;
-		}
-
-		if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK) {
-			rc = -EPIPE;
+		rc = media_drv_api_rx_check(mqueue);
+		if (rc < 0)
 			break;
-		}
 
 		if (copy_from_user(&rx, (void *)arg, sizeof(struct media_queue_rx))) {
 			rc = -EFAULT;
@@ -1532,22 +1947,46 @@ static long media_drv_api_ioctl(struct file *file, unsigned int cmd, unsigned lo
 		break;
 
 	case MEDIA_IOC_TX:
-		if (!(mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER)) {
-			rc = -EPERM;
+		rc = media_drv_api_tx_check(mqueue);
+		if (rc < 0)
+			break;
+
+		if (copy_from_user(&tx, (void *)arg, sizeof(struct media_queue_tx))) {
+			rc = -EFAULT;
 			break;
 		}
 
-		if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK) {
-			rc = -EPIPE;
+		rc = media_drv_api_tx(mqueue, &tx);
+
+		break;
+
+	case MEDIA_IOC_RX_GROUP:
+		if (copy_from_user(&group, (void *)arg, sizeof(struct media_queue_group))) {
+			rc = -EFAULT;
 			break;
 		}
 
-		if (copy_from_user(&tx, (void *)arg, sizeof(struct media_queue_tx))) {
+		rc = media_drv_api_rx_group(&group);
+
+		break;
+
+	case MEDIA_IOC_TX_GROUP:
+		if (copy_from_user(&group, (void *)arg, sizeof(struct media_queue_group))) {
 			rc = -EFAULT;
 			break;
 		}
 
-		rc = media_drv_api_tx(mqueue, &tx);
+		rc = media_drv_api_tx_group(&group);
+
+		break;
+
+	case MEDIA_IOC_NOTIFY_CREATE:
+		if (copy_from_user(&notify, (void *)arg, sizeof(struct media_queue_notify))) {
+			rc = -EFAULT;
+			break;
+		}
+
+		rc = media_drv_api_notifier_create(drv, &notify);
 
 		break;
 
@@ -1569,18 +2008,13 @@ static unsigned int media_drv_api_poll(struct file *file, poll_table *poll)
 
 	poll_wait(file, &mqueue->api_wait, poll);
 
-	if ((mqueue->flags & MEDIA_QUEUE_FLAGS_BOUND_MASK) != MEDIA_QUEUE_FLAGS_BOUND_MASK)
-		goto exit;
-
-	if (mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER) {
-		if ((media_queue_remaining(mqueue) >= mqueue->batch_size) || queue_empty(&mqueue->queue))
+	if (media_queue_api_ready(mqueue)) {
+		if (mqueue->flags & MEDIA_QUEUE_FLAGS_TALKER)
 			mask |= POLLOUT | POLLWRNORM;
-	} else {
-		if (need_to_wake_up_listener_queue(mqueue))
+		else
 			mask |= POLLIN | POLLRDNORM;
 	}
 
-exit:
 //	pr_info("%s: %x\n", __func__, mask);
 
 	return mask;
@@ -1625,6 +2059,8 @@ static int media_drv_api_release(struct inode *in, struct file *file)
 
 	mutex_lock(&drv->list_lock);
 
+	media_queue_notifier_detach(mqueue);
+
 	if ((mqueue->flags & ~MEDIA_QUEUE_FLAGS_API_BOUND & MEDIA_QUEUE_FLAGS_BOUND_MASK) == 0) {
 		media_queue_flush(mqueue);
 		media_queue_free(mqueue);
@@ -1670,6 +2106,7 @@ int media_drv_init(struct media_drv *drv)
 	INIT_LIST_HEAD(&drv->media_queues);
 
 	mutex_init(&drv->list_lock);
+	spin_lock_init(&drv->notify_lock);
 
 	rc = alloc_chrdev_region(&drv->devno, MEDIA_DRV_MINOR, MEDIA_DRV_MINOR_COUNT, MEDIA_DRV_NAME);
 	if (rc < 0) {
@@ -1,7 +1,7 @@
 /*
  * AVB media interface driver
  * Copyright 2014-2015 Freescale Semiconductor, Inc.
- * Copyright 2023 NXP
+ * Copyright 2023, 2026 NXP
  *
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
@@ -51,6 +51,33 @@ struct media_queue_tx {
 
 #define IOV_MAX		32
 
+/* Stream group receive/send (MEDIA_IOC_RX_GROUP/MEDIA_IOC_TX_GROUP), serviced in a single ioctl */
+struct media_queue_rx_entry {
+	int fd;					/**< media queue file descriptor of the stream */
+	int rc;					/**< return value, 0 or negative error code */
+	struct media_queue_rx rx;
+};
+
+struct media_queue_tx_entry {
+	int fd;					/**< media queue file descriptor of the stream */
+	int rc;					/**< return value, amount written (in bytes) or negative error code */
+	struct media_queue_tx tx;
+};
+
+struct media_queue_group {
+	void *entries;				/**< array of struct media_queue_rx_entry (or struct media_queue_tx_entry) */
+	unsigned int len;			/**< length of the entries array */
+};
+
+#define MEDIA_GROUP_MAX	32
+
+/* Stream group readiness notifier (MEDIA_IOC_NOTIFY_CREATE) */
+struct media_queue_notify {
+	int const *fd;				/**< array of media queue file descriptors, fd[n] is bit n of the ready bitmap */
+	unsigned int len;			/**< length of the fd array */
+	unsigned int threshold;			/**< number of ready streams for the notifier to become readable, 0 for all */
+};
+
 #ifdef __KERNEL__
 
 #include <linux/cdev.h>
@@ -65,6 +92,8 @@ struct media_queue_tx {
 #define MEDIA_DRV_MINOR_COUNT	2
 
 
+struct media_notifier;
+
 /* Media queue character device instance */
 struct media_queue {
 	void *partial_desc;
@@ -83,6 +112,9 @@ struct media_queue {
 
 	struct list_head list;
 
+	struct media_notifier *notifier;	/* Stream group readiness notifier, protected by media_drv notify_lock */
+	unsigned int notifier_bit;
+
 	unsigned int max_payload_size;
 	unsigned int max_frame_payload_size;
 	unsigned int payload_offset;
@@ -144,6 +176,7 @@ struct media_drv {
 	struct cdev cdev_net;
 	struct cdev cdev_api;
 	struct mutex list_lock;
+	spinlock_t notify_lock;
 	dev_t devno;
 };
 
@@ -158,5 +191,8 @@ void media_drv_exit(struct media_drv *drv);
 #define MEDIA_IOC_API_BIND		_IOWR(MEDIA_IOC_MAGIC, 1, struct media_queue_api_params)
 #define MEDIA_IOC_RX		_IOR(MEDIA_IOC_MAGIC, 2, struct media_queue_rx)
 #define MEDIA_IOC_TX		_IOW(MEDIA_IOC_MAGIC, 3, struct media_queue_tx)
+#define MEDIA_IOC_RX_GROUP	_IOW(MEDIA_IOC_MAGIC, 4, struct media_queue_group)
+#define MEDIA_IOC_TX_GROUP	_IOW(MEDIA_IOC_MAGIC, 5, struct media_queue_group)
+#define MEDIA_IOC_NOTIFY_CREATE	_IOW(MEDIA_IOC_MAGIC, 6, struct media_queue_notify)
 
 #endif /* _MEDIA_DRV_H_ */
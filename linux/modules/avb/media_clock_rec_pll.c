@@ -1,7 +1,7 @@
 /*
  * AVB media clock recovery
  * Copyright 2014-2015 Freescale Semiconductor, Inc.
- * Copyright 2018, 2023 NXP
+ * Copyright 2018, 2023, 2026 NXP
  *
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
@@ -154,12 +154,13 @@ static int mclock_rec_pll_configure_freqs(struct mclock_rec_pll *rec, mclock_ts_
 	if (mclock_rec_pll_check_ts_freq(rec, ts_freq_p, ts_freq_q) < 0)
 		return -1;
 
-	rational_init(&rec->pll_clk_period, (unsigned long long)rec->pll_ref_freq * ts_freq_q * div, ts_freq_p);
+	mclock_rec_pll_ctrl_set_period(&rec->ctrl, (unsigned long long)rec->pll_ref_freq * ts_freq_q * div, ts_freq_p,
+				       rec->fec_period.i);
 	rec->dev.drift_period = rec->fec_period.i;
 
 	//pr_info("%s : fec sampling period: %u + %u/%u, pll period / fec period: %u + %u/%u, div: %d\n",
 	//	__func__, rec->fec_period.i, rec->fec_period.p, rec->fec_period.q,
-	//	rec->pll_clk_period.i, rec->pll_clk_period.p, rec->pll_clk_period.q, div);
+	//	rec->ctrl.pll_clk_period.i, rec->ctrl.pll_clk_period.p, rec->ctrl.pll_clk_period.q, div);
 
 	return 0;
 }
@@ -233,25 +234,13 @@ int __mclock_rec_pll_start(struct mclock_rec_pll *rec, struct mclock_start *star
 		rec->next_ts = ts_1;
 	}
 
-	rec->state = START;
 	rec->pll.current_rate = imx_pll_get_rate(&rec->pll);
-	/*Initial control output is 0 (e.g 0 ppb variation)*/
-	pi_reset(&rec->pi, 0);
-	rational_init(&rec->pll_clk_target, 0, 1);
-	rec->pll_clk_meas = 0;
-	rec->meas = 0;
-	rec->start_ppb_err = 0;
-	rec->accepted_ppb_err_nb = 0;
+	mclock_rec_pll_ctrl_start(&rec->ctrl, rec->pll.ppb_adjust);
 	mclock_rec_pll_wd_reset(rec);
 	/*Set the status to running*/
 	atomic_set(&rec->status, MCLOCK_RUNNING);
 	dev->flags &= ~MCLOCK_FLAGS_RUNNING_LOCKED;
 
-	rec->stats.err_per_sec = 0;
-	rec->stats.err_cum = 0;
-	rec->stats.err_time = 0;
-	rec->stats.locked_state = 0;
-
 out:
 	return rc;
 }
@@ -275,7 +264,7 @@ int mclock_rec_pll_start(struct mclock_rec_pll *rec, struct mclock_start *start)
 	if (!(eth->flags & PORT_FLAGS_ENABLED)) {
 		rc = -EIO;
 		rec->stats.err_port_down++;
-		rec->state = RESET;
+		rec->ctrl.state = RESET;
 		goto out;
 	}
 
@@ -332,71 +321,26 @@ void mclock_rec_pll_reset(struct mclock_rec_pll *rec)
 	rec->stats.reset++;
 }
 
-static void mclock_rec_pll_adjust(struct mclock_rec_pll *rec, int err)
+/* PLL control loop adjust callback */
+static int mclock_rec_pll_adjust(struct mclock_rec_pll_ctrl *ctrl, int *ppb)
 {
-	int adjust_val;
-	int last_req_ppb, new_ppb_adjust;
-	int rc = 0;
+	struct mclock_rec_pll *rec = ctrl->data;
 	struct imx_pll *pll = &rec->pll;
+	int rc;
 
-	pi_update(&rec->pi, err);
-
-	/* Save the last ppb adjustement. */
-	last_req_ppb = rec->req_ppb_adjust;
-
-	/* Anti wind-up */
-	adjust_val = (rec->pi.u) - pll->ppb_adjust;
-
-#if MCLOCK_PLL_REC_TRACE
-	if (!rec->trace_freeze) {
-		rec->trace[rec->trace_count].pi_err_input = err;
-		rec->trace[rec->trace_count].pi_control_output = rec->pi.u;
-	}
-#endif
-
-	if (adjust_val > rec->max_adjust)
-		adjust_val = rec->max_adjust;
-	else if (adjust_val < (-rec->max_adjust))
-		adjust_val = (-rec->max_adjust);
-
-	new_ppb_adjust = pll->ppb_adjust + adjust_val;
-
-#if MCLOCK_PLL_REC_TRACE
-	if (!rec->trace_freeze)
-		rec->trace[rec->trace_count].previous_rate = pll->current_rate;
-#endif
-
-	/*Check if we really need to update the PLL settings*/
-	if (last_req_ppb == new_ppb_adjust)
-		goto no_adjust;
-
-	/* Save the requested ppb adjust*/
-	rec->req_ppb_adjust = new_ppb_adjust;
-
-	rc = imx_pll_adjust(pll, &new_ppb_adjust);
+	rc = imx_pll_adjust(pll, ppb);
 
 	if (rc == -IMX_CLK_PLL_INVALID_PARAM)
-		rec->stats.err_set_pll_rate++;
+		return -MCLOCK_REC_PLL_ADJUST_INVALID;
 	else if (rc == -IMX_CLK_PLL_PREC_ERR)
-		rec->stats.err_pll_prec++;
-	else {
-		/*Save the returned (exact) pbb adjust*/
-		pll->ppb_adjust = new_ppb_adjust;
-#if MCLOCK_PLL_REC_TRACE
-		pll->current_rate = imx_pll_get_rate(pll);
-#endif
-	}
-
-no_adjust:
+		return -MCLOCK_REC_PLL_ADJUST_PREC;
 
+	pll->ppb_adjust = *ppb;
 #if MCLOCK_PLL_REC_TRACE
-	if (!rec->trace_freeze) {
-		rec->trace[rec->trace_count].adjust_value = pll->ppb_adjust;
-		rec->trace[rec->trace_count].new_rate = pll->current_rate;
-	}
+	pll->current_rate = imx_pll_get_rate(pll);
 #endif
-	rec->stats.last_app_adjust = pll->ppb_adjust;
-	rec->stats.adjust++;
+
+	return 0;
 }
 
 
@@ -449,10 +393,11 @@ int mclock_rec_pll_timer_irq(struct mclock_rec_pll *rec, int fec_event, unsigned
 {
 	struct mclock_dev *dev = &rec->dev;
 	struct eth_avb *eth = dev->eth;
-	unsigned int pll_clk_last, pll_clk_meas_last, dt_pll_clk_target;
 	unsigned int next_ts;
-	int err;
-	s64 err_ppb;
+	rec_pll_state_t state;
+#if MCLOCK_PLL_REC_TRACE
+	unsigned long previous_rate;
+#endif
 	int rc = 0;
 
 	dev->clk_timer += ticks * dev->timer_period;
@@ -465,7 +410,7 @@ int mclock_rec_pll_timer_irq(struct mclock_rec_pll *rec, int fec_event, unsigned
 	/* No capture event */
 	if (!fec_event) {
 		if (avtp_after(dev->clk_timer, rec->wd)) {
-			rec->state = RESET;
+			rec->ctrl.state = RESET;
 			rec->stats.err_wd++;
 		}
 		goto out_no_trace;
@@ -505,118 +450,50 @@ int mclock_rec_pll_timer_irq(struct mclock_rec_pll *rec, int fec_event, unsigned
 		rec->next_ts = next_ts;
 	}
 
-	/* Check that measurement is fine */
-	if (abs(rec->pll_clk_period.i - meas) >  (rec->pll_clk_period.i / 1000)) {
-		/* First value is often wrong, skip it */
-		if (rec->meas) {
-			rec->state = RESET;
-			rc = -1;
-		}
-		rec->stats.err_meas++;
-		rec->meas++;
-		goto out;
-	}
-
-	pll_clk_last = rec->pll_clk_target.i;
-	pll_clk_meas_last = rec->pll_clk_meas;
-
-	rational_add(&rec->pll_clk_target, &rec->pll_clk_target, &rec->pll_clk_period);
-	/* Expected pll clock ticks. */
-	dt_pll_clk_target = rec->pll_clk_target.i - pll_clk_last;
-	rec->pll_clk_meas += meas;
-
-	/* err over a sampling period */
-	err = dt_pll_clk_target - (rec->pll_clk_meas - pll_clk_meas_last);
+	state = rec->ctrl.state;
 
-	/* make the error in ppb (divide by the sampling period) */
-	err_ppb = div_s64(err * 1000000000LL, dt_pll_clk_target);
-
-	/* err stats */
-	rec->stats.err_time += rec->fec_period.i;
-	rec->stats.err_cum += err;
+#if MCLOCK_PLL_REC_TRACE
+	previous_rate = rec->pll.current_rate;
+#endif
 
-	if (rec->stats.err_time >= NSEC_PER_SEC) {
-		rec->stats.err_per_sec = rec->stats.err_cum;
-		rec->stats.err_cum = 0;
-		rec->stats.err_time = 0;
+	if (mclock_rec_pll_ctrl_update(&rec->ctrl, meas) < 0) {
+		if (rec->ctrl.state == RESET)
+			rc = -1;
+		goto out;
 	}
 
 #if MCLOCK_PLL_REC_TRACE
 	if (!rec->trace_freeze) {
-		rec->trace[rec->trace_count].meas = meas;
-		rec->trace[rec->trace_count].ticks = ticks;
-		rec->trace[rec->trace_count].err = err;
-		rec->trace[rec->trace_count].pi_err_input = 0;
-		rec->trace[rec->trace_count].pi_control_output = 0;
-		rec->trace[rec->trace_count].new_rate = 0;
-		rec->trace[rec->trace_count].previous_rate = 0;
-		rec->trace[rec->trace_count].adjust_value = 0;
+		rec->trace[rec->trace_count].err = rec->ctrl.err;
+		if (rec->ctrl.adjusted) {
+			rec->trace[rec->trace_count].pi_err_input = rec->ctrl.adjust_err;
+			rec->trace[rec->trace_count].pi_control_output = rec->ctrl.pi.u;
+			rec->trace[rec->trace_count].adjust_value = rec->ctrl.ppb_adjust;
+			rec->trace[rec->trace_count].previous_rate = previous_rate;
+			rec->trace[rec->trace_count].new_rate = rec->pll.current_rate;
+		} else {
+			rec->trace[rec->trace_count].pi_err_input = 0;
+			rec->trace[rec->trace_count].pi_control_output = 0;
+			rec->trace[rec->trace_count].new_rate = 0;
+			rec->trace[rec->trace_count].previous_rate = 0;
+		}
 	}
 #endif
 
-	switch (rec->state) {
-	case START:
-		if (rec->meas > MCLOCK_REC_PLL_NB_MEAS_START_SKIP) { /* Skip the first values to have a proper average */
-			rec->start_ppb_err += err_ppb;
-		}
+	/* Declare clock domain locked. */
+	if (rec->ctrl.locked && !(dev->flags & MCLOCK_FLAGS_RUNNING_LOCKED)) {
+		atomic_set(&rec->status, MCLOCK_RUNNING_LOCKED);
+		dev->flags |= MCLOCK_FLAGS_RUNNING_LOCKED;
+	}
 
-		if(rec->meas++ >= (MCLOCK_REC_PLL_NB_MEAS + MCLOCK_REC_PLL_NB_MEAS_START_SKIP)) {
-			rec->state = ADJUST;
+	switch (state) {
+	case START:
+		if (rec->ctrl.state == ADJUST)
 			rational_init(&rec->clk_media, dev->clk_timer , 1);
-			/* Divide the accumulated error by the start measurement window
-			 * to get an estimation of the initial drift.
-			 */
-			rec->start_ppb_err = div_s64(rec->start_ppb_err, MCLOCK_REC_PLL_NB_MEAS);
-
-			/* PI reset should take into account the measured
-			 * ppb error and the previously set ppb adjust
-			 */
-			pi_reset(&rec->pi, rec->start_ppb_err + rec->pll.ppb_adjust);
 
-		}
 		break;
 	case ADJUST:
-		if (abs(err_ppb) < MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR) {
-			/* After few consecutive measurements under MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR, we can go to locked */
-			if (++rec->accepted_ppb_err_nb >= MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR_NB) {
-				/* Declare clock domain locked. */
-				if (!(dev->flags & MCLOCK_FLAGS_RUNNING_LOCKED)) {
-					atomic_set(&rec->status, MCLOCK_RUNNING_LOCKED);
-					dev->flags |= MCLOCK_FLAGS_RUNNING_LOCKED;
-				}
-				/* Go to ADJUST_LOCKED state with larger sampling period to reduce jitter. */
-				rec->state = ADJUST_LOCKED;
-				rec->stats.locked_state++;
-			}
-		} else
-			rec->accepted_ppb_err_nb = 0;
-
-		/* Do PLL adjustement on every sampling measure */
-		mclock_rec_pll_adjust(rec, err_ppb);
-
-		rec->locked_meas = 0;
-		rec->locked_ppb_err = 0;
-		fallthrough;
 	case ADJUST_LOCKED:
-		/* Do PLL adjustement every 2^MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT measurement. */
-		rec->locked_ppb_err += err_ppb;
-		if (++rec->locked_meas >= (1 << MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT)) {
-
-			/* Scale the accumulated error measurements to the sampling window. */
-			rec->locked_ppb_err >>= MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT;
-
-			mclock_rec_pll_adjust(rec, rec->locked_ppb_err);
-
-			/* If error is larger than MCLOCK_REC_PLL_OUT_LOCKED_PPB_ERR, go back to ADJUST state for quicker adjustments. */
-			if (abs(rec->locked_ppb_err) >= MCLOCK_REC_PLL_OUT_LOCKED_PPB_ERR) {
-				rec->accepted_ppb_err_nb = 0;
-				rec->state = ADJUST;
-			}
-
-			rec->locked_meas = 0;
-			rec->locked_ppb_err = 0;
-		}
-
 		rational_add(&rec->clk_media, &rec->clk_media, &rec->fec_period);
 
 		/* Not needed to reset here there are enough checks before*/
@@ -631,7 +508,7 @@ int mclock_rec_pll_timer_irq(struct mclock_rec_pll *rec, int fec_event, unsigned
 out:
 #if MCLOCK_PLL_REC_TRACE
 	if (!rec->trace_freeze) {
-		rec->trace[rec->trace_count].state = rec->state;
+		rec->trace[rec->trace_count].state = rec->ctrl.state;
 		if (++rec->trace_count > MCLOCK_REC_TRACE_SIZE - 1)
 		       rec->trace_freeze = 1;
 	}
@@ -639,7 +516,7 @@ out:
 
 out_no_trace:
 
-	if (rec->state == RESET)
+	if (rec->ctrl.state == RESET)
 		mclock_rec_pll_reset(rec);
 
 	return rc;
@@ -706,6 +583,8 @@ int mclock_rec_pll_init(struct mclock_rec_pll *rec)
 	struct mclock_dev *dev = &rec->dev;
 	int rc = 0;
 
+	mclock_rec_pll_ctrl_init(&rec->ctrl, &rec->stats, mclock_rec_pll_adjust, rec);
+
 	mclock_rec_pll_configure_freqs(rec, TS_INTERNAL, 0, 0);
 
 	/* For rec_pll, the ts freq holds value for the external ts
@@ -0,0 +1,245 @@
+/*
+ * AVB media clock recovery, PLL control loop
+ * Copyright 2014-2015 Freescale Semiconductor, Inc.
+ * Copyright 2018, 2023, 2026 NXP
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifdef __KERNEL__
+#include <linux/kernel.h>
+#include <linux/math64.h>
+#endif
+
+#include "media_clock_rec_pll_ctrl.h"
+
+/**
+ * mclock_rec_pll_ctrl_init() - initializes the PLL control loop
+ * @ctrl: pointer to the PLL control loop context
+ * @stats: pointer to the recovery statistics, updated by the control loop
+ * @adjust: PLL adjust callback
+ * @data: adjust callback private data
+ *
+ * The PI coefficients (pi_init()) and the maximum adjustment step (max_adjust) are set by the caller.
+ */
+void mclock_rec_pll_ctrl_init(struct mclock_rec_pll_ctrl *ctrl, struct mclock_rec_pll_stats *stats,
+			      mclock_rec_pll_adjust_t adjust, void *data)
+{
+	ctrl->state = RESET;
+	ctrl->stats = stats;
+	ctrl->adjust = adjust;
+	ctrl->data = data;
+	ctrl->req_ppb_adjust = 0;
+	ctrl->ppb_adjust = 0;
+	ctrl->locked = false;
+}
+
+/**
+ * mclock_rec_pll_ctrl_set_period() - sets the PLL measurement period
+ * @ctrl: pointer to the PLL control loop context
+ * @pll_clk_p: expected PLL clock ticks per sampling period, numerator
+ * @pll_clk_q: expected PLL clock ticks per sampling period, denominator
+ * @sampling_period: sampling period, in ns
+ */
+void mclock_rec_pll_ctrl_set_period(struct mclock_rec_pll_ctrl *ctrl, unsigned long long pll_clk_p, unsigned int pll_clk_q,
+				    unsigned int sampling_period)
+{
+	rational_init(&ctrl->pll_clk_period, pll_clk_p, pll_clk_q);
+	ctrl->sampling_period = sampling_period;
+}
+
+/**
+ * mclock_rec_pll_ctrl_start() - (re)starts the PLL control loop
+ * @ctrl: pointer to the PLL control loop context
+ * @ppb_adjust: adjustment currently applied to the PLL, in ppb
+ */
+void mclock_rec_pll_ctrl_start(struct mclock_rec_pll_ctrl *ctrl, int ppb_adjust)
+{
+	struct mclock_rec_pll_stats *stats = ctrl->stats;
+
+	ctrl->state = START;
+	ctrl->ppb_adjust = ppb_adjust;
+	/*Initial control output is 0 (e.g 0 ppb variation)*/
+	pi_reset(&ctrl->pi, 0);
+	rational_init(&ctrl->pll_clk_target, 0, 1);
+	ctrl->pll_clk_meas = 0;
+	ctrl->meas = 0;
+	ctrl->start_ppb_err = 0;
+	ctrl->accepted_ppb_err_nb = 0;
+	ctrl->locked = false;
+	ctrl->err = 0;
+	ctrl->err_ppb = 0;
+	ctrl->adjusted = false;
+
+	stats->err_per_sec = 0;
+	stats->err_cum = 0;
+	stats->err_time = 0;
+	stats->locked_state = 0;
+}
+
+static void mclock_rec_pll_ctrl_adjust(struct mclock_rec_pll_ctrl *ctrl, int err)
+{
+	int adjust_val;
+	int last_req_ppb, new_ppb_adjust;
+	int rc;
+
+	pi_update(&ctrl->pi, err);
+
+	ctrl->adjusted = true;
+	ctrl->adjust_err = err;
+
+	/* Save the last ppb adjustement. */
+	last_req_ppb = ctrl->req_ppb_adjust;
+
+	/* Anti wind-up */
+	adjust_val = (ctrl->pi.u) - ctrl->ppb_adjust;
+
+	if (adjust_val > ctrl->max_adjust)
+		adjust_val = ctrl->max_adjust;
+	else if (adjust_val < (-ctrl->max_adjust))
+		adjust_val = (-ctrl->max_adjust);
+
+	new_ppb_adjust = ctrl->ppb_adjust + adjust_val;
+
+	/*Check if we really need to update the PLL settings*/
+	if (last_req_ppb == new_ppb_adjust)
+		goto no_adjust;
+
+	/* Save the requested ppb adjust*/
+	ctrl->req_ppb_adjust = new_ppb_adjust;
+
+	rc = ctrl->adjust(ctrl, &new_ppb_adjust);
+
+	if (rc == -MCLOCK_REC_PLL_ADJUST_INVALID)
+		ctrl->stats->err_set_pll_rate++;
+	else if (rc == -MCLOCK_REC_PLL_ADJUST_PREC)
+		ctrl->stats->err_pll_prec++;
+	else
+		/*Save the returned (exact) pbb adjust*/
+		ctrl->ppb_adjust = new_ppb_adjust;
+
+no_adjust:
+	ctrl->stats->last_app_adjust = ctrl->ppb_adjust;
+	ctrl->stats->adjust++;
+}
+
+/**
+ * mclock_rec_pll_ctrl_update() - feeds a PLL measurement to the control loop
+ * @ctrl: pointer to the PLL control loop context
+ * @meas: PLL clock ticks counted over the last sampling period
+ *
+ * Invalid measurements move the control loop to the RESET state (except for the first one, often wrong),
+ * the caller must then restart the sampling and the control loop.
+ * Return: 0 on success, negative if the measurement was rejected.
+ */
+int mclock_rec_pll_ctrl_update(struct mclock_rec_pll_ctrl *ctrl, unsigned int meas)
+{
+	struct mclock_rec_pll_stats *stats = ctrl->stats;
+	unsigned int pll_clk_last, pll_clk_meas_last, dt_pll_clk_target;
+	int err;
+	s64 err_ppb;
+
+	ctrl->adjusted = false;
+
+	/* Check that measurement is fine */
+	if (abs(ctrl->pll_clk_period.i - meas) >  (ctrl->pll_clk_period.i / 1000)) {
+		/* First value is often wrong, skip it */
+		if (ctrl->meas)
+			ctrl->state = RESET;
+
+		stats->err_meas++;
+		ctrl->meas++;
+		return -1;
+	}
+
+	pll_clk_last = ctrl->pll_clk_target.i;
+	pll_clk_meas_last = ctrl->pll_clk_meas;
+
+	rational_add(&ctrl->pll_clk_target, &ctrl->pll_clk_target, &ctrl->pll_clk_period);
+	/* Expected pll clock ticks. */
+	dt_pll_clk_target = ctrl->pll_clk_target.i - pll_clk_last;
+	ctrl->pll_clk_meas += meas;
+
+	/* err over a sampling period */
+	err = dt_pll_clk_target - (ctrl->pll_clk_meas - pll_clk_meas_last);
+
+	/* make the error in ppb (divide by the sampling period) */
+	err_ppb = div_s64(err * 1000000000LL, dt_pll_clk_target);
+
+	ctrl->err = err;
+	ctrl->err_ppb = err_ppb;
+
+	/* err stats */
+	stats->err_time += ctrl->sampling_period;
+	stats->err_cum += err;
+
+	if (stats->err_time >= NSEC_PER_SEC) {
+		stats->err_per_sec = stats->err_cum;
+		stats->err_cum = 0;
+		stats->err_time = 0;
+	}
+
+	switch (ctrl->state) {
+	case START:
+		if (ctrl->meas > MCLOCK_REC_PLL_NB_MEAS_START_SKIP) { /* Skip the first values to have a proper average */
+			ctrl->start_ppb_err += err_ppb;
+		}
+
+		if (ctrl->meas++ >= (MCLOCK_REC_PLL_NB_MEAS + MCLOCK_REC_PLL_NB_MEAS_START_SKIP)) {
+			ctrl->state = ADJUST;
+			/* Divide the accumulated error by the start measurement window
+			 * to get an estimation of the initial drift.
+			 */
+			ctrl->start_ppb_err = div_s64(ctrl->start_ppb_err, MCLOCK_REC_PLL_NB_MEAS);
+
+			/* PI reset should take into account the measured
+			 * ppb error and the previously set ppb adjust
+			 */
+			pi_reset(&ctrl->pi, ctrl->start_ppb_err + ctrl->ppb_adjust);
+		}
+		break;
+	case ADJUST:
+		if (abs(err_ppb) < MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR) {
+			/* After few consecutive measurements under MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR, we can go to locked */
+			if (++ctrl->accepted_ppb_err_nb >= MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR_NB) {
+				/* Declare clock domain locked. */
+				ctrl->locked = true;
+				/* Go to ADJUST_LOCKED state with larger sampling period to reduce jitter. */
+				ctrl->state = ADJUST_LOCKED;
+				stats->locked_state++;
+			}
+		} else
+			ctrl->accepted_ppb_err_nb = 0;
+
+		/* Do PLL adjustement on every sampling measure */
+		mclock_rec_pll_ctrl_adjust(ctrl, err_ppb);
+
+		ctrl->locked_meas = 0;
+		ctrl->locked_ppb_err = 0;
+		fallthrough;
+	case ADJUST_LOCKED:
+		/* Do PLL adjustement every 2^MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT measurement. */
+		ctrl->locked_ppb_err += err_ppb;
+		if (++ctrl->locked_meas >= (1 << MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT)) {
+
+			/* Scale the accumulated error measurements to the sampling window. */
+			ctrl->locked_ppb_err >>= MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT;
+
+			mclock_rec_pll_ctrl_adjust(ctrl, ctrl->locked_ppb_err);
+
+			/* If error is larger than MCLOCK_REC_PLL_OUT_LOCKED_PPB_ERR, go back to ADJUST state for quicker adjustments. */
+			if (abs(ctrl->locked_ppb_err) >= MCLOCK_REC_PLL_OUT_LOCKED_PPB_ERR) {
+				ctrl->accepted_ppb_err_nb = 0;
+				ctrl->state = ADJUST;
+			}
+
+			ctrl->locked_meas = 0;
+			ctrl->locked_ppb_err = 0;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * AVB media clock recovery, PLL control loop
+ * Copyright 2014-2015 Freescale Semiconductor, Inc.
+ * Copyright 2018, 2023, 2026 NXP
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+/*
+ * Hardware independent part of the PLL media clock recovery (see media_clock_rec_pll.c): measurement checks,
+ * error computation, PI control and lock state machine.
+ * Also built in userspace (MCLOCK_REC_PLL_USERSPACE) by the media clock recovery simulator (linux/sim/mclock_rec_sim.c).
+ */
+
+#ifndef _MEDIA_CLOCK_REC_PLL_CTRL_H_
+#define _MEDIA_CLOCK_REC_PLL_CTRL_H_
+
+#ifdef __KERNEL__
+#include <linux/types.h>
+#else
+#include "media_clock_rec_user.h"	/* kernel interfaces, provided by the userspace build */
+#endif
+
+#include "pi.h"
+#include "rational.h"
+
+typedef enum {
+	RESET,
+	START,
+	ADJUST,
+	ADJUST_LOCKED,
+} rec_pll_state_t;
+
+struct mclock_rec_pll_stats {
+	unsigned int err_meas;
+	unsigned int err_port_down;
+	unsigned int err_fec;
+	unsigned int err_wd;
+	unsigned int err_ts;
+	unsigned int err_drift;
+	unsigned int err_set_pll_rate;
+	unsigned int err_pll_prec;
+	unsigned int reset;
+	unsigned int start;
+	unsigned int stop;
+	unsigned int adjust;
+	unsigned int locked_state;
+	int last_app_adjust;
+	int err_cum;
+	int err_per_sec;
+	unsigned int err_time;
+};
+
+/* PLL adjust callback errors */
+#define MCLOCK_REC_PLL_ADJUST_INVALID	1	/* invalid adjustment, PLL unchanged */
+#define MCLOCK_REC_PLL_ADJUST_PREC	2	/* adjustment out of the PLL precision, PLL unchanged */
+
+struct mclock_rec_pll_ctrl;
+
+/*
+ * Applies a ppb adjustment (relative to the nominal frequency) to the PLL.
+ * On success, ppb is updated with the exact adjustment applied.
+ * Returns 0 on success, -MCLOCK_REC_PLL_ADJUST_* otherwise.
+ */
+typedef int (*mclock_rec_pll_adjust_t)(struct mclock_rec_pll_ctrl *ctrl, int *ppb);
+
+struct mclock_rec_pll_ctrl {
+	rec_pll_state_t state;
+	struct rational pll_clk_target;
+	struct rational pll_clk_period; /* expected PLL clock ticks per sampling period */
+	unsigned int pll_clk_meas;
+	unsigned int sampling_period; /* ns */
+	struct pi pi;
+	s64 start_ppb_err; /* The accumulated starting ppb error measurements used to reset the PI at the end of the START state */
+	int max_adjust;
+	int meas;
+	int req_ppb_adjust; /* Requested pbb adjust passed to the PLL control layer */
+	int ppb_adjust; /* Exact ppb adjust returned by the PLL control layer */
+	unsigned int accepted_ppb_err_nb; /* Number of consecutive error measurements within accepted range */
+	int locked_ppb_err; /* accumulated error measurement since last adjustement in locked phase. */
+	unsigned int locked_meas; /* Number of error measurements since last adjustement in locked phase. */
+	bool locked; /* Set once the error has been under MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR, since last start */
+
+	int err; /* Last error, in PLL clock ticks over a sampling period */
+	int err_ppb; /* Last error, in ppb */
+	bool adjusted; /* PLL adjustment done by the last update */
+	int adjust_err; /* PI input of the last adjustment */
+
+	mclock_rec_pll_adjust_t adjust;
+	void *data; /* adjust callback private data */
+	struct mclock_rec_pll_stats *stats;
+};
+
+#define MCLOCK_REC_PLL_NB_MEAS			10
+#define MCLOCK_REC_PLL_NB_MEAS_START_SKIP	3 /* Number of first measurement to skip before starting ppb error average calculation */
+#define MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR	1000 /* Declare the domain locked (ADJUST -> ADJUST_LOCKED) if audio pll error measurement is under 1 ppm */
+#define MCLOCK_REC_PLL_IN_LOCKED_PPB_ERR_NB	3 /* Number of consecutive pll error measurment < MCLOCK_REC_PLL_LOCKED_PPB_ERR before we declare the recovery locked */
+#define MCLOCK_REC_PLL_ADJUST_LOCKED_SAMPLING_SHIFT	4 /* Number (left shift value) of PLL error sampling to be measured in locked phase before feeding to PI (to reduce sampling jitter) */
+#define MCLOCK_REC_PLL_OUT_LOCKED_PPB_ERR	5000 /* Go from ADJUST_LOCKED to ADJUST (quick adjustements) if measured error is over 5 ppm. */
+
+void mclock_rec_pll_ctrl_init(struct mclock_rec_pll_ctrl *ctrl, struct mclock_rec_pll_stats *stats,
+			      mclock_rec_pll_adjust_t adjust, void *data);
+void mclock_rec_pll_ctrl_set_period(struct mclock_rec_pll_ctrl *ctrl, unsigned long long pll_clk_p, unsigned int pll_clk_q,
+				    unsigned int sampling_period);
+void mclock_rec_pll_ctrl_start(struct mclock_rec_pll_ctrl *ctrl, int ppb_adjust);
+int mclock_rec_pll_ctrl_update(struct mclock_rec_pll_ctrl *ctrl, unsigned int meas);
+
+#endif /* _MEDIA_CLOCK_REC_PLL_CTRL_H_ */
@@ -0,0 +1,34 @@
+/*
+ * AVB socket flags
+ * Copyright 2014-2015 Freescale Semiconductor, Inc.
+ * Copyright 2023, 2026 NXP
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef _NET_SOCKET_FLAGS_H_
+#define _NET_SOCKET_FLAGS_H_
+
+/* No kernel dependencies, also used by the userspace build of the transmit scheduler (linux/sim) */
+
+#define SOCKET_FLAGS_RX			(1 << 0)
+#define SOCKET_FLAGS_BOUND		(1 << 1)
+#define SOCKET_FLAGS_CONNECTED		(1 << 2)
+#define SOCKET_FLAGS_WITH_SPH		(1 << 3)
+#define SOCKET_FLAGS_WITHOUT_SPH	(1 << 4)
+#define SOCKET_FLAGS_SPH_MASK		(SOCKET_FLAGS_WITH_SPH | SOCKET_FLAGS_WITHOUT_SPH)
+#define SOCKET_FLAGS_TX_TS_ENABLED	(1 << 5)
+#define SOCKET_FLAGS_VLAN		(1 << 6)
+#define SOCKET_FLAGS_RX_BATCHING_SYNC	(1 << 7)
+#define SOCKET_FLAGS_RX_BATCHING_ASYNC	(1 << 8)
+#define SOCKET_FLAGS_RX_NO_BATCHING	(1 << 9)
+#define SOCKET_FLAGS_RX_BATCHING	(SOCKET_FLAGS_RX_BATCHING_SYNC | SOCKET_FLAGS_RX_BATCHING_ASYNC)
+#define SOCKET_FLAGS_RX_BATCH_ANY	(SOCKET_FLAGS_RX_BATCHING_SYNC | SOCKET_FLAGS_RX_BATCHING_ASYNC | SOCKET_FLAGS_RX_NO_BATCHING)
+#define SOCKET_FLAGS_FLOW_CONTROL	(1 << 10)
+
+#define SOCKET_ATOMIC_FLAGS_FLUSH			0
+#define SOCKET_ATOMIC_FLAGS_BUSY			1
+#define SOCKET_ATOMIC_FLAGS_SOCKET_WAITING_EVENT	2
+#define SOCKET_ATOMIC_FLAGS_LATENCY_VALID		3
+
+#endif /* _NET_SOCKET_FLAGS_H_ */
@@ -1,7 +1,7 @@
 /*
  * AVB network tx QoS
  * Copyright 2014-2015 Freescale Semiconductor, Inc.
- * Copyright 2023 NXP
+ * Copyright 2023, 2026 NXP
  *
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
@@ -27,14 +27,19 @@ struct net_sr_config {
 	u8 stream_id[8];
 };
 
-#ifdef __KERNEL__
+#if defined(__KERNEL__) || defined(NET_TX_SCHED_USERSPACE)
 
+#ifdef __KERNEL__
 #include <linux/types.h>
 #include <linux/dcache.h>
 
-#include "pi.h"
 #include "queue.h"
 #include "port_config.h"
+#else
+#include "net_tx_sched_user.h"	/* kernel and FEC driver interfaces, provided by the userspace build */
+#endif
+
+#include "pi.h"
 #include "genavb/sr_class.h"
 #include "genavb/config.h"
 
@@ -250,30 +255,45 @@ struct port_qos {
 #endif
 };
 
+struct net_qos;
+
+/* Scheduling core (net_tx_sched.c) */
+int priority_to_tclass(uint8_t priority);
+struct qos_queue *qos_queue_connect(struct port_qos *port, u8 priority, struct queue *q, unsigned int is_sr);
+struct stream_queue *net_qos_stream_get(struct port_qos *port, u8 priority, u8 *stream_id);
+struct qos_queue *net_qos_stream_connect(struct port_qos *port, u8 class, u8 *stream_id, struct queue *queue);
+void net_qos_stream_flush(struct port_qos *port, struct stream_queue *stream);
+int net_qos_stream_configure(struct port_qos *port, struct stream_queue *stream, unsigned int idle_slope);
+void net_qos_sr_class_init(struct sr_class *sr_class, sr_class_t class, unsigned int tnow);
+int net_qos_port_init(struct net_qos *net, struct port_qos *port);
+void net_qos_port_reset(struct port_qos *port, int port_rate_bps);
+unsigned int port_scheduler(struct port_qos *port, unsigned int ptp_now);
+
+void port_jitter_stats_init(struct jitter_stats *s);
+void port_jitter_stats(struct jitter_stats *s, unsigned int ptp_now);
+
+/* Network driver side (net_tx.c, or the userspace simulator) */
+void qos_queue_flush(struct port_qos *port, struct qos_queue *qos_q);
+
+#ifdef __KERNEL__
 struct net_qos {
 	struct port_qos port[CFG_PORTS];
 };
 
 struct avb_drv;
 
-struct qos_queue *qos_queue_connect(struct port_qos *port, u8 priority, struct queue *q, unsigned int is_sr);
 void qos_queue_disconnect(struct port_qos *port, struct qos_queue *qos_q);
 
-struct qos_queue *net_qos_stream_connect(struct port_qos *port, u8 class, u8 *stream_id, struct queue *queue);
 void net_qos_stream_disconnect(struct port_qos *port, struct qos_queue *qos_q);
 int net_qos_sr_config(struct net_qos *net, struct net_sr_config *sr_config);
 void net_qos_port_flush(struct port_qos *port);
-void net_qos_port_reset(struct port_qos *port, int port_rate_bps);
 int net_qos_map_traffic_class_to_hw_queues(struct port_qos *port);
 
 int net_qos_init(struct net_qos *net, struct dentry *avb_dentry);
 int net_qos_sr_class_configure(struct avb_drv *avb, struct net_sr_class_cfg *net_sr_class_cfg);
 void net_qos_exit(struct net_qos *net);
-unsigned int port_scheduler(struct port_qos *port, unsigned int ptp_now);
-
-void port_jitter_stats_init(struct jitter_stats *s);
-void port_jitter_stats(struct jitter_stats *s, unsigned int ptp_now);
-
 #endif /* __KERNEL__ */
 
+#endif /* __KERNEL__ || NET_TX_SCHED_USERSPACE */
+
 #endif /* _NET_TX_H_ */
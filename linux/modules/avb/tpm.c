@@ -1,6 +1,6 @@
 /*
  * AVB TPM driver
- * Copyright 2022-2023 NXP
+ * Copyright 2022-2023, 2026 NXP
  *
  * SPDX-License-Identifier: GPL-2.0-or-later
  */
@@ -526,9 +526,9 @@ static int tpm_probe(struct platform_device *pdev)
 		}
 
 		rec->pll_ref_freq = clk_get_rate(drv->clk_tpm) / drv->prescale;
-		rec->max_adjust = TPM_REC_MAX_ADJUST_PPB;
+		rec->ctrl.max_adjust = TPM_REC_MAX_ADJUST_PPB;
 		rec->pll_timer_clk_div = clk_get_rate(drv->rec.pll.clk_audio_pll) / rec->pll_ref_freq;
-		pi_init(&rec->pi, TPM_REC_I_FACTOR, TPM_REC_P_FACTOR);
+		pi_init(&rec->ctrl.pi, TPM_REC_I_FACTOR, TPM_REC_P_FACTOR);
 
 		//FIXME register 2 devices, a REC and a GEN
 		clock_dev->type = REC;
@@ -93,6 +93,11 @@ int net_tx_multi(struct net_tx *tx, struct net_tx_desc **desc, unsigned int n)
 	return net_ops.net_tx_multi(tx, desc, n);
 }
 
+int net_tx_shaper_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval)
+{
+	return net_ops.net_tx_shaper_config(tx, idle_slope, interval);
+}
+
 void net_tx_ts_process(struct net_tx *tx)
 {
 	uint64_t ts;
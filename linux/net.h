@@ -30,6 +30,7 @@ struct net_ops_cb {
 	void (*net_tx_exit)(struct net_tx *);
 	int (*net_tx)(struct net_tx *, struct net_tx_desc *);
 	int (*net_tx_multi)(struct net_tx *, struct net_tx_desc **, unsigned int);
+	int (*net_tx_shaper_config)(struct net_tx *, unsigned int, unsigned int);
 
 	int (*net_tx_ts_get)(struct net_tx *, uint64_t *, unsigned int *);
 	int (*net_tx_ts_init)(struct net_tx *, struct net_address *, void (*func)(struct net_tx *, uint64_t, unsigned int), unsigned long);
@@ -400,6 +400,12 @@ err:
 		return -1;
 }
 
+int net_avb_tx_shaper_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval)
+{
+	/* SR streams are shaped by the AVB kernel module */
+	return 0;
+}
+
 int net_avb_tx_ts_get(struct net_tx *tx, uint64_t *ts, unsigned int *private)
 {
 	struct net_ts_desc ts_desc;
@@ -616,6 +622,7 @@ const static struct net_ops_cb net_avb_ops = {
 		.net_tx_exit = net_avb_tx_exit,
 		.net_tx = net_avb_tx,
 		.net_tx_multi = net_avb_tx_multi,
+		.net_tx_shaper_config = net_avb_tx_shaper_config,
 
 		.net_tx_ts_get = net_avb_tx_ts_get,
 		.net_tx_ts_init = net_avb_tx_ts_init,
@@ -0,0 +1,360 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Software credit based shaper for the standard socket and AF_XDP network backends
+ @details Stream credit updates and pending frames handling, plus the per endpoint enable (system.cfg [NET_SHAPER])
+ and the cbs/taprio qdisc detection. See net_shaper.h for the shaper behavior.
+*/
+
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+#include "common/log.h"
+#include "common/ether.h"
+#include "os/clock.h"
+#include "os/net.h"
+#include "os/stdlib.h"
+
+#include "net_logical_port.h"
+#include "net_shaper.h"
+#include "os_config.h"
+
+static struct os_net_shaper_config net_shaper_config;
+
+static s64 net_shaper_frame_cost(unsigned int len)
+{
+	unsigned int size = len + ETHER_FCS;
+
+	if (size < ETHER_MIN_FRAME_SIZE)
+		size = ETHER_MIN_FRAME_SIZE;
+
+	return (s64)(ETHER_IFG + ETHER_PREAMBLE + size) * 8 * NSECS_PER_SEC;
+}
+
+static void net_shaper_update(struct net_shaper *s, u64 now, bool pending)
+{
+	/* Positive credit is only kept while frames are waiting, and bounded to one second of reserved bandwidth */
+	s64 limit = pending ? (s64)s->idle_slope * NSECS_PER_SEC : 0;
+	u64 dt = now - s->tlast;
+
+	s->tlast = now;
+
+	if (s->credit >= limit) {
+		s->credit = limit;
+		return;
+	}
+
+	/* Elapsed time is only accounted up to the limit, so the product can't overflow after a long idle period */
+	if (s->idle_slope && (dt > (u64)(limit - s->credit) / s->idle_slope))
+		s->credit = limit;
+	else
+		s->credit += (s64)s->idle_slope * (s64)dt;
+}
+
+/* As in the kernel shaper, a frame can be sent if the credit would become positive within one class interval */
+static inline bool net_shaper_ready(struct net_shaper *s)
+{
+	return s->credit >= s->credit_min;
+}
+
+static void net_shaper_enqueue(struct net_shaper *s, struct net_tx_desc *desc)
+{
+	s->pending[(s->pending_r + s->pending_n) % NET_SHAPER_PENDING_MAX] = desc;
+	s->pending_n++;
+}
+
+static void net_shaper_dequeue(struct net_shaper *s)
+{
+	s->pending_r = (s->pending_r + 1) % NET_SHAPER_PENDING_MAX;
+	s->pending_n--;
+}
+
+/** Initializes a stream shaper
+ *
+ * \param s		pointer to shaper context
+ * \param idle_slope	stream reserved bandwidth, in bits per second
+ * \param interval	stream class measurement interval, in nanoseconds
+ * \param now		current time, in nanoseconds
+ */
+void net_shaper_init(struct net_shaper *s, unsigned int idle_slope, unsigned int interval, u64 now)
+{
+	s->idle_slope = idle_slope;
+	s->credit = 0;
+	s->credit_min = -(s64)idle_slope * interval;
+	s->tlast = now;
+
+	s->pending_r = 0;
+	s->pending_n = 0;
+	s->deferred = 0;
+	s->dropped = 0;
+
+	os_log(LOG_INFO, "shaper(%p) idle_slope %u interval %u\n", s, idle_slope, interval);
+}
+
+/** Releases the frames still pending in the shaper
+ *
+ * \param s		pointer to shaper context
+ * \param free_func	function used to free the pending descriptors
+ */
+void net_shaper_exit(struct net_shaper *s, net_shaper_free_t free_func)
+{
+	while (s->pending_n) {
+		free_func(s->pending[s->pending_r]);
+		net_shaper_dequeue(s);
+	}
+
+	os_log(LOG_INFO, "shaper(%p) deferred %u dropped %u\n", s, s->deferred, s->dropped);
+}
+
+/** Transmits a batch of frames, paced by the shaper
+ *
+ * Takes ownership of the descriptors: they are either transmitted, kept pending in the shaper or freed.
+ * Frames pending from previous calls are transmitted first.
+ *
+ * \return		number of descriptors accepted (transmitted or pending), -1 on error
+ * \param s		pointer to shaper context
+ * \param tx		pointer to network transmit context
+ * \param desc		array of network transmit descriptor pointers
+ * \param n		array length
+ * \param now		current time, in nanoseconds
+ * \param tx_func	backend transmit function
+ * \param free_func	backend descriptor free function
+ */
+int net_shaper_tx_multi(struct net_shaper *s, struct net_tx *tx, struct net_tx_desc **desc, unsigned int n, u64 now,
+			net_shaper_tx_t tx_func, net_shaper_free_t free_func)
+{
+	struct net_tx_desc *pending;
+	unsigned int accepted = 0;
+	unsigned int i;
+	s64 cost;
+
+	/* Credit only accumulates if frames were waiting since the last call */
+	net_shaper_update(s, now, s->pending_n != 0);
+
+	/* The descriptors may be freed by the transmit function, the frame cost is computed before */
+	while (s->pending_n) {
+		if (!net_shaper_ready(s))
+			break;
+
+		pending = s->pending[s->pending_r];
+		cost = net_shaper_frame_cost(pending->len);
+
+		/* Transmit queue full, retry on next call */
+		if (tx_func(tx, pending) < 0)
+			break;
+
+		s->credit -= cost;
+		net_shaper_dequeue(s);
+	}
+
+	for (i = 0; i < n; i++) {
+		if (!s->pending_n && net_shaper_ready(s)) {
+			cost = net_shaper_frame_cost(desc[i]->len);
+
+			if (tx_func(tx, desc[i]) < 0)
+				goto err;
+
+			s->credit -= cost;
+		} else {
+			if (s->pending_n == NET_SHAPER_PENDING_MAX)
+				goto err_full;
+
+			net_shaper_enqueue(s, desc[i]);
+			s->deferred++;
+		}
+
+		accepted++;
+	}
+
+	if (!s->pending_n && (s->credit > 0))
+		s->credit = 0;
+
+	return accepted;
+
+err_full:
+	s->dropped += n - i;
+
+err:
+	for (; i < n; i++)
+		free_func(desc[i]);
+
+	if (accepted)
+		return accepted;
+	else
+		return -1;
+}
+
+/** Checks if SR class traffic is already shaped by the network interface (cbs or taprio qdisc, offloaded or not)
+ *
+ * \return		true if a cbs or taprio qdisc is attached to the interface, false otherwise
+ * \param port_id	logical port
+ */
+static bool net_shaper_port_has_qdisc(unsigned int port_id)
+{
+	struct {
+		struct nlmsghdr nh;
+		struct tcmsg tcm;
+	} req;
+	char buf[8192];
+	struct nlmsghdr *nh;
+	struct tcmsg *tcm;
+	struct rtattr *rta;
+	unsigned int ifindex;
+	bool found = false, done = false;
+	int fd, len, rta_len;
+
+	ifindex = if_nametoindex(logical_port_name(port_id));
+	if (!ifindex)
+		goto err_ifindex;
+
+	fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+	if (fd < 0)
+		goto err_socket;
+
+	memset(&req, 0, sizeof(req));
+	req.nh.nlmsg_len = NLMSG_LENGTH(sizeof(struct tcmsg));
+	req.nh.nlmsg_type = RTM_GETQDISC;
+	req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	req.tcm.tcm_family = AF_UNSPEC;
+	req.tcm.tcm_ifindex = ifindex;
+
+	if (send(fd, &req, req.nh.nlmsg_len, 0) < 0)
+		goto exit;
+
+	while (!done) {
+		len = recv(fd, buf, sizeof(buf), 0);
+		if (len <= 0)
+			break;
+
+		for (nh = (struct nlmsghdr *)buf; NLMSG_OK(nh, len); nh = NLMSG_NEXT(nh, len)) {
+			if ((nh->nlmsg_type == NLMSG_DONE) || (nh->nlmsg_type == NLMSG_ERROR)) {
+				done = true;
+				break;
+			}
+
+			if (nh->nlmsg_type != RTM_NEWQDISC)
+				continue;
+
+			/* The dump covers all interfaces */
+			tcm = NLMSG_DATA(nh);
+			if (tcm->tcm_ifindex != (int)ifindex)
+				continue;
+
+			rta_len = nh->nlmsg_len - NLMSG_LENGTH(sizeof(struct tcmsg));
+
+			for (rta = TCA_RTA(tcm); RTA_OK(rta, rta_len); rta = RTA_NEXT(rta, rta_len)) {
+				if ((rta->rta_type == TCA_KIND)
+				&& (!strcmp(RTA_DATA(rta), "cbs") || !strcmp(RTA_DATA(rta), "taprio")))
+					found = true;
+			}
+		}
+	}
+
+exit:
+	close(fd);
+
+err_socket:
+err_ifindex:
+	return found;
+}
+
+/** Sets the software shaper run time configuration, must be called before any transmit context is configured
+ *
+ * \param config	pointer to the shaper configuration
+ */
+void net_shaper_config_init(struct os_net_shaper_config *config)
+{
+	net_shaper_config = *config;
+}
+
+/** Enables (or reconfigures) software shaping of a network transmit context
+ * Only if enabled for the transmit context port, and the port doesn't already shape SR class traffic.
+ *
+ * \return		1 if the transmit context is shaped in software, 0 if not, -1 on error
+ * \param tx		pointer to network transmit context
+ * \param idle_slope	stream reserved bandwidth, in bits per second
+ * \param interval	stream class measurement interval, in nanoseconds
+ */
+int net_shaper_tx_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval)
+{
+	u64 now;
+
+	if (!logical_port_valid(tx->port_id) || !logical_port_is_endpoint(tx->port_id)
+	|| !net_shaper_config.endpoint_enable[logical_port_endpoint_id(tx->port_id)])
+		return 0;
+
+	if (net_shaper_port_has_qdisc(tx->port_id)) {
+		os_log(LOG_INFO, "logical_port(%u) SR class shaping done by the interface, software shaper not used\n", tx->port_id);
+		return 0;
+	}
+
+	if (!idle_slope || !interval)
+		goto err;
+
+	if (os_clock_gettime64(OS_CLOCK_SYSTEM_MONOTONIC, &now) < 0)
+		goto err;
+
+	if (!tx->shaper) {
+		tx->shaper = os_malloc(sizeof(struct net_shaper));
+		if (!tx->shaper)
+			goto err;
+	} else if (tx->shaper->pending_n) {
+		/* Keep the pending frames, only the reservation changes */
+		tx->shaper->idle_slope = idle_slope;
+		tx->shaper->credit_min = -(s64)idle_slope * interval;
+
+		return 1;
+	}
+
+	net_shaper_init(tx->shaper, idle_slope, interval, now);
+
+	return 1;
+
+err:
+	return -1;
+}
+
+/** Disables software shaping of a network transmit context
+ *
+ * \param tx		pointer to network transmit context
+ * \param free_func	backend descriptor free function
+ */
+void net_shaper_tx_exit(struct net_tx *tx, net_shaper_free_t free_func)
+{
+	if (!tx->shaper)
+		return;
+
+	net_shaper_exit(tx->shaper, free_func);
+
+	os_free(tx->shaper);
+	tx->shaper = NULL;
+}
+
+/** Transmits a batch of frames on a shaped network transmit context
+ *
+ * \return		number of descriptors accepted (transmitted or pending), -1 on error
+ * \param tx		pointer to network transmit context
+ * \param desc		array of network transmit descriptor pointers
+ * \param n		array length
+ * \param tx_func	backend transmit function
+ * \param free_func	backend descriptor free function
+ */
+int net_shaper_tx(struct net_tx *tx, struct net_tx_desc **desc, unsigned int n, net_shaper_tx_t tx_func, net_shaper_free_t free_func)
+{
+	u64 now;
+
+	/* No credit increase if the time is not available */
+	if (os_clock_gettime64(OS_CLOCK_SYSTEM_MONOTONIC, &now) < 0)
+		now = tx->shaper->tlast;
+
+	return net_shaper_tx_multi(tx->shaper, tx, desc, n, now, tx_func, free_func);
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Software credit based shaper for the standard socket and AF_XDP network backends
+ @details Paces the frames of a single SR stream transmit context against the stream reservation. Disabled by
+ default, enabled per endpoint at run time (system.cfg [NET_SHAPER] endpoint_enable), and only used if the network
+ interface doesn't already shape SR class traffic (cbs or taprio qdisc, including hardware offloads).
+ Follows the stream shaper of the AVB kernel module (linux/modules/avb/net_tx.c):
+ - credit increases at the idle slope rate while frames are pending, and is reset to 0 when the queue empties
+ - credit decreases by the frame size (including the ethernet overhead) for each transmitted frame
+ - a frame can be transmitted if the credit is above a minimum credit of one class measurement interval worth of
+ reserved bandwidth (i.e. the credit would become positive within one class interval)
+
+ Frames that can not be transmitted yet are kept, in order, and transmitted by the next calls. The shaper only acts
+ when called, so a talker must submit its frames at least once per class interval (see stream_tx_batch()) to be
+ paced at that granularity. Less frequent batches are still limited to the reserved rate.
+*/
+
+#ifndef _LINUX_NET_SHAPER_H_
+#define _LINUX_NET_SHAPER_H_
+
+#include "os/sys_types.h"
+#include "genavb/net_types.h"
+
+#define NET_SHAPER_PENDING_MAX	NET_TX_BATCH
+
+struct net_tx;
+struct os_net_shaper_config;
+
+struct net_shaper {
+	unsigned int idle_slope;	/* bits/s */
+	s64 credit;			/* bits x NSECS_PER_SEC */
+	s64 credit_min;			/* bits x NSECS_PER_SEC */
+	u64 tlast;			/* ns */
+
+	struct net_tx_desc *pending[NET_SHAPER_PENDING_MAX];
+	unsigned int pending_r;
+	unsigned int pending_n;
+
+	unsigned int deferred;		/* frames not transmitted on first attempt */
+	unsigned int dropped;		/* frames dropped because the pending queue was full */
+};
+
+/** Network shaper transmit function, leaves the descriptor ownership to the caller on error
+ */
+typedef int (*net_shaper_tx_t)(struct net_tx *tx, struct net_tx_desc *desc);
+typedef void (*net_shaper_free_t)(struct net_tx_desc *desc);
+
+void net_shaper_init(struct net_shaper *s, unsigned int idle_slope, unsigned int interval, u64 now);
+void net_shaper_exit(struct net_shaper *s, net_shaper_free_t free_func);
+int net_shaper_tx_multi(struct net_shaper *s, struct net_tx *tx, struct net_tx_desc **desc, unsigned int n, u64 now,
+			net_shaper_tx_t tx_func, net_shaper_free_t free_func);
+
+void net_shaper_config_init(struct os_net_shaper_config *config);
+int net_shaper_tx_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval);
+void net_shaper_tx_exit(struct net_tx *tx, net_shaper_free_t free_func);
+int net_shaper_tx(struct net_tx *tx, struct net_tx_desc **desc, unsigned int n, net_shaper_tx_t tx_func, net_shaper_free_t free_func);
+
+#endif /* _LINUX_NET_SHAPER_H_ */
@@ -39,6 +39,7 @@
 #include "epoll.h"
 #include "net.h"
 #include "net_logical_port.h"
+#include "net_shaper.h"
 #include "net_std_socket_filters.h"
 
 extern int net_set_hw_ts(unsigned int port_id, bool enable);
@@ -484,6 +485,8 @@ int net_std_tx_init(struct net_tx *tx, struct net_address *addr)
 	if (addr && !net_address_is_supported(addr))
 		goto err_addr;
 
+	tx->shaper = NULL;
+
 	/* protocol 0 for AF_PACKET means socket for transmission only (the sll_protocol
 	 * should also be 0 in bind) */
 	tx->fd = socket(AF_PACKET, SOCK_RAW | SOCK_NONBLOCK, 0);
@@ -528,6 +531,8 @@ err_addr:
 
 void net_std_tx_exit(struct net_tx *tx)
 {
+	net_shaper_tx_exit(tx, net_std_tx_free);
+
 	close(tx->fd);
 	tx->fd = -1;
 
@@ -588,6 +593,9 @@ int net_std_tx_multi(struct net_tx *tx, struct net_tx_desc **desc, unsigned int
 	unsigned int written = 0;
 	int i, rc;
 
+	if (tx->shaper)
+		return net_shaper_tx(tx, desc, n, net_std_tx, net_std_tx_free);
+
 	while (written < n) {
 		rc = net_std_tx(tx, desc[written]);
 		if (rc < 0)
@@ -606,6 +614,11 @@ err:
 		return -1;
 }
 
+int net_std_tx_shaper_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval)
+{
+	return net_shaper_tx_config(tx, idle_slope, interval);
+}
+
 int net_std_tx_ts_get(struct net_tx *tx, uint64_t *ts, unsigned int *private)
 {
 	char iobuf[256];
@@ -730,6 +743,7 @@ const static struct net_ops_cb net_std_ops = {
 		.net_tx_exit = net_std_tx_exit,
 		.net_tx = net_std_tx,
 		.net_tx_multi = net_std_tx_multi,
+		.net_tx_shaper_config = net_std_tx_shaper_config,
 
 		.net_tx_ts_get = net_std_tx_ts_get,
 		.net_tx_ts_init = net_std_tx_ts_init,
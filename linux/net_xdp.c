@@ -35,6 +35,7 @@
 #include "epoll.h"
 #include "net_logical_port.h"
 #include "net.h"
+#include "net_shaper.h"
 #include "pool.h"
 
 #define NET_XDP_ZEROCOPY 1
@@ -796,6 +797,7 @@ int net_xdp_tx_init(struct net_tx *tx, struct net_address *addr)
 	tx->priv = ctx;
 	tx->port_id = addr->port;
 	tx->fd = xdp_dl_libs.xsk_socket__fd(ctx->xdpsock);
+	tx->shaper = NULL;
 
 	os_log(LOG_INIT, "fd(%d)\n", tx->fd);
 
@@ -809,6 +811,8 @@ void net_xdp_tx_exit(struct net_tx *tx)
 {
 	struct net_xdp_ctx *ctx = (struct net_xdp_ctx *)tx->priv;
 
+	net_shaper_tx_exit(tx, net_xdp_tx_free);
+
 	net_xdp_ctx_exit(ctx);
 
 	tx->fd = -1;
@@ -852,6 +856,9 @@ int net_xdp_tx_multi(struct net_tx *tx, struct net_tx_desc **desc, unsigned int
 	unsigned int written = 0;
 	int i, rc;
 
+	if (tx->shaper)
+		return net_shaper_tx(tx, desc, n, net_xdp_tx, net_xdp_tx_free);
+
 	while (written < n) {
 		rc = net_xdp_tx(tx, desc[written]);
 		if (rc < 0)
@@ -870,6 +877,11 @@ err:
 		return -1;
 }
 
+int net_xdp_tx_shaper_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval)
+{
+	return net_shaper_tx_config(tx, idle_slope, interval);
+}
+
 int net_xdp_tx_ts_get(struct net_tx *tx, uint64_t *ts, unsigned int *private)
 {
 	return -1;
@@ -935,6 +947,7 @@ const static struct net_ops_cb net_xdp_ops = {
 		.net_tx_exit = net_xdp_tx_exit,
 		.net_tx = net_xdp_tx,
 		.net_tx_multi = net_xdp_tx_multi,
+		.net_tx_shaper_config = net_xdp_tx_shaper_config,
 
 		.net_tx_ts_get = net_xdp_tx_ts_get,
 		.net_tx_ts_init = net_xdp_tx_ts_init,
@@ -1,5 +1,5 @@
 /*
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -20,10 +20,13 @@
 #define CLOCK_BRIDGE_GPTP_0_DEFAULT		"sw_clock"		/* domain 0 */
 #define CLOCK_BRIDGE_GPTP_1_DEFAULT		"sw_clock"		/* domain 1 */
 #define CLOCK_BRIDGE_LOCAL_DEFAULT		"/dev/ptp1"
+#define CLOCK_TIME_PAGE_DEFAULT			1
 
 const int XDP_ENDPOINT_QUEUE_RX_DEFAULT[2] = { 0, 0 };
 const int XDP_ENDPOINT_QUEUE_TX_DEFAULT[2] = { 1, 1 };
 
+const int NET_SHAPER_ENDPOINT_ENABLE_DEFAULT[2] = { 0, 0 };
+
 static int process_section_logical_port(struct _SECTIONENTRY *configtree, struct os_logical_port_config *config)
 {
 	if (cfg_get_string_list(configtree, "LOGICAL_PORT", "endpoint", LOGICAL_PORT_ENDPOINT_DEFAULT, config->endpoint, CFG_MAX_ENDPOINTS) < 0)
@@ -63,6 +66,9 @@ static int process_section_clock(struct _SECTIONENTRY *configtree, struct os_clo
 	if (cfg_get_string_list(configtree, "CLOCK", "bridge_local", CLOCK_BRIDGE_LOCAL_DEFAULT, config->bridge_local, CFG_MAX_BRIDGES) < 0)
 		goto err;
 
+	if (cfg_get_uint(configtree, "CLOCK", "time_page", CLOCK_TIME_PAGE_DEFAULT, 0, 1, &config->time_page) < 0)
+		goto err;
+
 	return 0;
 
 err:
@@ -83,6 +89,17 @@ err:
 	return -1;
 }
 
+static int process_section_net_shaper(struct _SECTIONENTRY *configtree, struct os_net_shaper_config *config)
+{
+	if (cfg_get_signed_int_list(configtree, "NET_SHAPER", "endpoint_enable", NET_SHAPER_ENDPOINT_ENABLE_DEFAULT, config->endpoint_enable, CFG_MAX_ENDPOINTS) < 0)
+		goto err;
+
+	return 0;
+
+err:
+	return -1;
+}
+
 static int process_os_config(struct os_config *config, struct _SECTIONENTRY *configtree)
 {
 
@@ -99,6 +116,9 @@ static int process_os_config(struct os_config *config, struct _SECTIONENTRY *con
 	if (process_section_xdp(configtree, &config->xdp_config))
 		goto err;
 
+	if (process_section_net_shaper(configtree, &config->net_shaper_config))
+		goto err;
+
 	return 0;
 
 err:
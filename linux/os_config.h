@@ -1,5 +1,5 @@
 /*
-* Copyright 2020, 2023 NXP
+* Copyright 2020, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -27,6 +27,7 @@ struct os_config {
 		char endpoint_local[CFG_MAX_ENDPOINTS][32];
 		char bridge_gptp[CFG_MAX_GPTP_DOMAINS][CFG_MAX_BRIDGES][32];
 		char bridge_local[CFG_MAX_BRIDGES][32];
+		unsigned int time_page;	/* 1 to read gPTP clocks adjusted by another process from their time page, 0 to always use system calls */
 	} clock_config;
 
 	struct os_net_config {
@@ -37,6 +38,10 @@ struct os_config {
 		int endpoint_queue_rx[CFG_MAX_ENDPOINTS];
 		int endpoint_queue_tx[CFG_MAX_ENDPOINTS];
 	} xdp_config;
+
+	struct os_net_shaper_config {
+		int endpoint_enable[CFG_MAX_ENDPOINTS];	/* software SR stream shaping, standard socket and AF_XDP backends */
+	} net_shaper_config;
 };
 
 int os_config_get(struct os_config *config);
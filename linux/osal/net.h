@@ -20,6 +20,8 @@
 
 #define DEFAULT_NET_DATA_SIZE 1600
 
+struct net_shaper;
+
 struct net_tx {
 	int fd;
 	int epoll_fd;
@@ -29,6 +31,7 @@ struct net_tx {
 	u8 eth_src[6];
 	os_clock_id_t clock_domain; /* clock domain to which hw timestamps must be converted */
 	void *priv;
+	struct net_shaper *shaper; /* software shaper, for SR streams on backends without SR class shaping */
 };
 
 struct net_rx {
@@ -0,0 +1,758 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief AVB transmit shaper simulator
+ @details Runs the AVB kernel module transmit scheduler (linux/modules/avb/net_tx_sched.c), built in userspace,
+ with synthetic stream and best effort queues. port_scheduler() is called every hardware timer period, with an
+ optional interrupt latency jitter, and transmitted frames are serialized at the port rate on a simulated wire.
+ Reports, for each class, the latency of transmitted frames (end of transmission on the wire, relative to the
+ frame transmit time for SR streams and to the enqueue time for best effort), the measured SR class rate against
+ its idle slope, the credit ranges and the CPU cost of each scheduler tick. An optional trace records the port,
+ class and stream credits after each tick.
+
+ The SR class latency bound checked is a simplified one, specific to the software shaper, over one hop. It is not
+ the IEEE 802.1Q Annex L / 802.1BA per-hop latency bound: a frame is released to the
+ driver at the latest by the first scheduler tick following its transmit time (and possibly up to one class
+ sub-interval earlier, so latencies can be negative), the wire may then still hold up to one tick worth of data plus
+ one maximum size frame, and all the frames of the same and higher SR classes released in the same tick may be sent
+ first (one frame per stream and class interval):
+ bound = jitter + tick period + (max frame + sum of same and higher class stream frames) / port rate
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "genavb/helpers.h"
+#include "genavb/ether.h"
+#include "genavb/qos.h"
+#include "genavb/sr_class.h"
+
+#include "os/clock.h"
+
+#include "modules/avb/net_tx.h"
+#include "modules/avb/hw_timer.h"
+
+#define CBS_SIM_DEFAULT_RATE		100	/* Mbps */
+#define CBS_SIM_DEFAULT_DURATION	1000	/* ms */
+#define CBS_SIM_DEFAULT_APP_PERIOD	1000	/* us */
+#define CBS_SIM_DEFAULT_SR_FRAME_SIZE	256	/* bytes, without FCS */
+#define CBS_SIM_DEFAULT_BE_FRAME_SIZE	1518	/* bytes, without FCS */
+
+#define CBS_SIM_MIN_FRAME_SIZE		(ETHER_MIN_FRAME_SIZE - FCS_LEN)
+#define CBS_SIM_MAX_FRAME_SIZE		1518
+
+#define CBS_SIM_TX_RING_SIZE		512	/* FEC transmit ring */
+
+#define CBS_SIM_CLASS_BE		CFG_SR_CLASS_MAX	/* statistics index of the best effort class */
+#define CBS_SIM_CLASS_MAX		(CFG_SR_CLASS_MAX + 1)
+
+#define CBS_SIM_STREAM_MAX		CFG_SR_CLASS_STREAM_MAX
+#define CBS_SIM_FRAME_MAX		((CFG_SR_CLASS_MAX * CBS_SIM_STREAM_MAX + 1) * QUEUE_ENTRIES_MAX + CBS_SIM_TX_RING_SIZE)
+
+#define CBS_SIM_COST_BIN_NS		10
+#define CBS_SIM_COST_BINS		10000	/* up to 100 us */
+
+struct cbs_sim_frame {
+	struct avb_tx_desc desc;	/* must be first, the scheduler queues hold descriptor pointers */
+	u64 time;			/* transmit time (SR) or enqueue time (best effort), in ns */
+	unsigned int class;
+};
+
+struct cbs_sim_stream {
+	struct queue queue;
+	struct qos_queue *qos_q;
+	unsigned int class;		/* statistics index */
+	unsigned int frame_size;
+	u64 period;			/* ns */
+	u64 next;			/* next frame transmit time, in ns */
+};
+
+struct cbs_sim_class_stats {
+	unsigned int streams;
+	unsigned int frame_size;
+	unsigned int idle_slope;	/* bits/s */
+	u64 bound;			/* ns */
+
+	u64 frames;
+	u64 dropped;
+	u64 bits;			/* including the port overhead */
+	double latency_sum;
+	s64 latency_min;
+	s64 latency_max;
+	u64 bound_exceeded;
+
+	int credit_min;
+	int credit_max;
+};
+
+static struct cbs_sim {
+	struct port_qos port;
+
+	u64 now;			/* ns */
+	u64 rate;			/* bits/s */
+	u64 jitter;			/* ns */
+
+	/* simulated wire and transmit ring */
+	u64 wire_free;			/* end of the last frame on the wire */
+	u64 ring[CBS_SIM_TX_RING_SIZE];	/* end of transmission of the frames in the ring */
+	unsigned int ring_r;
+	unsigned int ring_n;
+	u64 ring_full;
+
+	struct cbs_sim_stream stream[CFG_SR_CLASS_MAX * CBS_SIM_STREAM_MAX];
+	unsigned int stream_n;
+
+	/* best effort traffic, Poisson arrivals */
+	struct cbs_sim_stream be;
+	unsigned int be_load;		/* percent of the port rate */
+	double be_mean_interval;	/* ns */
+
+	struct cbs_sim_frame frame[CBS_SIM_FRAME_MAX];
+	struct cbs_sim_frame *frame_free[CBS_SIM_FRAME_MAX];
+	unsigned int frame_free_n;
+
+	struct cbs_sim_class_stats stats[CBS_SIM_CLASS_MAX];
+	int port_credit_min;
+	int port_credit_max;
+
+	u64 ticks;
+	u64 cost_sum;
+	u64 cost_max;
+	unsigned int cost_hist[CBS_SIM_COST_BINS + 1];
+
+	FILE *trace;
+} cbs_sim;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n cbs-sim [options]\n");
+	printf("\nOptions:\n"
+		"\t-A <streams>[,<bytes>]  high priority SR class streams, one frame per class interval (default: 0, frame size %u)\n"
+		"\t-B <streams>[,<bytes>]  low priority SR class streams, one frame per class interval (default: 0, frame size %u)\n"
+		"\t-e <load>[,<bytes>]     best effort load, in percent of the port rate, Poisson arrivals (default: 0, frame size %u)\n"
+		"\t-r <Mbps>               port rate (default: %u)\n"
+		"\t-t <ms>                 simulated duration (default: %u)\n"
+		"\t-j <ns>                 scheduler tick jitter, uniformly distributed interrupt latency (default: 0)\n"
+		"\t-p <us>                 talker application period, frames are queued one period ahead (default: %u)\n"
+		"\t-s <seed>               random seed (default: 1)\n"
+		"\t-T <file>               write a credit trace (one line per scheduler tick, csv)\n"
+		"\t-h                      print this help text\n"
+		"\nThe SR class latency bound checked is a simplified one hop bound of the software shaper\n"
+		"(jitter + tick period + (max frame + same and higher class stream frames) / port rate),\n"
+		"not the IEEE 802.1Q Annex L / 802.1BA per-hop latency bound.\n",
+		CBS_SIM_DEFAULT_SR_FRAME_SIZE, CBS_SIM_DEFAULT_SR_FRAME_SIZE, CBS_SIM_DEFAULT_BE_FRAME_SIZE,
+		CBS_SIM_DEFAULT_RATE, CBS_SIM_DEFAULT_DURATION, CBS_SIM_DEFAULT_APP_PERIOD);
+}
+
+/* Parses "<n>[,<bytes>]" */
+static int parse_count_size(const char *s, unsigned long *n, unsigned long *size)
+{
+	char *end;
+
+	if (h_strtoul(n, s, &end, 0) < 0)
+		return -1;
+
+	if (*end == ',') {
+		if ((h_strtoul(size, end + 1, NULL, 0) < 0) || (*size < CBS_SIM_MIN_FRAME_SIZE) || (*size > CBS_SIM_MAX_FRAME_SIZE))
+			return -1;
+	} else if (*end) {
+		return -1;
+	}
+
+	return 0;
+}
+
+static u64 frame_bits(unsigned int len)
+{
+	if (len < CBS_SIM_MIN_FRAME_SIZE)
+		len = CBS_SIM_MIN_FRAME_SIZE;
+
+	return (u64)(len + PORT_OVERHEAD) * BITS_PER_BYTE;
+}
+
+static char class_name(unsigned int class)
+{
+	if (class == CBS_SIM_CLASS_BE)
+		return '-';
+
+	return 'A' + sr_prio_class(class);
+}
+
+static struct cbs_sim_frame *frame_alloc(void)
+{
+	if (!cbs_sim.frame_free_n)
+		return NULL;
+
+	return cbs_sim.frame_free[--cbs_sim.frame_free_n];
+}
+
+static void frame_free(struct cbs_sim_frame *frame)
+{
+	cbs_sim.frame_free[cbs_sim.frame_free_n++] = frame;
+}
+
+/*
+ * FEC driver interface
+ */
+
+int fec_enet_start_xmit_avb(void *data, struct avb_tx_desc *desc)
+{
+	struct cbs_sim_frame *frame = (struct cbs_sim_frame *)desc;
+	struct cbs_sim_class_stats *stats = &cbs_sim.stats[frame->class];
+	u64 start, end;
+	s64 latency;
+
+	/* Release the ring entries of the frames already transmitted */
+	while (cbs_sim.ring_n && (cbs_sim.ring[cbs_sim.ring_r] <= cbs_sim.now)) {
+		cbs_sim.ring_r = (cbs_sim.ring_r + 1) % CBS_SIM_TX_RING_SIZE;
+		cbs_sim.ring_n--;
+	}
+
+	if (cbs_sim.ring_n == CBS_SIM_TX_RING_SIZE) {
+		cbs_sim.ring_full++;
+		return -ENOSPC;
+	}
+
+	start = (cbs_sim.wire_free > cbs_sim.now) ? cbs_sim.wire_free : cbs_sim.now;
+	end = start + (frame_bits(desc->common.len) * NSECS_PER_SEC) / cbs_sim.rate;
+
+	cbs_sim.wire_free = end;
+	cbs_sim.ring[(cbs_sim.ring_r + cbs_sim.ring_n) % CBS_SIM_TX_RING_SIZE] = end;
+	cbs_sim.ring_n++;
+
+	latency = (s64)(end - frame->time);
+
+	stats->frames++;
+	stats->bits += frame_bits(desc->common.len);
+	stats->latency_sum += latency;
+	if (latency < stats->latency_min)
+		stats->latency_min = latency;
+	if (latency > stats->latency_max)
+		stats->latency_max = latency;
+	if ((frame->class != CBS_SIM_CLASS_BE) && (latency > (s64)stats->bound))
+		stats->bound_exceeded++;
+
+	frame_free(frame);
+
+	return 0;
+}
+
+void fec_enet_finish_xmit_avb(void *data, unsigned int queue_id)
+{
+}
+
+int fec_enet_set_idle_slope(void *data, unsigned int queue_id, unsigned int idle_slope)
+{
+	/* Software shaping only */
+	return 0;
+}
+
+void qos_queue_flush(struct port_qos *port, struct qos_queue *qos_q)
+{
+	struct traffic_class *tc = qos_q->tc;
+
+	if (!(qos_q->flags & QOS_QUEUE_FLAG_CONNECTED))
+		return;
+
+	clear_bit(qos_q->index, &tc->shared_pending_mask);
+	clear_bit(qos_q->index, &tc->scheduled_mask);
+
+	while (!queue_empty(qos_q->queue))
+		frame_free((struct cbs_sim_frame *)queue_dequeue(qos_q->queue));
+}
+
+/* Log timestamps use the simulated time */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = cbs_sim.now;
+
+	return 0;
+}
+
+/*
+ * Talkers
+ */
+
+/* Same as the kernel socket_qos_enqueue() */
+static int stream_enqueue(struct cbs_sim_stream *stream, struct cbs_sim_frame *frame)
+{
+	struct qos_queue *qos_q = stream->qos_q;
+
+	if (queue_enqueue(qos_q->queue, (unsigned long)frame) < 0) {
+		qos_q->full++;
+		qos_q->dropped++;
+		return -1;
+	}
+
+	set_bit(qos_q->index, &qos_q->tc->shared_pending_mask);
+
+	return 0;
+}
+
+/* Queues all the stream frames with a transmit time before the end of the next application period */
+static void stream_write(struct cbs_sim_stream *stream, u64 until)
+{
+	struct cbs_sim_frame *frame;
+
+	while (stream->next < until) {
+		frame = frame_alloc();
+		if (!frame)
+			goto drop;
+
+		frame->desc.common.flags = AVB_TX_FLAG_TS;
+		frame->desc.common.ts = (u32)stream->next;
+		frame->desc.common.len = stream->frame_size;
+		frame->time = stream->next;
+		frame->class = stream->class;
+
+		if (stream_enqueue(stream, frame) < 0) {
+			frame_free(frame);
+			goto drop;
+		}
+
+		goto next;
+
+	drop:
+		cbs_sim.stats[stream->class].dropped++;
+
+	next:
+		stream->next += stream->period;
+	}
+}
+
+/* Queues the best effort frames that arrived since the last tick */
+static void be_write(void)
+{
+	struct cbs_sim_stream *be = &cbs_sim.be;
+	struct cbs_sim_frame *frame;
+
+	while (be->next <= cbs_sim.now) {
+		frame = frame_alloc();
+		if (!frame) {
+			cbs_sim.stats[CBS_SIM_CLASS_BE].dropped++;
+		} else {
+			frame->desc.common.flags = 0;
+			frame->desc.common.ts = 0;
+			frame->desc.common.len = be->frame_size;
+			frame->time = be->next;
+			frame->class = CBS_SIM_CLASS_BE;
+
+			if (stream_enqueue(be, frame) < 0) {
+				frame_free(frame);
+				cbs_sim.stats[CBS_SIM_CLASS_BE].dropped++;
+			}
+		}
+
+		be->next += (u64)(-log(1.0 - drand48()) * cbs_sim.be_mean_interval) + 1;
+	}
+}
+
+/*
+ * Setup
+ */
+
+static int cbs_sim_add_streams(unsigned int sr_class, unsigned int n, unsigned int frame_size)
+{
+	struct cbs_sim_class_stats *stats = &cbs_sim.stats[sr_class];
+	sr_class_t class = sr_prio_class(sr_class);
+	struct cbs_sim_stream *stream;
+	struct stream_queue *stream_q;
+	unsigned int idle_slope;
+	u8 stream_id[8];
+	unsigned int i;
+
+	/* One frame per class interval */
+	idle_slope = ((u64)frame_bits(frame_size) * NSECS_PER_SEC * sr_class_interval_q(class)) / sr_class_interval_p(class);
+
+	stats->streams = n;
+	stats->frame_size = frame_size;
+
+	for (i = 0; i < n; i++) {
+		stream = &cbs_sim.stream[cbs_sim.stream_n];
+
+		memset(stream_id, 0, sizeof(stream_id));
+		stream_id[6] = sr_class;
+		stream_id[7] = i;
+
+		stream_q = net_qos_stream_get(&cbs_sim.port, sr_class_pcp(class), stream_id);
+		if (!stream_q)
+			goto err;
+
+		if (net_qos_stream_configure(&cbs_sim.port, stream_q, idle_slope) < 0) {
+			printf("class %c stream %u: idle slope %u bits/s exceeds the port reservable bandwidth\n", class_name(sr_class), i, idle_slope);
+			goto err;
+		}
+
+		queue_init(&stream->queue, NULL);
+
+		stream->qos_q = net_qos_stream_connect(&cbs_sim.port, class, stream_id, &stream->queue);
+		if (!stream->qos_q)
+			goto err;
+
+		stream->class = sr_class;
+		stream->frame_size = frame_size;
+		stream->period = sr_class_interval_p(class) / sr_class_interval_q(class);
+		stream->next = cbs_sim.now + (stream->period * i) / n;	/* spread the streams over the class interval */
+
+		stats->idle_slope += idle_slope;
+		cbs_sim.stream_n++;
+	}
+
+	return 0;
+
+err:
+	printf("class %c: cannot add %u streams\n", class_name(sr_class), n);
+	return -1;
+}
+
+static int cbs_sim_add_be(unsigned int load, unsigned int frame_size)
+{
+	struct cbs_sim_stream *be = &cbs_sim.be;
+
+	queue_init(&be->queue, NULL);
+
+	be->qos_q = qos_queue_connect(&cbs_sim.port, QOS_BEST_EFFORT_PRIORITY, &be->queue, 0);
+	if (!be->qos_q) {
+		printf("cannot connect best effort queue\n");
+		return -1;
+	}
+
+	be->class = CBS_SIM_CLASS_BE;
+	be->frame_size = frame_size;
+	be->next = cbs_sim.now;
+
+	cbs_sim.be_load = load;
+	cbs_sim.be_mean_interval = (double)frame_bits(frame_size) * NSECS_PER_SEC * 100 / ((double)cbs_sim.rate * load);
+	cbs_sim.stats[CBS_SIM_CLASS_BE].frame_size = frame_size;
+
+	return 0;
+}
+
+/* Simplified software shaper latency bound (not the 802.1Q Annex L bound), see the file description */
+static void cbs_sim_bounds(void)
+{
+	u64 max_bits = 0, burst_bits = 0;
+	unsigned int i;
+
+	for (i = 0; i < CBS_SIM_CLASS_MAX; i++)
+		if ((cbs_sim.stats[i].streams || (i == CBS_SIM_CLASS_BE && cbs_sim.be_load)) && (frame_bits(cbs_sim.stats[i].frame_size) > max_bits))
+			max_bits = frame_bits(cbs_sim.stats[i].frame_size);
+
+	/* Highest priority first */
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++) {
+		burst_bits += cbs_sim.stats[i].streams * frame_bits(cbs_sim.stats[i].frame_size);
+
+		cbs_sim.stats[i].bound = cbs_sim.jitter + HW_TIMER_PERIOD_NS + ((max_bits + burst_bits) * NSECS_PER_SEC) / cbs_sim.rate;
+	}
+}
+
+static void cbs_sim_trace_header(void)
+{
+	unsigned int i;
+
+	fprintf(cbs_sim.trace, "time,port");
+
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++)
+		fprintf(cbs_sim.trace, ",class_%c", class_name(i));
+
+	for (i = 0; i < cbs_sim.stream_n; i++)
+		fprintf(cbs_sim.trace, ",stream_%c%u", class_name(cbs_sim.stream[i].class), cbs_sim.stream[i].qos_q->index);
+
+	fprintf(cbs_sim.trace, "\n");
+}
+
+/* Credits after a scheduler tick */
+static void cbs_sim_credits(void)
+{
+	struct port_qos *port = &cbs_sim.port;
+	struct cbs_sim_class_stats *stats;
+	int credit;
+	unsigned int i;
+
+	if (port->shaper.credit < cbs_sim.port_credit_min)
+		cbs_sim.port_credit_min = port->shaper.credit;
+	if (port->shaper.credit > cbs_sim.port_credit_max)
+		cbs_sim.port_credit_max = port->shaper.credit;
+
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++) {
+		stats = &cbs_sim.stats[i];
+		credit = port->sr_class[i].shaper.credit;
+
+		if (credit < stats->credit_min)
+			stats->credit_min = credit;
+		if (credit > stats->credit_max)
+			stats->credit_max = credit;
+	}
+
+	if (!cbs_sim.trace)
+		return;
+
+	fprintf(cbs_sim.trace, "%" PRIu64 ",%d", cbs_sim.now, port->shaper.credit);
+
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++)
+		fprintf(cbs_sim.trace, ",%d", port->sr_class[i].shaper.credit);
+
+	for (i = 0; i < cbs_sim.stream_n; i++)
+		fprintf(cbs_sim.trace, ",%d", cbs_sim.stream[i].qos_q->stream->shaper.credit);
+
+	fprintf(cbs_sim.trace, "\n");
+}
+
+static u64 monotonic_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (u64)ts.tv_sec * NSECS_PER_SEC + ts.tv_nsec;
+}
+
+static void cbs_sim_tick(void)
+{
+	u64 start, cost;
+
+	start = monotonic_ns();
+	port_scheduler(&cbs_sim.port, (u32)cbs_sim.now);
+	cost = monotonic_ns() - start;
+
+	cbs_sim.ticks++;
+	cbs_sim.cost_sum += cost;
+	if (cost > cbs_sim.cost_max)
+		cbs_sim.cost_max = cost;
+
+	cost /= CBS_SIM_COST_BIN_NS;
+	if (cost > CBS_SIM_COST_BINS)
+		cost = CBS_SIM_COST_BINS;
+	cbs_sim.cost_hist[cost]++;
+}
+
+static u64 cbs_sim_cost_percentile(double p)
+{
+	u64 count = 0, target = (u64)ceil(p * cbs_sim.ticks);
+	unsigned int i;
+
+	for (i = 0; i <= CBS_SIM_COST_BINS; i++) {
+		count += cbs_sim.cost_hist[i];
+		if (count >= target)
+			break;
+	}
+
+	return (u64)(i + 1) * CBS_SIM_COST_BIN_NS;
+}
+
+static void cbs_sim_summary(u64 duration)
+{
+	struct cbs_sim_class_stats *stats;
+	unsigned int i;
+
+	printf("\nclass streams frames   dropped  latency min/mean/max (ns)            bound (ns)  exceeded  rate/idle slope (bits/s)\n");
+
+	for (i = 0; i < CBS_SIM_CLASS_MAX; i++) {
+		stats = &cbs_sim.stats[i];
+
+		if (!stats->frames && !stats->dropped)
+			continue;
+
+		printf("%c     %7u %8" PRIu64 " %7" PRIu64 "  %10" PRId64 " %10.0f %10" PRId64, class_name(i), stats->streams, stats->frames, stats->dropped,
+		       stats->frames ? stats->latency_min : 0, stats->frames ? stats->latency_sum / stats->frames : 0.0,
+		       stats->frames ? stats->latency_max : 0);
+
+		if (i == CBS_SIM_CLASS_BE) {
+			printf("  %10s  %8s  %" PRIu64 "\n", "-", "-", (stats->bits * NSECS_PER_SEC) / duration);
+		} else {
+			printf("  %10" PRIu64 "  %8" PRIu64 "  %" PRIu64 "/%u\n", stats->bound, stats->bound_exceeded,
+			       (stats->bits * NSECS_PER_SEC) / duration, stats->idle_slope);
+		}
+	}
+
+	printf("\ncredit (bits x scale): port %d/%d", cbs_sim.port_credit_min, cbs_sim.port_credit_max);
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++)
+		if (cbs_sim.stats[i].streams)
+			printf(", class %c %d/%d", class_name(i), cbs_sim.stats[i].credit_min, cbs_sim.stats[i].credit_max);
+	printf(" (min/max)\n");
+
+	printf("transmit ring full: %" PRIu64 ", scheduler tx full: %u\n", cbs_sim.ring_full, cbs_sim.port.tx_full);
+
+	if (cbs_sim.ticks)
+		printf("scheduler tick cost (ns): mean %" PRIu64 " p50 %" PRIu64 " p99 %" PRIu64 " p99.9 %" PRIu64 " max %" PRIu64 " (%" PRIu64 " ticks)\n",
+		       cbs_sim.cost_sum / cbs_sim.ticks, cbs_sim_cost_percentile(0.5), cbs_sim_cost_percentile(0.99),
+		       cbs_sim_cost_percentile(0.999), cbs_sim.cost_max, cbs_sim.ticks);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long streams[CFG_SR_CLASS_MAX] = {0};
+	unsigned long frame_size[CBS_SIM_CLASS_MAX];
+	unsigned long be_load = 0;
+	unsigned long rate = CBS_SIM_DEFAULT_RATE;
+	unsigned long duration = CBS_SIM_DEFAULT_DURATION;
+	unsigned long jitter = 0;
+	unsigned long app_period = CBS_SIM_DEFAULT_APP_PERIOD;
+	unsigned long seed = 1;
+	const char *trace_path = NULL;
+	u64 start, end, tick, app_next;
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++)
+		frame_size[i] = CBS_SIM_DEFAULT_SR_FRAME_SIZE;
+	frame_size[CBS_SIM_CLASS_BE] = CBS_SIM_DEFAULT_BE_FRAME_SIZE;
+
+	while ((option = getopt(argc, argv, "A:B:e:r:t:j:p:s:T:h")) != -1) {
+		switch (option) {
+		case 'A':
+			if ((parse_count_size(optarg, &streams[SR_PRIO_HIGH], &frame_size[SR_PRIO_HIGH]) < 0) || (streams[SR_PRIO_HIGH] > CBS_SIM_STREAM_MAX))
+				goto err_option;
+			break;
+
+		case 'B':
+			if ((parse_count_size(optarg, &streams[SR_PRIO_LOW], &frame_size[SR_PRIO_LOW]) < 0) || (streams[SR_PRIO_LOW] > CBS_SIM_STREAM_MAX))
+				goto err_option;
+			break;
+
+		case 'e':
+			if ((parse_count_size(optarg, &be_load, &frame_size[CBS_SIM_CLASS_BE]) < 0) || (be_load > 100))
+				goto err_option;
+			break;
+
+		case 'r':
+			if ((h_strtoul(&rate, optarg, NULL, 0) < 0) || !rate || (rate > 10000))
+				goto err_option;
+			break;
+
+		case 't':
+			if ((h_strtoul(&duration, optarg, NULL, 0) < 0) || !duration)
+				goto err_option;
+			break;
+
+		case 'j':
+			if ((h_strtoul(&jitter, optarg, NULL, 0) < 0) || (jitter >= HW_TIMER_PERIOD_NS))
+				goto err_option;
+			break;
+
+		case 'p':
+			if ((h_strtoul(&app_period, optarg, NULL, 0) < 0) || !app_period)
+				goto err_option;
+			break;
+
+		case 's':
+			if (h_strtoul(&seed, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'T':
+			trace_path = optarg;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	srand48(seed);
+
+	cbs_sim.rate = (u64)rate * 1000000;
+	cbs_sim.jitter = jitter;
+
+	/* Start away from 0, the scheduler time base wraps at 32 bits */
+	cbs_sim.now = NSECS_PER_SEC;
+
+	for (i = 0; i < CBS_SIM_FRAME_MAX; i++)
+		frame_free(&cbs_sim.frame[i]);
+
+	for (i = 0; i < CBS_SIM_CLASS_MAX; i++) {
+		cbs_sim.stats[i].latency_min = INT64_MAX;
+		cbs_sim.stats[i].latency_max = INT64_MIN;
+	}
+
+	if (net_qos_port_init(NULL, &cbs_sim.port) < 0) {
+		printf("net_qos_port_init() failed\n");
+		goto exit;
+	}
+
+	cbs_sim.port.fec_data = &cbs_sim;
+	net_qos_port_reset(&cbs_sim.port, cbs_sim.rate);
+
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++)
+		if (streams[i] && (cbs_sim_add_streams(i, streams[i], frame_size[i]) < 0))
+			goto exit;
+
+	if (be_load && (cbs_sim_add_be(be_load, frame_size[CBS_SIM_CLASS_BE]) < 0))
+		goto exit;
+
+	cbs_sim_bounds();
+
+	if (trace_path) {
+		cbs_sim.trace = fopen(trace_path, "w");
+		if (!cbs_sim.trace) {
+			printf("cannot open %s\n", trace_path);
+			goto exit;
+		}
+
+		cbs_sim_trace_header();
+	}
+
+	printf("cbs-sim: port %lu Mbps, tick %u ns (jitter %lu ns), application period %lu us, %lu ms\n",
+	       rate, HW_TIMER_PERIOD_NS, jitter, app_period, duration);
+
+	for (i = 0; i < CFG_SR_CLASS_MAX; i++)
+		if (streams[i])
+			printf("class %c: %lu stream(s) x %lu bytes, idle slope %u bits/s\n", class_name(i), streams[i], frame_size[i],
+			       cbs_sim.stats[i].idle_slope);
+
+	if (be_load)
+		printf("best effort: %lu%% load, %lu bytes\n", be_load, frame_size[CBS_SIM_CLASS_BE]);
+
+	start = cbs_sim.now;
+	end = start + (u64)duration * NSECS_PER_MS;
+	app_next = start;
+
+	for (tick = start; tick < end; tick += HW_TIMER_PERIOD_NS) {
+		/* Hardware timer interrupt latency */
+		cbs_sim.now = tick + (jitter ? (u64)(drand48() * jitter) : 0);
+
+		if (cbs_sim.now >= app_next) {
+			app_next += (u64)app_period * 1000;
+
+			for (i = 0; i < cbs_sim.stream_n; i++)
+				stream_write(&cbs_sim.stream[i], app_next);
+		}
+
+		if (be_load)
+			be_write();
+
+		cbs_sim_tick();
+
+		cbs_sim_credits();
+	}
+
+	cbs_sim_summary(end - start);
+
+	rc = 0;
+
+	if (cbs_sim.trace)
+		fclose(cbs_sim.trace);
+
+exit:
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
@@ -0,0 +1,336 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Clock read benchmark
+ @details Compares reading a gPTP clock with a clock_gettime() system call on the PHC and reading it from the shared
+ memory time page (linux/clock_page.c) published by the gPTP stack:
+ - cost of each read path (mean, min, median, 99th percentile, max), including the timing overhead (cost of a
+   CLOCK_MONOTONIC_RAW read, also reported)
+ - time page error, the PHC time minus the time page time (interpolated between two time page reads surrounding the
+   PHC read)
+
+ The time page is either published by a running gPTP stack, or by the benchmark itself (-p), from the PHC, refreshed
+ periodically as the gPTP stack does after each clock adjustment.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <inttypes.h>
+
+#include "genavb/helpers.h"
+
+#include "common/types.h"
+#include "os/clock.h"
+
+#include "clock_page.h"
+#include "clock_xts.h"
+
+#define CLOCKFD 3
+#define FD_TO_CLOCKID(fd)	((~(clockid_t) (fd) << 3) | CLOCKFD)
+
+#define BENCH_DEFAULT_DEVICE	"/dev/ptp0"
+#define BENCH_DEFAULT_SAMPLES	100000
+#define BENCH_DEFAULT_PERIOD	125	/* ms, gPTP sync interval */
+#define BENCH_PAGE_TIMEOUT	(3ULL * NSECS_PER_SEC)
+
+static struct bench {
+	clockid_t clk_id;		/* PHC */
+	unsigned int id;		/* os clock id of the time page */
+	struct clock_page_reader reader;
+
+	/* time page publisher */
+	struct clock_page_writer writer;
+	struct clock_xts xts;
+	unsigned int period;		/* ms */
+	bool publish;
+	volatile bool stop;
+
+	u32 *cost;
+	s64 *err;
+} bench;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n clock-bench [options]\n");
+	printf("\nOptions:\n"
+		"\t-d <device>             PHC device, or \"realtime\" for CLOCK_REALTIME (default: %s)\n"
+		"\t-c <id>                 time page clock id (default: %u, gPTP clock endpoint 0 domain 0)\n"
+		"\t-p                      publish the time page from the PHC, instead of the gPTP stack\n"
+		"\t-u <ms>                 time page update period, when published by the benchmark (default: %u)\n"
+		"\t-n <samples>            samples per measurement (default: %u)\n"
+		"\t-h                      print this help text\n",
+		BENCH_DEFAULT_DEVICE, OS_CLOCK_GPTP_EP_0_0, BENCH_DEFAULT_PERIOD, BENCH_DEFAULT_SAMPLES);
+}
+
+static u64 monotonic_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return (u64)ts.tv_sec * NSECS_PER_SEC + ts.tv_nsec;
+}
+
+/* Log time base */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = monotonic_ns();
+
+	return 0;
+}
+
+/* CLOCK_MONOTONIC_RAW (vDSO) read, also included in the time page read */
+static int monotonic_gettime(u64 *ns)
+{
+	*ns = monotonic_ns();
+
+	return 0;
+}
+
+static int phc_gettime(u64 *ns)
+{
+	struct timespec ts;
+
+	if (clock_gettime(bench.clk_id, &ts) < 0)
+		return -1;
+
+	*ns = (u64)ts.tv_sec * NSECS_PER_SEC + ts.tv_nsec;
+
+	return 0;
+}
+
+static int page_gettime(u64 *ns)
+{
+	return clock_page_gettime(&bench.reader, bench.id, ns);
+}
+
+/* Time page refresh, as done by the gPTP stack after each clock adjustment (the PHC is not adjusted here) */
+static void *publish_thread(void *arg)
+{
+	struct timespec period = {
+		.tv_sec = bench.period / 1000,
+		.tv_nsec = (bench.period % 1000) * NSECS_PER_MS,
+	};
+	u64 mono, hw;
+
+	while (!bench.stop) {
+		if (!clock_xts_update(&bench.xts, 0, false, &mono, &hw))
+			clock_page_update(&bench.writer, mono, hw, bench.xts.ratio, false);
+
+		nanosleep(&period, NULL);
+	}
+
+	return NULL;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	u32 x = *(const u32 *)a, y = *(const u32 *)b;
+
+	return (x > y) - (x < y);
+}
+
+static int cmp_s64(const void *a, const void *b)
+{
+	s64 x = *(const s64 *)a, y = *(const s64 *)b;
+
+	return (x > y) - (x < y);
+}
+
+static int bench_cost(const char *name, int (*gettime)(u64 *ns), unsigned int n)
+{
+	u64 t0, t1, ns, sum = 0;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		t0 = monotonic_ns();
+
+		if (gettime(&ns) < 0) {
+			printf("%s: read failed after %u samples\n", name, i);
+			return -1;
+		}
+
+		t1 = monotonic_ns();
+
+		bench.cost[i] = t1 - t0;
+		sum += t1 - t0;
+	}
+
+	qsort(bench.cost, n, sizeof(u32), cmp_u32);
+
+	printf("%-12s %10" PRIu64 " %10u %10u %10u %10u\n", name, sum / n,
+	       bench.cost[0], bench.cost[n / 2], bench.cost[(n * 99) / 100], bench.cost[n - 1]);
+
+	return 0;
+}
+
+static int bench_error(unsigned int n)
+{
+	u64 p0, p1, hw;
+	s64 sum = 0;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		if ((page_gettime(&p0) < 0) || (phc_gettime(&hw) < 0) || (page_gettime(&p1) < 0)) {
+			printf("error: read failed after %u samples\n", i);
+			return -1;
+		}
+
+		bench.err[i] = (s64)(hw - p0) - (s64)(p1 - p0) / 2;
+		sum += bench.err[i];
+	}
+
+	qsort(bench.err, n, sizeof(s64), cmp_s64);
+
+	printf("\ntime page error (PHC - time page, ns): mean %" PRId64 " min %" PRId64 " median %" PRId64 " p1 %" PRId64 " p99 %" PRId64 " max %" PRId64 "\n",
+	       sum / (s64)n, bench.err[0], bench.err[n / 2], bench.err[n / 100], bench.err[(n * 99) / 100], bench.err[n - 1]);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *device = BENCH_DEFAULT_DEVICE;
+	unsigned long id = OS_CLOCK_GPTP_EP_0_0;
+	unsigned long period = BENCH_DEFAULT_PERIOD;
+	unsigned long samples = BENCH_DEFAULT_SAMPLES;
+	pthread_t thread;
+	bool thread_started = false;
+	u64 start, ns;
+	int fd = -1;
+	int option;
+	int rc = -1;
+
+	while ((option = getopt(argc, argv, "d:c:pu:n:h")) != -1) {
+		switch (option) {
+		case 'd':
+			device = optarg;
+			break;
+
+		case 'c':
+			if ((h_strtoul(&id, optarg, NULL, 0) < 0) || (id >= OS_CLOCK_MAX))
+				goto err_option;
+			break;
+
+		case 'p':
+			bench.publish = true;
+			break;
+
+		case 'u':
+			if ((h_strtoul(&period, optarg, NULL, 0) < 0) || !period || (period >= 1000))
+				goto err_option;
+			break;
+
+		case 'n':
+			if ((h_strtoul(&samples, optarg, NULL, 0) < 0) || (samples < 100))
+				goto err_option;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	bench.id = id;
+	bench.period = period;
+
+	if (!strcmp(device, "realtime")) {
+		bench.clk_id = CLOCK_REALTIME;
+	} else {
+		fd = open(device, O_RDONLY);
+		if (fd < 0) {
+			printf("open(%s) failed: %s\n", device, strerror(errno));
+			goto exit;
+		}
+
+		bench.clk_id = FD_TO_CLOCKID(fd);
+	}
+
+	bench.cost = calloc(samples, sizeof(u32));
+	bench.err = calloc(samples, sizeof(s64));
+	if (!bench.cost || !bench.err)
+		goto exit;
+
+	if (bench.publish) {
+		if (clock_xts_init(&bench.xts, fd, bench.clk_id, CLOCK_XTS_AUTO) < 0)
+			goto exit;
+
+		if (clock_page_create(&bench.writer, bench.id) < 0)
+			goto exit;
+
+		if (pthread_create(&thread, NULL, publish_thread, NULL)) {
+			printf("pthread_create() failed\n");
+			goto exit;
+		}
+
+		thread_started = true;
+	}
+
+	/* Wait for a valid time page (oscillator rate measured) */
+	start = monotonic_ns();
+	while (page_gettime(&ns) < 0) {
+		if ((monotonic_ns() - start) > BENCH_PAGE_TIMEOUT) {
+			printf("clock id %u: no valid time page%s\n", bench.id, bench.publish ? "" : ", gPTP stack not running or clock not adjusted");
+			goto exit;
+		}
+
+		usleep(10000);
+	}
+
+	printf("clock-bench: %s, clock id %u time page (%s), %lu samples\n\n", device, bench.id,
+	       bench.publish ? "published by the benchmark" : "published by the gPTP stack", samples);
+
+	printf("read cost (ns)     mean        min     median        p99        max\n");
+
+	if (bench_cost("monotonic", monotonic_gettime, samples) < 0)
+		goto exit;
+
+	if (bench_cost("PHC", phc_gettime, samples) < 0)
+		goto exit;
+
+	if (bench_cost("time page", page_gettime, samples) < 0)
+		goto exit;
+
+	if (bench_error(samples) < 0)
+		goto exit;
+
+	rc = 0;
+
+exit:
+	if (thread_started) {
+		bench.stop = true;
+		pthread_join(thread, NULL);
+	}
+
+	clock_page_destroy(&bench.writer, bench.id);
+	clock_page_close(&bench.reader);
+
+	free(bench.cost);
+	free(bench.err);
+
+	if (fd >= 0)
+		close(fd);
+
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
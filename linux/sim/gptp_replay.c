@@ -0,0 +1,812 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief gPTP capture replay
+ @details Feeds the gPTP frames of one pcap file per port into the receive path of a gPTP stack
+ instance, running over a virtual clock. The hardware receive timestamps are the capture timestamps,
+ or are read from sidecar files.
+ Pdelay responses can't be replayed (they answer requests sent at different times by the recorded
+ node), the local Pdelay requests are answered instead by an emulated link partner, with a fixed
+ link delay.
+ Prints port role, grandmaster and synchronization state changes, and the offset measured by the
+ stack on each sync. State machine transitions are logged at the gPTP debug log level.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "common/log.h"
+#include "common/net.h"
+#include "common/ptp_time_ops.h"
+
+#include "genavb/helpers.h"
+#include "genavb/ether.h"
+
+#include "gptp/gptp.h"
+#include "gptp/config.h"
+
+#include "sim.h"
+#include "pcap.h"
+
+#define GPTP_REPLAY_DEFAULT_DELAY	500	/* ns */
+#define GPTP_REPLAY_DEFAULT_LEAD_IN	3000	/* ms */
+#define GPTP_REPLAY_DEFAULT_TAIL	1000	/* ms */
+#define GPTP_REPLAY_CHECK_PERIOD	1	/* ms */
+
+#define PTP_MSG_TYPE_MAX		16
+
+struct gptp_replay_port {
+	const char *path;
+	struct pcap_file pcap;
+	FILE *sidecar;
+
+	struct pcap_record rec;		/* next record to replay */
+	u64 ts;				/* hardware timestamp of the next record, in ns */
+	bool pending;
+	u64 index;			/* next record index, in the capture file */
+
+	ptp_port_role_t role;
+
+	/* emulated link partner */
+	struct net_rx rx;
+	struct net_tx tx;
+	struct ptp_pdelay_req_pdu req;	/* last request received */
+};
+
+static struct gptp_replay {
+	struct gptp_replay_port port[CFG_MAX_NUM_PORT];
+	unsigned int port_n;
+
+	struct sim_node *node;
+	struct sim_node *peer;
+	struct gptp_ctx *gptp;
+
+	u64 lead_in;
+	u64 phc_start;
+
+	bool skip_src;
+	u8 src_mac[6];			/* frames from this address were transmitted by the recorded node */
+	bool sidecar;
+	bool trace;
+
+	bool synchronized;
+	u64 last_receipt_time;
+
+	/* statistics */
+	u64 frames_read;
+	u64 frames_replayed[PTP_MSG_TYPE_MAX];
+	u64 frames_own;
+	u64 frames_pdelay_resp;
+	u64 frames_other;
+	u64 frames_no_ts;
+	u64 frames_reordered;
+
+	unsigned int role_changes;
+	unsigned int gm_changes;
+	unsigned int sync_changes;
+
+	u64 offset_n;
+	double offset_sum;
+	double offset_sum2;
+	s64 offset_max_abs;
+} replay;
+
+static const u8 ptp_dst_mac[6] = MC_ADDR_PTP;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n gptp-replay [options] <port 0 pcap> [<port 1 pcap> ...]\n");
+	printf("\nOptions:\n"
+		"\t-m <mac>                address of the recorded node, frames sent by it are not replayed\n"
+		"\t-x                      read hardware timestamps from <pcap>.ts sidecar files, one line per capture record:\n"
+		"\t                        timestamp in ns, or '-' if the record has no timestamp (lines starting with '#' are ignored)\n"
+		"\t-d <ns>                 link delay of the emulated pdelay responder (default: %u)\n"
+		"\t-P <priority1>          local priority1 (default: %u)\n"
+		"\t-L <ms>                 time the stack runs before the first replayed frame (default: %u)\n"
+		"\t-e <ms>                 time the stack runs after the last replayed frame (default: %u)\n"
+		"\t-q                      print the summary only\n"
+		"\t-v <level>              gPTP log level: crit, err, init, info, dbg (default: err)\n"
+		"\t-h                      print this help text\n",
+		GPTP_REPLAY_DEFAULT_DELAY, CFG_GPTP_DEFAULT_PRIORITY1, GPTP_REPLAY_DEFAULT_LEAD_IN, GPTP_REPLAY_DEFAULT_TAIL);
+}
+
+static int log_string2level(const char *s)
+{
+	int level;
+
+	for (level = LOG_CRIT; level <= LOG_DEBUG; level++) {
+		if (!strcasecmp(s, log_lvl_string[level]))
+			return level;
+	}
+
+	return -1;
+}
+
+/* Time relative to the first replayed frame, in s */
+static double replay_time(void)
+{
+	return ((s64)sim_time() - (s64)replay.lead_in) / 1.0e9;
+}
+
+static void replay_print_identity(const char *prefix, struct ptp_clock_identity *id)
+{
+	printf("%s%02x%02x%02x%02x%02x%02x%02x%02x", prefix, id->identity[0], id->identity[1], id->identity[2], id->identity[3],
+	       id->identity[4], id->identity[5], id->identity[6], id->identity[7]);
+}
+
+/*
+ * Stack callbacks
+ */
+
+static void gptp_replay_sync_indication(struct gptp_sync_info *info)
+{
+	bool synchronized;
+
+	if (info->domain || (sim_current != replay.node))
+		return;
+
+	synchronized = (info->state == SYNC_STATE_SYNCHRONIZED);
+	if (synchronized == replay.synchronized)
+		return;
+
+	replay.synchronized = synchronized;
+	replay.sync_changes++;
+
+	if (replay.trace)
+		printf("%12.6f port %u %s\n", replay_time(), info->port_id, synchronized ? "synchronized" : "not synchronized");
+}
+
+static void gptp_replay_gm_indication(struct gptp_gm_info *info)
+{
+	if (info->domain || (sim_current != replay.node))
+		return;
+
+	replay.gm_changes++;
+
+	if (replay.trace) {
+		printf("%12.6f grandmaster", replay_time());
+		replay_print_identity(" ", &info->vector.u.s.root_system_identity.u.s.clock_identity);
+		printf(" priority1 %u%s\n", info->vector.u.s.root_system_identity.u.s.priority_1, info->is_grandmaster ? " (local)" : "");
+	}
+}
+
+/* Called periodically and after the last frame, reports port role changes and the offsets computed on sync reception */
+static void gptp_replay_check(void *data)
+{
+	struct gptp_instance *instance = replay.gptp->instances[0];
+	struct target_clkadj_params *adj = &instance->target_clkadj_params;
+	struct gptp_replay_port *port;
+	ptp_port_role_t role;
+	unsigned int i;
+
+	for (i = 0; i < replay.port_n; i++) {
+		port = &replay.port[i];
+		role = instance->params.selected_role[i + 1];
+
+		if (role == port->role)
+			continue;
+
+		if (replay.trace)
+			printf("%12.6f port %u role %s -> %s\n", replay_time(), i, gptp_port_role2string(port->role), gptp_port_role2string(role));
+
+		port->role = role;
+		replay.role_changes++;
+	}
+
+	if (adj->previous_receipt_time == replay.last_receipt_time)
+		return;
+
+	replay.last_receipt_time = adj->previous_receipt_time;
+
+	if (replay.trace)
+		printf("%12.6f offset %8" PRId64 " ns freq %8" PRId64 " ppb\n", replay_time(), adj->last_err_ns, adj->last_ppb);
+
+	if (replay.synchronized) {
+		replay.offset_n++;
+		replay.offset_sum += adj->last_err_ns;
+		replay.offset_sum2 += (double)adj->last_err_ns * adj->last_err_ns;
+		if (llabs(adj->last_err_ns) > replay.offset_max_abs)
+			replay.offset_max_abs = llabs(adj->last_err_ns);
+	}
+}
+
+/*
+ * Emulated link partner, answers the local pdelay requests
+ */
+
+static void gptp_replay_peer_tx(struct gptp_replay_port *port, void *msg, unsigned int len, bool ts_required)
+{
+	struct net_tx_desc *desc;
+	void *pdu;
+
+	desc = net_tx_alloc(sizeof(struct eth_hdr) + len);
+	if (!desc)
+		return;
+
+	if (ts_required)
+		desc->flags = NET_TX_FLAGS_HW_TS;
+
+	pdu = NET_DATA_START(desc);
+	desc->len += net_add_eth_header(pdu, ptp_dst_mac, ETHERTYPE_PTP);
+
+	memcpy((char *)pdu + desc->len, msg, len);
+	desc->len += len;
+
+	net_tx(&port->tx, desc);
+}
+
+static void gptp_replay_peer_header(struct gptp_replay_port *port, struct ptp_hdr *hdr, u8 msg_type, u16 len)
+{
+	u8 *mac = port->tx.eth_src;
+
+	memset(hdr, 0, sizeof(*hdr));
+
+	hdr->transport_specific = PTP_DOMAIN_MAJOR_SDOID;
+	hdr->msg_type = msg_type;
+	hdr->version_ptp = PTP_VERSION;
+	hdr->minor_version_ptp = PTP_MINOR_VERSION;
+	hdr->msg_length = htons(len);
+	hdr->flags = htons(PTP_FLAG_PTP_TIMESCALE);
+	hdr->sequence_id = port->req.header.sequence_id;
+	hdr->log_msg_interval = PTP_LOG_MSG_PDELAY_RESP;
+
+	/* EUI-64 clock identity, from the port address */
+	hdr->source_port_id.clock_identity[0] = mac[0];
+	hdr->source_port_id.clock_identity[1] = mac[1];
+	hdr->source_port_id.clock_identity[2] = mac[2];
+	hdr->source_port_id.clock_identity[3] = 0xff;
+	hdr->source_port_id.clock_identity[4] = 0xfe;
+	hdr->source_port_id.clock_identity[5] = mac[3];
+	hdr->source_port_id.clock_identity[6] = mac[4];
+	hdr->source_port_id.clock_identity[7] = mac[5];
+	hdr->source_port_id.port_number = htons(1);
+}
+
+static void gptp_replay_peer_rx(struct net_rx *rx, struct net_rx_desc *desc)
+{
+	struct gptp_replay_port *port = &replay.port[rx->port_id];
+	struct ptp_hdr *hdr = (struct ptp_hdr *)((char *)desc + desc->l3_offset);
+	struct ptp_pdelay_resp_pdu resp;
+
+	if ((desc->ethertype != ETHERTYPE_PTP) || (desc->len < (sizeof(struct eth_hdr) + sizeof(struct ptp_pdelay_req_pdu)))
+	|| (hdr->msg_type != PTP_MSG_TYPE_PDELAY_REQ))
+		goto exit;
+
+	memcpy(&port->req, hdr, sizeof(port->req));
+
+	gptp_replay_peer_header(port, &resp.header, PTP_MSG_TYPE_PDELAY_RESP, sizeof(resp));
+	resp.header.flags |= htons(PTP_FLAG_TWO_STEP << 8);
+	resp.header.control = PTP_CONTROL_PDELAY_RESP;
+
+	u64_to_pdu_ptp_timestamp(&resp.request_receipt_timestamp, desc->ts64);
+	memcpy(&resp.requesting_port_identity, &port->req.header.source_port_id, sizeof(struct ptp_port_identity));
+
+	gptp_replay_peer_tx(port, &resp, sizeof(resp), true);
+
+exit:
+	net_rx_free(desc);
+}
+
+static void gptp_replay_peer_tx_ts(struct net_tx *tx, u64 ts, unsigned int priv)
+{
+	struct gptp_replay_port *port = &replay.port[tx->port_id];
+	struct ptp_pdelay_resp_follow_up_pdu fup;
+
+	gptp_replay_peer_header(port, &fup.header, PTP_MSG_TYPE_PDELAY_RESP_FUP, sizeof(fup));
+	fup.header.control = PTP_CONTROL_PDELAY_RESP_FUP;
+	fup.header.log_msg_interval = PTP_LOG_MSG_PDELAY_RESP_FUP;
+
+	u64_to_pdu_ptp_timestamp(&fup.response_origin_timestamp, ts);
+	memcpy(&fup.requesting_port_identity, &port->req.header.source_port_id, sizeof(struct ptp_port_identity));
+
+	gptp_replay_peer_tx(port, &fup, sizeof(fup), false);
+}
+
+static int gptp_replay_peer_init(struct gptp_replay_port *port, unsigned int port_id)
+{
+	struct net_address addr;
+	int rc = -1;
+
+	memset(&addr, 0, sizeof(addr));
+	addr.ptype = PTYPE_PTP;
+	addr.port = port_id;
+
+	sim_current = replay.peer;
+
+	if (net_rx_init(&port->rx, &addr, gptp_replay_peer_rx, (unsigned long)replay.peer) < 0)
+		goto exit;
+
+	if (net_tx_ts_init(&port->tx, &addr, gptp_replay_peer_tx_ts, (unsigned long)replay.peer) < 0)
+		goto exit;
+
+	rc = 0;
+
+exit:
+	sim_current = NULL;
+
+	return rc;
+}
+
+/*
+ * Capture files
+ */
+
+/** Reads the hardware timestamp of the next record from the sidecar file
+ * \return	1 if a timestamp was read, 0 if the record has no timestamp, -1 on error or end of file
+ */
+static int gptp_replay_sidecar_read(struct gptp_replay_port *port, u64 *ts)
+{
+	char line[64];
+	unsigned long long val;
+
+	do {
+		if (!fgets(line, sizeof(line), port->sidecar))
+			return -1;
+	} while (line[0] == '#');
+
+	if (line[0] == '-')
+		return 0;
+
+	if (h_strtoull(&val, line, NULL, 0) < 0)
+		return -1;
+
+	*ts = val;
+
+	return 1;
+}
+
+/** Reads the next record of a port capture file
+ * \return	0 on success (port->pending set if a record is available), -1 on error
+ */
+static int gptp_replay_port_read(struct gptp_replay_port *port)
+{
+	int rc;
+
+	port->pending = false;
+
+	while (1) {
+		rc = pcap_read(&port->pcap, &port->rec);
+		if (rc <= 0)
+			break;
+
+		port->index++;
+		replay.frames_read++;
+
+		if (!replay.sidecar) {
+			port->ts = port->rec.ts;
+			goto out;
+		}
+
+		rc = gptp_replay_sidecar_read(port, &port->ts);
+		if (rc < 0) {
+			printf("%s.ts: no timestamp for record %" PRIu64 "\n", port->path, port->index);
+			break;
+		}
+
+		if (rc)
+			goto out;
+
+		replay.frames_no_ts++;
+	}
+
+	if (rc < 0)
+		printf("%s: read error at record %" PRIu64 "\n", port->path, port->index);
+
+	return rc;
+
+out:
+	port->pending = true;
+
+	return 0;
+}
+
+static int gptp_replay_port_open(struct gptp_replay_port *port, const char *path)
+{
+	char sidecar_path[256];
+
+	port->path = path;
+	port->role = DISABLED_PORT;
+
+	if (pcap_open(&port->pcap, path) < 0) {
+		printf("%s: cannot open capture file\n", path);
+		goto err_pcap;
+	}
+
+	if (replay.sidecar) {
+		snprintf(sidecar_path, sizeof(sidecar_path), "%s.ts", path);
+
+		port->sidecar = fopen(sidecar_path, "r");
+		if (!port->sidecar) {
+			printf("%s: cannot open timestamp file\n", sidecar_path);
+			goto err_sidecar;
+		}
+	}
+
+	return gptp_replay_port_read(port);
+
+err_sidecar:
+	pcap_close(&port->pcap);
+
+err_pcap:
+	return -1;
+}
+
+static void gptp_replay_port_close(struct gptp_replay_port *port)
+{
+	if (port->sidecar)
+		fclose(port->sidecar);
+
+	pcap_close(&port->pcap);
+}
+
+/* Port with the oldest pending record, NULL once all files are replayed */
+static struct gptp_replay_port *gptp_replay_next_port(void)
+{
+	struct gptp_replay_port *next = NULL;
+	unsigned int i;
+
+	for (i = 0; i < replay.port_n; i++) {
+		if (!replay.port[i].pending)
+			continue;
+
+		if (!next || (replay.port[i].ts < next->ts))
+			next = &replay.port[i];
+	}
+
+	return next;
+}
+
+/** Schedules the reception of the pending record of a port, if it's a gPTP frame to replay */
+static void gptp_replay_schedule(struct gptp_replay_port *port, unsigned int port_id)
+{
+	struct pcap_record *rec = &port->rec;
+	struct eth_hdr *eth = (struct eth_hdr *)rec->data;
+	struct net_rx_desc *desc;
+	struct ptp_hdr *hdr;
+	unsigned int l3_offset = sizeof(struct eth_hdr);
+	u16 ethertype;
+	u64 time;
+
+	if (rec->len < sizeof(struct eth_hdr))
+		goto other;
+
+	ethertype = ntohs(eth->type);
+	if (ethertype == ETHERTYPE_VLAN) {
+		if (rec->len < (sizeof(struct eth_hdr) + sizeof(struct vlanhdr)))
+			goto other;
+
+		ethertype = ntohs(((struct vlanhdr *)(rec->data + l3_offset))->type);
+		l3_offset += sizeof(struct vlanhdr);
+	}
+
+	if ((ethertype != ETHERTYPE_PTP) || (rec->len < (l3_offset + sizeof(struct ptp_hdr))) || (rec->len > DEFAULT_NET_DATA_SIZE))
+		goto other;
+
+	if (replay.skip_src && !memcmp(eth->src, replay.src_mac, 6)) {
+		replay.frames_own++;
+		return;
+	}
+
+	hdr = (struct ptp_hdr *)(rec->data + l3_offset);
+	if ((hdr->msg_type == PTP_MSG_TYPE_PDELAY_RESP) || (hdr->msg_type == PTP_MSG_TYPE_PDELAY_RESP_FUP)) {
+		replay.frames_pdelay_resp++;
+		return;
+	}
+
+	desc = malloc(NET_DATA_OFFSET + DEFAULT_NET_DATA_SIZE);
+	if (!desc)
+		return;
+
+	memset(desc, 0, sizeof(*desc));
+	desc->l2_offset = NET_DATA_OFFSET;
+	desc->l3_offset = NET_DATA_OFFSET + l3_offset;
+	desc->len = rec->len;
+	desc->port = port_id;
+	desc->ethertype = ethertype;
+
+	memcpy(NET_DATA_START(desc), rec->data, rec->len);
+
+	/* The local hardware clock runs at the capture time base, so the receive timestamp is the recorded one */
+	time = port->ts - replay.phc_start;
+	if (time < sim_time()) {
+		replay.frames_reordered++;
+		time = sim_time();
+	}
+
+	if (sim_event_add_frame(replay.node, port_id, desc, time) < 0) {
+		free(desc);
+		return;
+	}
+
+	replay.frames_replayed[hdr->msg_type]++;
+
+	return;
+
+other:
+	replay.frames_other++;
+}
+
+static void gptp_replay_config(struct fgptp_config *cfg, int log_level, unsigned int priority1, u64 delay)
+{
+	int i;
+
+	memset(cfg, 0, sizeof(*cfg));
+
+	cfg->log_level = log_level;
+	cfg->is_bridge = (replay.port_n > 1);
+	cfg->profile = CFG_GPTP_PROFILE_STANDARD;
+	cfg->domain_max = 1;
+	cfg->port_max = replay.port_n;
+
+	for (i = 0; i < cfg->port_max; i++)
+		cfg->logical_port_list[i] = i;
+
+	cfg->management_enabled = 0;
+	cfg->clock_local = logical_port_to_local_clock(0);
+	cfg->gm_id = 0;
+	cfg->neighborPropDelayThreshold = CFG_GPTP_NEIGH_THRESH_DEFAULT;
+	if (cfg->neighborPropDelayThreshold < 2 * delay)
+		cfg->neighborPropDelayThreshold = 2 * delay;
+	cfg->rsync = CFG_GPTP_RSYNC_ENABLE_DEFAULT;
+	cfg->rsync_interval = CFG_GPTP_RSYNC_INTERVAL_DEFAULT;
+	cfg->statsInterval = CFG_GPTP_STATS_INTERVAL_DEFAULT;
+
+	cfg->neighborPropDelay_mode = CFG_GPTP_PDELAY_MODE_STANDARD;
+	for (i = 0; i < CFG_MAX_NUM_PORT; i++)
+		cfg->initial_neighborPropDelay[i] = CFG_GPTP_DEFAULT_PDELAY_VALUE;
+	cfg->neighborPropDelay_sensitivity = CFG_GPTP_DEFAULT_PDELAY_SENSITIVITY;
+
+	cfg->sync_indication = gptp_replay_sync_indication;
+	cfg->gm_indication = gptp_replay_gm_indication;
+	cfg->pdelay_indication = NULL;
+
+	for (i = 0; i < cfg->port_max; i++) {
+		struct fgptp_port_config *port_cfg = &cfg->port_cfg[i];
+
+		port_cfg->portRole = CFG_GPTP_DEFAULT_PORT_ROLE;
+		port_cfg->ptpPortEnabled = CFG_GPTP_DEFAULT_PTP_ENABLED;
+		port_cfg->rxDelayCompensation = CFG_GPTP_DEFAULT_RX_DELAY_COMP;
+		port_cfg->txDelayCompensation = CFG_GPTP_DEFAULT_TX_DELAY_COMP;
+		port_cfg->initialLogPdelayReqInterval = CFG_GPTP_DFLT_LOG_PDELAY_REQ_INTERVAL;
+		port_cfg->initialLogSyncInterval = CFG_GPTP_DFLT_LOG_SYNC_INTERVAL;
+		port_cfg->initialLogAnnounceInterval = CFG_GPTP_DFLT_LOG_ANNOUNCE_INTERVAL;
+		port_cfg->operLogPdelayReqInterval = CFG_GPTP_DFLT_LOG_PDELAY_REQ_INTERVAL;
+		port_cfg->operLogSyncInterval = CFG_GPTP_DFLT_LOG_SYNC_INTERVAL;
+		port_cfg->delayMechanism[0] = P2P;
+		port_cfg->allowedLostResponses = CFG_GPTP_DFLT_ALLOWED_LOST_RESP_2020;
+		port_cfg->pdelayWindow = CFG_GPTP_DFLT_PDELAY_WINDOW;
+	}
+
+	cfg->domain_cfg[0].domain_number = PTP_DOMAIN_0;
+	cfg->domain_cfg[0].clock_target = logical_port_to_gptp_clock(0, 0);
+	cfg->domain_cfg[0].clock_source = cfg->domain_cfg[0].clock_target;
+	cfg->domain_cfg[0].servo = CFG_GPTP_DEFAULT_SERVO;
+	cfg->domain_cfg[0].gmCapable = CFG_GPTP_DEFAULT_GM_CAPABLE;
+	cfg->domain_cfg[0].priority1 = priority1;
+	cfg->domain_cfg[0].priority2 = CFG_GPTP_DEFAULT_PRIORITY2;
+	cfg->domain_cfg[0].clockClass = CFG_GPTP_DEFAULT_CLOCK_CLASS;
+	cfg->domain_cfg[0].clockAccuracy = CFG_GPTP_DEFAULT_CLOCK_ACCURACY;
+	cfg->domain_cfg[0].offsetScaledLogVariance = CFG_GPTP_DEFAULT_CLOCK_VARIANCE;
+
+	cfg->force_2011 = 0;
+}
+
+static void gptp_replay_summary(double cpu_time)
+{
+	u64 replayed = 0;
+	unsigned int i;
+
+	for (i = 0; i < PTP_MSG_TYPE_MAX; i++)
+		replayed += replay.frames_replayed[i];
+
+	printf("\nframes: read %" PRIu64 " replayed %" PRIu64 " (sync %" PRIu64 " follow_up %" PRIu64 " announce %" PRIu64
+	       " signaling %" PRIu64 " pdelay_req %" PRIu64 ")\n",
+	       replay.frames_read, replayed, replay.frames_replayed[PTP_MSG_TYPE_SYNC], replay.frames_replayed[PTP_MSG_TYPE_FOLLOW_UP],
+	       replay.frames_replayed[PTP_MSG_TYPE_ANNOUNCE], replay.frames_replayed[PTP_MSG_TYPE_SIGNALING],
+	       replay.frames_replayed[PTP_MSG_TYPE_PDELAY_REQ]);
+
+	printf("skipped: own %" PRIu64 " pdelay_resp %" PRIu64 " other %" PRIu64 " no_timestamp %" PRIu64 ", reordered %" PRIu64 "\n",
+	       replay.frames_own, replay.frames_pdelay_resp, replay.frames_other, replay.frames_no_ts, replay.frames_reordered);
+
+	printf("changes: port roles %u grandmaster %u synchronization %u\n", replay.role_changes, replay.gm_changes, replay.sync_changes);
+
+	if (replay.offset_n)
+		printf("offset (synchronized): samples %" PRIu64 " mean %.1f ns rms %.1f ns max %" PRId64 " ns\n",
+		       replay.offset_n, replay.offset_sum / replay.offset_n, sqrt(replay.offset_sum2 / replay.offset_n), replay.offset_max_abs);
+	else
+		printf("offset (synchronized): no samples\n");
+
+	printf("replay cpu time: %.3f ms", cpu_time * 1000);
+	if (replayed)
+		printf(" (%.3f us per replayed frame)", cpu_time * 1.0e6 / replayed);
+	printf("\n");
+}
+
+static double cpu_time_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1.0e9;
+}
+
+int main(int argc, char *argv[])
+{
+	struct fgptp_config cfg;
+	struct sim_link_params link_params;
+	struct gptp_replay_port *port;
+	unsigned long delay = GPTP_REPLAY_DEFAULT_DELAY;
+	unsigned long priority1 = CFG_GPTP_DEFAULT_PRIORITY1;
+	unsigned long lead_in = GPTP_REPLAY_DEFAULT_LEAD_IN;
+	unsigned long tail = GPTP_REPLAY_DEFAULT_TAIL;
+	int log_level = LOG_ERR;
+	double cpu_start;
+	u64 first_ts = 0;
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	replay.trace = true;
+
+	while ((option = getopt(argc, argv, "m:xd:P:L:e:qv:h")) != -1) {
+		switch (option) {
+		case 'm':
+			if (sscanf(optarg, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", &replay.src_mac[0], &replay.src_mac[1], &replay.src_mac[2],
+				   &replay.src_mac[3], &replay.src_mac[4], &replay.src_mac[5]) != 6)
+				goto err_option;
+
+			replay.skip_src = true;
+			break;
+
+		case 'x':
+			replay.sidecar = true;
+			break;
+
+		case 'd':
+			if (h_strtoul(&delay, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'P':
+			if ((h_strtoul(&priority1, optarg, NULL, 0) < 0) || (priority1 > 255))
+				goto err_option;
+			break;
+
+		case 'L':
+			if ((h_strtoul(&lead_in, optarg, NULL, 0) < 0) || !lead_in)
+				goto err_option;
+			break;
+
+		case 'e':
+			if (h_strtoul(&tail, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'q':
+			replay.trace = false;
+			break;
+
+		case 'v':
+			log_level = log_string2level(optarg);
+			if (log_level < 0)
+				goto err_option;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	if ((optind >= argc) || ((argc - optind) > CFG_MAX_NUM_PORT))
+		goto err_option;
+
+	log_level_set(common_COMPONENT_ID, log_level);
+	log_level_set(os_COMPONENT_ID, log_level);
+
+	replay.port_n = argc - optind;
+	replay.lead_in = (u64)lead_in * NSECS_PER_MS;
+
+	for (i = 0; i < replay.port_n; i++) {
+		port = &replay.port[i];
+
+		if (gptp_replay_port_open(port, argv[optind + i]) < 0)
+			goto err_open;
+
+		if (port->pending && (!first_ts || (port->ts < first_ts)))
+			first_ts = port->ts;
+	}
+
+	if (first_ts < replay.lead_in) {
+		printf("capture timestamps must be larger than the lead-in time\n");
+		goto err_open;
+	}
+
+	replay.phc_start = first_ts - replay.lead_in;
+
+	sim_init(1);
+
+	/* Local and link partner hardware clocks run at the capture time base */
+	replay.node = sim_node_add(0, replay.phc_start);
+	replay.peer = sim_node_add(0, replay.phc_start);
+	if (!replay.node || !replay.peer)
+		goto err_sim;
+
+	memset(&link_params, 0, sizeof(link_params));
+	link_params.delay = delay;
+
+	for (i = 0; i < replay.port_n; i++) {
+		if (!sim_link_add(replay.node, i, replay.peer, i, &link_params))
+			goto err_sim;
+
+		if (gptp_replay_peer_init(&replay.port[i], i) < 0)
+			goto err_sim;
+	}
+
+	printf("gptp-replay: %u port(s), link delay %lu ns, priority1 %lu, %s timestamps\n", replay.port_n, delay, priority1,
+	       replay.sidecar ? "sidecar" : "capture");
+
+	gptp_replay_config(&cfg, log_level, priority1, delay);
+
+	sim_current = replay.node;
+	replay.gptp = gptp_init(&cfg, (unsigned long)replay.node);
+	sim_current = NULL;
+
+	if (!replay.gptp) {
+		printf("gptp_init() failed\n");
+		goto err_sim;
+	}
+
+	cpu_start = cpu_time_now();
+
+	/* Frames are scheduled one at a time, in timestamp order, so the whole capture is never loaded in memory */
+	while ((port = gptp_replay_next_port()) != NULL) {
+		if (port->ts > replay.phc_start + sim_time())
+			sim_run(port->ts - replay.phc_start - 1, gptp_replay_check, GPTP_REPLAY_CHECK_PERIOD * NSECS_PER_MS, NULL);
+
+		gptp_replay_schedule(port, port - replay.port);
+
+		if (gptp_replay_port_read(port) < 0)
+			break;
+	}
+
+	sim_run(sim_time() + (u64)tail * NSECS_PER_MS, gptp_replay_check, GPTP_REPLAY_CHECK_PERIOD * NSECS_PER_MS, NULL);
+	gptp_replay_check(NULL);
+
+	gptp_replay_summary(cpu_time_now() - cpu_start);
+
+	rc = 0;
+
+	sim_current = replay.node;
+	gptp_exit(replay.gptp);
+	sim_current = NULL;
+
+err_sim:
+	sim_exit();
+
+err_open:
+	for (i = 0; i < replay.port_n; i++)
+		gptp_replay_port_close(&replay.port[i]);
+
+exit:
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
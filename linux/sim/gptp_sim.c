@@ -0,0 +1,561 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief gPTP network simulator
+ @details Runs a chain of gPTP time-aware systems (endpoints at both ends,
+ bridges in between) over simulated links, in simulated time. Each node has
+ its own free running hardware clock, with a random frequency error.
+ Reports, for each node, the true offset and rate error of its gPTP clock
+ relative to the grandmaster, the neighbor rate ratio and link delay measurement
+ errors, and the time needed to lock.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include "common/log.h"
+#include "common/ptp_time_ops.h"
+
+#include "genavb/helpers.h"
+
+#include "gptp/gptp.h"
+#include "gptp/config.h"
+
+#include "sim.h"
+
+#define GPTP_SIM_DEFAULT_NODES		2
+#define GPTP_SIM_DEFAULT_DURATION	60	/* s */
+#define GPTP_SIM_DEFAULT_DELAY		500	/* ns */
+#define GPTP_SIM_DEFAULT_DRIFT		50000	/* ppb */
+#define GPTP_SIM_DEFAULT_CONGESTION_DELAY	10000	/* ns */
+#define GPTP_SIM_DEFAULT_TRACE_PERIOD	1000	/* ms */
+#define GPTP_SIM_DEFAULT_SAMPLE_PERIOD	1	/* ms */
+#define GPTP_SIM_DEFAULT_LOCK_THRESHOLD	100	/* ns */
+
+/* Offset statistics are only accumulated after the node locks */
+struct gptp_sim_stats {
+	u64 n;
+	double sum;
+	double sum2;
+	s64 max_abs;
+};
+
+struct gptp_sim_node {
+	struct sim_node *node;
+	struct gptp_ctx *gptp;
+
+	bool is_grandmaster;	/* as reported by the stack */
+	bool synchronized;	/* as reported by the stack */
+	u64 sync_time_ms;
+
+	bool locked;		/* true offset within the lock threshold */
+	u64 lock_time;		/* first sample of the current locked period */
+	unsigned int lock_count;
+
+	s64 offset;
+	struct gptp_sim_stats stats;
+};
+
+static struct gptp_sim {
+	struct gptp_sim_node node[SIM_MAX_NODES];
+	unsigned int node_n;
+	unsigned int gm;
+
+	u64 lock_threshold;
+	u64 trace_period;	/* ns */
+	u64 next_trace;		/* ns */
+	unsigned int servo;
+	unsigned int pdelay_window;
+	bool trace;
+} gptp_sim;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n gptp-sim [options]\n");
+	printf("\nOptions:\n"
+		"\t-n <nodes>              number of time-aware systems, connected in a chain (default: %u, max %u)\n"
+		"\t-g <node>               grandmaster node index, gets a better priority1 (default: 0)\n"
+		"\t-t <seconds>            simulated duration (default: %u)\n"
+		"\t-d <ns>                 link propagation delay (default: %u)\n"
+		"\t-j <ns>                 link jitter, uniformly distributed extra delay (default: 0)\n"
+		"\t-a <ns>                 link asymmetry, added downstream and removed upstream (default: 0)\n"
+		"\t-l <ppm>                frame loss probability, in parts per million (default: 0)\n"
+		"\t-c <ppm>                frame congestion probability, in parts per million (default: 0)\n"
+		"\t-C <ns>                 maximum congestion delay, congested frames are delayed by [C/2, C] (default: %u)\n"
+		"\t-D <ppb>                maximum hardware clock frequency error (default: %u)\n"
+		"\t-s <seed>               random seed (default: 1)\n"
+		"\t-p <ms>                 trace period (default: %u)\n"
+		"\t-r <ms>                 offset sampling period, sets the lock time resolution (default: %u)\n"
+		"\t-T <ns>                 lock threshold (default: %u)\n"
+		"\t-S <servo>              target clock servo: pi, adaptive_pi, kalman (default: %s)\n"
+		"\t-W <turnarounds>        path delay and rate ratio estimation window (default: %u, min %u, max %u)\n"
+		"\t-q                      print the summary only\n"
+		"\t-v <level>              gPTP log level: crit, err, init, info, dbg (default: err)\n"
+		"\t-h                      print this help text\n",
+		GPTP_SIM_DEFAULT_NODES, SIM_MAX_NODES, GPTP_SIM_DEFAULT_DURATION, GPTP_SIM_DEFAULT_DELAY, GPTP_SIM_DEFAULT_CONGESTION_DELAY,
+		GPTP_SIM_DEFAULT_DRIFT, GPTP_SIM_DEFAULT_TRACE_PERIOD, GPTP_SIM_DEFAULT_SAMPLE_PERIOD, GPTP_SIM_DEFAULT_LOCK_THRESHOLD,
+		CFG_GPTP_DEFAULT_SERVO_NAME, CFG_GPTP_DFLT_PDELAY_WINDOW, CFG_GPTP_MIN_PDELAY_WINDOW, CFG_GPTP_MAX_PDELAY_WINDOW);
+}
+
+static int log_string2level(const char *s)
+{
+	int level;
+
+	for (level = LOG_CRIT; level <= LOG_DEBUG; level++) {
+		if (!strcasecmp(s, log_lvl_string[level]))
+			return level;
+	}
+
+	return -1;
+}
+
+static int servo_string2type(const char *s)
+{
+	if (!strcasecmp(s, "pi"))
+		return CFG_GPTP_SERVO_PI;
+	else if (!strcasecmp(s, "adaptive_pi"))
+		return CFG_GPTP_SERVO_ADAPTIVE_PI;
+	else if (!strcasecmp(s, "kalman"))
+		return CFG_GPTP_SERVO_KALMAN;
+
+	return -1;
+}
+
+static struct gptp_sim_node *gptp_sim_current(void)
+{
+	if (!sim_current)
+		return NULL;
+
+	return &gptp_sim.node[sim_current->index];
+}
+
+static void gptp_sim_sync_indication(struct gptp_sync_info *info)
+{
+	struct gptp_sim_node *n = gptp_sim_current();
+
+	if (!n || info->domain)
+		return;
+
+	n->synchronized = (info->state == SYNC_STATE_SYNCHRONIZED);
+	n->sync_time_ms = info->sync_time_ms;
+}
+
+static void gptp_sim_gm_indication(struct gptp_gm_info *info)
+{
+	struct gptp_sim_node *n = gptp_sim_current();
+
+	if (!n || info->domain)
+		return;
+
+	n->is_grandmaster = info->is_grandmaster;
+}
+
+static void gptp_sim_config(struct fgptp_config *cfg, struct sim_node *node, bool is_gm, int log_level, u64 neighbor_threshold)
+{
+	int i;
+
+	memset(cfg, 0, sizeof(*cfg));
+
+	cfg->log_level = log_level;
+	cfg->is_bridge = (node->port_max > 1);
+	cfg->profile = CFG_GPTP_PROFILE_STANDARD;
+	cfg->domain_max = 1;
+	cfg->port_max = node->port_max;
+
+	for (i = 0; i < cfg->port_max; i++)
+		cfg->logical_port_list[i] = i;
+
+	cfg->management_enabled = 0;
+	cfg->clock_local = logical_port_to_local_clock(0);
+	cfg->gm_id = 0;
+	cfg->neighborPropDelayThreshold = neighbor_threshold;
+	cfg->rsync = CFG_GPTP_RSYNC_ENABLE_DEFAULT;
+	cfg->rsync_interval = CFG_GPTP_RSYNC_INTERVAL_DEFAULT;
+	cfg->statsInterval = CFG_GPTP_STATS_INTERVAL_DEFAULT;
+
+	cfg->neighborPropDelay_mode = CFG_GPTP_PDELAY_MODE_STANDARD;
+	for (i = 0; i < CFG_MAX_NUM_PORT; i++)
+		cfg->initial_neighborPropDelay[i] = CFG_GPTP_DEFAULT_PDELAY_VALUE;
+	cfg->neighborPropDelay_sensitivity = CFG_GPTP_DEFAULT_PDELAY_SENSITIVITY;
+
+	cfg->sync_indication = gptp_sim_sync_indication;
+	cfg->gm_indication = gptp_sim_gm_indication;
+	cfg->pdelay_indication = NULL;
+
+	for (i = 0; i < cfg->port_max; i++) {
+		struct fgptp_port_config *port_cfg = &cfg->port_cfg[i];
+
+		port_cfg->portRole = CFG_GPTP_DEFAULT_PORT_ROLE;
+		port_cfg->ptpPortEnabled = CFG_GPTP_DEFAULT_PTP_ENABLED;
+		port_cfg->rxDelayCompensation = CFG_GPTP_DEFAULT_RX_DELAY_COMP;
+		port_cfg->txDelayCompensation = CFG_GPTP_DEFAULT_TX_DELAY_COMP;
+		port_cfg->initialLogPdelayReqInterval = CFG_GPTP_DFLT_LOG_PDELAY_REQ_INTERVAL;
+		port_cfg->initialLogSyncInterval = CFG_GPTP_DFLT_LOG_SYNC_INTERVAL;
+		port_cfg->initialLogAnnounceInterval = CFG_GPTP_DFLT_LOG_ANNOUNCE_INTERVAL;
+		port_cfg->operLogPdelayReqInterval = CFG_GPTP_DFLT_LOG_PDELAY_REQ_INTERVAL;
+		port_cfg->operLogSyncInterval = CFG_GPTP_DFLT_LOG_SYNC_INTERVAL;
+		port_cfg->delayMechanism[0] = P2P;
+		port_cfg->allowedLostResponses = CFG_GPTP_DFLT_ALLOWED_LOST_RESP_2020;
+		port_cfg->pdelayWindow = gptp_sim.pdelay_window;
+	}
+
+	cfg->domain_cfg[0].domain_number = PTP_DOMAIN_0;
+	cfg->domain_cfg[0].clock_target = logical_port_to_gptp_clock(0, 0);
+	cfg->domain_cfg[0].clock_source = cfg->domain_cfg[0].clock_target;
+	cfg->domain_cfg[0].servo = gptp_sim.servo;
+	cfg->domain_cfg[0].gmCapable = CFG_GPTP_DEFAULT_GM_CAPABLE;
+	cfg->domain_cfg[0].priority1 = is_gm ? (CFG_GPTP_DEFAULT_PRIORITY1 - 2) : CFG_GPTP_DEFAULT_PRIORITY1;
+	cfg->domain_cfg[0].priority2 = CFG_GPTP_DEFAULT_PRIORITY2;
+	cfg->domain_cfg[0].clockClass = CFG_GPTP_DEFAULT_CLOCK_CLASS;
+	cfg->domain_cfg[0].clockAccuracy = CFG_GPTP_DEFAULT_CLOCK_ACCURACY;
+	cfg->domain_cfg[0].offsetScaledLogVariance = CFG_GPTP_DEFAULT_CLOCK_VARIANCE;
+
+	cfg->force_2011 = 0;
+}
+
+/** Neighbor rate ratio measurement error, for the given node port
+ * \return	error in ppb
+ */
+static double gptp_sim_nrr_error(struct gptp_sim_node *n, unsigned int port_id)
+{
+	struct sim_link *link = n->node->port[port_id].link;
+	struct sim_node *peer = link->node[!n->node->port[port_id].dir];
+	double nrr_true, nrr;
+
+	nrr_true = (1.0 + peer->phc.drift_ppb / 1.0e9) / (1.0 + n->node->phc.drift_ppb / 1.0e9);
+	nrr = ptp_ratio_to_double(get_neighbor_rate_ratio(&n->gptp->instances[0]->ports[port_id]));
+
+	return (nrr - nrr_true) * 1.0e9;
+}
+
+/** Link delay measurement error, for the given node port
+ * \return	error in ns
+ */
+static s64 gptp_sim_pdelay_error(struct gptp_sim_node *n, unsigned int port_id)
+{
+	struct sim_link *link = n->node->port[port_id].link;
+	u64 pdelay;
+
+	u_scaled_ns_to_u64(&pdelay, get_mean_link_delay(&n->gptp->instances[0]->ports[port_id]));
+
+	return (s64)pdelay - (s64)(link->params.delay + link->params.jitter / 2);
+}
+
+static void gptp_sim_sample(void *data)
+{
+	struct gptp_sim_node *gm = &gptp_sim.node[gptp_sim.gm];
+	u64 now = sim_time();
+	u64 gm_time = sim_gptp_time(gm->node, 0, now);
+	double gm_rate = sim_gptp_rate(gm->node, 0);
+	struct gptp_sim_node *n;
+	unsigned int i;
+	double rate_error;
+	bool trace = false;
+
+	/* Offsets are sampled every sample period, so lock time is not limited by the trace period */
+	if (gptp_sim.trace && (now >= gptp_sim.next_trace)) {
+		trace = true;
+		gptp_sim.next_trace += gptp_sim.trace_period;
+	}
+
+	for (i = 0; i < gptp_sim.node_n; i++) {
+		n = &gptp_sim.node[i];
+
+		if (i == gptp_sim.gm)
+			continue;
+
+		n->offset = (s64)(sim_gptp_time(n->node, 0, now) - gm_time);
+
+		if ((u64)llabs(n->offset) <= gptp_sim.lock_threshold) {
+			if (!n->locked) {
+				n->locked = true;
+				n->lock_time = now;
+				n->lock_count++;
+				memset(&n->stats, 0, sizeof(n->stats));
+			}
+		} else {
+			n->locked = false;
+		}
+
+		if (n->locked) {
+			n->stats.n++;
+			n->stats.sum += n->offset;
+			n->stats.sum2 += (double)n->offset * n->offset;
+			if (llabs(n->offset) > n->stats.max_abs)
+				n->stats.max_abs = llabs(n->offset);
+		}
+
+		if (trace) {
+			rate_error = (sim_gptp_rate(n->node, 0) / gm_rate - 1.0) * 1.0e9;
+
+			printf("%10.3f node %2u offset %10" PRId64 " ns rate %12.3f ppb nrr_err %10.3f ppb pdelay_err %6" PRId64 " ns %s\n",
+			       now / 1.0e9, i, n->offset, rate_error, gptp_sim_nrr_error(n, 0), gptp_sim_pdelay_error(n, 0),
+			       n->synchronized ? "sync" : "-");
+		}
+	}
+}
+
+static void gptp_sim_summary(void)
+{
+	struct gptp_sim_node *n;
+	unsigned int i;
+	double mean, rms;
+
+	printf("\nnode  bmca_gm  stack_sync  sync_time(ms)  lock_time(s)  relocks  offset_mean(ns)  offset_rms(ns)  offset_max(ns)\n");
+
+	for (i = 0; i < gptp_sim.node_n; i++) {
+		n = &gptp_sim.node[i];
+
+		printf("%4u  %-7s  ", i, n->is_grandmaster ? "yes" : "no");
+
+		if (i == gptp_sim.gm) {
+			printf("%-10s\n", "-");
+			continue;
+		}
+
+		if (!n->locked || !n->stats.n) {
+			printf("%-10s  %13" PRIu64 "  %12s\n", n->synchronized ? "yes" : "no", n->sync_time_ms, "never");
+			continue;
+		}
+
+		mean = n->stats.sum / n->stats.n;
+		rms = sqrt(n->stats.sum2 / n->stats.n);
+
+		printf("%-10s  %13" PRIu64 "  %12.3f  %7u  %15.1f  %14.1f  %14" PRId64 "\n",
+		       n->synchronized ? "yes" : "no", n->sync_time_ms,
+		       n->lock_time / 1.0e9, n->lock_count - 1, mean, rms, n->stats.max_abs);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	struct fgptp_config cfg;
+	struct sim_link_params link_params;
+	struct gptp_sim_node *n;
+	unsigned long nodes = GPTP_SIM_DEFAULT_NODES;
+	unsigned long gm = 0;
+	unsigned long duration = GPTP_SIM_DEFAULT_DURATION;
+	unsigned long delay = GPTP_SIM_DEFAULT_DELAY;
+	unsigned long jitter = 0;
+	long asymmetry = 0;
+	unsigned long loss = 0;
+	unsigned long congestion = 0;
+	unsigned long congestion_delay = GPTP_SIM_DEFAULT_CONGESTION_DELAY;
+	unsigned long drift = GPTP_SIM_DEFAULT_DRIFT;
+	unsigned long seed = 1;
+	unsigned long trace_period = GPTP_SIM_DEFAULT_TRACE_PERIOD;
+	unsigned long sample_period = GPTP_SIM_DEFAULT_SAMPLE_PERIOD;
+	unsigned long lock_threshold = GPTP_SIM_DEFAULT_LOCK_THRESHOLD;
+	unsigned long pdelay_window = CFG_GPTP_DFLT_PDELAY_WINDOW;
+	int log_level = LOG_ERR;
+	int servo = CFG_GPTP_DEFAULT_SERVO;
+	u64 neighbor_threshold;
+	s64 drift_ppb;
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	gptp_sim.trace = true;
+
+	while ((option = getopt(argc, argv, "n:g:t:d:j:a:l:c:C:D:s:p:r:T:S:W:qv:h")) != -1) {
+		switch (option) {
+		case 'n':
+			if ((h_strtoul(&nodes, optarg, NULL, 0) < 0) || (nodes < 2) || (nodes > SIM_MAX_NODES))
+				goto err_option;
+			break;
+
+		case 'g':
+			if (h_strtoul(&gm, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 't':
+			if ((h_strtoul(&duration, optarg, NULL, 0) < 0) || !duration)
+				goto err_option;
+			break;
+
+		case 'd':
+			if (h_strtoul(&delay, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'j':
+			if (h_strtoul(&jitter, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'a':
+			asymmetry = strtol(optarg, NULL, 0);
+			break;
+
+		case 'l':
+			if ((h_strtoul(&loss, optarg, NULL, 0) < 0) || (loss > 1000000))
+				goto err_option;
+			break;
+
+		case 'c':
+			if ((h_strtoul(&congestion, optarg, NULL, 0) < 0) || (congestion > 1000000))
+				goto err_option;
+			break;
+
+		case 'C':
+			if (h_strtoul(&congestion_delay, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'D':
+			if ((h_strtoul(&drift, optarg, NULL, 0) < 0) || (drift > PTP_MAXFREQ_PPB / 2))
+				goto err_option;
+			break;
+
+		case 's':
+			if (h_strtoul(&seed, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'p':
+			if ((h_strtoul(&trace_period, optarg, NULL, 0) < 0) || !trace_period)
+				goto err_option;
+			break;
+
+		case 'r':
+			if ((h_strtoul(&sample_period, optarg, NULL, 0) < 0) || !sample_period)
+				goto err_option;
+			break;
+
+		case 'T':
+			if (h_strtoul(&lock_threshold, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'S':
+			servo = servo_string2type(optarg);
+			if (servo < 0)
+				goto err_option;
+			break;
+
+		case 'W':
+			if ((h_strtoul(&pdelay_window, optarg, NULL, 0) < 0) || (pdelay_window < CFG_GPTP_MIN_PDELAY_WINDOW)
+			|| (pdelay_window > CFG_GPTP_MAX_PDELAY_WINDOW))
+				goto err_option;
+			break;
+
+		case 'q':
+			gptp_sim.trace = false;
+			break;
+
+		case 'v':
+			log_level = log_string2level(optarg);
+			if (log_level < 0)
+				goto err_option;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	if (gm >= nodes)
+		goto err_option;
+
+	log_level_set(common_COMPONENT_ID, log_level);
+	log_level_set(os_COMPONENT_ID, log_level);
+
+	gptp_sim.node_n = nodes;
+	gptp_sim.gm = gm;
+	gptp_sim.lock_threshold = lock_threshold;
+	gptp_sim.trace_period = (u64)trace_period * NSECS_PER_MS;
+	gptp_sim.next_trace = gptp_sim.trace_period;
+	gptp_sim.servo = servo;
+	gptp_sim.pdelay_window = pdelay_window;
+
+	sim_init(seed);
+
+	/* Nodes start with random hardware clock frequency errors and unrelated times */
+	for (i = 0; i < nodes; i++) {
+		drift_ppb = drift ? ((s64)(sim_random() % (2 * drift + 1)) - (s64)drift) : 0;
+
+		gptp_sim.node[i].node = sim_node_add(drift_ppb, (u64)sim_random() * NSECS_PER_SEC);
+		if (!gptp_sim.node[i].node)
+			goto err_sim;
+	}
+
+	link_params.delay = delay;
+	link_params.jitter = jitter;
+	link_params.asymmetry = asymmetry;
+	link_params.loss_ppm = loss;
+	link_params.congestion_ppm = congestion;
+	link_params.congestion_delay = congestion_delay;
+
+	/* Chain topology: port 0 of node i + 1 is connected to the last port of node i */
+	for (i = 0; i + 1 < nodes; i++) {
+		if (!sim_link_add(gptp_sim.node[i].node, i ? 1 : 0, gptp_sim.node[i + 1].node, 0, &link_params))
+			goto err_sim;
+	}
+
+	neighbor_threshold = CFG_GPTP_NEIGH_THRESH_DEFAULT;
+	if (neighbor_threshold < 2 * (delay + jitter + llabs(asymmetry)))
+		neighbor_threshold = 2 * (delay + jitter + llabs(asymmetry));
+
+	printf("gptp-sim: %lu nodes, gm %lu, delay %lu ns, jitter %lu ns, asymmetry %ld ns, loss %lu ppm, congestion %lu ppm (%lu ns), seed %lu\n",
+	       nodes, gm, delay, jitter, asymmetry, loss, congestion, congestion ? congestion_delay : 0, seed);
+
+	for (i = 0; i < nodes; i++) {
+		n = &gptp_sim.node[i];
+
+		printf("node %2u: %u port(s), clock drift %" PRId64 " ppb\n", i, n->node->port_max, n->node->phc.drift_ppb);
+
+		gptp_sim_config(&cfg, n->node, i == gm, log_level, neighbor_threshold);
+
+		sim_current = n->node;
+		n->gptp = gptp_init(&cfg, (unsigned long)n->node);
+		sim_current = NULL;
+
+		if (!n->gptp) {
+			printf("node %2u: gptp_init() failed\n", i);
+			goto err_gptp;
+		}
+	}
+
+	sim_run((u64)duration * NSECS_PER_SEC, gptp_sim_sample, (u64)sample_period * NSECS_PER_MS, NULL);
+
+	gptp_sim_summary();
+
+	rc = 0;
+
+err_gptp:
+	for (i = 0; i < nodes; i++) {
+		n = &gptp_sim.node[i];
+
+		if (!n->gptp)
+			continue;
+
+		sim_current = n->node;
+		gptp_exit(n->gptp);
+		sim_current = NULL;
+	}
+
+err_sim:
+	sim_exit();
+
+exit:
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
@@ -0,0 +1,707 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Media clock recovery simulator
+ @details Runs the AVB kernel module PLL media clock recovery control loop (linux/modules/avb/media_clock_rec_pll_ctrl.c),
+ built in userspace, against a simulated talker media clock and a simulated listener audio PLL, all in gPTP time:
+ - the talker media clock runs with a given frequency offset, one presentation timestamp every <samples> media
+ samples (AAF or CRF), with optional uniform jitter and random losses
+ - the listener timestamp checks and restarts follow the userspace recovery (avtp/media_clock.c): any lost or too
+ jittery timestamp stops the kernel recovery, which is started again after a new measurement phase
+ - as in the kernel hardware recovery mode, the audio PLL ticks are captured when the listener gPTP time reaches
+ every <div>th timestamp (one capture every ~10 ms), and the captured tick count differences are fed to the
+ control loop. Control loop resets (invalid measurement) restart the sampling, as mclock_rec_pll_reset() does
+ - the audio PLL runs with its own frequency offset, plus the adjustment applied by the control loop (optionally
+ rounded to the PLL adjustment resolution)
+ - an optional step of the listener gPTP time (e.g. after a grandmaster change) shifts the following captures
+
+ Reports the lock time (from the first timestamp, and for each (re)start of the control loop), the steady state
+ frequency error of the recovered clock against the talker media clock, and the jitter of the recovered media
+ clock output timestamps (the time each timestamped sample is output by the PLL, against its presentation time):
+ time interval error (TIE) relative to the start of the steady state, and period jitter between captures.
+ The steady state starts <settle> ms after the control loop declares the domain locked, and ends with the next restart.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+#include <inttypes.h>
+
+#include "genavb/helpers.h"
+
+#include "os/clock.h"
+
+#include "modules/avb/media_clock_rec_pll_ctrl.h"
+
+#define MCLOCK_REC_SIM_DEFAULT_RATE		48000		/* Hz */
+#define MCLOCK_REC_SIM_DEFAULT_SAMPLES		6		/* AAF, 8000 timestamps per second */
+#define MCLOCK_REC_SIM_DEFAULT_PLL_FREQ		24576000	/* Hz, PLL clock at the timer input */
+#define MCLOCK_REC_SIM_DEFAULT_DURATION		30		/* s */
+#define MCLOCK_REC_SIM_DEFAULT_TALKER_PPB	20000
+#define MCLOCK_REC_SIM_DEFAULT_PLL_PPB		-15000
+#define MCLOCK_REC_SIM_DEFAULT_SETTLE		2000		/* ms */
+
+/* Same as the GPT/TPM recovery drivers */
+#define MCLOCK_REC_SIM_P_FACTOR			4
+#define MCLOCK_REC_SIM_I_FACTOR			6
+#define MCLOCK_REC_SIM_MAX_ADJUST_PPB		200000
+
+/* Same as the kernel driver (media_clock_rec_pll.h) */
+#define MCLOCK_REC_SIM_SAMPLING_PERIOD_NS	10000000
+
+/* Same as the userspace recovery (avtp/media_clock.h) */
+#define MCLOCK_REC_SIM_NB_MEAS			100
+#define MCLOCK_REC_SIM_MAX_PERIOD		20000000
+
+#define MCLOCK_REC_SIM_START			NSECS_PER_SEC	/* gPTP time of the first timestamp */
+
+typedef enum {
+	SIM_INIT,
+	SIM_MEASUREMENT,
+	SIM_READY,
+	SIM_RUNNING,
+} mclock_rec_sim_state_t;
+
+struct mclock_rec_sim_stats {
+	unsigned int n;
+	double sum;
+	double sum2;
+	double min;
+	double max;
+};
+
+static struct mclock_rec_sim {
+	/* configuration */
+	unsigned int rate;		/* Hz */
+	unsigned int samples;		/* samples per timestamp */
+	unsigned int pll_freq;		/* Hz */
+	unsigned int div;		/* timestamps per capture */
+	unsigned int ts_period;		/* nominal timestamp period, rounded to ns */
+	unsigned int sampling_period;	/* nominal capture period, ns */
+	double ts_nominal_period;	/* nominal timestamp period, ns */
+	double ts_true_period;		/* actual timestamp period, ns */
+	double pll_ticks_per_ts;	/* nominal PLL ticks per timestamp */
+	int talker_ppb;
+	int pll_ppb;
+	unsigned int jitter;		/* ns */
+	unsigned int loss;		/* ppm */
+	s64 step;			/* ns */
+	double step_time;		/* ns */
+	unsigned int resolution;	/* ppb */
+	double settle;			/* ns */
+
+	double now;			/* ns */
+
+	/* userspace timestamp checks */
+	mclock_rec_sim_state_t state;
+	u32 last_ts;
+	unsigned int nb_meas;
+	unsigned int ready;
+	u32 period_min;
+	u32 period_max;
+	u32 period_mean;
+
+	/* audio PLL */
+	double phase;			/* PLL ticks */
+	double phase_time;		/* ns */
+	int ppb_adjust;			/* applied adjustment */
+
+	/* kernel recovery */
+	bool running;
+	unsigned int slot;
+	bool anchored;
+	u32 count_last;
+	double phase_anchor;
+	u64 k_anchor;
+	struct mclock_rec_pll_ctrl ctrl;
+	struct mclock_rec_pll_stats stats;
+
+	/* results */
+	u64 ts_n;
+	u64 lost;
+	unsigned int restarts;		/* userspace recovery restarts */
+	unsigned int missed;		/* captures missed after a gPTP step */
+	unsigned int starts;		/* control loop (re)starts */
+	unsigned int locks;
+	double start_time;
+	double lock_time;		/* ns, 0 if not locked since the last start */
+	double first_lock;		/* ns, from the first timestamp */
+	double lock_sum;		/* sum of the start to lock durations */
+	bool steady;
+	double tie_ref;
+	double tie_last;
+	struct mclock_rec_sim_stats ppb_err;
+	struct mclock_rec_sim_stats meas_ppb_err;
+	struct mclock_rec_sim_stats tie;
+	struct mclock_rec_sim_stats period_jitter;
+
+	FILE *trace;
+} sim;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n mclock-rec-sim [options]\n");
+	printf("\nOptions:\n"
+		"\t-r <Hz>                 media clock sampling rate (default: %u)\n"
+		"\t-n <samples>            media samples per timestamp, e.g 6 for AAF, 160 for CRF at 48 kHz (default: %u)\n"
+		"\t-f <Hz>                 audio PLL frequency at the timer input (default: %u)\n"
+		"\t-t <s>                  simulated duration (default: %u)\n"
+		"\t-c <ppb>                talker media clock frequency offset (default: %d)\n"
+		"\t-p <ppb>                listener audio PLL frequency offset, before adjustment (default: %d)\n"
+		"\t-j <ns>                 presentation timestamp jitter, uniformly distributed (default: 0)\n"
+		"\t-l <ppm>                presentation timestamp loss rate, in parts per million (default: 0)\n"
+		"\t-g <ns>[,<ms>]          listener gPTP time step, at the given time (default: none, at half the duration)\n"
+		"\t-q <ppb>                audio PLL adjustment resolution (default: 1)\n"
+		"\t-S <ms>                 settling time after lock, before steady state measurements (default: %u)\n"
+		"\t-s <seed>               random seed (default: 1)\n"
+		"\t-T <file>               write a control loop trace (one line per capture, csv)\n"
+		"\t-h                      print this help text\n",
+		MCLOCK_REC_SIM_DEFAULT_RATE, MCLOCK_REC_SIM_DEFAULT_SAMPLES, MCLOCK_REC_SIM_DEFAULT_PLL_FREQ,
+		MCLOCK_REC_SIM_DEFAULT_DURATION, MCLOCK_REC_SIM_DEFAULT_TALKER_PPB, MCLOCK_REC_SIM_DEFAULT_PLL_PPB,
+		MCLOCK_REC_SIM_DEFAULT_SETTLE);
+}
+
+static int parse_long(const char *s, long *val, char **endptr)
+{
+	char *end;
+
+	*val = strtol(s, &end, 0);
+
+	if (end == s)
+		return -1;
+
+	if (endptr)
+		*endptr = end;
+	else if (*end)
+		return -1;
+
+	return 0;
+}
+
+/* The log functions use the simulated time */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = (u64)sim.now;
+
+	return 0;
+}
+
+static void stats_add(struct mclock_rec_sim_stats *s, double val)
+{
+	if (!s->n || (val < s->min))
+		s->min = val;
+
+	if (!s->n || (val > s->max))
+		s->max = val;
+
+	s->n++;
+	s->sum += val;
+	s->sum2 += val * val;
+}
+
+static double stats_mean(struct mclock_rec_sim_stats *s)
+{
+	return s->n ? s->sum / s->n : 0.0;
+}
+
+static double stats_rms(struct mclock_rec_sim_stats *s)
+{
+	return s->n ? sqrt(s->sum2 / s->n) : 0.0;
+}
+
+/*
+ * Audio PLL
+ */
+
+static double pll_freq(void)
+{
+	return sim.pll_freq * (1.0 + (sim.pll_ppb + sim.ppb_adjust) * 1e-9);
+}
+
+static void pll_advance(double t)
+{
+	sim.phase += (t - sim.phase_time) * pll_freq() / NSECS_PER_SEC;
+	sim.phase_time = t;
+}
+
+/* Recovered clock frequency error against the talker media clock */
+static double pll_ppb_err(void)
+{
+	return ((1.0 + (sim.pll_ppb + sim.ppb_adjust) * 1e-9) / (1.0 + sim.talker_ppb * 1e-9) - 1.0) * 1e9;
+}
+
+/* Same as the kernel imx_pll_adjust() wrapper, with the PLL resolution */
+static int pll_adjust(struct mclock_rec_pll_ctrl *ctrl, int *ppb)
+{
+	int q = sim.resolution;
+
+	if (q > 1)
+		*ppb = ((*ppb >= 0) ? (*ppb + q / 2) : (*ppb - q / 2)) / q * q;
+
+	pll_advance(sim.now);
+	sim.ppb_adjust = *ppb;
+
+	return 0;
+}
+
+/*
+ * Kernel recovery
+ */
+
+static void rec_start(void)
+{
+	mclock_rec_pll_ctrl_start(&sim.ctrl, sim.ppb_adjust);
+
+	sim.anchored = false;
+	sim.steady = false;
+	sim.lock_time = 0;
+	sim.start_time = sim.now;
+	sim.starts++;
+}
+
+/* Listener gPTP time reaches the timestamp (before or after the gPTP step) */
+static double rec_capture_time(double t)
+{
+	if (!sim.step || (t < sim.step_time))
+		return t;
+
+	if ((t - sim.step) >= sim.step_time)
+		return t - sim.step;
+
+	/* Timestamp skipped by the step, assume the capture happens right away */
+	return sim.step_time;
+}
+
+static void rec_steady_state(double ts_true)
+{
+	double t_out, tie;
+
+	/* Time at which the PLL outputs the timestamped sample */
+	t_out = sim.phase_time + (sim.phase_anchor + (sim.ts_n - sim.k_anchor) * sim.pll_ticks_per_ts - sim.phase) * NSECS_PER_SEC / pll_freq();
+	tie = t_out - ts_true;
+
+	if (!sim.ctrl.locked || ((sim.now - sim.lock_time) < sim.settle))
+		goto out;
+
+	if (!sim.steady) {
+		sim.steady = true;
+		sim.tie_ref = tie;
+	} else {
+		stats_add(&sim.period_jitter, tie - sim.tie_last);
+	}
+
+	stats_add(&sim.ppb_err, pll_ppb_err());
+	stats_add(&sim.meas_ppb_err, sim.ctrl.err_ppb);
+	stats_add(&sim.tie, tie - sim.tie_ref);
+
+out:
+	sim.tie_last = tie;
+}
+
+static void rec_capture(double ts, double ts_true)
+{
+	double t = rec_capture_time(ts);
+	u32 count;
+
+	/* Capture time already passed (gPTP step), no compare event: the kernel watchdog resets the recovery */
+	if (t <= sim.phase_time) {
+		sim.missed++;
+		sim.stats.err_wd++;
+		sim.ctrl.state = RESET;
+		goto reset;
+	}
+
+	sim.now = t;
+	pll_advance(t);
+	count = (u32)sim.phase;
+
+	if (!sim.anchored) {
+		sim.anchored = true;
+		sim.phase_anchor = sim.phase;
+		sim.k_anchor = sim.ts_n;
+		goto out;
+	}
+
+	mclock_rec_pll_ctrl_update(&sim.ctrl, count - sim.count_last);
+
+	if (sim.ctrl.locked && !sim.lock_time) {
+		sim.lock_time = sim.now;
+		sim.lock_sum += sim.now - sim.start_time;
+
+		if (!sim.locks)
+			sim.first_lock = sim.now - MCLOCK_REC_SIM_START;
+
+		sim.locks++;
+	}
+
+	rec_steady_state(ts_true);
+
+	if (sim.trace)
+		fprintf(sim.trace, "%.3f,%u,%u,%d,%d,%.1f,%.1f\n", (sim.now - MCLOCK_REC_SIM_START) / NSECS_PER_MS, sim.ctrl.state,
+			count - sim.count_last, sim.ctrl.err_ppb, sim.ppb_adjust, pll_ppb_err(), sim.tie_last);
+
+out:
+	sim.count_last = count;
+
+reset:
+	if (sim.ctrl.state == RESET) {
+		sim.stats.reset++;
+		rec_start();
+	}
+}
+
+static void rec_ts(double ts, double ts_true)
+{
+	if (++sim.slot < sim.div)
+		return;
+
+	sim.slot = 0;
+
+	rec_capture(ts, ts_true);
+}
+
+/*
+ * Userspace recovery, same checks as avtp/media_clock.c
+ */
+
+static int period_error(u32 p1, u32 p2)
+{
+	if (abs((int)(p1 - p2)) > (p1 >> 5))
+		return 1;
+	else
+		return 0;
+}
+
+static void listener_init(void)
+{
+	sim.state = SIM_INIT;
+
+	if (sim.running) {
+		sim.running = false;
+		sim.stats.stop++;
+		sim.restarts++;
+	}
+}
+
+static void listener_ts(double ts_obs, double ts_true)
+{
+	/* AVTP presentation times are 32 bit gPTP times */
+	u32 ts = (u32)(u64)ts_obs;
+	u32 period = ts - sim.last_ts;
+
+	switch (sim.state) {
+	case SIM_INIT:
+		sim.state = SIM_MEASUREMENT;
+		sim.nb_meas = 0;
+		break;
+
+	case SIM_MEASUREMENT:
+		if (period > MCLOCK_REC_SIM_MAX_PERIOD) {
+			listener_init();
+			return;
+		}
+
+		if (sim.nb_meas) {
+			sim.period_mean = (sim.period_mean + period) / 2;
+		} else {
+			sim.period_min = period;
+			sim.period_max = period;
+			sim.period_mean = period;
+		}
+
+		if (period < sim.period_min)
+			sim.period_min = period;
+
+		if (period > sim.period_max)
+			sim.period_max = period;
+
+		if (++sim.nb_meas >= MCLOCK_REC_SIM_NB_MEAS) {
+			if (period_error(sim.period_min, sim.period_max) || period_error(sim.ts_period, sim.period_mean)) {
+				listener_init();
+				return;
+			}
+
+			sim.state = SIM_READY;
+			sim.ready = 0;
+		}
+		break;
+
+	case SIM_READY:
+		if (period_error(sim.ts_period, period)) {
+			listener_init();
+			return;
+		}
+
+		if (++sim.ready == 4) {
+			sim.state = SIM_RUNNING;
+			sim.running = true;
+			sim.slot = sim.div - 1;
+			sim.stats.start++;
+			rec_start();
+		}
+		break;
+
+	case SIM_RUNNING:
+		if (period_error(sim.ts_period, period)) {
+			listener_init();
+			return;
+		}
+
+		rec_ts(ts_obs, ts_true);
+		break;
+	}
+
+	sim.last_ts = ts;
+}
+
+/* Same as mclock_rec_pll_configure_freqs() */
+static int mclock_rec_sim_config(void)
+{
+	u64 pll_clk_p;
+
+	if (((u64)sim.pll_freq * sim.samples) % sim.rate) {
+		printf("timestamp frequency %u / %u Hz is not a divider of PLL frequency %u Hz\n", sim.rate, sim.samples, sim.pll_freq);
+		return -1;
+	}
+
+	sim.ts_nominal_period = (double)NSECS_PER_SEC * sim.samples / sim.rate;
+	sim.ts_period = (u32)(sim.ts_nominal_period + 0.5);
+
+	if (sim.ts_nominal_period > MCLOCK_REC_SIM_SAMPLING_PERIOD_NS) {
+		printf("timestamp period %u ns too long\n", sim.ts_period);
+		return -1;
+	}
+
+	/* Divide the timestamp frequency until the period is greater than the sampling period */
+	sim.div = 1;
+	while ((u32)(sim.div * sim.ts_nominal_period) < MCLOCK_REC_SIM_SAMPLING_PERIOD_NS)
+		sim.div++;
+
+	sim.sampling_period = (u32)(sim.div * sim.ts_nominal_period);
+
+	sim.pll_ticks_per_ts = (double)sim.pll_freq * sim.samples / sim.rate;
+	sim.ts_true_period = sim.ts_nominal_period / (1.0 + sim.talker_ppb * 1e-9);
+
+	pll_clk_p = (u64)sim.pll_freq * sim.samples * sim.div;
+
+	mclock_rec_pll_ctrl_set_period(&sim.ctrl, pll_clk_p, sim.rate, sim.sampling_period);
+
+	return 0;
+}
+
+static void mclock_rec_sim_summary(void)
+{
+	printf("\ntimestamps: %" PRIu64 ", lost %" PRIu64 ", userspace restarts %u\n", sim.ts_n, sim.lost, sim.restarts);
+	printf("control loop: starts %u, resets %u (invalid measurements %u, missed captures %u), adjustments %u, last adjustment %d ppb\n",
+	       sim.starts, sim.stats.reset, sim.stats.err_meas, sim.missed, sim.stats.adjust, sim.ppb_adjust);
+
+	if (!sim.locks) {
+		printf("lock: never locked\n");
+		return;
+	}
+
+	printf("lock: first after %.1f ms, %u lock(s), mean %.1f ms from control loop start\n",
+	       sim.first_lock / NSECS_PER_MS, sim.locks, sim.lock_sum / sim.locks / NSECS_PER_MS);
+
+	if (!sim.ppb_err.n) {
+		printf("steady state: not reached\n");
+		return;
+	}
+
+	printf("steady state: %u captures\n", sim.ppb_err.n);
+	printf("frequency error (ppb): mean %.2f, rms %.2f, min %.2f, max %.2f (measured: mean %.2f, rms %.2f)\n",
+	       stats_mean(&sim.ppb_err), stats_rms(&sim.ppb_err), sim.ppb_err.min, sim.ppb_err.max,
+	       stats_mean(&sim.meas_ppb_err), stats_rms(&sim.meas_ppb_err));
+	printf("output timestamp TIE (ns): rms %.1f, min %.1f, max %.1f, pk-pk %.1f\n",
+	       stats_rms(&sim.tie), sim.tie.min, sim.tie.max, sim.tie.max - sim.tie.min);
+
+	if (sim.period_jitter.n)
+		printf("output period jitter (ns, over %u ns): rms %.1f, min %.1f, max %.1f\n",
+		       sim.sampling_period, stats_rms(&sim.period_jitter), sim.period_jitter.min, sim.period_jitter.max);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long rate = MCLOCK_REC_SIM_DEFAULT_RATE;
+	unsigned long samples = MCLOCK_REC_SIM_DEFAULT_SAMPLES;
+	unsigned long pll_freq = MCLOCK_REC_SIM_DEFAULT_PLL_FREQ;
+	unsigned long duration = MCLOCK_REC_SIM_DEFAULT_DURATION;
+	long talker_ppb = MCLOCK_REC_SIM_DEFAULT_TALKER_PPB;
+	long pll_ppb = MCLOCK_REC_SIM_DEFAULT_PLL_PPB;
+	unsigned long jitter = 0;
+	unsigned long loss = 0;
+	long step = 0;
+	long step_time = -1;
+	unsigned long resolution = 1;
+	unsigned long settle = MCLOCK_REC_SIM_DEFAULT_SETTLE;
+	unsigned long seed = 1;
+	const char *trace_path = NULL;
+	double ts_true;
+	u64 k, n;
+	char *end;
+	int option;
+	int rc = -1;
+
+	while ((option = getopt(argc, argv, "r:n:f:t:c:p:j:l:g:q:S:s:T:h")) != -1) {
+		switch (option) {
+		case 'r':
+			if ((h_strtoul(&rate, optarg, NULL, 0) < 0) || !rate)
+				goto err_option;
+			break;
+
+		case 'n':
+			if ((h_strtoul(&samples, optarg, NULL, 0) < 0) || !samples)
+				goto err_option;
+			break;
+
+		case 'f':
+			if ((h_strtoul(&pll_freq, optarg, NULL, 0) < 0) || !pll_freq)
+				goto err_option;
+			break;
+
+		case 't':
+			if ((h_strtoul(&duration, optarg, NULL, 0) < 0) || !duration || (duration > 3600))
+				goto err_option;
+			break;
+
+		case 'c':
+			if ((parse_long(optarg, &talker_ppb, NULL) < 0) || (labs(talker_ppb) > 1000000))
+				goto err_option;
+			break;
+
+		case 'p':
+			if ((parse_long(optarg, &pll_ppb, NULL) < 0) || (labs(pll_ppb) > 1000000))
+				goto err_option;
+			break;
+
+		case 'j':
+			if (h_strtoul(&jitter, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'l':
+			if ((h_strtoul(&loss, optarg, NULL, 0) < 0) || (loss > 1000000))
+				goto err_option;
+			break;
+
+		case 'g':
+			if (parse_long(optarg, &step, &end) < 0)
+				goto err_option;
+
+			if (*end == ',') {
+				if ((parse_long(end + 1, &step_time, NULL) < 0) || (step_time < 0))
+					goto err_option;
+			} else if (*end) {
+				goto err_option;
+			}
+			break;
+
+		case 'q':
+			if ((h_strtoul(&resolution, optarg, NULL, 0) < 0) || !resolution)
+				goto err_option;
+			break;
+
+		case 'S':
+			if (h_strtoul(&settle, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 's':
+			if (h_strtoul(&seed, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'T':
+			trace_path = optarg;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	srand48(seed);
+
+	sim.rate = rate;
+	sim.samples = samples;
+	sim.pll_freq = pll_freq;
+	sim.talker_ppb = talker_ppb;
+	sim.pll_ppb = pll_ppb;
+	sim.jitter = jitter;
+	sim.loss = loss;
+	sim.step = step;
+	sim.step_time = MCLOCK_REC_SIM_START + ((step_time < 0) ? (double)duration * NSECS_PER_SEC / 2 : (double)step_time * NSECS_PER_MS);
+	sim.resolution = resolution;
+	sim.settle = (double)settle * NSECS_PER_MS;
+
+	pi_init(&sim.ctrl.pi, MCLOCK_REC_SIM_I_FACTOR, MCLOCK_REC_SIM_P_FACTOR);
+	sim.ctrl.max_adjust = MCLOCK_REC_SIM_MAX_ADJUST_PPB;
+	mclock_rec_pll_ctrl_init(&sim.ctrl, &sim.stats, pll_adjust, &sim);
+
+	if (mclock_rec_sim_config() < 0)
+		goto exit;
+
+	if (trace_path) {
+		sim.trace = fopen(trace_path, "w");
+		if (!sim.trace) {
+			printf("cannot open %s\n", trace_path);
+			goto exit;
+		}
+
+		fprintf(sim.trace, "time_ms,state,meas,err_ppb,ppb_adjust,freq_err_ppb,tie_ns\n");
+	}
+
+	printf("mclock-rec-sim: %lu Hz, %lu samples per timestamp (period %u ns, %u per capture), PLL %lu Hz, %lu s\n",
+	       rate, samples, sim.ts_period, sim.div, pll_freq, duration);
+	printf("talker %ld ppb, PLL %ld ppb (resolution %lu ppb), jitter %lu ns, loss %lu ppm", talker_ppb, pll_ppb, resolution, jitter, loss);
+	if (step)
+		printf(", gPTP step %ld ns at %.0f ms", step, (sim.step_time - MCLOCK_REC_SIM_START) / NSECS_PER_MS);
+	printf("\n");
+
+	sim.now = MCLOCK_REC_SIM_START;
+	sim.phase_time = sim.now;
+	sim.state = SIM_INIT;
+
+	n = (u64)(duration * NSECS_PER_SEC / sim.ts_nominal_period);
+
+	for (k = 0; k < n; k++) {
+		ts_true = MCLOCK_REC_SIM_START + k * sim.ts_true_period;
+
+		sim.ts_n = k;
+
+		if (loss && ((drand48() * 1000000) < loss)) {
+			sim.lost++;
+			continue;
+		}
+
+		sim.now = ts_true;
+
+		listener_ts(floor(ts_true + (jitter ? (drand48() * 2 - 1) * jitter : 0.0)), ts_true);
+	}
+
+	mclock_rec_sim_summary();
+
+	rc = 0;
+
+	if (sim.trace)
+		fclose(sim.trace);
+
+exit:
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
@@ -0,0 +1,31 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Userspace build of the AVB kernel module media clock recovery control loop
+ @details Provides the kernel interfaces used by linux/modules/avb/media_clock_rec_pll_ctrl.c, so that the
+ PLL control loop can run in the media clock recovery simulator.
+*/
+
+#ifndef _LINUX_SIM_MEDIA_CLOCK_REC_USER_H_
+#define _LINUX_SIM_MEDIA_CLOCK_REC_USER_H_
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "os/sys_types.h"
+
+#define NSEC_PER_SEC	1000000000L
+
+#define fallthrough	__attribute__((__fallthrough__))
+
+static inline s64 div_s64(s64 dividend, s32 divisor)
+{
+	return dividend / divisor;
+}
+
+#endif /* _LINUX_SIM_MEDIA_CLOCK_REC_USER_H_ */
@@ -0,0 +1,426 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Software stream shaper pacing benchmark
+ @details Compares the frames released to the network interface by a talker stream on the standard socket/AF_XDP
+ backends, without shaping (one transmit batch every CFG_AVTP_MIN_LATENCY) and with the software shaper
+ (linux/net_shaper.c, one transmit batch every class interval, as selected by stream_tx_batch()). A third case runs
+ the unshaped talker batches through the shaper: frames above the reservation are deferred, and only released by the
+ next transmit call. The talker is woken up periodically with a given jitter, and may produce more than its
+ reservation. Measures how well the released frames follow the stream reservation (max_frame_size/max_interval_frames):
+ - maximum amount of data released in any class measurement interval, relative to the reservation
+ - long term rate, relative to the idle slope
+ - delay added by the shaper (frame release time minus batch submission time)
+ - shaper cost per transmit call
+
+ By default, time is simulated; in real-time
+ mode the talker sleeps on the monotonic clock between batches and the release times are measured, so that the
+ results include the actual scheduling jitter of the host.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "genavb/helpers.h"
+#include "genavb/ether.h"
+#include "genavb/sr_class.h"
+
+#include "common/types.h"
+#include "os/clock.h"
+
+#include "net_shaper.h"
+
+#define BENCH_DEFAULT_FRAME_SIZE	256	/* bytes, without FCS */
+#define BENCH_DEFAULT_DURATION		1000	/* ms */
+#define BENCH_DEFAULT_BATCH_TIME	500000	/* ns, CFG_AVTP_MIN_LATENCY */
+
+#define BENCH_WINDOW_MAX		1024	/* frames released in one class interval */
+
+struct bench_result {
+	const char *name;
+	bool shaped;
+	unsigned int batch;		/* frames per wakeup */
+	u64 period;			/* wakeup period, in ns */
+
+	u64 frames;
+	u64 dropped;
+	u64 bits;
+
+	u64 window_bits_max;		/* in any class interval */
+	unsigned int window_frames_max;
+
+	u64 delay_sum;
+	u64 delay_max;
+
+	u64 cost_sum;
+	u64 cost_max;
+	u64 calls;
+
+	unsigned int deferred;		/* frames held by the shaper */
+	unsigned int pending;		/* frames still held at the end of the run */
+
+	/* sliding class interval window of released frames */
+	u64 window_t[BENCH_WINDOW_MAX];
+	u64 window_b[BENCH_WINDOW_MAX];
+	unsigned int window_r;
+	unsigned int window_n;
+	u64 window_bits;
+};
+
+struct bench_frame {
+	struct net_tx_desc desc;
+	u64 submit;			/* batch submission time, in ns */
+};
+
+static struct bench {
+	sr_class_t class;
+	unsigned int frame_size;
+	unsigned int interval_frames;
+	unsigned int interval;		/* class measurement interval, in ns */
+	unsigned int idle_slope;	/* bits/s */
+	unsigned int load;		/* talker rate, in percent of the reservation */
+	unsigned int jitter;		/* ns */
+	bool realtime;
+
+	u64 now;			/* simulated time, or time of the current call, in ns */
+	struct bench_result *result;
+
+	struct bench_frame *frame;
+	struct net_tx_desc **free_list;
+	unsigned int free_n;
+	unsigned int frame_n;
+} bench;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n net-shaper-bench [options]\n");
+	printf("\nOptions:\n"
+		"\t-c <class>              SR class (default: A)\n"
+		"\t-f <bytes>              max frame size, including the ethernet/vlan headers, without FCS (default: %u)\n"
+		"\t-n <frames>             max interval frames (default: 1)\n"
+		"\t-b <frames>             unshaped talker frames per transmit batch (default: %u ns worth of frames)\n"
+		"\t-o <percent>            talker rate, relative to the reservation (default: 100)\n"
+		"\t-j <ns>                 talker wakeup jitter, uniformly distributed (default: 0)\n"
+		"\t-t <ms>                 duration (default: %u)\n"
+		"\t-R                      real-time mode, sleep between batches and measure the release times\n"
+		"\t-s <seed>               random seed (default: 1)\n"
+		"\t-h                      print this help text\n",
+		BENCH_DEFAULT_FRAME_SIZE, BENCH_DEFAULT_BATCH_TIME, BENCH_DEFAULT_DURATION);
+}
+
+static u64 monotonic_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (u64)ts.tv_sec * NSECS_PER_SEC + ts.tv_nsec;
+}
+
+/* Shaper time base */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = bench.now;
+
+	return 0;
+}
+
+static u64 frame_bits(unsigned int len)
+{
+	unsigned int size = len + ETHER_FCS;
+
+	if (size < ETHER_MIN_FRAME_SIZE)
+		size = ETHER_MIN_FRAME_SIZE;
+
+	return (u64)(size + ETHER_IFG + ETHER_PREAMBLE) * 8;
+}
+
+static void bench_free(struct net_tx_desc *desc)
+{
+	bench.free_list[bench.free_n++] = desc;
+}
+
+static struct net_tx_desc *bench_alloc(void)
+{
+	if (!bench.free_n)
+		return NULL;
+
+	return bench.free_list[--bench.free_n];
+}
+
+/* Network interface, records the frame release */
+static int bench_tx(struct net_tx *tx, struct net_tx_desc *desc)
+{
+	struct bench_result *r = bench.result;
+	struct bench_frame *frame = container_of(desc, struct bench_frame, desc);
+	u64 t = bench.realtime ? monotonic_ns() : bench.now;
+	u64 bits = frame_bits(desc->len);
+	unsigned int w;
+
+	/* Frames released more than one interval ago leave the window */
+	while (r->window_n && (r->window_t[r->window_r] + bench.interval <= t)) {
+		r->window_bits -= r->window_b[r->window_r];
+		r->window_r = (r->window_r + 1) % BENCH_WINDOW_MAX;
+		r->window_n--;
+	}
+
+	if (r->window_n == BENCH_WINDOW_MAX) {
+		r->window_bits -= r->window_b[r->window_r];
+		r->window_r = (r->window_r + 1) % BENCH_WINDOW_MAX;
+		r->window_n--;
+	}
+
+	w = (r->window_r + r->window_n) % BENCH_WINDOW_MAX;
+	r->window_t[w] = t;
+	r->window_b[w] = bits;
+	r->window_n++;
+	r->window_bits += bits;
+
+	if (r->window_bits > r->window_bits_max)
+		r->window_bits_max = r->window_bits;
+	if (r->window_n > r->window_frames_max)
+		r->window_frames_max = r->window_n;
+
+	r->frames++;
+	r->bits += bits;
+	r->delay_sum += t - frame->submit;
+	if (t - frame->submit > r->delay_max)
+		r->delay_max = t - frame->submit;
+
+	bench_free(desc);
+
+	return 0;
+}
+
+static void bench_run(struct bench_result *r, u64 duration)
+{
+	struct net_tx_desc *desc[NET_TX_BATCH];
+	struct net_shaper shaper;
+	struct bench_frame *frame;
+	u64 start, wakeup, cost;
+	struct timespec ts;
+	unsigned int i;
+	int rc;
+
+	memset(r->window_t, 0, sizeof(r->window_t));
+	r->window_r = r->window_n = 0;
+	r->window_bits = 0;
+
+	bench.result = r;
+	bench.now = bench.realtime ? monotonic_ns() : NSECS_PER_SEC;
+
+	net_shaper_init(&shaper, bench.idle_slope, bench.interval, bench.now);
+
+	start = bench.now;
+
+	for (wakeup = start; wakeup < start + duration; wakeup += r->period) {
+		u64 t = wakeup + (bench.jitter ? (u64)(drand48() * bench.jitter) : 0);
+
+		if (bench.realtime) {
+			ts.tv_sec = t / NSECS_PER_SEC;
+			ts.tv_nsec = t % NSECS_PER_SEC;
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+			t = monotonic_ns();
+		}
+
+		bench.now = t;
+
+		for (i = 0; i < r->batch; i++) {
+			desc[i] = bench_alloc();
+			if (!desc[i])
+				break;
+
+			desc[i]->len = bench.frame_size;
+			frame = container_of(desc[i], struct bench_frame, desc);
+			frame->submit = t;
+		}
+
+		r->dropped += r->batch - i;
+
+		cost = monotonic_ns();
+
+		if (r->shaped) {
+			rc = net_shaper_tx_multi(&shaper, NULL, desc, i, bench.now, bench_tx, bench_free);
+			if (rc < (int)i)
+				r->dropped += i - (rc < 0 ? 0 : rc);
+		} else {
+			for (rc = 0; rc < i; rc++)
+				bench_tx(NULL, desc[rc]);
+		}
+
+		cost = monotonic_ns() - cost;
+
+		r->calls++;
+		r->cost_sum += cost;
+		if (cost > r->cost_max)
+			r->cost_max = cost;
+	}
+
+	r->deferred = shaper.deferred;
+	r->pending = shaper.pending_n;
+
+	net_shaper_exit(&shaper, bench_free);
+}
+
+static void bench_print(struct bench_result *r, u64 duration)
+{
+	double reserved = (double)bench.idle_slope * bench.interval / NSECS_PER_SEC;
+
+	printf("%-9s %5u %9" PRIu64 " %7" PRIu64 "  %6u %10.2f  %10.4f  %10" PRIu64 " %10" PRIu64 "  %8" PRIu64 " %8" PRIu64 "\n",
+	       r->name, r->batch, r->frames, r->dropped, r->window_frames_max, r->window_bits_max / reserved,
+	       ((double)r->bits * NSECS_PER_SEC / duration) / bench.idle_slope,
+	       r->frames ? r->delay_sum / r->frames : 0, r->delay_max,
+	       r->calls ? r->cost_sum / r->calls : 0, r->cost_max);
+}
+
+int main(int argc, char *argv[])
+{
+	static struct bench_result unshaped = { .name = "unshaped", .shaped = false };
+	static struct bench_result shaped = { .name = "shaped", .shaped = true };
+	static struct bench_result shaped_batch = { .name = "shaped/b", .shaped = true };
+	unsigned long frame_size = BENCH_DEFAULT_FRAME_SIZE;
+	unsigned long interval_frames = 1;
+	unsigned long batch = 0;
+	unsigned long load = 100;
+	unsigned long jitter = 0;
+	unsigned long duration = BENCH_DEFAULT_DURATION;
+	unsigned long seed = 1;
+	sr_class_t class = SR_CLASS_A;
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	while ((option = getopt(argc, argv, "c:f:n:b:o:j:t:Rs:h")) != -1) {
+		switch (option) {
+		case 'c':
+			class = str_to_sr_class(optarg);
+			if (class == SR_CLASS_NONE)
+				goto err_option;
+			break;
+
+		case 'f':
+			if ((h_strtoul(&frame_size, optarg, NULL, 0) < 0) || !frame_size || (frame_size > 1518))
+				goto err_option;
+			break;
+
+		case 'n':
+			if ((h_strtoul(&interval_frames, optarg, NULL, 0) < 0) || !interval_frames || (interval_frames > NET_TX_BATCH))
+				goto err_option;
+			break;
+
+		case 'b':
+			if ((h_strtoul(&batch, optarg, NULL, 0) < 0) || !batch || (batch > NET_TX_BATCH))
+				goto err_option;
+			break;
+
+		case 'o':
+			if ((h_strtoul(&load, optarg, NULL, 0) < 0) || !load || (load > 1000))
+				goto err_option;
+			break;
+
+		case 'j':
+			if (h_strtoul(&jitter, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 't':
+			if ((h_strtoul(&duration, optarg, NULL, 0) < 0) || !duration)
+				goto err_option;
+			break;
+
+		case 'R':
+			bench.realtime = true;
+			break;
+
+		case 's':
+			if (h_strtoul(&seed, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	srand48(seed);
+
+	bench.class = class;
+	bench.frame_size = frame_size;
+	bench.interval_frames = interval_frames;
+	bench.interval = sr_class_interval_p(class) / sr_class_interval_q(class);
+	bench.jitter = jitter;
+	bench.load = load;
+
+	/* Same reservation as the talker stream (see stream_tx_shaper_config()) */
+	bench.idle_slope = (frame_bits(frame_size) * interval_frames * sr_class_interval_q(class) * NSECS_PER_SEC) / sr_class_interval_p(class);
+
+	/* Default batch as an unshaped talker, whole class intervals and at least BENCH_DEFAULT_BATCH_TIME worth of frames */
+	if (!batch) {
+		batch = ((BENCH_DEFAULT_BATCH_TIME + bench.interval - 1) / bench.interval) * interval_frames;
+		if (batch > NET_TX_BATCH)
+			batch = (NET_TX_BATCH / interval_frames) * interval_frames;
+	}
+
+	unshaped.batch = batch;
+	unshaped.period = ((u64)batch * bench.interval * 100) / (interval_frames * load);
+
+	shaped.batch = interval_frames;
+	shaped.period = ((u64)bench.interval * 100) / load;
+
+	/* Unshaped talker batches, through the shaper */
+	shaped_batch.batch = unshaped.batch;
+	shaped_batch.period = unshaped.period;
+
+	bench.frame_n = NET_SHAPER_PENDING_MAX + 2 * NET_TX_BATCH;
+	bench.frame = calloc(bench.frame_n, sizeof(struct bench_frame));
+	bench.free_list = calloc(bench.frame_n, sizeof(struct net_tx_desc *));
+	if (!bench.frame || !bench.free_list)
+		goto exit;
+
+	for (i = 0; i < bench.frame_n; i++)
+		bench_free(&bench.frame[i].desc);
+
+	printf("net-shaper-bench: class %c (interval %u ns), %lu x %lu bytes per interval, idle slope %u bits/s\n",
+	       'A' + class, bench.interval, interval_frames, frame_size, bench.idle_slope);
+	printf("talker rate %u%%, unshaped batch every %" PRIu64 " ns, shaped batch every %" PRIu64 " ns, jitter %u ns, %s time, %lu ms\n\n",
+	       bench.load, unshaped.period, shaped.period, bench.jitter, bench.realtime ? "real" : "simulated", duration);
+
+	bench_run(&unshaped, (u64)duration * NSECS_PER_MS);
+	bench_run(&shaped, (u64)duration * NSECS_PER_MS);
+	bench_run(&shaped_batch, (u64)duration * NSECS_PER_MS);
+
+	printf("          batch    frames dropped  max per interval        rate   delay mean/max (ns)    cost mean/max (ns)\n");
+	printf("                                   frames  /reserved  /idle slope\n");
+	bench_print(&unshaped, (u64)duration * NSECS_PER_MS);
+	bench_print(&shaped, (u64)duration * NSECS_PER_MS);
+	bench_print(&shaped_batch, (u64)duration * NSECS_PER_MS);
+
+	printf("\n%-9s %u frames deferred, %u still pending at the end\n", shaped.name, shaped.deferred, shaped.pending);
+	printf("%-9s %u frames deferred, %u still pending at the end\n", shaped_batch.name, shaped_batch.deferred, shaped_batch.pending);
+
+	rc = 0;
+
+exit:
+	free(bench.frame);
+	free(bench.free_list);
+
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
@@ -0,0 +1,96 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Userspace build of the AVB kernel module transmit scheduler
+ @details Provides the kernel and FEC driver interfaces used by linux/modules/avb/net_tx_sched.c, so that the
+ scheduling core can run in the shaper simulator. Socket flags and queue sizes come from the kernel module headers.
+ The FEC functions are implemented by the simulator.
+*/
+
+#ifndef _LINUX_SIM_NET_TX_SCHED_USER_H_
+#define _LINUX_SIM_NET_TX_SCHED_USER_H_
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include "os/sys_types.h"
+
+#define BITS_PER_LONG	(8 * sizeof(long))
+#define BITS_PER_BYTE	8
+
+#define NSEC_PER_SEC	1000000000L
+
+#define pr_err(...)	fprintf(stderr, __VA_ARGS__)
+#define pr_info(...)	printf(__VA_ARGS__)
+
+static inline u64 div64_u64(u64 dividend, u64 divisor)
+{
+	return dividend / divisor;
+}
+
+/* Return number of leading zeros in a BITS_PER_LONG-bit word */
+static inline unsigned long leading_zeros(unsigned long x)
+{
+	return x ? __builtin_clzl(x) : BITS_PER_LONG;
+}
+
+/* The simulator is single threaded, bit operations don't need to be atomic */
+static inline void set_bit(unsigned int nr, unsigned long *addr)
+{
+	*addr |= 1UL << nr;
+}
+
+static inline void clear_bit(unsigned int nr, unsigned long *addr)
+{
+	*addr &= ~(1UL << nr);
+}
+
+static inline int test_bit(unsigned int nr, const unsigned long *addr)
+{
+	return (*addr >> nr) & 1;
+}
+
+typedef unsigned int atomic_t;
+
+static inline void atomic_set(atomic_t *addr, unsigned int val)
+{
+	*addr = val;
+}
+
+static inline unsigned int atomic_read(atomic_t *addr)
+{
+	return *addr;
+}
+
+static inline void smp_wmb(void) {}
+
+#include "modules/common/queue.h"
+#include "common/os/queue_common.h"
+
+/* Transmit descriptor, from the FEC driver AVB interface (include/linux/fec.h in the vendor kernel, not part of
+ * this tree and not usable from userspace). Only the fields used by the scheduler.
+ */
+#define AVB_TX_FLAG_TS		(1 << 0)
+
+struct avb_desc {
+	u32 ts;			/* transmit time, gPTP time in ns */
+	u16 flags;
+	u16 len;		/* frame length, without FCS */
+};
+
+struct avb_tx_desc {
+	struct avb_desc common;
+	unsigned int queue_id;
+};
+
+int fec_enet_start_xmit_avb(void *data, struct avb_tx_desc *desc);
+void fec_enet_finish_xmit_avb(void *data, unsigned int queue_id);
+int fec_enet_set_idle_slope(void *data, unsigned int queue_id, unsigned int idle_slope);
+
+#endif /* _LINUX_SIM_NET_TX_SCHED_USER_H_ */
@@ -0,0 +1,145 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Capture file reader
+ @details Reads classic pcap files, as written by tcpdump/wireshark. The pcapng format is not supported
+ (convert with "editcap -F pcap").
+*/
+
+#include <string.h>
+
+#include "common/log.h"
+
+#include "pcap.h"
+
+#define PCAP_MAGIC_USEC		0xa1b2c3d4
+#define PCAP_MAGIC_NSEC		0xa1b23c4d
+
+struct pcap_file_hdr {
+	u32 magic;
+	u16 version_major;
+	u16 version_minor;
+	s32 thiszone;
+	u32 sigfigs;
+	u32 snaplen;
+	u32 linktype;
+};
+
+struct pcap_record_hdr {
+	u32 ts_sec;
+	u32 ts_frac;	/* us or ns, depending on the file magic */
+	u32 incl_len;
+	u32 orig_len;
+};
+
+static u32 pcap_u32(struct pcap_file *p, u32 v)
+{
+	return p->swapped ? __builtin_bswap32(v) : v;
+}
+
+/** Opens a capture file and reads its header.
+ * \return	0 on success, -1 on error
+ * \param p	pointer to the capture file context
+ * \param path	capture file path
+ */
+int pcap_open(struct pcap_file *p, const char *path)
+{
+	struct pcap_file_hdr hdr;
+
+	memset(p, 0, sizeof(*p));
+
+	p->f = fopen(path, "rb");
+	if (!p->f) {
+		os_log(LOG_ERR, "%s: cannot open\n", path);
+		goto err_open;
+	}
+
+	if (fread(&hdr, sizeof(hdr), 1, p->f) != 1) {
+		os_log(LOG_ERR, "%s: cannot read file header\n", path);
+		goto err_hdr;
+	}
+
+	switch (hdr.magic) {
+	case PCAP_MAGIC_USEC:
+		break;
+
+	case PCAP_MAGIC_NSEC:
+		p->nsec = true;
+		break;
+
+	default:
+		p->swapped = true;
+
+		if (pcap_u32(p, hdr.magic) == PCAP_MAGIC_NSEC) {
+			p->nsec = true;
+		} else if (pcap_u32(p, hdr.magic) != PCAP_MAGIC_USEC) {
+			os_log(LOG_ERR, "%s: not a pcap file (magic 0x%08x)\n", path, hdr.magic);
+			goto err_hdr;
+		}
+		break;
+	}
+
+	p->snaplen = pcap_u32(p, hdr.snaplen);
+	p->linktype = pcap_u32(p, hdr.linktype);
+
+	if (p->linktype != PCAP_LINKTYPE_ETHERNET) {
+		os_log(LOG_ERR, "%s: unsupported link type %u\n", path, p->linktype);
+		goto err_hdr;
+	}
+
+	return 0;
+
+err_hdr:
+	fclose(p->f);
+	p->f = NULL;
+
+err_open:
+	return -1;
+}
+
+/** Reads the next record of a capture file.
+ * \return	1 if a record was read, 0 at the end of the file, -1 on error
+ * \param p	pointer to the capture file context
+ * \param r	pointer to the returned record
+ */
+int pcap_read(struct pcap_file *p, struct pcap_record *r)
+{
+	struct pcap_record_hdr hdr;
+	unsigned int incl_len;
+
+	if (fread(&hdr, sizeof(hdr), 1, p->f) != 1)
+		return feof(p->f) ? 0 : -1;
+
+	incl_len = pcap_u32(p, hdr.incl_len);
+
+	r->ts = (u64)pcap_u32(p, hdr.ts_sec) * NSECS_PER_SEC;
+	if (p->nsec)
+		r->ts += pcap_u32(p, hdr.ts_frac);
+	else
+		r->ts += (u64)pcap_u32(p, hdr.ts_frac) * 1000;
+
+	r->orig_len = pcap_u32(p, hdr.orig_len);
+	r->len = (incl_len > PCAP_MAX_SNAPLEN) ? PCAP_MAX_SNAPLEN : incl_len;
+
+	if (fread(r->data, 1, r->len, p->f) != r->len)
+		return -1;
+
+	/* Skip the truncated part */
+	if ((incl_len > r->len) && fseek(p->f, incl_len - r->len, SEEK_CUR) < 0)
+		return -1;
+
+	return 1;
+}
+
+void pcap_close(struct pcap_file *p)
+{
+	if (p->f)
+		fclose(p->f);
+
+	p->f = NULL;
+}
@@ -0,0 +1,43 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Capture file reader
+ @details Reads classic pcap files (microsecond or nanosecond resolution, any byte order).
+*/
+
+#ifndef _LINUX_SIM_PCAP_H_
+#define _LINUX_SIM_PCAP_H_
+
+#include <stdio.h>
+
+#include "os/sys_types.h"
+
+#define PCAP_LINKTYPE_ETHERNET	1
+
+#define PCAP_MAX_SNAPLEN	2048	/* longer records are truncated */
+
+struct pcap_file {
+	FILE *f;
+	bool swapped;		/* file byte order differs from host byte order */
+	bool nsec;		/* nanosecond timestamps */
+	u32 linktype;
+	u32 snaplen;
+};
+
+struct pcap_record {
+	u64 ts;			/* capture timestamp, in ns */
+	unsigned int len;	/* number of bytes in data */
+	unsigned int orig_len;	/* length of the frame on the wire */
+	u8 data[PCAP_MAX_SNAPLEN];
+};
+
+int pcap_open(struct pcap_file *p, const char *path);
+int pcap_read(struct pcap_file *p, struct pcap_record *r);
+void pcap_close(struct pcap_file *p);
+
+#endif /* _LINUX_SIM_PCAP_H_ */
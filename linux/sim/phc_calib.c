@@ -0,0 +1,263 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief PHC cross timestamp calibration quality
+ @details For each PHC device (all /dev/ptp* by default), and each cross timestamp method supported by its driver
+ (precise, extended, system calls, see linux/clock_xts.h), runs the PHC/CLOCK_MONOTONIC_RAW calibration for a number of
+ samples and reports:
+ - cross timestamp cost and delay (read uncertainty)
+ - residual error, each cross timestamp minus the PHC time predicted from the previous calibration
+ - PHC oscillator frequency offset relative to CLOCK_MONOTONIC_RAW
+
+ The PHC is expected not to be adjusted during the measurement (adjustments by a running gPTP stack show up in the
+ residual error).
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <glob.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <inttypes.h>
+
+#include "genavb/helpers.h"
+
+#include "common/types.h"
+#include "os/clock.h"
+
+#include "clock_xts.h"
+
+#define CLOCKFD 3
+#define FD_TO_CLOCKID(fd)	((~(clockid_t) (fd) << 3) | CLOCKFD)
+
+#define CALIB_DEFAULT_SAMPLES	200
+#define CALIB_DEFAULT_INTERVAL	10	/* ms */
+
+static struct calib {
+	unsigned int samples;
+	unsigned int interval;		/* ms */
+	clock_xts_method_t method;	/* CLOCK_XTS_AUTO for all methods */
+
+	u64 *cost;
+	u64 *delay;
+	s64 *residual;
+} calib;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n phc-calib [options] [device ...]\n");
+	printf("\nDevices: PHC devices, or \"realtime\" for CLOCK_REALTIME (default: all /dev/ptp*)\n");
+	printf("\nOptions:\n"
+		"\t-m <method>             cross timestamp method: precise, extended or syscall (default: all supported)\n"
+		"\t-n <samples>            samples per method (default: %u)\n"
+		"\t-i <ms>                 interval between samples (default: %u)\n"
+		"\t-h                      print this help text\n",
+		CALIB_DEFAULT_SAMPLES, CALIB_DEFAULT_INTERVAL);
+}
+
+static u64 monotonic_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return (u64)ts.tv_sec * NSECS_PER_SEC + ts.tv_nsec;
+}
+
+/* Log time base */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = monotonic_ns();
+
+	return 0;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	u64 x = *(const u64 *)a, y = *(const u64 *)b;
+
+	return (x > y) - (x < y);
+}
+
+static int cmp_s64(const void *a, const void *b)
+{
+	s64 x = *(const s64 *)a, y = *(const s64 *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void calib_method(const char *device, int fd, clockid_t clk_id, clock_xts_method_t method)
+{
+	struct timespec interval = {
+		.tv_sec = calib.interval / 1000,
+		.tv_nsec = (calib.interval % 1000) * NSECS_PER_MS,
+	};
+	struct clock_xts x;
+	unsigned int i, n = 0, r = 0;
+	u64 t0, mono, hw, abs_sum = 0;
+
+	if (clock_xts_init(&x, fd, clk_id, method) < 0) {
+		printf("%-14s %-9s not supported\n", device, clock_xts_method_str(method));
+		return;
+	}
+
+	for (i = 0; i < calib.samples; i++) {
+		t0 = monotonic_ns();
+
+		if (clock_xts_update(&x, 0, false, &mono, &hw) < 0)
+			goto next;
+
+		calib.cost[n] = monotonic_ns() - t0;
+		calib.delay[n] = x.stats.delay;
+		n++;
+
+		if (x.stats.n > r) {
+			calib.residual[r] = x.stats.residual;
+			abs_sum += (x.stats.residual < 0) ? -x.stats.residual : x.stats.residual;
+			r++;
+		}
+
+	next:
+		nanosleep(&interval, NULL);
+	}
+
+	if (!n || !r) {
+		printf("%-14s %-9s no valid samples (%" PRIu64 " errors)\n", device, clock_xts_method_str(x.method), x.stats.errors);
+		return;
+	}
+
+	qsort(calib.cost, n, sizeof(u64), cmp_u64);
+	qsort(calib.delay, n, sizeof(u64), cmp_u64);
+	qsort(calib.residual, r, sizeof(s64), cmp_s64);
+
+	printf("%-14s %-9s %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %8" PRId64 " %8" PRId64 " %8" PRId64 " %+10.3f %6" PRIu64 "\n",
+	       device, clock_xts_method_str(x.method),
+	       calib.cost[n / 2], calib.cost[n - 1],
+	       calib.delay[0], calib.delay[n / 2], calib.delay[n - 1],
+	       abs_sum / r, calib.residual[0], calib.residual[r / 2], calib.residual[r - 1],
+	       x.osc_mono ? ((x.osc / x.osc_mono) - 1.0) * 1000000.0 : 0.0,
+	       x.stats.errors);
+}
+
+static void calib_device(const char *device)
+{
+	clock_xts_method_t method;
+	clockid_t clk_id;
+	int fd = -1;
+
+	if (!strcmp(device, "realtime")) {
+		clk_id = CLOCK_REALTIME;
+	} else {
+		fd = open(device, O_RDONLY);
+		if (fd < 0) {
+			printf("%-14s open failed: %s\n", device, strerror(errno));
+			return;
+		}
+
+		clk_id = FD_TO_CLOCKID(fd);
+	}
+
+	if (calib.method != CLOCK_XTS_AUTO) {
+		calib_method(device, fd, clk_id, calib.method);
+	} else {
+		for (method = CLOCK_XTS_PRECISE; method < CLOCK_XTS_METHOD_MAX; method++)
+			calib_method(device, fd, clk_id, method);
+	}
+
+	if (fd >= 0)
+		close(fd);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long samples = CALIB_DEFAULT_SAMPLES;
+	unsigned long interval = CALIB_DEFAULT_INTERVAL;
+	glob_t devices = { 0 };
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	calib.method = CLOCK_XTS_AUTO;
+
+	while ((option = getopt(argc, argv, "m:n:i:h")) != -1) {
+		switch (option) {
+		case 'm':
+			if (!strcmp(optarg, "precise"))
+				calib.method = CLOCK_XTS_PRECISE;
+			else if (!strcmp(optarg, "extended"))
+				calib.method = CLOCK_XTS_EXTENDED;
+			else if (!strcmp(optarg, "syscall"))
+				calib.method = CLOCK_XTS_SYSCALL;
+			else
+				goto err_option;
+			break;
+
+		case 'n':
+			if ((h_strtoul(&samples, optarg, NULL, 0) < 0) || (samples < 2))
+				goto err_option;
+			break;
+
+		case 'i':
+			if ((h_strtoul(&interval, optarg, NULL, 0) < 0) || !interval || (interval >= 1000))
+				goto err_option;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			goto exit;
+		}
+	}
+
+	calib.samples = samples;
+	calib.interval = interval;
+
+	calib.cost = calloc(samples, sizeof(u64));
+	calib.delay = calloc(samples, sizeof(u64));
+	calib.residual = calloc(samples, sizeof(s64));
+	if (!calib.cost || !calib.delay || !calib.residual)
+		goto exit;
+
+	printf("phc-calib: %u samples every %u ms per method\n\n", calib.samples, calib.interval);
+	printf("device         method    cost (ns)          delay (ns)                 residual (ns)                       oscillator errors\n");
+	printf("                           median      max      min   median      max mean abs      min   median      max      (ppm)\n");
+
+	if (optind < argc) {
+		for (i = optind; i < argc; i++)
+			calib_device(argv[i]);
+	} else {
+		if (glob("/dev/ptp[0-9]*", 0, NULL, &devices)) {
+			printf("no PHC device found\n");
+			goto exit;
+		}
+
+		for (i = 0; i < devices.gl_pathc; i++)
+			calib_device(devices.gl_pathv[i]);
+	}
+
+	rc = 0;
+
+exit:
+	globfree(&devices);
+	free(calib.cost);
+	free(calib.delay);
+	free(calib.residual);
+
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
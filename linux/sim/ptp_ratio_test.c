@@ -0,0 +1,304 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief gPTP rate ratio operations test
+ @details Built with CONFIG_GPTP_FIXED_POINT, compares the fixed point rate ratio operations (common/ptp_time_ops.h)
+ with a floating point reference, over the value ranges used by gPTP. Exits with a non zero status if any operation
+ is outside of its error bound.
+ Optionally (-b) measures the execution time of each operation, in CPU cycles (perf hardware counter) when available,
+ in nanoseconds otherwise.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "genavb/helpers.h"
+
+#include "common/types.h"
+#include "common/ptp_time_ops.h"
+#include "os/stdlib.h"
+#include "os/clock.h"
+
+#ifndef CONFIG_GPTP_FIXED_POINT
+#error "ptp-ratio-test must be built with CONFIG_GPTP_FIXED_POINT"
+#endif
+
+#define RATIO_TEST_VECTORS	10000
+#define RATIO_TEST_MAX_DEV	2.0e-2	/* twice the largest neighbor rate ratio deviation accepted by gPTP */
+#define RATIO_TEST_MAX_PPB	20000000
+#define RATIO_TEST_MAX_CSO_DEV	9.0e-4	/* cumulativeScaledRateOffset range is +/- 2^31 x 2^-41 */
+
+/* Error bounds, relative to the double precision reference (itself accurate to ~2^-52) */
+#define RATIO_TEST_MAX_ERR		4.0e-16
+#define RATIO_TEST_MAX_SCALED_NS_ERR	(3.0 / 65536)	/* ns, scaled ns input and output rounding (2^-16 ns each) */
+
+#define RATIO_BENCH_LOOPS	1000000
+#define RATIO_BENCH_VALUES	64
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n ptp-ratio-test [options]\n");
+	printf("\nOptions:\n"
+		"\t-s <seed>               random seed (default: 1)\n"
+		"\t-b                      also measure the execution time of each operation\n"
+		"\t-h                      print this help text\n");
+}
+
+/* Deterministic pseudo random generator (LCG), returns 53 random bits */
+static u64 test_rand(u64 *state)
+{
+	*state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+	return *state >> 11;
+}
+
+/* Pseudo random value in [min, max) */
+static double test_rand_range(u64 *state, double min, double max)
+{
+	return min + (max - min) * ((double)test_rand(state) / (double)(1ULL << 53));
+}
+
+static void test_max(double *max, double err)
+{
+	if (err > *max)
+		*max = err;
+}
+
+static int test_check(const char *name, double max, double bound)
+{
+	int fail = (max > bound);
+
+	printf("%-24s max error %e (bound %e) %s\n", name, max, bound, fail ? "FAIL" : "ok");
+
+	return fail;
+}
+
+static int test_check_count(const char *name, unsigned int errors)
+{
+	printf("%-24s %u errors %s\n", name, errors, errors ? "FAIL" : "ok");
+
+	return errors ? 1 : 0;
+}
+
+/** Compares the rate ratio operations with a floating point reference.
+ * \return	number of failed operations
+ * \param seed	random seed
+ */
+static int ptp_ratio_test(u64 seed)
+{
+	double a, b, c, ns, res;
+	double max_mul = 0, max_div = 0, max_offset = 0, max_scaled_ns = 0;
+	unsigned int cso_errors = 0, ppb_errors = 0;
+	ptp_ratio ra, rb, rc;
+	struct ptp_scaled_ns s;
+	u64 seed0 = seed;
+	int failed = 0;
+	s32 cso;
+	s64 ppb;
+	int i;
+
+	for (i = 0; i < RATIO_TEST_VECTORS; i++) {
+		a = test_rand_range(&seed, 1.0 - RATIO_TEST_MAX_DEV, 1.0 + RATIO_TEST_MAX_DEV);
+		b = test_rand_range(&seed, 1.0 - RATIO_TEST_MAX_DEV, 1.0 + RATIO_TEST_MAX_DEV);
+		ra = ptp_ratio_from_double(a);
+		rb = ptp_ratio_from_double(b);
+
+		test_max(&max_mul, os_fabs(ptp_ratio_to_double(ptp_ratio_mul(ra, rb)) - a * b));
+		test_max(&max_div, os_fabs(ptp_ratio_to_double(ptp_ratio_div(ra, rb)) - a / b));
+		test_max(&max_offset, os_fabs(ptp_ratio_to_double(ptp_ratio_add_offset(ra, rb)) - (a + (b - 1.0))));
+
+		/* cumulativeScaledRateOffset, full s32 range must round trip exactly */
+		cso = (s32)test_rand(&seed);
+		if (ptp_ratio_to_scaled_rate_offset(ptp_ratio_from_scaled_rate_offset(cso)) != cso)
+			cso_errors++;
+
+		c = test_rand_range(&seed, 1.0 - RATIO_TEST_MAX_CSO_DEV, 1.0 + RATIO_TEST_MAX_CSO_DEV);
+		rc = ptp_ratio_from_double(c);
+		if (os_llabs(ptp_ratio_to_scaled_rate_offset(rc) - (s64)((c - 1.0) * POW_2_41)) > 1)
+			cso_errors++;
+
+		/* ppb, one unit of error allowed for the truncation */
+		ppb = (s64)(test_rand(&seed) % (2 * RATIO_TEST_MAX_PPB + 1)) - RATIO_TEST_MAX_PPB;
+		if (os_llabs(ptp_ratio_to_ppb(ptp_ratio_from_ppb(ppb)) - ppb) > 1)
+			ppb_errors++;
+
+		if (os_llabs(ptp_ratio_to_ppb(ra) - (s64)(1.0e9 * (a - 1.0))) > 1)
+			ppb_errors++;
+
+		/* Residence time, up to 1s */
+		ns = test_rand_range(&seed, 0, 1.0e9);
+		ptp_double_to_scaled_ns(&s, ns);
+		ptp_ratio_scaled_ns_mul(&s, ra, s);
+		scaled_ns_to_ptp_double(&res, &s);
+
+		test_max(&max_scaled_ns, os_fabs(res - a * ns));
+	}
+
+	printf("%d test vectors, seed %" PRIu64 "\n", RATIO_TEST_VECTORS, seed0);
+
+	failed += test_check("mul", max_mul, RATIO_TEST_MAX_ERR);
+	failed += test_check("div", max_div, RATIO_TEST_MAX_ERR);
+	failed += test_check("add_offset", max_offset, RATIO_TEST_MAX_ERR);
+	failed += test_check("scaled_ns_mul (ns)", max_scaled_ns, RATIO_TEST_MAX_SCALED_NS_ERR);
+	failed += test_check_count("scaled_rate_offset", cso_errors);
+	failed += test_check_count("ppb", ppb_errors);
+
+	return failed;
+}
+
+static u64 monotonic_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return (u64)ts.tv_sec * NSECS_PER_SEC + ts.tv_nsec;
+}
+
+/* Log time base */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = monotonic_ns();
+
+	return 0;
+}
+
+/* CPU cycle counter, for the calling thread, user space only */
+static int cycles_open(void)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = PERF_COUNT_HW_CPU_CYCLES;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/* CPU cycles if the counter is available, nanoseconds otherwise */
+static u64 bench_counter(int fd)
+{
+	u64 cycles;
+
+	if (fd < 0)
+		return monotonic_ns();
+
+	if (read(fd, &cycles, sizeof(cycles)) != sizeof(cycles))
+		return 0;
+
+	return cycles;
+}
+
+#define RATIO_BENCH(name, expr)											\
+	do {													\
+		start = bench_counter(fd);									\
+		for (i = 0; i < RATIO_BENCH_LOOPS; i++)								\
+			expr;											\
+		end = bench_counter(fd);									\
+		printf("%-24s %.2f %s/op\n", name, (double)(end - start) / RATIO_BENCH_LOOPS, unit);		\
+	} while (0)
+
+/* Rate ratio operations execution time, to compare the fixed and floating point implementations on a given target */
+static void ptp_ratio_benchmark(void)
+{
+	ptp_ratio r[RATIO_BENCH_VALUES];
+	struct ptp_scaled_ns s = {.u.s.nanoseconds = 123456789, .u.s.fractional_nanoseconds = 0x8000};
+	struct ptp_scaled_ns s_res;
+	volatile ptp_ratio r_res;
+	volatile s64 s64_res;
+	volatile double d_res;
+	double d[RATIO_BENCH_VALUES];
+	u64 seed = 1, start, end;
+	const char *unit;
+	unsigned int i;
+	int fd;
+
+	for (i = 0; i < RATIO_BENCH_VALUES; i++) {
+		d[i] = test_rand_range(&seed, 1.0 - RATIO_TEST_MAX_DEV, 1.0 + RATIO_TEST_MAX_DEV);
+		r[i] = ptp_ratio_from_double(d[i]);
+	}
+
+	fd = cycles_open();
+	if (fd < 0) {
+		printf("CPU cycle counter not available, measuring time\n");
+		unit = "ns";
+	} else {
+		unit = "cycles";
+	}
+
+	RATIO_BENCH("mul", r_res = ptp_ratio_mul(r[i % RATIO_BENCH_VALUES], r[(i + 1) % RATIO_BENCH_VALUES]));
+	RATIO_BENCH("div", r_res = ptp_ratio_div(r[i % RATIO_BENCH_VALUES], r[(i + 1) % RATIO_BENCH_VALUES]));
+	RATIO_BENCH("add_offset", r_res = ptp_ratio_add_offset(r[i % RATIO_BENCH_VALUES], r[(i + 1) % RATIO_BENCH_VALUES]));
+	RATIO_BENCH("to_scaled_rate_offset", s64_res = ptp_ratio_to_scaled_rate_offset(r[i % RATIO_BENCH_VALUES]));
+	RATIO_BENCH("to_ppb", s64_res = ptp_ratio_to_ppb(r[i % RATIO_BENCH_VALUES]));
+	RATIO_BENCH("from_ppb", r_res = ptp_ratio_from_ppb((s64)i));
+	RATIO_BENCH("scaled_ns_mul", ptp_ratio_scaled_ns_mul(&s_res, r[i % RATIO_BENCH_VALUES], s); r_res = s_res.u.s.nanoseconds);
+
+	/* Floating point reference */
+	RATIO_BENCH("double mul", d_res = d[i % RATIO_BENCH_VALUES] * d[(i + 1) % RATIO_BENCH_VALUES]);
+	RATIO_BENCH("double div", d_res = d[i % RATIO_BENCH_VALUES] / d[(i + 1) % RATIO_BENCH_VALUES]);
+
+	if (fd >= 0)
+		close(fd);
+
+	(void)r_res;
+	(void)s64_res;
+	(void)d_res;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long seed = 1;
+	bool bench = false;
+	int option;
+
+	while ((option = getopt(argc, argv, "s:bh")) != -1) {
+		switch (option) {
+		case 's':
+			if (h_strtoul(&seed, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'b':
+			bench = true;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			return 0;
+		}
+	}
+
+	if (ptp_ratio_test(seed)) {
+		printf("FAILED\n");
+		return 1;
+	}
+
+	if (bench)
+		ptp_ratio_benchmark();
+
+	return 0;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return 1;
+}
@@ -0,0 +1,741 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Discrete time network simulator
+ @details Event scheduler, virtual clocks and timers. All stack instances run
+ in the same thread, one event at a time, in simulated time order. Events with
+ the same expiration time are processed in insertion order, so a given seed
+ always produces the same run.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/log.h"
+
+#include "sim.h"
+
+typedef enum {
+	SIM_EVENT_TIMER,
+	SIM_EVENT_FRAME,
+	SIM_EVENT_TX_TS,
+} sim_event_type_t;
+
+struct sim_timer {
+	struct os_timer *t;
+	struct sim_node *node;
+	bool used;
+	bool armed;
+	unsigned int gen;	/* incremented on each start/stop, to discard stale events */
+	u64 expiration;
+	u64 period;
+};
+
+struct sim_event {
+	u64 time;
+	u64 seq;
+	sim_event_type_t type;
+	struct sim_node *node;
+
+	union {
+		struct {
+			struct sim_timer *timer;
+			unsigned int gen;
+		} timer;
+
+		struct {
+			unsigned int port;
+			struct net_rx_desc *desc;
+		} frame;
+
+		struct {
+			struct net_tx *tx;
+			u64 ts;
+			unsigned int priv;
+		} tx_ts;
+	} u;
+};
+
+static struct sim_ctx {
+	u64 now;
+	u64 seq;
+	u64 random_state;
+
+	struct sim_event *heap;
+	unsigned int heap_len;
+	unsigned int heap_size;
+
+	struct sim_node node[SIM_MAX_NODES];
+	unsigned int node_n;
+
+	struct sim_link link[SIM_MAX_LINKS];
+	unsigned int link_n;
+
+	struct sim_timer timer[SIM_MAX_TIMERS];
+} sim;
+
+struct sim_node *sim_current;
+
+/*
+ * Event scheduler (binary min-heap, ordered by time then insertion sequence)
+ */
+
+static bool sim_event_before(struct sim_event *a, struct sim_event *b)
+{
+	if (a->time != b->time)
+		return a->time < b->time;
+
+	return a->seq < b->seq;
+}
+
+static int sim_event_push(struct sim_event *e)
+{
+	struct sim_event tmp;
+	unsigned int i, parent;
+
+	if (sim.heap_len == sim.heap_size) {
+		unsigned int size = sim.heap_size ? 2 * sim.heap_size : 256;
+		struct sim_event *heap = realloc(sim.heap, size * sizeof(struct sim_event));
+
+		if (!heap)
+			return -1;
+
+		sim.heap = heap;
+		sim.heap_size = size;
+	}
+
+	e->seq = sim.seq++;
+
+	i = sim.heap_len++;
+	sim.heap[i] = *e;
+
+	while (i) {
+		parent = (i - 1) / 2;
+
+		if (!sim_event_before(&sim.heap[i], &sim.heap[parent]))
+			break;
+
+		tmp = sim.heap[parent];
+		sim.heap[parent] = sim.heap[i];
+		sim.heap[i] = tmp;
+		i = parent;
+	}
+
+	return 0;
+}
+
+static void sim_event_pop(struct sim_event *e)
+{
+	struct sim_event tmp;
+	unsigned int i, child;
+
+	*e = sim.heap[0];
+
+	sim.heap[0] = sim.heap[--sim.heap_len];
+
+	i = 0;
+	while ((child = 2 * i + 1) < sim.heap_len) {
+		if ((child + 1 < sim.heap_len) && sim_event_before(&sim.heap[child + 1], &sim.heap[child]))
+			child++;
+
+		if (!sim_event_before(&sim.heap[child], &sim.heap[i]))
+			break;
+
+		tmp = sim.heap[child];
+		sim.heap[child] = sim.heap[i];
+		sim.heap[i] = tmp;
+		i = child;
+	}
+}
+
+int sim_event_add_frame(struct sim_node *dst, unsigned int port, struct net_rx_desc *desc, u64 time)
+{
+	struct sim_event e;
+
+	e.time = time;
+	e.type = SIM_EVENT_FRAME;
+	e.node = dst;
+	e.u.frame.port = port;
+	e.u.frame.desc = desc;
+
+	return sim_event_push(&e);
+}
+
+int sim_event_add_tx_ts(struct net_tx *tx, u64 ts, unsigned int priv, u64 time)
+{
+	struct sim_event e;
+
+	e.time = time;
+	e.type = SIM_EVENT_TX_TS;
+	e.node = tx->priv;
+	e.u.tx_ts.tx = tx;
+	e.u.tx_ts.ts = ts;
+	e.u.tx_ts.priv = priv;
+
+	return sim_event_push(&e);
+}
+
+static int sim_event_add_timer(struct sim_timer *timer)
+{
+	struct sim_event e;
+
+	e.time = timer->expiration;
+	e.type = SIM_EVENT_TIMER;
+	e.node = timer->node;
+	e.u.timer.timer = timer;
+	e.u.timer.gen = timer->gen;
+
+	return sim_event_push(&e);
+}
+
+static void sim_event_process(struct sim_event *e)
+{
+	struct sim_timer *timer;
+	struct net_rx *rx;
+	struct net_rx_desc *desc;
+
+	sim_current = e->node;
+
+	log_update_time(OS_CLOCK_SYSTEM_MONOTONIC);
+
+	switch (e->type) {
+	case SIM_EVENT_TIMER:
+		timer = e->u.timer.timer;
+
+		if (!timer->used || !timer->armed || (timer->gen != e->u.timer.gen))
+			break;
+
+		if (timer->period) {
+			timer->expiration += timer->period;
+			sim_event_add_timer(timer);
+		} else {
+			timer->armed = false;
+		}
+
+		timer->t->func(timer->t, 1);
+		break;
+
+	case SIM_EVENT_FRAME:
+		desc = e->u.frame.desc;
+		rx = e->node->port[e->u.frame.port].rx;
+
+		if (!rx || !rx->func) {
+			free(desc);
+			break;
+		}
+
+		desc->ts64 = sim_phc_time(e->node, sim.now);
+		desc->ts = (u32)desc->ts64;
+
+		rx->func(rx, desc);
+		break;
+
+	case SIM_EVENT_TX_TS:
+		if (e->u.tx_ts.tx->func_tx_ts)
+			e->u.tx_ts.tx->func_tx_ts(e->u.tx_ts.tx, e->u.tx_ts.ts, e->u.tx_ts.priv);
+		break;
+	}
+
+	sim_current = NULL;
+}
+
+/** Run the simulation.
+ * \return	0 on success, negative value on error
+ * \param until		simulated time at which the run stops, in ns
+ * \param tick		optional function called periodically, between events (e.g. to sample clocks)
+ * \param tick_period	tick function period, in ns
+ * \param tick_data	tick function argument
+ */
+int sim_run(u64 until, void (*tick)(void *), u64 tick_period, void *tick_data)
+{
+	struct sim_event e;
+	u64 next_tick = sim.now + tick_period;
+
+	while (sim.heap_len && (sim.heap[0].time <= until)) {
+		while (tick && (next_tick <= sim.heap[0].time)) {
+			sim.now = next_tick;
+			tick(tick_data);
+			next_tick += tick_period;
+		}
+
+		sim_event_pop(&e);
+
+		sim.now = e.time;
+
+		sim_event_process(&e);
+	}
+
+	while (tick && (next_tick <= until)) {
+		sim.now = next_tick;
+		tick(tick_data);
+		next_tick += tick_period;
+	}
+
+	sim.now = until;
+
+	return 0;
+}
+
+u64 sim_time(void)
+{
+	return sim.now;
+}
+
+/** Deterministic pseudo random generator (xorshift64*)
+ * \return	32 bit random value
+ */
+u32 sim_random(void)
+{
+	sim.random_state ^= sim.random_state >> 12;
+	sim.random_state ^= sim.random_state << 25;
+	sim.random_state ^= sim.random_state >> 27;
+
+	return (u32)((sim.random_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/*
+ * Virtual clocks
+ */
+
+static s64 sim_scale(s64 delta, s64 ppb)
+{
+	return delta + (s64)(((__int128)delta * ppb) / NSECS_PER_SEC);
+}
+
+static s64 sim_unscale(s64 delta, s64 ppb)
+{
+	return (s64)(((__int128)delta * NSECS_PER_SEC) / (NSECS_PER_SEC + ppb));
+}
+
+u64 sim_phc_time(struct sim_node *node, u64 t)
+{
+	struct sim_phc *phc = &node->phc;
+
+	return phc->base_value + sim_scale((s64)(t - phc->base_time), phc->drift_ppb);
+}
+
+static u64 sim_phc_to_time(struct sim_node *node, u64 phc_value)
+{
+	struct sim_phc *phc = &node->phc;
+
+	return phc->base_time + sim_unscale((s64)(phc_value - phc->base_value), phc->drift_ppb);
+}
+
+static u64 sim_sw_clock_from_phc(struct sim_sw_clock *clk, u64 phc_value)
+{
+	return clk->base_value + sim_scale((s64)(phc_value - clk->base_phc), clk->ppb);
+}
+
+static u64 sim_sw_clock_to_phc(struct sim_sw_clock *clk, u64 value)
+{
+	return clk->base_phc + sim_unscale((s64)(value - clk->base_value), clk->ppb);
+}
+
+u64 sim_gptp_time(struct sim_node *node, unsigned int domain, u64 t)
+{
+	return sim_sw_clock_from_phc(&node->gptp_clock[domain], sim_phc_time(node, t));
+}
+
+/** Frequency of a node gPTP clock, relative to simulated time
+ * \return	clock rate
+ * \param node	simulated node
+ * \param domain	gPTP domain index
+ */
+double sim_gptp_rate(struct sim_node *node, unsigned int domain)
+{
+	return (1.0 + node->phc.drift_ppb / 1.0e9) * (1.0 + node->gptp_clock[domain].ppb / 1.0e9);
+}
+
+typedef enum {
+	SIM_CLOCK_MONOTONIC,
+	SIM_CLOCK_PHC,
+	SIM_CLOCK_GPTP,
+	SIM_CLOCK_INVALID,
+} sim_clock_type_t;
+
+static sim_clock_type_t sim_clock_type(os_clock_id_t id, unsigned int *domain)
+{
+	switch (id) {
+	case OS_CLOCK_SYSTEM_MONOTONIC:
+	case OS_CLOCK_SYSTEM_MONOTONIC_COARSE:
+	case OS_CLOCK_SYSTEM_MONOTONIC_1:
+		return SIM_CLOCK_MONOTONIC;
+
+	case OS_CLOCK_LOCAL_EP_0:
+	case OS_CLOCK_LOCAL_EP_1:
+	case OS_CLOCK_LOCAL_BR_0:
+		return SIM_CLOCK_PHC;
+
+	case OS_CLOCK_GPTP_EP_0_0:
+	case OS_CLOCK_GPTP_EP_1_0:
+	case OS_CLOCK_GPTP_BR_0_0:
+		*domain = 0;
+		return SIM_CLOCK_GPTP;
+
+	case OS_CLOCK_GPTP_EP_0_1:
+	case OS_CLOCK_GPTP_EP_1_1:
+	case OS_CLOCK_GPTP_BR_0_1:
+		*domain = 1;
+		return SIM_CLOCK_GPTP;
+
+	default:
+		return SIM_CLOCK_INVALID;
+	}
+}
+
+static int sim_clock_to_phc(struct sim_node *node, os_clock_id_t id, u64 ns, u64 *phc_value)
+{
+	unsigned int domain = 0;
+
+	switch (sim_clock_type(id, &domain)) {
+	case SIM_CLOCK_MONOTONIC:
+		*phc_value = sim_phc_time(node, ns);
+		break;
+
+	case SIM_CLOCK_PHC:
+		*phc_value = ns;
+		break;
+
+	case SIM_CLOCK_GPTP:
+		*phc_value = sim_sw_clock_to_phc(&node->gptp_clock[domain], ns);
+		break;
+
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+static int sim_clock_from_phc(struct sim_node *node, os_clock_id_t id, u64 phc_value, u64 *ns)
+{
+	unsigned int domain = 0;
+
+	switch (sim_clock_type(id, &domain)) {
+	case SIM_CLOCK_MONOTONIC:
+		*ns = sim_phc_to_time(node, phc_value);
+		break;
+
+	case SIM_CLOCK_PHC:
+		*ns = phc_value;
+		break;
+
+	case SIM_CLOCK_GPTP:
+		*ns = sim_sw_clock_from_phc(&node->gptp_clock[domain], phc_value);
+		break;
+
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	unsigned int domain = 0;
+
+	if (!sim_current)
+		return -1;
+
+	switch (sim_clock_type(id, &domain)) {
+	case SIM_CLOCK_MONOTONIC:
+		*ns = sim.now;
+		break;
+
+	case SIM_CLOCK_PHC:
+		*ns = sim_phc_time(sim_current, sim.now);
+		break;
+
+	case SIM_CLOCK_GPTP:
+		*ns = sim_gptp_time(sim_current, domain, sim.now);
+		break;
+
+	default:
+		return -1;
+	}
+
+	return 0;
+}
+
+int os_clock_gettime32(os_clock_id_t id, u32 *ns)
+{
+	u64 ns64;
+
+	if (os_clock_gettime64(id, &ns64) < 0)
+		return -1;
+
+	*ns = (u32)ns64;
+
+	return 0;
+}
+
+int os_clock_convert(os_clock_id_t id_src, u64 ns_src, os_clock_id_t id_dst, u64 *ns_dst)
+{
+	u64 phc_value;
+
+	if (!sim_current)
+		return -1;
+
+	if (sim_clock_to_phc(sim_current, id_src, ns_src, &phc_value) < 0)
+		return -1;
+
+	return sim_clock_from_phc(sim_current, id_dst, phc_value, ns_dst);
+}
+
+/* Hardware clocks are free running, only the gPTP clocks can be adjusted */
+int os_clock_setfreq(os_clock_id_t id, s32 ppb)
+{
+	struct sim_sw_clock *clk;
+	unsigned int domain = 0;
+	u64 phc_value;
+
+	if (!sim_current || (sim_clock_type(id, &domain) != SIM_CLOCK_GPTP))
+		return -1;
+
+	clk = &sim_current->gptp_clock[domain];
+	phc_value = sim_phc_time(sim_current, sim.now);
+
+	clk->base_value = sim_sw_clock_from_phc(clk, phc_value);
+	clk->base_phc = phc_value;
+	clk->ppb = ppb;
+
+	return 0;
+}
+
+int os_clock_setoffset(os_clock_id_t id, s64 offset)
+{
+	unsigned int domain = 0;
+
+	if (!sim_current || (sim_clock_type(id, &domain) != SIM_CLOCK_GPTP))
+		return -1;
+
+	sim_current->gptp_clock[domain].base_value += offset;
+
+	return 0;
+}
+
+unsigned int os_clock_adjust_mode(os_clock_id_t id)
+{
+	return 0;
+}
+
+os_clock_id_t logical_port_to_local_clock(unsigned int port_id)
+{
+	return OS_CLOCK_LOCAL_EP_0;
+}
+
+os_clock_id_t logical_port_to_gptp_clock(unsigned int port_id, unsigned int domain)
+{
+	return (domain ? OS_CLOCK_GPTP_EP_0_1 : OS_CLOCK_GPTP_EP_0_0);
+}
+
+/*
+ * Virtual timers
+ * All timers run on simulated time, whatever the clock they were created on.
+ */
+
+static struct sim_timer *sim_timer_get(struct os_timer *t)
+{
+	if ((t->fd < 0) || (t->fd >= SIM_MAX_TIMERS))
+		return NULL;
+
+	return &sim.timer[t->fd];
+}
+
+int os_timer_create(struct os_timer *t, os_clock_id_t id, unsigned int flags, void (*func)(struct os_timer *t, int count), unsigned long priv)
+{
+	struct sim_timer *timer;
+	int i;
+
+	if (flags & (OS_TIMER_FLAGS_PPS | OS_TIMER_FLAGS_RECOVERY))
+		goto err;
+
+	for (i = 0; i < SIM_MAX_TIMERS; i++) {
+		timer = &sim.timer[i];
+
+		if (!timer->used)
+			goto found;
+	}
+
+err:
+	return -1;
+
+found:
+	memset(t, 0, sizeof(*t));
+	t->fd = i;
+	t->func = func;
+
+	timer->t = t;
+	timer->node = (struct sim_node *)priv;
+	timer->used = true;
+	timer->armed = false;
+	timer->gen++;
+
+	return 0;
+}
+
+int os_timer_start(struct os_timer *t, u64 value, u64 interval_p, u64 interval_q, unsigned int flags)
+{
+	struct sim_timer *timer = sim_timer_get(t);
+
+	if (!timer || !timer->used)
+		return -1;
+
+	timer->period = interval_p ? (interval_p / (interval_q ? interval_q : 1)) : 0;
+
+	if (flags & OS_TIMER_FLAGS_ABSOLUTE)
+		timer->expiration = value;
+	else
+		timer->expiration = sim.now + value;
+
+	if (timer->period)
+		timer->expiration += timer->period;
+
+	if (timer->expiration < sim.now)
+		timer->expiration = sim.now;
+
+	timer->armed = true;
+	timer->gen++;
+
+	return sim_event_add_timer(timer);
+}
+
+void os_timer_stop(struct os_timer *t)
+{
+	struct sim_timer *timer = sim_timer_get(t);
+
+	if (!timer)
+		return;
+
+	timer->armed = false;
+	timer->gen++;
+}
+
+void os_timer_destroy(struct os_timer *t)
+{
+	struct sim_timer *timer = sim_timer_get(t);
+
+	if (!timer)
+		return;
+
+	timer->used = false;
+	timer->armed = false;
+	timer->gen++;
+
+	t->fd = -1;
+}
+
+void os_timer_process(struct os_timer *t)
+{
+}
+
+/*
+ * Topology
+ */
+
+/** Add a simulated node.
+ * \return	pointer to the new node, NULL on error
+ * \param drift_ppb	hardware clock frequency error, in parts per billion
+ * \param initial_time	hardware clock value at simulated time 0
+ */
+struct sim_node *sim_node_add(s64 drift_ppb, u64 initial_time)
+{
+	struct sim_node *node;
+	int i;
+
+	if (sim.node_n >= SIM_MAX_NODES)
+		return NULL;
+
+	node = &sim.node[sim.node_n];
+	memset(node, 0, sizeof(*node));
+
+	node->index = sim.node_n;
+
+	node->phc.base_time = sim.now;
+	node->phc.base_value = initial_time;
+	node->phc.drift_ppb = drift_ppb;
+
+	for (i = 0; i < SIM_MAX_DOMAINS; i++) {
+		node->gptp_clock[i].base_phc = initial_time;
+		node->gptp_clock[i].base_value = initial_time;
+	}
+
+	sim.node_n++;
+
+	return node;
+}
+
+/** Connect two node ports with a point to point link.
+ * \return	pointer to the new link, NULL on error
+ * \param a		first node
+ * \param port_a	first node port (logical port)
+ * \param b		second node
+ * \param port_b	second node port (logical port)
+ * \param params	link characteristics
+ */
+struct sim_link *sim_link_add(struct sim_node *a, unsigned int port_a, struct sim_node *b, unsigned int port_b, struct sim_link_params *params)
+{
+	struct sim_link *link;
+
+	if ((sim.link_n >= SIM_MAX_LINKS) || (port_a >= CFG_MAX_NUM_PORT) || (port_b >= CFG_MAX_NUM_PORT))
+		return NULL;
+
+	if (a->port[port_a].link || b->port[port_b].link)
+		return NULL;
+
+	link = &sim.link[sim.link_n++];
+	memset(link, 0, sizeof(*link));
+
+	link->node[0] = a;
+	link->port[0] = port_a;
+	link->node[1] = b;
+	link->port[1] = port_b;
+	link->params = *params;
+
+	a->port[port_a].link = link;
+	a->port[port_a].dir = 0;
+	b->port[port_b].link = link;
+	b->port[port_b].dir = 1;
+
+	if (a->port_max <= port_a)
+		a->port_max = port_a + 1;
+
+	if (b->port_max <= port_b)
+		b->port_max = port_b + 1;
+
+	return link;
+}
+
+void sim_init(unsigned int seed)
+{
+	memset(&sim, 0, sizeof(sim));
+
+	sim.random_state = ((u64)seed << 32) | 0x9e3779b9;
+
+	/* stack code using os_random() must also be reproducible */
+	srandom(seed);
+}
+
+void sim_exit(void)
+{
+	struct sim_event e;
+
+	while (sim.heap_len) {
+		sim_event_pop(&e);
+
+		if (e.type == SIM_EVENT_FRAME)
+			free(e.u.frame.desc);
+	}
+
+	free(sim.heap);
+	sim.heap = NULL;
+	sim.heap_size = 0;
+}
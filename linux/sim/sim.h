@@ -0,0 +1,109 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Discrete time network simulator
+ @details Virtual clocks, timers and links used to run several stack instances
+ in a single process, against a simulated time base.
+*/
+
+#ifndef _LINUX_SIM_H_
+#define _LINUX_SIM_H_
+
+#include "os/sys_types.h"
+#include "os/clock.h"
+#include "os/timer.h"
+#include "os/net.h"
+
+#define SIM_MAX_NODES		16
+#define SIM_MAX_LINKS		(SIM_MAX_NODES * CFG_MAX_NUM_PORT)
+#define SIM_MAX_TIMERS		1024
+#define SIM_MAX_DOMAINS		2
+
+/* Delay between frame transmission and the matching tx timestamp callback */
+#define SIM_TX_TS_DELAY		10000
+
+/** Free running hardware clock of a node.
+ * value(t) = base_value + (t - base_time) * (1 + drift_ppb / 10^9), with t the simulated time
+ */
+struct sim_phc {
+	u64 base_time;
+	u64 base_value;
+	s64 drift_ppb;	/* oscillator error, fixed */
+};
+
+/** Software clock derived from the node hardware clock, similar to the Linux stack gPTP clocks.
+ * value(phc) = base_value + (phc - base_phc) * (1 + ppb / 10^9)
+ */
+struct sim_sw_clock {
+	u64 base_phc;
+	u64 base_value;
+	s64 ppb;
+};
+
+struct sim_node;
+
+struct sim_port {
+	struct net_rx *rx;
+	struct net_tx *tx;
+
+	struct sim_link *link;
+	unsigned int dir;	/* link direction used when transmitting from this port */
+};
+
+struct sim_node {
+	unsigned int index;
+	unsigned int port_max;
+
+	struct sim_phc phc;
+	struct sim_sw_clock gptp_clock[SIM_MAX_DOMAINS];
+
+	struct sim_port port[CFG_MAX_NUM_PORT];
+};
+
+struct sim_link_params {
+	u64 delay;		/* mean one way propagation delay, in ns */
+	s64 asymmetry;		/* added to one direction, removed from the other, in ns */
+	u64 jitter;		/* uniformly distributed extra delay, in ns */
+	unsigned int loss_ppm;	/* frame loss probability, in parts per million */
+	unsigned int congestion_ppm;	/* probability of a frame being queued behind other traffic, in parts per million */
+	u64 congestion_delay;		/* maximum queuing delay, in ns */
+};
+
+struct sim_link {
+	struct sim_node *node[2];
+	unsigned int port[2];
+
+	struct sim_link_params params;
+
+	u64 last_arrival[2];	/* links do not reorder frames */
+
+	u64 tx_frames[2];
+	u64 lost_frames[2];
+};
+
+extern struct sim_node *sim_current;
+
+void sim_init(unsigned int seed);
+void sim_exit(void);
+
+struct sim_node *sim_node_add(s64 drift_ppb, u64 initial_time);
+struct sim_link *sim_link_add(struct sim_node *a, unsigned int port_a, struct sim_node *b, unsigned int port_b, struct sim_link_params *params);
+
+u64 sim_time(void);
+int sim_run(u64 until, void (*tick)(void *), u64 tick_period, void *tick_data);
+
+u64 sim_phc_time(struct sim_node *node, u64 t);
+u64 sim_gptp_time(struct sim_node *node, unsigned int domain, u64 t);
+double sim_gptp_rate(struct sim_node *node, unsigned int domain);
+
+u32 sim_random(void);
+
+int sim_event_add_frame(struct sim_node *dst, unsigned int port, struct net_rx_desc *desc, u64 time);
+int sim_event_add_tx_ts(struct net_tx *tx, u64 ts, unsigned int priv, u64 time);
+
+#endif /* _LINUX_SIM_H_ */
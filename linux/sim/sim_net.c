@@ -0,0 +1,311 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Discrete time network simulator, network and IPC services
+ @details Frames are copied from the transmitting port to the link peer, with
+ the link delay, jitter, asymmetry and loss applied. Hardware timestamps are
+ taken from the node hardware clocks at simulated transmit/receive time.
+ IPC channels are not connected to anything.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/log.h"
+#include "common/net.h"
+#include "common/ipc.h"
+
+#include "sim.h"
+
+static void sim_local_addr(struct sim_node *node, unsigned int port_id, unsigned char *addr)
+{
+	addr[0] = 0x00;
+	addr[1] = 0x04;
+	addr[2] = 0x9f;
+	addr[3] = 0x5e;
+	addr[4] = node->index;
+	addr[5] = port_id;
+}
+
+int net_get_local_addr(unsigned int port_id, unsigned char *addr)
+{
+	if (!sim_current || (port_id >= CFG_MAX_NUM_PORT))
+		return -1;
+
+	sim_local_addr(sim_current, port_id, addr);
+
+	return 0;
+}
+
+int net_rx_init(struct net_rx *rx, struct net_address *addr, void (*func)(struct net_rx *, struct net_rx_desc *), unsigned long priv)
+{
+	struct sim_node *node = (struct sim_node *)priv;
+
+	if (!node || (addr->port >= CFG_MAX_NUM_PORT))
+		return -1;
+
+	memset(rx, 0, sizeof(*rx));
+	rx->fd = -1;
+	rx->port_id = addr->port;
+	rx->func = func;
+	rx->clock_domain = OS_CLOCK_LOCAL_EP_0;
+	rx->priv = node;
+
+	node->port[addr->port].rx = rx;
+
+	return 0;
+}
+
+void net_rx_exit(struct net_rx *rx)
+{
+	struct sim_node *node = rx->priv;
+
+	if (node && (node->port[rx->port_id].rx == rx))
+		node->port[rx->port_id].rx = NULL;
+}
+
+int net_tx_init(struct net_tx *tx, struct net_address *addr)
+{
+	struct sim_node *node = sim_current;
+
+	if (!node || (addr->port >= CFG_MAX_NUM_PORT))
+		return -1;
+
+	memset(tx, 0, sizeof(*tx));
+	tx->fd = -1;
+	tx->port_id = addr->port;
+	tx->clock_domain = OS_CLOCK_LOCAL_EP_0;
+	tx->priv = node;
+
+	sim_local_addr(node, addr->port, tx->eth_src);
+
+	node->port[addr->port].tx = tx;
+
+	return 0;
+}
+
+int net_tx_ts_init(struct net_tx *tx, struct net_address *addr, void (*func)(struct net_tx *, uint64_t, unsigned int), unsigned long priv)
+{
+	struct sim_node *node = (struct sim_node *)priv;
+
+	if (!node || (addr->port >= CFG_MAX_NUM_PORT))
+		return -1;
+
+	memset(tx, 0, sizeof(*tx));
+	tx->fd = -1;
+	tx->port_id = addr->port;
+	tx->func_tx_ts = func;
+	tx->clock_domain = OS_CLOCK_LOCAL_EP_0;
+	tx->priv = node;
+
+	sim_local_addr(node, addr->port, tx->eth_src);
+
+	node->port[addr->port].tx = tx;
+
+	return 0;
+}
+
+void net_tx_exit(struct net_tx *tx)
+{
+	struct sim_node *node = tx->priv;
+
+	if (node && (node->port[tx->port_id].tx == tx))
+		node->port[tx->port_id].tx = NULL;
+}
+
+int net_tx_ts_exit(struct net_tx *tx)
+{
+	net_tx_exit(tx);
+
+	return 0;
+}
+
+int net_add_multi(struct net_rx *rx, unsigned int port_id, const unsigned char *hw_addr)
+{
+	return 0;
+}
+
+int net_del_multi(struct net_rx *rx, unsigned int port_id, const unsigned char *hw_addr)
+{
+	return 0;
+}
+
+struct net_tx_desc *net_tx_alloc(unsigned int size)
+{
+	struct net_tx_desc *desc;
+
+	if (size > DEFAULT_NET_DATA_SIZE)
+		return NULL;
+
+	desc = malloc(NET_DATA_OFFSET + DEFAULT_NET_DATA_SIZE);
+	if (!desc)
+		return NULL;
+
+	memset(desc, 0, sizeof(*desc));
+	desc->l2_offset = NET_DATA_OFFSET;
+
+	return desc;
+}
+
+void net_tx_free(struct net_tx_desc *desc)
+{
+	free(desc);
+}
+
+void net_rx_free(struct net_rx_desc *desc)
+{
+	free(desc);
+}
+
+static u64 sim_link_arrival(struct sim_link *link, unsigned int dir, u64 now)
+{
+	struct sim_link_params *params = &link->params;
+	s64 delay = params->delay;
+
+	if (dir)
+		delay -= params->asymmetry / 2;
+	else
+		delay += params->asymmetry / 2;
+
+	if (params->jitter)
+		delay += sim_random() % (params->jitter + 1);
+
+	/* Heavy tail of the delay distribution, e.g. a switch port loaded with other traffic */
+	if (params->congestion_ppm && ((sim_random() % 1000000) < params->congestion_ppm))
+		delay += params->congestion_delay / 2 + sim_random() % (params->congestion_delay / 2 + 1);
+
+	if (delay < 0)
+		delay = 0;
+
+	/* Frames never overtake each other on a link */
+	if ((now + delay) <= link->last_arrival[dir])
+		return link->last_arrival[dir] + 1;
+
+	return now + delay;
+}
+
+int net_tx(struct net_tx *tx, struct net_tx_desc *desc)
+{
+	struct sim_node *node = tx->priv;
+	struct sim_port *port = &node->port[tx->port_id];
+	struct sim_link *link = port->link;
+	struct net_rx_desc *rx_desc;
+	struct eth_hdr *eth;
+	unsigned int dir = port->dir;
+	u64 now = sim_time();
+
+	if (!link)
+		goto drop;
+
+	eth = NET_DATA_START(desc);
+	memcpy(eth->src, tx->eth_src, 6);
+
+	/* The frame leaves the port now, the timestamp is reported asynchronously as on real hardware */
+	if (desc->flags & NET_TX_FLAGS_HW_TS)
+		sim_event_add_tx_ts(tx, sim_phc_time(node, now), desc->priv, now + SIM_TX_TS_DELAY);
+
+	link->tx_frames[dir]++;
+
+	if (link->params.loss_ppm && ((sim_random() % 1000000) < link->params.loss_ppm)) {
+		link->lost_frames[dir]++;
+		goto drop;
+	}
+
+	rx_desc = malloc(NET_DATA_OFFSET + DEFAULT_NET_DATA_SIZE);
+	if (!rx_desc)
+		goto drop;
+
+	memset(rx_desc, 0, sizeof(*rx_desc));
+	rx_desc->l2_offset = NET_DATA_OFFSET;
+	rx_desc->len = desc->len;
+	rx_desc->port = link->port[!dir];
+
+	memcpy(NET_DATA_START(rx_desc), NET_DATA_START(desc), desc->len);
+
+	/* Same parsing as the Linux standard network service (no VLAN on gPTP links) */
+	eth = NET_DATA_START(rx_desc);
+	rx_desc->ethertype = ntohs(eth->type);
+	rx_desc->l3_offset = rx_desc->l2_offset + sizeof(struct eth_hdr);
+
+	link->last_arrival[dir] = sim_link_arrival(link, dir, now);
+
+	if (sim_event_add_frame(link->node[!dir], link->port[!dir], rx_desc, link->last_arrival[dir]) < 0) {
+		free(rx_desc);
+		goto drop;
+	}
+
+drop:
+	free(desc);
+
+	return 0;
+}
+
+int net_port_status(struct net_tx *tx, unsigned int port_id, bool *up, bool *point_to_point, unsigned int *rate)
+{
+	struct sim_node *node = tx->priv;
+
+	if (!node || (port_id >= CFG_MAX_NUM_PORT))
+		return -1;
+
+	*up = (node->port[port_id].link != NULL);
+	*point_to_point = true;
+	*rate = 1000;
+
+	return 0;
+}
+
+/*
+ * IPC, not connected
+ */
+
+struct ipc_desc *ipc_alloc(struct ipc_tx const *tx, unsigned int size)
+{
+	return malloc(sizeof(struct ipc_desc));
+}
+
+void ipc_free(void const *ipc, struct ipc_desc *desc)
+{
+	free(desc);
+}
+
+int ipc_rx_init(struct ipc_rx *rx, ipc_id_t id, void (*func)(struct ipc_rx const *, struct ipc_desc *), unsigned long priv)
+{
+	memset(rx, 0, sizeof(*rx));
+	rx->fd = -1;
+	rx->func = func;
+
+	return 0;
+}
+
+void ipc_rx_exit(struct ipc_rx *rx)
+{
+}
+
+int ipc_tx_init(struct ipc_tx *tx, ipc_id_t id)
+{
+	memset(tx, 0, sizeof(*tx));
+	tx->fd = -1;
+
+	return 0;
+}
+
+void ipc_tx_exit(struct ipc_tx *tx)
+{
+}
+
+int ipc_tx(struct ipc_tx const *tx, struct ipc_desc *desc)
+{
+	free(desc);
+
+	return 0;
+}
+
+int ipc_tx_connect(struct ipc_tx *tx, struct ipc_rx *rx)
+{
+	return 0;
+}
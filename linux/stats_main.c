@@ -0,0 +1,451 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Live statistics reader
+ @details Samples the statistics regions exported by the stack processes (see linux/stats_shm.h), without any IPC
+ with the stack, and prints the counters and histograms of all the sections, as text or in Prometheus text exposition
+ format (e.g. for a node exporter textfile collector).
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <glob.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "genavb/helpers.h"
+
+#include "common/types.h"
+#include "common/stats_export.h"
+#include "os/clock.h"
+
+#include "stats_shm.h"
+
+#define STATS_DEFAULT_INTERVAL	1000	/* ms */
+#define STATS_DEFAULT_COUNT	1
+
+#define STATS_MAX_REGIONS	16
+
+enum {
+	FORMAT_TEXT,
+	FORMAT_PROMETHEUS,
+};
+
+static const struct {
+	const char *name;
+	const char *quantile;
+	u32 ppm;
+} percentiles[] = {
+	{ "p50", "0.5", HDR_HIST_PPM(50) },
+	{ "p90", "0.9", HDR_HIST_PPM(90) },
+	{ "p99", "0.99", HDR_HIST_PPM(99) },
+	{ "p99.9", "0.999", HDR_HIST_PPM(99.9) },
+	{ "p99.99", "0.9999", HDR_HIST_PPM(99.99) },
+};
+
+#define STATS_PERCENTILES	(sizeof(percentiles) / sizeof(percentiles[0]))
+
+static struct stats_reader {
+	char *path[STATS_MAX_REGIONS];
+	unsigned int n_regions;
+	unsigned int format;
+	const char *prefix;	/* section name prefix filter */
+} reader;
+
+static void print_usage(void)
+{
+	printf("\nUsage:\n genavb-stats [options] [region ...]\n");
+	printf("\nRegions are region names (e.g. avb, tsn_br, tsn_ep0) or file paths (default: all %s* files)\n",
+		STATS_SHM_PATH_PREFIX);
+	printf("\nOptions:\n"
+		"\t-i <ms>                 sampling interval (default: %u)\n"
+		"\t-n <count>              number of samples, 0 for no limit (default: %u)\n"
+		"\t-f <format>             output format: text (default), prometheus\n"
+		"\t-s <prefix>             only print the sections with a name starting with prefix\n"
+		"\t-h                      print this help text\n",
+		STATS_DEFAULT_INTERVAL, STATS_DEFAULT_COUNT);
+}
+
+static u64 monotonic_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &now);
+
+	return (u64)now.tv_sec * NSECS_PER_SEC + now.tv_nsec;
+}
+
+/* Log time base */
+int os_clock_gettime64(os_clock_id_t id, u64 *ns)
+{
+	*ns = monotonic_ns();
+
+	return 0;
+}
+
+/* Region name, from the file path */
+static const char *region_name(const char *path)
+{
+	if (!strncmp(path, STATS_SHM_PATH_PREFIX, strlen(STATS_SHM_PATH_PREFIX)))
+		return path + strlen(STATS_SHM_PATH_PREFIX);
+
+	return path;
+}
+
+static int region_add(const char *arg)
+{
+	char path[STATS_SHM_PATH_MAX];
+
+	if (reader.n_regions >= STATS_MAX_REGIONS)
+		return -1;
+
+	if (strchr(arg, '/'))
+		reader.path[reader.n_regions] = strdup(arg);
+	else {
+		snprintf(path, STATS_SHM_PATH_MAX, STATS_SHM_PATH, arg);
+		reader.path[reader.n_regions] = strdup(path);
+	}
+
+	if (!reader.path[reader.n_regions])
+		return -1;
+
+	reader.n_regions++;
+
+	return 0;
+}
+
+static int region_find(void)
+{
+	glob_t g;
+	unsigned int i;
+	int rc;
+
+	rc = glob(STATS_SHM_PATH_PREFIX "*", 0, NULL, &g);
+	if (rc == GLOB_NOMATCH) {
+		printf("no statistics region found (stack not running?)\n");
+		return -1;
+	} else if (rc) {
+		return -1;
+	}
+
+	for (i = 0; i < g.gl_pathc; i++)
+		if (region_add(g.gl_pathv[i]) < 0)
+			break;
+
+	globfree(&g);
+
+	return 0;
+}
+
+/* Prometheus metric name characters: [a-zA-Z0-9_:] */
+static void print_metric(const char *section, const char *name)
+{
+	const char *c;
+
+	printf("genavb_");
+
+	for (c = section; *c; c++)
+		putchar(((*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9')) ? *c : '_');
+
+	putchar('_');
+
+	for (c = name; *c; c++)
+		putchar(((*c >= 'a' && *c <= 'z') || (*c >= 'A' && *c <= 'Z') || (*c >= '0' && *c <= '9')) ? *c : '_');
+}
+
+static void print_labels(const char *region, const struct stats_export_id *id, const char *quantile)
+{
+	const struct stats_export_label *l;
+	unsigned int i;
+
+	printf("{region=\"%s\"", region);
+
+	for (i = 0; i < id->n_labels; i++) {
+		l = &id->label[i];
+
+		if (l->flags & STATS_EXPORT_LABEL_HEX)
+			printf(",%.*s=\"0x%016" PRIx64 "\"", STATS_EXPORT_LABEL_NAME_MAX, l->name, l->value);
+		else
+			printf(",%.*s=\"%" PRIu64 "\"", STATS_EXPORT_LABEL_NAME_MAX, l->name, l->value);
+	}
+
+	if (quantile)
+		printf(",quantile=\"%s\"", quantile);
+
+	printf("}");
+}
+
+static void print_section_prometheus(const char *region, const struct stats_export_section *s, const struct stats_export_id *id,
+				     const s64 *counters, const struct hdr_hist *hists)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < s->n_counters; i++) {
+		print_metric(id->name, stats_export_counter_name(s, i));
+		print_labels(region, id, NULL);
+		printf(" %" PRId64 "\n", counters[i]);
+	}
+
+	/* Histograms as summaries, plus min/max gauges */
+	for (i = 0; i < s->n_hists; i++) {
+		for (j = 0; j < STATS_PERCENTILES; j++) {
+			print_metric(id->name, stats_export_hist_name(s, i));
+			print_labels(region, id, percentiles[j].quantile);
+			printf(" %u\n", hdr_hist_percentile(&hists[i], percentiles[j].ppm));
+		}
+
+		print_metric(id->name, stats_export_hist_name(s, i));
+		printf("_count");
+		print_labels(region, id, NULL);
+		printf(" %u\n", hists[i].count);
+
+		print_metric(id->name, stats_export_hist_name(s, i));
+		printf("_min");
+		print_labels(region, id, NULL);
+		printf(" %u\n", hists[i].count ? hists[i].min : 0);
+
+		print_metric(id->name, stats_export_hist_name(s, i));
+		printf("_max");
+		print_labels(region, id, NULL);
+		printf(" %u\n", hists[i].max);
+	}
+}
+
+static void print_section_text(const struct stats_export_section *s, const struct stats_export_id *id, const s64 *counters,
+			       const struct hdr_hist *hists, u64 time, u64 now)
+{
+	const struct stats_export_label *l;
+	unsigned int i, j;
+
+	printf("%s", id->name);
+
+	for (i = 0; i < id->n_labels; i++) {
+		l = &id->label[i];
+
+		if (l->flags & STATS_EXPORT_LABEL_HEX)
+			printf(" %.*s=0x%016" PRIx64, STATS_EXPORT_LABEL_NAME_MAX, l->name, l->value);
+		else
+			printf(" %.*s=%" PRIu64, STATS_EXPORT_LABEL_NAME_MAX, l->name, l->value);
+	}
+
+	printf(" (updated %" PRIu64 " ms ago)\n", (now > time) ? (now - time) / NSECS_PER_MS : 0);
+
+	for (i = 0; i < s->n_counters; i++)
+		printf("  %-32s %" PRId64 "\n", stats_export_counter_name(s, i), counters[i]);
+
+	for (i = 0; i < s->n_hists; i++) {
+		printf("  %-32s count %u", stats_export_hist_name(s, i), hists[i].count);
+
+		if (hists[i].count) {
+			printf(" min %u", hists[i].min);
+
+			for (j = 0; j < STATS_PERCENTILES; j++)
+				printf(" %s %u", percentiles[j].name, hdr_hist_percentile(&hists[i], percentiles[j].ppm));
+
+			printf(" max %u", hists[i].max);
+		}
+
+		printf("\n");
+	}
+}
+
+static int section_sample(const char *region, const struct stats_export_section *s, u64 now)
+{
+	struct stats_export_id id;
+	struct hdr_hist *hists;
+	s64 *counters;
+	u64 time;
+	int rc = -1;
+
+	counters = malloc(s->n_counters * sizeof(s64) + 1);
+	if (!counters)
+		goto err_counters;
+
+	hists = malloc(s->n_hists * sizeof(struct hdr_hist) + 1);
+	if (!hists)
+		goto err_hists;
+
+	/* Section freed, or continuously updated */
+	if (stats_export_read(s, &id, counters, hists, &time) < 0)
+		goto err_read;
+
+	id.name[STATS_EXPORT_NAME_MAX - 1] = '\0';
+	if (id.n_labels > STATS_EXPORT_LABEL_MAX)
+		id.n_labels = STATS_EXPORT_LABEL_MAX;
+
+	if (reader.prefix && strncmp(id.name, reader.prefix, strlen(reader.prefix)))
+		goto out;
+
+	if (reader.format == FORMAT_PROMETHEUS)
+		print_section_prometheus(region, s, &id, counters, hists);
+	else
+		print_section_text(s, &id, counters, hists, time, now);
+
+out:
+	rc = 0;
+
+err_read:
+	free(hists);
+
+err_hists:
+	free(counters);
+
+err_counters:
+	return rc;
+}
+
+static int region_sample(const char *path)
+{
+	const struct stats_export_header *header;
+	const struct stats_export_section *s = NULL;
+	const char *region = region_name(path);
+	struct stat st;
+	void *map;
+	u64 now;
+	int fd, rc = -1;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		printf("open(%s) failed: %s\n", path, strerror(errno));
+		goto err_open;
+	}
+
+	if ((fstat(fd, &st) < 0) || (st.st_size < (off_t)sizeof(*header))) {
+		printf("%s: invalid statistics region\n", path);
+		goto err_stat;
+	}
+
+	map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED) {
+		printf("mmap(%s) failed: %s\n", path, strerror(errno));
+		goto err_stat;
+	}
+
+	header = map;
+
+	if ((__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) != STATS_EXPORT_MAGIC)
+	|| (header->version != STATS_EXPORT_VERSION) || (header->hist_buckets != HDR_HIST_BUCKETS)
+	|| (header->size > st.st_size)) {
+		printf("%s: invalid or incompatible statistics region\n", path);
+		goto err_header;
+	}
+
+	now = monotonic_ns();
+
+	if (reader.format == FORMAT_TEXT)
+		printf("# %s\n", region);
+
+	while ((s = stats_export_next(header, s)))
+		section_sample(region, s, now);
+
+	rc = 0;
+
+err_header:
+	munmap(map, st.st_size);
+
+err_stat:
+	close(fd);
+
+err_open:
+	return rc;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned long interval = STATS_DEFAULT_INTERVAL;
+	unsigned long count = STATS_DEFAULT_COUNT;
+	struct timespec next;
+	unsigned long n;
+	unsigned int i;
+	int option;
+	int rc = -1;
+
+	while ((option = getopt(argc, argv, "i:n:f:s:h")) != -1) {
+		switch (option) {
+		case 'i':
+			if ((h_strtoul(&interval, optarg, NULL, 0) < 0) || !interval)
+				goto err_option;
+			break;
+
+		case 'n':
+			if (h_strtoul(&count, optarg, NULL, 0) < 0)
+				goto err_option;
+			break;
+
+		case 'f':
+			if (!strcmp(optarg, "text"))
+				reader.format = FORMAT_TEXT;
+			else if (!strcmp(optarg, "prometheus"))
+				reader.format = FORMAT_PROMETHEUS;
+			else
+				goto err_option;
+			break;
+
+		case 's':
+			reader.prefix = optarg;
+			break;
+
+		case 'h':
+		default:
+			print_usage();
+			return 0;
+		}
+	}
+
+	for (i = optind; i < (unsigned int)argc; i++)
+		if (region_add(argv[i]) < 0)
+			goto exit;
+
+	if (!reader.n_regions && (region_find() < 0))
+		goto exit;
+
+	clock_gettime(CLOCK_MONOTONIC, &next);
+
+	for (n = 0; !count || (n < count); n++) {
+		if (n) {
+			next.tv_sec += interval / 1000;
+			next.tv_nsec += (interval % 1000) * NSECS_PER_MS;
+			if (next.tv_nsec >= NSECS_PER_SEC) {
+				next.tv_nsec -= NSECS_PER_SEC;
+				next.tv_sec++;
+			}
+
+			clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+			if (reader.format == FORMAT_TEXT)
+				printf("\n");
+		}
+
+		for (i = 0; i < reader.n_regions; i++)
+			region_sample(reader.path[i]);
+
+		fflush(stdout);
+	}
+
+	rc = 0;
+
+exit:
+	for (i = 0; i < reader.n_regions; i++)
+		free(reader.path[i]);
+
+	return rc;
+
+err_option:
+	printf("invalid option\n");
+	print_usage();
+	return -1;
+}
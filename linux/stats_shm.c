@@ -0,0 +1,179 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Linux shared memory statistics region
+ @details
+*/
+
+#define _GNU_SOURCE
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/mman.h>
+
+#include "common/log.h"
+#include "common/stats_export.h"
+
+#include "clock.h"
+#include "stats_shm.h"
+
+static void *stats_shm_region;
+static char stats_shm_path[STATS_SHM_PATH_MAX];
+
+/* Cross timestamp calibration of the time pages published by this process (see clock_xts.h) */
+static struct stats_export_section *stats_shm_clock[OS_CLOCK_MAX];
+
+static const char * const stats_shm_clock_counter_names[] = {
+	"Samples",
+	"Errors",
+	"Residuals",
+	"ResidualNs",
+	"ResidualAbsTotalNs",
+	"ResidualAbsMaxNs",
+	"DelayNs",
+	"OscillatorPpb",
+};
+
+#define STATS_SHM_CLOCK_COUNTERS	(sizeof(stats_shm_clock_counter_names) / sizeof(char *))
+
+/** Creates the statistics region of the process. Must be called before the stack threads are started.
+ * A failure only disables the statistics export.
+ * \return	0 on success, -1 on error
+ * \param name	region name (process name and instance)
+ */
+int stats_shm_create(const char *name)
+{
+	void *region;
+	int fd;
+
+	snprintf(stats_shm_path, STATS_SHM_PATH_MAX, STATS_SHM_PATH, name);
+
+	/* New file, readers still mapping the region of a previous instance keep the old one */
+	unlink(stats_shm_path);
+
+	fd = open(stats_shm_path, O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (fd < 0) {
+		os_log(LOG_ERR, "open(%s) failed: %s\n", stats_shm_path, strerror(errno));
+		goto err_open;
+	}
+
+	if (ftruncate(fd, STATS_SHM_SIZE) < 0) {
+		os_log(LOG_ERR, "ftruncate(%s) failed: %s\n", stats_shm_path, strerror(errno));
+		goto err_truncate;
+	}
+
+	region = mmap(NULL, STATS_SHM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (region == MAP_FAILED) {
+		os_log(LOG_ERR, "mmap(%s) failed: %s\n", stats_shm_path, strerror(errno));
+		goto err_mmap;
+	}
+
+	/* Fault in the pages now, not in the stack threads */
+	memset(region, 0, STATS_SHM_SIZE);
+
+	if (stats_export_init(region, STATS_SHM_SIZE) < 0)
+		goto err_init;
+
+	close(fd);
+
+	stats_shm_region = region;
+
+	os_log(LOG_INIT, "statistics region %s\n", stats_shm_path);
+
+	return 0;
+
+err_init:
+	munmap(region, STATS_SHM_SIZE);
+
+err_mmap:
+err_truncate:
+	close(fd);
+	unlink(stats_shm_path);
+
+err_open:
+	return -1;
+}
+
+/** Destroys the statistics region of the process. Must be called once the stack threads have exited.
+ */
+void stats_shm_destroy(void)
+{
+	int i;
+
+	if (!stats_shm_region)
+		return;
+
+	for (i = 0; i < OS_CLOCK_MAX; i++) {
+		if (stats_shm_clock[i]) {
+			stats_export_free(stats_shm_clock[i]);
+			stats_shm_clock[i] = NULL;
+		}
+	}
+
+	stats_export_exit();
+
+	munmap(stats_shm_region, STATS_SHM_SIZE);
+	stats_shm_region = NULL;
+
+	unlink(stats_shm_path);
+}
+
+/** Exports the cross timestamp calibration statistics of the clocks whose time page is published by this process.
+ * Called periodically by the process main thread, the only writer of these sections. Counters are cumulative since
+ * the calibration start, except the last residual, delay and oscillator rate.
+ */
+void stats_shm_clock_export(void)
+{
+	struct stats_export_section *s;
+	struct clock_xts_stats xts;
+	s64 *counters;
+	s32 osc_ppb;
+	int i;
+
+	if (!stats_shm_region)
+		return;
+
+	for (i = 0; i < OS_CLOCK_MAX; i++) {
+		if (clock_xts_stats_get(i, &xts, &osc_ppb) < 0)
+			continue;
+
+		s = stats_shm_clock[i];
+		if (!s) {
+			struct stats_export_id id = {
+				.name = "clock_xts",
+				.label = {
+					{ .name = "clock", .value = i },
+				},
+				.n_labels = 1,
+			};
+
+			s = stats_export_alloc(&id, stats_shm_clock_counter_names, STATS_SHM_CLOCK_COUNTERS, NULL, 0);
+			if (!s)
+				return;
+
+			stats_shm_clock[i] = s;
+		}
+
+		stats_export_begin(s);
+
+		counters = stats_export_counters(s);
+		counters[0] = xts.samples;
+		counters[1] = xts.errors;
+		counters[2] = xts.residuals;
+		counters[3] = xts.residual;
+		counters[4] = xts.residual_abs_total;
+		counters[5] = xts.residual_abs_max;
+		counters[6] = xts.delay;
+		counters[7] = osc_ppb;
+
+		stats_export_end(s);
+	}
+}
@@ -0,0 +1,27 @@
+/*
+* Copyright 2026 NXP
+*
+* SPDX-License-Identifier: BSD-3-Clause
+*/
+
+/**
+ @file
+ @brief Linux shared memory statistics region
+ @details Each stack process (avb, tsn) exports the live statistics of its threads in a shared memory file (see
+ common/stats_export.h), re-created at each process start. The region is read, at any rate, by genavb-stats (or any
+ other consumer mapping the file read-only).
+*/
+
+#ifndef _LINUX_STATS_SHM_H_
+#define _LINUX_STATS_SHM_H_
+
+#define STATS_SHM_PATH		"/dev/shm/genavb_stats_%s"
+#define STATS_SHM_PATH_PREFIX	"/dev/shm/genavb_stats_"
+#define STATS_SHM_PATH_MAX	64
+#define STATS_SHM_SIZE		(1024 * 1024)
+
+int stats_shm_create(const char *name);
+void stats_shm_destroy(void);
+void stats_shm_clock_export(void);
+
+#endif /* _LINUX_STATS_SHM_H_ */
@@ -1,6 +1,6 @@
 /*
 * Copyright 2015 Freescale Semiconductor, Inc.
-* Copyright 2019-2023 NXP
+* Copyright 2019-2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -39,6 +39,7 @@
 #include "tsn.h"
 #include "init.h"
 #include "net.h"
+#include "stats_shm.h"
 
 #define TSN_VERSION GENAVB_VERSION
 
@@ -129,6 +130,30 @@ static int process_section_general(struct _SECTIONENTRY *configtree, int instanc
 		goto exit;
 	}
 
+	/* target clock servo */
+	if (cfg_get_string(configtree, "FGPTP_GENERAL", "servo", CFG_GPTP_DEFAULT_SERVO_NAME, stringvalue)) {
+		rc = -1;
+		goto exit;
+	}
+
+	if (!strcasecmp("pi", stringvalue))
+		cfg->domain_cfg[instance_index].servo = CFG_GPTP_SERVO_PI;
+	else if (!strcasecmp("adaptive_pi", stringvalue))
+		cfg->domain_cfg[instance_index].servo = CFG_GPTP_SERVO_ADAPTIVE_PI;
+	else if (!strcasecmp("kalman", stringvalue)) {
+#ifdef CONFIG_GPTP_FIXED_POINT
+		printf("Error setting servo (%s), floating point servo not available with CONFIG_GPTP_FIXED_POINT\n", stringvalue);
+		rc = -1;
+		goto exit;
+#else
+		cfg->domain_cfg[instance_index].servo = CFG_GPTP_SERVO_KALMAN;
+#endif
+	} else {
+		printf("Error setting servo (%s)\n", stringvalue);
+		rc = -1;
+		goto exit;
+	}
+
 	/* Below parameters are only needed for domain 0 */
 	if (instance_index != 0)
 		goto exit;
@@ -425,6 +450,12 @@ static int process_section_port_params(struct _SECTIONENTRY *configtree, int ins
 			rc = -1;
 			goto exit;
 		}
+
+		/* Port path delay and rate ratio estimation window */
+		if (cfg_get_uchar(configtree, section, "pdelayWindow", CFG_GPTP_DFLT_PDELAY_WINDOW, CFG_GPTP_MIN_PDELAY_WINDOW, CFG_GPTP_MAX_PDELAY_WINDOW, &cfg->port_cfg[i].pdelayWindow)) {
+			rc = -1;
+			goto exit;
+		}
 	}
 exit:
 	return rc;
@@ -648,6 +679,7 @@ int main(int argc, char *argv[])
 	unsigned long endpoint_instance = CFG_ENDPOINT_0_LOGICAL_PORT;
 	unsigned long network_mode = CONFIG_TSN_DEFAULT_NET;
 	bool is_bridge = false;
+	char stats_name[16];
 
 
 	/* Setup standard output in append mode so that log file truncate works correctly */
@@ -847,6 +879,14 @@ int main(int argc, char *argv[])
 	if (rc)
 		os_log(LOG_ERR, "pthread_sigmask(): %s\n", strerror(rc));
 
+	/* Before the stack threads allocate their statistics sections */
+	if (is_bridge)
+		snprintf(stats_name, sizeof(stats_name), "tsn_br");
+	else
+		snprintf(stats_name, sizeof(stats_name), "tsn_ep%lu", endpoint_instance);
+
+	stats_shm_create(stats_name);
+
 #ifdef CONFIG_MANAGEMENT
 	pthread_cond_init(&tsn.management_cond, NULL);
 #endif
@@ -963,6 +1003,8 @@ int main(int argc, char *argv[])
 
 		if (terminate)
 			break;
+
+		stats_shm_clock_export();
 	}
 
 #ifdef CONFIG_GPTP
@@ -980,6 +1022,8 @@ int main(int argc, char *argv[])
 	pthread_join(management_thread, NULL);
 #endif
 
+	stats_shm_destroy();
+
 	os_exit();
 
 	return 0;
@@ -1008,6 +1052,8 @@ err_thread_init_management:
 
 err_pthread_create_management:
 #endif
+	stats_shm_destroy();
+
 	os_exit();
 #ifdef CONFIG_SRP
 err_sr_config:
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -24,6 +24,7 @@ static const u8 maap_multicast_addr[6] = MAAP_MULTICAST_ADDR;
 
 static void maap_sm(struct maap_range *range, struct maap_port *port, maap_event_t event, struct maap_range_info *range_info);
 static void maap_ipc_indication(struct maap_ctx *maap, struct ipc_tx *ipc, unsigned int ipc_dst, unsigned int port_id, u32 range_id, const u8 *base_addr, u16 count, u16 status);
+static void maap_range_indication(struct maap_ctx *maap, struct maap_port *port, struct maap_range *range, u16 status);
 static void maap_net_transmit(struct maap_port *port, struct maap_range *range, u8 msg_type, struct maap_range_info *range_info);
 
 static const char *maap_event2string(maap_event_t event)
@@ -71,22 +72,156 @@ static bool maap_is_in_dynamic_pool(const u8 *start_address, unsigned int count)
 	return (check_start && check_end);
 }
 
+static inline u64 maap_range_start(struct maap_range *range)
+{
+	return MAC_VALUE(range->start_mac_addr);
+}
+
+static inline u64 maap_range_end(struct maap_range *range)
+{
+	return MAC_VALUE(range->start_mac_addr) + (range->mac_count - 1);
+}
+
+/**
+ * Get the first address of a sub-range
+ * \param range, the range
+ * \param i, sub-range index
+ * \param addr, OUTPUT, first MAC address of the sub-range
+ */
+static void maap_sub_range_address(struct maap_range *range, unsigned int i, u8 *addr)
+{
+	u64 value = maap_range_start(range) + (u64)i * range->sub_range_count;
+
+	addr[0] = (value >> 40) & 0xFF;
+	addr[1] = (value >> 32) & 0xFF;
+	addr[2] = (value >> 24) & 0xFF;
+	addr[3] = (value >> 16) & 0xFF;
+	addr[4] = (value >> 8) & 0xFF;
+	addr[5] = value & 0xFF;
+}
+
+/**
+ * Find the first range of the port (in address order) that ends at or after a given address
+ * \return index of the range in the port range index, port->range_index_n if there is none
+ * \param port, the port
+ * \param addr, MAC address value
+ */
+static unsigned int maap_range_index_lookup(struct maap_port *port, u64 addr)
+{
+	unsigned int lo = 0, hi = port->range_index_n, mid;
+
+	/* Ranges don't overlap, so range end addresses are sorted as the start addresses */
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+
+		if (maap_range_end(port->range_index[mid]) < addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
 /**
- * Generate a random mac address between 91:E0:F0:00:00:00 and 91:E0:F0:00:FD:FF
- * \param range, the pointer to the range that need to generate its first MAC address
+ * Add a range to the port range index
+ * \param port, the port
+ * \param range, the range to add, must not overlap with other ranges of the port
+ */
+static void maap_range_index_add(struct maap_port *port, struct maap_range *range)
+{
+	unsigned int i;
+
+	i = maap_range_index_lookup(port, maap_range_start(range));
+
+	os_memmove(&port->range_index[i + 1], &port->range_index[i], (port->range_index_n - i) * sizeof(struct maap_range *));
+
+	port->range_index[i] = range;
+	port->range_index_n++;
+}
+
+/**
+ * Remove a range from the port range index
+ * \param port, the port
+ * \param range, the range to remove
+ */
+static void maap_range_index_del(struct maap_port *port, struct maap_range *range)
+{
+	unsigned int i;
+
+	for (i = maap_range_index_lookup(port, maap_range_start(range)); i < port->range_index_n; i++) {
+		if (port->range_index[i] == range) {
+			port->range_index_n--;
+			os_memmove(&port->range_index[i], &port->range_index[i + 1], (port->range_index_n - i) * sizeof(struct maap_range *));
+			break;
+		}
+	}
+}
+
+/**
+ * Number of possible start addresses for a range of count addresses in the free addresses gap [gap_start, gap_end[
+ */
+static inline u64 maap_gap_positions(u64 gap_start, u64 gap_end, unsigned int count)
+{
+	if (gap_end < gap_start + count)
+		return 0;
+
+	return gap_end - gap_start - count + 1;
+}
+
+/**
+ * Generate a random mac address range between 91:E0:F0:00:00:00 and 91:E0:F0:00:FD:FF, not overlapping with the
+ * other ranges of the port. The start address is picked uniformly among the free positions of the address gaps
+ * between the port ranges, so no retry is needed on internal conflict.
+ * \return 0 on success, -1 if the dynamic pool has no free space left for the range
+ * \param port, the port where the range is allocated
+ * \param range, the pointer to the range that need to generate its first MAC address, must not be in the port range index
  * \param count, number of addresses in the range, max 65024
  */
 /* FIXME : Seed should depend of the local mac address */
-static void maap_generate_address(struct maap_range *range, unsigned int count)
+static int maap_generate_address(struct maap_port *port, struct maap_range *range, unsigned int count)
 {
+	const u8 addr_min[6] = MAAP_DYNAMIC_POOL_MIN;
+	const u8 addr_max[6] = MAAP_DYNAMIC_POOL_MAX;
+	u64 pool_start = MAC_VALUE(addr_min);
+	u64 pool_end = MAC_VALUE(addr_max) + 1;
+	u64 gap_start, gap_end, positions, n;
+	unsigned int i;
 	u16 rand_bytes;
-	unsigned int max;
 
 	if (count > MAAP_DYNAMIC_POOL_SIZE)
 		count = MAAP_DYNAMIC_POOL_SIZE;
 
-	max = MAAP_DYNAMIC_POOL_SIZE - count;
-	rand_bytes = random_range(0x0000, max);
+	/* Ranges in the index are sorted and all in the dynamic pool */
+	positions = 0;
+	gap_start = pool_start;
+
+	for (i = 0; i < port->range_index_n; i++) {
+		positions += maap_gap_positions(gap_start, maap_range_start(port->range_index[i]), count);
+		gap_start = maap_range_end(port->range_index[i]) + 1;
+	}
+
+	positions += maap_gap_positions(gap_start, pool_end, count);
+
+	if (!positions)
+		return -1;
+
+	n = random_range(0, positions - 1);
+
+	gap_start = pool_start;
+
+	for (i = 0; i < port->range_index_n; i++) {
+		gap_end = maap_range_start(port->range_index[i]);
+
+		positions = maap_gap_positions(gap_start, gap_end, count);
+		if (n < positions)
+			break;
+
+		n -= positions;
+		gap_start = maap_range_end(port->range_index[i]) + 1;
+	}
+
+	rand_bytes = (gap_start + n) - pool_start;
 
 	range->start_mac_addr[0] = 0x91;
 	range->start_mac_addr[1] = 0xE0;
@@ -94,6 +229,8 @@ static void maap_generate_address(struct maap_range *range, unsigned int count)
 	range->start_mac_addr[3] = 0x00;
 	range->start_mac_addr[4] = (rand_bytes >> 8) & 0xFF;
 	range->start_mac_addr[5] = rand_bytes & 0xFF;
+
+	return 0;
 }
 
 /**
@@ -158,25 +295,45 @@ static bool are_ranges_in_conflict(struct maap_port *port, const u8 *addr_local,
  */
 static bool check_internal_conflict(struct maap_port *port, struct maap_range *new_range)
 {
-	struct list_head *entry, *entry_next;
-	struct maap_range *range;
-	struct maap_range_info range_info;
+	unsigned int i;
 
-	/* Check conflict on each range of this port */
-	for (entry = list_first(&port->range); entry_next = list_next(entry), entry != &port->range; entry = entry_next) {
+	i = maap_range_index_lookup(port, maap_range_start(new_range));
 
-		range = container_of(entry, struct maap_range, list);
+	return (i < port->range_index_n) && (maap_range_start(port->range_index[i]) <= maap_range_end(new_range));
+}
+
+/**
+ * Get the local ranges of a port overlapping with a given address range
+ * \return number of ranges found
+ * \param port, the port
+ * \param addr, first address of the range
+ * \param count, number of addresses in the range
+ * \param conflict, OUTPUT, array of MAAP_PORT_MAX_RANGES_ALLOCATION range pointers, filled in address order
+ */
+static unsigned int maap_range_index_conflicts(struct maap_port *port, const u8 *addr, unsigned int count, struct maap_range **conflict)
+{
+	u64 start, end;
+	unsigned int i, n = 0;
+
+	if (!count)
+		return 0;
+
+	start = MAC_VALUE(addr);
+	end = start + (count - 1);
+
+	for (i = maap_range_index_lookup(port, start); i < port->range_index_n; i++) {
+		if (maap_range_start(port->range_index[i]) > end)
+			break;
 
-		if (are_ranges_in_conflict(port, range->start_mac_addr, range->mac_count, new_range->start_mac_addr, new_range->mac_count, &range_info.conflict))
-			return true;
+		conflict[n++] = port->range_index[i];
 	}
 
-	return false;
+	return n;
 }
 
 /**
  * Get the range accroding to its id
- * \return the range with this id, NULL if the id is not used
+ * \return the range (or block of ranges) with this id, NULL if the id is not used
  * \param maap, pointer to maap context
  * \param port, pointer to port
  * \param range_id, id of the range
@@ -190,7 +347,8 @@ static struct maap_range *get_range_by_id(struct maap_ctx *maap, struct maap_por
 
 		range = container_of(entry, struct maap_range, list);
 
-		if (range->range_id == range_id)
+		if ((range_id - range->range_id) < range->sub_ranges
+		&& (range->sub_range_mask & ((u64)1 << (range_id - range->range_id))))
 			return range;
 	}
 
@@ -247,14 +405,23 @@ static void maap_release(struct maap_ctx *maap, struct maap_port *port, struct m
 	u8 addr[6] = {0};
 	unsigned int count = 0;
 	u32 range_id;
+	u64 mask;
+	unsigned int i;
 
 	range_id = range->range_id;
+	mask = range->sub_range_mask;
 
-	if (maap_remove_range_on_port(maap, port, range_id, addr, &count) < 0) {
-		maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range_id, addr, count, MAAP_STATUS_ERROR);
+	/* The range is freed with its last sub-range */
+	for (i = 0; mask; i++, mask >>= 1) {
+		if (!(mask & 1))
+			continue;
 
-	} else {
-		maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range_id, addr, count, MAAP_STATUS_FREE);
+		if (maap_remove_range_on_port(maap, port, range_id + i, addr, &count) < 0) {
+			maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range_id + i, addr, count, MAAP_STATUS_ERROR);
+
+		} else {
+			maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range_id + i, addr, count, MAAP_STATUS_FREE);
+		}
 	}
 }
 
@@ -362,13 +529,20 @@ start:
 		case MAAP_STATE_INITIAL:
 			/* Send conflict indication only if we previously (last sent message) notified upper layer with success indication. */
 			if (range->sm.send_conflict_indication) {
-				maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range->range_id,
-							range->start_mac_addr, range->mac_count, MAAP_STATUS_CONFLICT);
+				maap_range_indication(maap, port, range, MAAP_STATUS_CONFLICT);
 
 				range->sm.send_conflict_indication = false;
 			}
 
-			maap_generate_address(range, range->mac_count);
+			/* Pick a new address in the free space of the port, the range is moved in the port range index */
+			maap_range_index_del(port, range);
+
+			if (maap_generate_address(port, range, range->mac_count) < 0)
+				os_log(LOG_ERR, "maap(%p) no free address range of count(%u) on port(%u), retrying with the current one\n",
+					maap, range->mac_count, port->port_id);
+
+			maap_range_index_add(port, range);
+
 			/* This action triggers a ReserveAddress event 1722-2016 Table B.7 */
 			event = MAAP_EVENT_RESERVE_ADDRESS;
 			goto start;
@@ -456,7 +630,7 @@ start:
 		case MAAP_STATE_PROBE:
 			timer_stop(&range->sm.probe_timer);
 			/* Device has sent all its probe messages without receiving conflicting messages, the addresses of the range are successfully attributed */
-			maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range->range_id, range->start_mac_addr, range->mac_count, MAAP_STATUS_SUCCESS);
+			maap_range_indication(maap, port, range, MAAP_STATUS_SUCCESS);
 
 			range->sm.send_conflict_indication = true;
 
@@ -591,9 +765,10 @@ unsigned int maap_port_to_logical(struct maap_ctx *maap, unsigned int port_id)
 static void maap_handle_probe(struct maap_port *port, struct maap_pdu *pdu, struct net_rx_desc *desc)
 {
 	struct eth_hdr *eth = (struct eth_hdr *)((u8 *)desc + desc->l2_offset);
+	struct maap_range *conflict[MAAP_PORT_MAX_RANGES_ALLOCATION];
 	struct maap_range *range;
-	struct list_head *entry, *entry_next;
 	struct maap_range_info range_info;
+	unsigned int i, n;
 	u16 requested_count;
 
 	requested_count = ntohs(pdu->requested_count);
@@ -603,10 +778,11 @@ static void maap_handle_probe(struct maap_port *port, struct maap_pdu *pdu, stru
 				pdu->requested_start_address[2], pdu->requested_start_address[3], pdu->requested_start_address[4],
 				pdu->requested_start_address[5], requested_count);
 
-	/* Check conflict on each range of this port */
-	for (entry = list_first(&port->range); entry_next = list_next(entry), entry != &port->range; entry = entry_next) {
+	/* The state machine may move a range to a new address, so conflicting ranges are looked up first */
+	n = maap_range_index_conflicts(port, pdu->requested_start_address, requested_count, conflict);
 
-		range = container_of(entry, struct maap_range, list);
+	for (i = 0; i < n; i++) {
+		range = conflict[i];
 
 		/* Only receive packets that conflict with the range's addresses */
 		if (!are_ranges_in_conflict(port, range->start_mac_addr, range->mac_count, pdu->requested_start_address, requested_count, &range_info.conflict))
@@ -633,9 +809,10 @@ static void maap_handle_probe(struct maap_port *port, struct maap_pdu *pdu, stru
 static void maap_handle_announce(struct maap_port *port, struct maap_pdu *pdu, struct net_rx_desc *desc)
 {
 	struct eth_hdr *eth = (struct eth_hdr *)((u8 *)desc + desc->l2_offset);
+	struct maap_range *conflict[MAAP_PORT_MAX_RANGES_ALLOCATION];
 	struct maap_range *range;
-	struct list_head *entry, *entry_next;
 	struct maap_range_info range_info;
+	unsigned int i, n;
 	u16 requested_count;
 
 	requested_count = ntohs(pdu->requested_count);
@@ -645,9 +822,11 @@ static void maap_handle_announce(struct maap_port *port, struct maap_pdu *pdu, s
 				pdu->requested_start_address[2], pdu->requested_start_address[3], pdu->requested_start_address[4],
 				pdu->requested_start_address[5], requested_count);
 
-	for (entry = list_first(&port->range); entry_next = list_next(entry), entry != &port->range; entry = entry_next) {
+	/* The state machine may move a range to a new address, so conflicting ranges are looked up first */
+	n = maap_range_index_conflicts(port, pdu->requested_start_address, requested_count, conflict);
 
-		range = container_of(entry, struct maap_range, list);
+	for (i = 0; i < n; i++) {
+		range = conflict[i];
 
 		/* Only receive packets that conflict with the range's address range */
 		if (!are_ranges_in_conflict(port, range->start_mac_addr, range->mac_count, pdu->requested_start_address, requested_count, &range_info.conflict))
@@ -677,15 +856,16 @@ static void maap_handle_defend(struct maap_port *port, struct maap_pdu *pdu, str
 {
 	struct eth_hdr *eth = (struct eth_hdr *)((u8 *)desc + desc->l2_offset);
 	struct maap_range *range;
-	struct list_head *entry, *entry_next;
 	struct maap_range_info range_info;
+	unsigned int i;
 	u16 requested_count;
 
 	requested_count = ntohs(pdu->requested_count);
 
-	for (entry = list_first(&port->range); entry_next = list_next(entry), entry != &port->range; entry = entry_next) {
+	i = maap_range_index_lookup(port, MAC_VALUE(pdu->requested_start_address));
 
-		range = container_of(entry, struct maap_range, list);
+	if (i < port->range_index_n) {
+		range = port->range_index[i];
 
 		/* Retrieve the range that sent the PROBE that triggered this DEFEND respond */
 		if ((os_memcmp(range->start_mac_addr, pdu->requested_start_address, sizeof(u8) * 6) == 0) && (range->mac_count == requested_count)) {
@@ -943,6 +1123,64 @@ static void maap_ipc_indication(struct maap_ctx *maap, struct ipc_tx *ipc, unsig
 		os_log(LOG_ERR, "maap(%p) ipc_alloc() failed\n", maap);
 	}
 }
+
+/**
+ * Send a status indication for each sub-range (not deleted) of a range
+ * \param maap, pointer to maap context
+ * \param port, pointer to port
+ * \param range, the range
+ * \param status, ::genavb_maap_status_t
+ */
+static void maap_range_indication(struct maap_ctx *maap, struct maap_port *port, struct maap_range *range, u16 status)
+{
+	u8 addr[6];
+	unsigned int i;
+
+	for (i = 0; i < range->sub_ranges; i++) {
+		if (!(range->sub_range_mask & ((u64)1 << i)))
+			continue;
+
+		maap_sub_range_address(range, i, addr);
+
+		maap_ipc_indication(maap, &maap->ipc_tx, IPC_DST_ALL, port->port_id, range->range_id + i, addr, range->sub_range_count, status);
+	}
+}
+
+static void maap_ipc_create_ranges_response(struct maap_ctx *maap, struct ipc_tx *ipc, unsigned int ipc_dst, unsigned int logical_port, u32 range_id,
+						unsigned int n_ranges, const u8 *base_addr, u16 count, u16 status)
+{
+	struct ipc_desc *desc;
+	struct ipc_maap_create_ranges_response *msg;
+
+	desc = ipc_alloc(ipc, sizeof(struct ipc_maap_create_ranges_response));
+	if (desc) {
+		desc->dst = ipc_dst;
+		desc->type = GENAVB_MSG_MAAP_CREATE_RANGES_RESPONSE;
+		desc->len = sizeof(struct ipc_maap_create_ranges_response);
+		desc->flags = 0;
+
+		msg = &desc->u.maap_create_ranges_response;
+
+		msg->status = status;
+		msg->port_id = logical_port;
+		msg->range_id = range_id;
+		msg->n_ranges = n_ranges;
+		msg->count = count;
+		os_memcpy(msg->base_address, base_addr, sizeof(u8) * 6);
+
+		if (ipc_tx(ipc, desc) < 0) {
+			os_log(LOG_ERR, "maap(%p) ipc_tx() failed\n", maap);
+
+			ipc_free(ipc, desc);
+		}
+
+		os_log(LOG_DEBUG, "maap(%p) Status %u response for ranges(%u, %02x:%02x:%02x:%02x:%02x:%02x, %u x %u) sent to %u\n",
+			maap, status, range_id, base_addr[0], base_addr[1], base_addr[2], base_addr[3], base_addr[4], base_addr[5], n_ranges, count, ipc_dst);
+
+	} else {
+		os_log(LOG_ERR, "maap(%p) ipc_alloc() failed\n", maap);
+	}
+}
 /* IPC_TX */
 
 /* IPC_RX */
@@ -995,6 +1233,32 @@ err_create_range:
 						desc->u.maap_create.base_address, desc->u.maap_create.count, MAAP_RESPONSE_ERROR);
 		break;
 
+	case GENAVB_MSG_MAAP_CREATE_RANGES:
+		os_log(LOG_DEBUG, "Received GENAVB_MSG_MAAP_CREATE_RANGES\n");
+
+		port = logical_to_maap_port(maap, desc->u.maap_create_ranges.port_id);
+		if (!port) {
+			os_log(LOG_ERR, "maap(%p) invalid logical port(%u)\n", maap, desc->u.maap_create_ranges.port_id);
+			goto err_create_ranges;
+		}
+
+		range = maap_new_ranges_on_port(maap, port, desc->u.maap_create_ranges.range_id,
+						(desc->u.maap_create_ranges.flag == 1) ? desc->u.maap_create_ranges.base_address : NULL,
+						desc->u.maap_create_ranges.n_ranges, desc->u.maap_create_ranges.count);
+		if (!range)
+			goto err_create_ranges;
+
+		maap_ipc_create_ranges_response(maap, ipc_tx, desc->src, port->logical_port, range->range_id, range->sub_ranges,
+						range->start_mac_addr, range->sub_range_count, MAAP_RESPONSE_SUCCESS);
+
+		break;
+
+err_create_ranges:
+		maap_ipc_create_ranges_response(maap, ipc_tx, desc->src, desc->u.maap_create_ranges.port_id, desc->u.maap_create_ranges.range_id,
+						desc->u.maap_create_ranges.n_ranges, desc->u.maap_create_ranges.base_address,
+						desc->u.maap_create_ranges.count, MAAP_RESPONSE_ERROR);
+		break;
+
 	case GENAVB_MSG_MAAP_DELETE_RANGE:
 		os_log(LOG_DEBUG, "Received GENAVB_MSG_MAAP_DELETE_RANGE\n");
 
@@ -1162,30 +1426,40 @@ err_timer_probe:
 }
 
 /**
- * Create a new range of MAC addresses and its associated state machine
+ * Create a new range of MAC addresses and its associated state machine.
+ * The range can be split in several sub-ranges, with consecutive ids, sharing the same state machine.
  * \return a pointer to the range created on success, NULL value on failure
  * \param maap, pointer to the MAAP context
  * \param port, the port where the range is allocated
- * \param range_id, chosen range id
+ * \param range_id, chosen range id (of the first sub-range)
  * \param addr, a chosen initial MAC address if needed, NULL otherwise
- * \param n_addr, number of addresses requested for the range
+ * \param n_ranges, number of sub-ranges
+ * \param n_addr, number of addresses requested for each sub-range
  */
-static struct maap_range *maap_range_alloc(struct maap_ctx *maap, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_addr)
+static struct maap_range *maap_range_alloc(struct maap_ctx *maap, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_ranges, unsigned int n_addr)
 {
 	struct maap_range *range;
+	unsigned int i;
+
+	if (!n_ranges || n_ranges > MAAP_CREATE_RANGES_MAX)
+		goto err_alloc;
 
-	if (n_addr > MAAP_DYNAMIC_POOL_SIZE || n_addr <= 0)
+	if (n_addr > (MAAP_DYNAMIC_POOL_SIZE / n_ranges) || n_addr <= 0)
 		goto err_alloc;
 
-	if (addr && !maap_is_in_dynamic_pool(addr, n_addr))
+	if (addr && !maap_is_in_dynamic_pool(addr, n_ranges * n_addr))
 		goto err_alloc;
 
 	if (port->allocated_ranges_count >= MAAP_PORT_MAX_RANGES_ALLOCATION)
 		goto err_alloc;
 
-	if (is_range_id_used(maap, port, range_id))
+	if (range_id > (u32)(range_id + (n_ranges - 1)))
 		goto err_alloc;
 
+	for (i = 0; i < n_ranges; i++)
+		if (is_range_id_used(maap, port, range_id + i))
+			goto err_alloc;
+
 	range = os_malloc(sizeof(struct maap_range));
 	if (!range)
 		goto err_alloc;
@@ -1198,15 +1472,20 @@ static struct maap_range *maap_range_alloc(struct maap_ctx *maap, struct maap_po
 	/* Init MAC address range. */
 	if (!addr) {
 		/* Generate the range address on init */
-		maap_generate_address(range, n_addr);
+		if (maap_generate_address(port, range, n_ranges * n_addr) < 0)
+			goto err_init;
 	} else {
 		os_memcpy(range->start_mac_addr, addr, sizeof(u8) * 6);
 	}
 
-	range->mac_count = n_addr;
+	range->mac_count = n_ranges * n_addr;
 
 	range->range_id = range_id;
 
+	range->sub_ranges = n_ranges;
+	range->sub_range_count = n_addr;
+	range->sub_range_mask = (n_ranges < 64) ? (((u64)1 << n_ranges) - 1) : ~(u64)0;
+
 	/* Check for internal conflict inside the same port */
 	if (check_internal_conflict(port, range))
 		goto err_init;
@@ -1283,6 +1562,7 @@ __init static int maap_ports_init(struct maap_ctx *maap, struct maap_config *cfg
 		maap->port[i].logical_port = logical_port;
 		maap->port[i].initialized = false;
 		maap->port[i].allocated_ranges_count = 0;
+		maap->port[i].range_index_n = 0;
 
 		addr.ptype = PTYPE_AVTP;
 		addr.port = logical_port;
@@ -1445,40 +1725,57 @@ __exit static void maap_ipc_exit(struct maap_ctx *maap)
 /* _INTERFACE_ */
 /**
  * Entry point for external use (AVDEEC).
- * Allows to start the process of attributing a MAC address range to a port and start the corresponding state machine
- * \return	the range created on success, NULL otherwise
+ * Allows to start the process of attributing a block of MAC address ranges to a port, with a single state machine
+ * \return	the block range on success, NULL otherwise
  * \param maap	pointer to the MAAP context
  * \param port, pointer to the port
- * \param range_id, chosen id for the range
- * \param addr, a chosen initial MAC address if needed otherwise NULL
- * \param n_addr, number of MAC addresses requested for the range
+ * \param range_id, id of the first range, the ranges use consecutive ids
+ * \param addr, a chosen initial MAC address for the block if needed otherwise NULL
+ * \param n_ranges, number of ranges
+ * \param n_addr, number of MAC addresses requested for each range
  */
-struct maap_range *maap_new_range_on_port(struct maap_ctx *maap, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_addr)
+struct maap_range *maap_new_ranges_on_port(struct maap_ctx *maap, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_ranges, unsigned int n_addr)
 {
 	struct maap_range *range;
 
-	range = maap_range_alloc(maap, port, range_id, addr, n_addr);
+	range = maap_range_alloc(maap, port, range_id, addr, n_ranges, n_addr);
 	if (!range)
 		goto err_range_alloc;
 
 	/* Add range to the linked list of MAC address range of the port */
 	list_add(&port->range, &range->list);
+	maap_range_index_add(port, range);
 
 	/* Start the range's state machine */
 	maap_sm(range, port, MAAP_EVENT_BEGIN, NULL);
 
-	os_log(LOG_INFO, "maap(%p) success range(%u, %02x:%02x:%02x:%02x:%02x:%02x, %u) on port(%u) created\n", maap, range->range_id,
+	os_log(LOG_INFO, "maap(%p) success range(%u, %02x:%02x:%02x:%02x:%02x:%02x, %u x %u) on port(%u) created\n", maap, range->range_id,
 		range->start_mac_addr[0], range->start_mac_addr[1], range->start_mac_addr[2],
-		range->start_mac_addr[3], range->start_mac_addr[4], range->start_mac_addr[5], range->mac_count, port->port_id);
+		range->start_mac_addr[3], range->start_mac_addr[4], range->start_mac_addr[5], range->sub_ranges, range->sub_range_count, port->port_id);
 
 	return range;
 
 err_range_alloc:
-	os_log(LOG_ERR, "maap(%p) failed to create range of count(%u) on port(%u)\n", maap, n_addr, port->port_id);
+	os_log(LOG_ERR, "maap(%p) failed to create range of count(%u x %u) on port(%u)\n", maap, n_ranges, n_addr, port->port_id);
 
 	return NULL;
 }
 
+/**
+ * Entry point for external use (AVDEEC).
+ * Allows to start the process of attributing a MAC address range to a port and start the corresponding state machine
+ * \return	the range created on success, NULL otherwise
+ * \param maap	pointer to the MAAP context
+ * \param port, pointer to the port
+ * \param range_id, chosen id for the range
+ * \param addr, a chosen initial MAC address if needed otherwise NULL
+ * \param n_addr, number of MAC addresses requested for the range
+ */
+struct maap_range *maap_new_range_on_port(struct maap_ctx *maap, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_addr)
+{
+	return maap_new_ranges_on_port(maap, port, range_id, addr, 1, n_addr);
+}
+
 /**
  * Entry point for external use (AVDEEC).
  * Allows to remove all ranges attributed on a port
@@ -1500,6 +1797,8 @@ int maap_remove_all_range_on_port(struct maap_ctx *maap, struct maap_port *port)
 		maap_range_free(range);
 	}
 
+	port->range_index_n = 0;
+
 	return 0;
 }
 
@@ -1515,26 +1814,29 @@ int maap_remove_all_range_on_port(struct maap_ctx *maap, struct maap_port *port)
  */
 int maap_remove_range_on_port(struct maap_ctx *maap, struct maap_port *port, u32 range_id, u8 *addr, unsigned int *count)
 {
-	struct list_head *entry, *entry_next;
 	struct maap_range *range;
+	unsigned int i;
 
-	/* Exit ranges */
-	for (entry = list_first(&port->range); entry_next = list_next(entry), entry != &port->range; entry = entry_next) {
+	range = get_range_by_id(maap, port, range_id);
+	if (range) {
+		i = range_id - range->range_id;
 
-		range = container_of(entry, struct maap_range, list);
+		maap_sub_range_address(range, i, addr);
+		*count = range->sub_range_count;
 
-		if (range->range_id == range_id) {
-			os_memcpy(addr, range->start_mac_addr, sizeof(u8) * 6);
-			*count = range->mac_count;
+		/* The addresses of a block are kept until all its ranges are deleted */
+		range->sub_range_mask &= ~((u64)1 << i);
 
-			list_del(entry);
+		if (!range->sub_range_mask) {
+			list_del(&range->list);
+			maap_range_index_del(port, range);
 			maap_range_free(range);
+		}
 
-			os_log(LOG_INFO, "maap(%p) success range(%02x:%02x:%02x:%02x:%02x:%02x, %u) on port(%u) freed\n", maap,
-				addr[0], addr[1], addr[2], addr[3], addr[4], addr[5], *count, port->port_id);
+		os_log(LOG_INFO, "maap(%p) success range(%02x:%02x:%02x:%02x:%02x:%02x, %u) on port(%u) freed\n", maap,
+			addr[0], addr[1], addr[2], addr[3], addr[4], addr[5], *count, port->port_id);
 
-			return 0;
-		}
+		return 0;
 	}
 
 	os_log(LOG_ERR, "maap(%p) failed to free range(%u) on port(%u)\n", maap, range_id, port->port_id);
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -183,6 +183,11 @@ struct maap_range {
 	/* Start MAC address */
 	u8 start_mac_addr[6];
 
+	/* Split in sub_ranges ranges of sub_range_count addresses, with ids range_id to (range_id + sub_ranges - 1) */
+	unsigned int sub_ranges;
+	unsigned int sub_range_count;
+	u64 sub_range_mask;	/* Ranges not deleted yet */
+
 	/* MAAP state machine per range, 1..1 */
 	struct maap_sm sm;
 };
@@ -207,6 +212,10 @@ struct maap_port {
 
 	/* MAC address range, 0..n */
 	struct list_head range;
+
+	/* Same MAC address ranges, sorted by start address (ranges don't overlap) */
+	struct maap_range *range_index[MAAP_PORT_MAX_RANGES_ALLOCATION];
+	unsigned int range_index_n;
 };
 
 /**
@@ -257,6 +266,19 @@ struct maap_range_info {
  */
 struct maap_range *maap_new_range_on_port(struct maap_ctx *ctx, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_addr);
 
+/**
+ * Entry point for external use (AVDEEC).
+ * Allows to start the process of attributing a block of MAC address ranges to a port, with a single state machine
+ * \return	the block range on success, NULL otherwise
+ * \param maap	pointer to the MAAP context
+ * \param port, pointer to the port
+ * \param range_id, id of the first range, the ranges use consecutive ids
+ * \param addr, a chosen initial MAC address for the block if needed otherwise NULL
+ * \param n_ranges, number of ranges
+ * \param n_addr, number of MAC addresses requested for each range
+ */
+struct maap_range *maap_new_ranges_on_port(struct maap_ctx *maap, struct maap_port *port, u32 range_id, const u8 *addr, unsigned int n_ranges, unsigned int n_addr);
+
 /**
  * Entry point for external use (AVDEEC).
  * Allows to remove all ranges attributed on a port
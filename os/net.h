@@ -122,6 +122,18 @@ int net_tx_init(struct net_tx *tx, struct net_address *addr);
  */
 void net_tx_exit(struct net_tx *tx);
 
+/** Enables software shaping of a network transmit context
+ *
+ * Used by SR stream talkers, for network backends that don't shape SR class traffic themselves. Frames passed to
+ * net_tx_multi() are then paced against the stream reservation.
+ *
+ * \return 1 if frames are shaped in software, 0 if shaping is left to the network backend, -1 on error
+ * \param tx		pointer to network transmit context
+ * \param idle_slope	stream reserved bandwidth, in bits per second
+ * \param interval	stream class measurement interval, in nanoseconds
+ */
+int net_tx_shaper_config(struct net_tx *tx, unsigned int idle_slope, unsigned int interval);
+
 /** Retrieves port mac address
  *
  * \return 0 on success, -1 on error
@@ -34,7 +34,13 @@ unsigned int aem_get_descriptor_max(struct aem_desc_hdr *aem_desc, avb_u16 type)
 
 void *aem_get_descriptor(struct aem_desc_hdr *aem_desc, avb_u16 type, avb_u16 index, avb_u16 *len)
 {
-	struct aem_desc_hdr *desc = &aem_desc[type];
+	struct aem_desc_hdr *desc;
+
+	/* type/index usually come straight from a received AECP command */
+	if (type >= AEM_NUM_DESC_TYPES)
+		return NULL;
+
+	desc = &aem_desc[type];
 
 	if (index < desc->total) {
 		if (len)
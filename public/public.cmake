@@ -21,3 +21,51 @@ genavb_target_add_srcs(TARGET genavb
   qos.c
   helpers.c
   )
+
+genavb_target_add_srcs(TARGET ${gptp_sim}
+  SRCS
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${gptp_replay}
+  SRCS
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${cbs_sim}
+  SRCS
+  sr_class.c
+  qos.c
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${net_shaper_bench}
+  SRCS
+  sr_class.c
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${mclock_rec_sim}
+  SRCS
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${clock_bench}
+  SRCS
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${phc_calib}
+  SRCS
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${ptp_ratio_test}
+  SRCS
+  helpers.c
+  )
+
+genavb_target_add_srcs(TARGET ${stats}
+  SRCS
+  helpers.c
+  )
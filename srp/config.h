@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -22,6 +22,8 @@
 /* 3 timers per application: LeaveAll, Join Periodic */
 #define CFG_SRP_MAX_TIMERS_PER_PORT	(2 * 3)
 
+#define CFG_SRP_STATS_EXPORT_PERIOD_MS	1000	/* counters publication period, to the statistics region (see common/stats_export.h) */
+
 #define CFG_PORT_TC_MAX_LATENCY	500	/* ns */
 
 #define CFG_MVRP_PARTICIPANT_TYPE	MRP_PARTICIPANT_TYPE_FULL_POINT_TO_POINT
@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -174,6 +174,123 @@ static void srp_port_exit(struct srp_ctx *srp)
 	}
 }
 
+static const char * const srp_port_counter_names[] = {
+	"MsrpRxPkts",
+	"MsrpTxPkts",
+	"MsrpTxErr",
+	"MsrpFailedRegistrations",
+	"MvrpRxPkts",
+	"MvrpTxPkts",
+	"MvrpTxErr",
+};
+
+#define SRP_PORT_COUNTERS	(sizeof(srp_port_counter_names) / sizeof(char *))
+
+/** Publishes SRP per port counters to the statistics region
+ * \return	none
+ * \param srp	pointer to the main SRP context
+ */
+static void srp_stats_export(struct srp_ctx *srp)
+{
+	struct msrp_port *msrp_port;
+	struct mvrp_port *mvrp_port;
+	struct stats_export_section *s;
+	s64 *counters;
+	int i;
+
+	for (i = 0; i < srp->port_max; i++) {
+		s = srp->port[i].stats_export;
+		if (!s)
+			continue;
+
+		msrp_port = &srp->msrp->port[i];
+		mvrp_port = &srp->mvrp->port[i];
+
+		stats_export_begin(s);
+
+		counters = stats_export_counters(s);
+		counters[0] = msrp_port->mrp_app.num_rx_pkts;
+		counters[1] = msrp_port->num_tx_pkts;
+		counters[2] = msrp_port->num_tx_err;
+		counters[3] = msrp_port->failed_registrations;
+		counters[4] = mvrp_port->mrp_app.num_rx_pkts;
+		counters[5] = mvrp_port->num_tx_pkts;
+		counters[6] = mvrp_port->num_tx_err;
+
+		stats_export_end(s);
+	}
+}
+
+static void srp_stats_export_timer_handler(void *data)
+{
+	struct srp_ctx *srp = (struct srp_ctx *)data;
+
+	srp_stats_export(srp);
+
+	timer_restart(&srp->stats_export_timer, CFG_SRP_STATS_EXPORT_PERIOD_MS);
+}
+
+static void srp_stats_export_free(struct srp_ctx *srp)
+{
+	int i;
+
+	for (i = 0; i < srp->port_max; i++) {
+		if (srp->port[i].stats_export)
+			stats_export_free(srp->port[i].stats_export);
+	}
+}
+
+/** Allocates the SRP statistics region sections, and starts their periodic update.
+ * Does nothing if statistics export is disabled (see stats_export_init()).
+ * \return	none
+ * \param srp	pointer to the main SRP context
+ */
+__init static void srp_stats_export_init(struct srp_ctx *srp)
+{
+	struct stats_export_id id = {
+		.name = "srp_port",
+		.label = {
+			{ .name = "port" },
+		},
+		.n_labels = 1,
+	};
+	int i;
+
+	for (i = 0; i < srp->port_max; i++) {
+		id.label[0].value = srp->port[i].port_id;
+
+		srp->port[i].stats_export = stats_export_alloc(&id, srp_port_counter_names, SRP_PORT_COUNTERS, NULL, 0);
+		if (!i && !srp->port[i].stats_export)
+			return;
+	}
+
+	srp->stats_export_timer.func = srp_stats_export_timer_handler;
+	srp->stats_export_timer.data = srp;
+	if (timer_create(srp->timer_ctx, &srp->stats_export_timer, TIMER_TYPE_SYS, 0) < 0)
+		goto err_timer;
+
+	timer_start(&srp->stats_export_timer, CFG_SRP_STATS_EXPORT_PERIOD_MS);
+
+	srp->stats_export = true;
+
+	return;
+
+err_timer:
+	os_log(LOG_ERR, "srp(%p) stats export timer creation failed\n", srp);
+
+	srp_stats_export_free(srp);
+}
+
+static void srp_stats_export_exit(struct srp_ctx *srp)
+{
+	if (!srp->stats_export)
+		return;
+
+	timer_destroy(&srp->stats_export_timer);
+
+	srp_stats_export_free(srp);
+}
+
 __init static struct srp_ctx *srp_alloc(unsigned int ports, unsigned int timer_n)
 {
 	struct srp_ctx *srp;
@@ -215,7 +332,7 @@ __init void *srp_init(struct srp_config *cfg, unsigned long priv)
 	unsigned int timer_n;
 	unsigned int ipc_tx, ipc_rx;
 
-	timer_n = cfg->port_max * CFG_SRP_MAX_TIMERS_PER_PORT;
+	timer_n = cfg->port_max * CFG_SRP_MAX_TIMERS_PER_PORT + 1; /* stats export timer */
 
 	srp = srp_alloc(cfg->port_max, timer_n);
 	if (!srp)
@@ -266,6 +383,8 @@ __init void *srp_init(struct srp_config *cfg, unsigned long priv)
 
 	srp_managed_objects_init(&srp->module, srp);
 
+	srp_stats_export_init(srp);
+
 	os_log(LOG_INIT, "srp(%p) done\n", srp);
 
 	return srp;
@@ -307,6 +426,8 @@ __exit int srp_exit(void *srp_h)
 {
 	struct srp_ctx *srp = (struct srp_ctx *)srp_h;
 
+	srp_stats_export_exit(srp);
+
 	mmrp_exit(&srp->mmrp);
 
 	mvrp_exit(srp->mvrp);
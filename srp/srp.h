@@ -1,6 +1,6 @@
 /*
 * Copyright 2014 Freescale Semiconductor, Inc.
-* Copyright 2020-2021, 2023 NXP
+* Copyright 2020-2021, 2023, 2026 NXP
 *
 * SPDX-License-Identifier: BSD-3-Clause
 */
@@ -20,6 +20,7 @@
 #include "common/net.h"
 #include "common/ipc.h"
 #include "common/timer.h"
+#include "common/stats_export.h"
 
 #include "srp_managed_objects.h"
 
@@ -35,6 +36,7 @@ struct srp_port {
 	bool initialized;
 	struct net_rx net_rx; /**< network rx context */
 	struct net_tx net_tx; /**< network tx context */
+	struct stats_export_section *stats_export; /**< statistics region section */
 };
 
 /**
@@ -48,6 +50,8 @@ struct srp_ctx {
 	struct mvrp_ctx *mvrp; /**< MVRP module context */
 	struct mmrp_ctx mmrp; /**< MMRP module context */
 	struct timer_ctx *timer_ctx; /**< timer context */
+	struct timer stats_export_timer; /**< statistics region update timer */
+	bool stats_export;
 
 	struct ipc_rx ipc_rx_mac_service;
 	struct ipc_tx ipc_tx_mac_service;